@@ -0,0 +1,103 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <string>
+#include <vector>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "global/RuntimeParameters.h"
+#include "index/EncodedIriManager.h"
+#include "parser/SparqlFastPathParser.h"
+#include "parser/SparqlParser.h"
+
+namespace ad_benchmark {
+
+namespace {
+// The number of queries that are parsed per measurement.
+constexpr size_t numQueries = 10'000;
+
+// Generate `numQueries` queries from the given `makeQuery`, which gets the
+// index of the query, s.t. the constants in the queries differ.
+std::vector<std::string> generateQueries(auto makeQuery) {
+  std::vector<std::string> result;
+  result.reserve(numQueries);
+  for (size_t i = 0; i < numQueries; ++i) {
+    result.push_back(makeQuery(i));
+  }
+  return result;
+}
+}  // namespace
+
+// Compare the time for parsing frequent query shapes with the parser that is
+// generated by ANTLR and with the hand-written `SparqlFastPathParser`.
+class SparqlParserBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Parsing simple SPARQL queries with and without the fast path";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    std::vector<std::pair<std::string, std::vector<std::string>>> workloads;
+    workloads.emplace_back(
+        "Single triple", generateQueries([](size_t i) {
+          return absl::StrCat("SELECT ?x WHERE { ?x <http://example.org/p> ",
+                              "<http://example.org/o", i, "> }");
+        }));
+    workloads.emplace_back(
+        "Star with prefixes, FILTER, and LIMIT",
+        generateQueries([](size_t i) {
+          return absl::StrCat(
+              "PREFIX ex: <http://example.org/>\n"
+              "PREFIX rdfs: <http://www.w3.org/2000/01/rdf-schema#>\n"
+              "SELECT DISTINCT ?x ?label ?age WHERE {\n"
+              "  ?x a ex:Person ; rdfs:label ?label ; ex:age ?age ;\n"
+              "     ex:livesIn ex:city",
+              i % 100,
+              " .\n"
+              "  FILTER(?age > ",
+              i % 90, ")\n} LIMIT 100");
+        }));
+
+    std::vector<std::string> rowNames;
+    for (const auto& [workloadName, queries] : workloads) {
+      rowNames.push_back(absl::StrCat(workloadName, ", ANTLR"));
+      rowNames.push_back(absl::StrCat(workloadName, ", fast path"));
+    }
+    auto& table =
+        results.addTable("Parsing " + std::to_string(numQueries) + " queries",
+                         rowNames, {"Time (s)", "Queries per second"});
+
+    EncodedIriManager encodedIriManager;
+    size_t row = 0;
+    for (const auto& workload : workloads) {
+      const auto& queries = workload.second;
+      for (bool useFastPath : {false, true}) {
+        RuntimeParameters().set<"use-sparql-fast-path-parser">(useFastPath);
+        size_t numVisibleVariables = 0;
+        table.addMeasurement(row, 0, [&]() {
+          for (const auto& query : queries) {
+            numVisibleVariables +=
+                SparqlParser::parseQuery(&encodedIriManager, query)
+                    .getVisibleVariables()
+                    .size();
+          }
+        });
+        AD_CORRECTNESS_CHECK(numVisibleVariables > 0);
+        auto seconds = table.getEntry<float>(row, 0);
+        table.setEntry(row, 1, static_cast<float>(numQueries) / seconds);
+        ++row;
+      }
+      // All the queries of the workloads are supported by the fast path.
+      AD_CORRECTNESS_CHECK(SparqlFastPathParser::tryParseQuery(
+                               &encodedIriManager, queries.front())
+                               .has_value());
+    }
+    RuntimeParameters().set<"use-sparql-fast-path-parser">(true);
+    return results;
+  }
+};
+
+AD_REGISTER_BENCHMARK(SparqlParserBenchmark);
+}  // namespace ad_benchmark
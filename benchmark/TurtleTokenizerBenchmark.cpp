@@ -0,0 +1,179 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+
+#include <string>
+#include <string_view>
+
+#include "../benchmark/infrastructure/Benchmark.h"
+#include "index/EncodedIriManager.h"
+#include "parser/RdfParser.h"
+#include "parser/SimdScanner.h"
+#include "parser/Tokenizer.h"
+#include "parser/TokenizerCtre.h"
+#include "util/Log.h"
+
+namespace ad_benchmark {
+
+namespace {
+// The number of triples in the generated inputs.
+constexpr size_t numTriples = 500'000;
+
+// Generate an N-Triples input with IRIs, literals, and blank nodes.
+std::string generateNTriples() {
+  std::string result;
+  for (size_t i = 0; i < numTriples; ++i) {
+    absl::StrAppend(&result, "<http://example.org/subject/", i % 10'000,
+                    "> <http://example.org/property/", i % 37, "> ");
+    switch (i % 4) {
+      case 0:
+        absl::StrAppend(&result, "<http://example.org/object/", i, ">");
+        break;
+      case 1:
+        absl::StrAppend(&result, "\"A literal with some text, number ", i,
+                        " and an \\\"escaped\\\" quote\"@en");
+        break;
+      case 2:
+        absl::StrAppend(&result, "\"", i,
+                        "\"^^<http://www.w3.org/2001/XMLSchema#integer>");
+        break;
+      default:
+        absl::StrAppend(&result, "_:b", i);
+    }
+    absl::StrAppend(&result, " .\n");
+  }
+  return result;
+}
+
+// Generate a Turtle input with prefixed names, and predicate and object lists.
+std::string generateTurtle() {
+  std::string result =
+      "@prefix ex: <http://example.org/> .\n"
+      "@prefix xsd: <http://www.w3.org/2001/XMLSchema#> .\n";
+  for (size_t i = 0; i < numTriples / 4; ++i) {
+    absl::StrAppend(&result, "ex:subject", i, "\n    ex:name \"Name ", i,
+                    "\"@en , \"Nom ", i, "\"@fr ;\n    ex:value \"", i,
+                    "\"^^xsd:integer ;\n    ex:link <http://example.org/object/",
+                    i % 1000, "> .\n");
+  }
+  return result;
+}
+
+// Parse the complete `input` with the given `Parser` and return the number of
+// triples.
+template <typename Parser>
+size_t parseAll(const std::string& input) {
+  EncodedIriManager encodedIriManager;
+  Parser parser{&encodedIriManager};
+  parser.setInputStream(input);
+  return parser.parseAndReturnAllTriples().size();
+}
+}  // namespace
+
+// Compare the throughput of the tokenizers that are used by the `TurtleParser`
+// (the hand-written one based on CTRE, which uses the `simdScanner` for the
+// structural characters, and the one based on RE2), and of the `simdScanner`
+// compared to the scanning functions of `std::string_view`.
+class TurtleTokenizerBenchmark : public BenchmarkInterface {
+  std::string name() const final {
+    return "Throughput of the Turtle and N-Triples tokenizers";
+  }
+
+  BenchmarkResults runAllBenchmarks() final {
+    BenchmarkResults results{};
+    const std::string nTriples = generateNTriples();
+    const std::string turtle = generateTurtle();
+
+    // The scanning for the end of the IRIs and the whitespace, which are the
+    // most frequent operations of the tokenizer.
+    auto& scanning = results.addTable(
+        "Scanning the N-Triples input for structural characters",
+        {"std::string_view", "simdScanner"}, {"Time (s)", "Throughput (MB/s)"});
+    size_t checksumStd = 0;
+    size_t checksumSimd = 0;
+    auto scanWith = [&nTriples](auto findStructural, auto skipWhitespace,
+                                size_t& checksum) {
+      std::string_view view = nTriples;
+      size_t pos = 0;
+      while (pos < view.size()) {
+        pos += skipWhitespace(view.substr(pos));
+        auto next = findStructural(view, pos + 1);
+        if (next == std::string_view::npos) {
+          break;
+        }
+        checksum += next;
+        pos = next + 1;
+      }
+    };
+    scanning.addMeasurement(0, 0, [&]() {
+      scanWith(
+          [](std::string_view v, size_t pos) {
+            return v.find_first_of("<>\"\n", pos);
+          },
+          [](std::string_view v) {
+            return std::min(v.find_first_not_of(" \t\r\n"), v.size());
+          },
+          checksumStd);
+    });
+    scanning.addMeasurement(1, 0, [&]() {
+      scanWith(
+          [](std::string_view v, size_t pos) {
+            return simdScanner::findFirstOf<'<', '>', '"', '\n'>(v, pos);
+          },
+          [](std::string_view v) {
+            return simdScanner::numLeadingWhitespace(v);
+          },
+          checksumSimd);
+    });
+    AD_CORRECTNESS_CHECK(checksumStd == checksumSimd);
+    addThroughputColumn(scanning, nTriples.size());
+
+    // The complete parsing of both inputs with both tokenizers.
+    auto& parsing = results.addTable(
+        "Parsing (single-threaded)",
+        {"N-Triples, CTRE tokenizer", "N-Triples, RE2 tokenizer",
+         "Turtle, CTRE tokenizer", "Turtle, RE2 tokenizer"},
+        {"Time (s)", "Throughput (MB/s)"});
+    using CtreParser = RdfStringParser<TurtleParser<TokenizerCtre>>;
+    using Re2Parser = RdfStringParser<TurtleParser<Tokenizer>>;
+    size_t row = 0;
+    for (const auto* input : {&nTriples, &turtle}) {
+      size_t numTriplesCtre = 0;
+      size_t numTriplesRe2 = 0;
+      parsing.addMeasurement(row, 0, [&]() {
+        numTriplesCtre = parseAll<CtreParser>(*input);
+      });
+      parsing.addMeasurement(row + 1, 0, [&]() {
+        numTriplesRe2 = parseAll<Re2Parser>(*input);
+      });
+      AD_CORRECTNESS_CHECK(numTriplesCtre == numTriplesRe2);
+      LOG(INFO) << "Number of triples parsed: " << numTriplesCtre << std::endl;
+      row += 2;
+    }
+    for (size_t i = 0; i < parsing.numRows(); ++i) {
+      auto numBytes = i < 2 ? nTriples.size() : turtle.size();
+      setThroughput(parsing, i, numBytes);
+    }
+    return results;
+  }
+
+ private:
+  // Set the throughput in the second column of the `row` of the `table` from
+  // the time that was measured in the first column.
+  static void setThroughput(ResultTable& table, size_t row, size_t numBytes) {
+    auto seconds = table.getEntry<float>(row, 0);
+    table.setEntry(row, 1,
+                   static_cast<float>(numBytes) / 1'000'000.0f / seconds);
+  }
+
+  // Call `setThroughput` for all the rows of the `table`.
+  static void addThroughputColumn(ResultTable& table, size_t numBytes) {
+    for (size_t i = 0; i < table.numRows(); ++i) {
+      setThroughput(table, i, numBytes);
+    }
+  }
+};
+
+AD_REGISTER_BENCHMARK(TurtleTokenizerBenchmark);
+}  // namespace ad_benchmark
@@ -24,11 +24,15 @@ class Bind : public Operation {
   // For the documentation of the overridden members, see Operation.h
  protected:
   [[nodiscard]] std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   const parsedQuery::Bind& bind() const { return _bind; }
   [[nodiscard]] std::string getDescriptor() const override;
   [[nodiscard]] size_t getResultWidth() const override;
+  [[nodiscard]] bool canYieldLazyResult() const override { return true; }
   std::vector<QueryExecutionTree*> getChildren() override;
   size_t getCostEstimate() override;
   bool supportsLimitOffset() const override;
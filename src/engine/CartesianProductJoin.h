@@ -54,6 +54,9 @@ class CartesianProductJoin : public Operation {
   // The individual implementation of `getCacheKey` (see above) that has to be
   // customized by every child class.
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   // Gets a very short (one line without line ending) descriptor string for
@@ -4,12 +4,150 @@
 
 #include "engine/CountConnectedSubgraphs.h"
 
+#include <atomic>
+#include <bit>
+#include <bitset>
+
 #include "util/BitUtils.h"
+#include "util/Synchronized.h"
+#include "util/jthread.h"
 
 namespace countConnectedSubgraphs {
 
+namespace {
+// Return the set of nodes in `graph` that are adjacent to at least one of the
+// nodes in `nodes`. Nodes that are `ignored` are excluded from the result. Note
+// that the result may contain nodes from the `nodes` itself. The result is
+// returned using the same encoding as `nodes` and `ignored`.
+uint64_t computeNeighbors(const Graph& graph, uint64_t nodes,
+                          uint64_t ignored) {
+  uint64_t neighbors{};
+  for (uint64_t remaining = nodes; remaining != 0;
+       remaining &= remaining - 1) {
+    neighbors |= graph[std::countr_zero(remaining)].neighbors_;
+  }
+  neighbors &= (~ignored);
+  return neighbors;
+}
+
+// Return the next non-empty subset of `set` after `subset` in increasing
+// numeric order, or 0 if `subset` was the last one. Passing 0 as the `subset`
+// returns the first subset.
+uint64_t nextSubset(uint64_t subset, uint64_t set) {
+  return (subset - set) & set;
+}
+
+// The implementation of `countSubgraphsRecursively`, which stops as soon as
+// `shouldStop(count)` returns true and then returns the current `count`.
+template <typename ShouldStop>
+size_t countRecursively(const Graph& graph, uint64_t nodes, uint64_t ignored,
+                        size_t count, const ShouldStop& shouldStop) {
+  // Compute the set of direct neighbors of the `nodes` that is not
+  // ignored
+  uint64_t neighbors = computeNeighbors(graph, nodes, ignored);
+
+  // This is the recursion level which handles all the subsets of the neighbors,
+  // and the above recursion levels deal with `nodes`, so we have to exclude
+  // them further down.
+  auto newIgnored = ignored | neighbors | nodes;
+
+  // Iterate over all the non-empty subsets of the neighbors.
+  for (uint64_t subset = nextSubset(0, neighbors); subset != 0;
+       subset = nextSubset(subset, neighbors)) {
+    ++count;
+    if (shouldStop(count)) {
+      return count;
+    }
+    count = countRecursively(graph, nodes | subset, newIgnored, count,
+                             shouldStop);
+    if (shouldStop(count)) {
+      return count;
+    }
+  }
+  return count;
+}
+
+// Below this budget, counting sequentially is faster than starting threads.
+constexpr size_t MIN_BUDGET_FOR_PARALLELISM = 10'000;
+
+// The maximal number of subsets of the neighbors of a start node that a
+// thread claims at once in `countSubgraphsInParallel`.
+constexpr size_t NUM_TASKS_PER_CLAIM = 16;
+
+// The parallel implementation of `countSubgraphs`. The subgraphs that contain
+// the start node `i`, but no node `k < i` are split into tasks, one for each
+// subset of the neighbors of `i` that are `> i`. The threads claim these
+// tasks in small chunks from a shared cursor, so a thread that finishes its
+// tasks early takes over more of the remaining work. All threads stop as soon
+// as the total count exceeds the `budget`.
+size_t countSubgraphsInParallel(const Graph& graph, size_t budget,
+                                size_t numThreads) {
+  // The subgraphs that consist of a single node.
+  std::atomic<size_t> totalCount = graph.size();
+  if (graph.size() > budget) {
+    return budget + 1;
+  }
+  // The next task is the next subset of the neighbors of the `node` after the
+  // `subset`.
+  struct Cursor {
+    size_t node_ = 0;
+    uint64_t subset_ = 0;
+  };
+  ad_utility::Synchronized<Cursor> cursor;
+  using Task = std::pair<uint64_t, uint64_t>;
+  auto claimTasks = [&graph, &cursor](std::vector<Task>& tasks) {
+    tasks.clear();
+    cursor.withWriteLock([&](Cursor& c) {
+      while (tasks.size() < NUM_TASKS_PER_CLAIM && c.node_ < graph.size()) {
+        uint64_t nodes = 1ULL << c.node_;
+        uint64_t ignored = ad_utility::bitMaskForLowerBits(c.node_);
+        uint64_t neighbors = computeNeighbors(graph, nodes, ignored);
+        c.subset_ = nextSubset(c.subset_, neighbors);
+        if (c.subset_ == 0) {
+          ++c.node_;
+          continue;
+        }
+        tasks.emplace_back(nodes | c.subset_, ignored | neighbors | nodes);
+      }
+    });
+  };
+
+  auto shouldStop = [&totalCount, budget](size_t count) {
+    return count + totalCount.load(std::memory_order_relaxed) > budget;
+  };
+  auto work = [&]() {
+    std::vector<Task> tasks;
+    while (!shouldStop(0)) {
+      claimTasks(tasks);
+      if (tasks.empty()) {
+        return;
+      }
+      for (const auto& [nodes, ignored] : tasks) {
+        // The subgraph `nodes` itself and its extensions.
+        size_t count = countRecursively(graph, nodes, ignored, 1, shouldStop);
+        if (totalCount.fetch_add(count, std::memory_order_relaxed) + count >
+            budget) {
+          return;
+        }
+      }
+    }
+  };
+  {
+    std::vector<ad_utility::JThread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back(work);
+    }
+    work();
+  }
+  return std::min(totalCount.load(), budget + 1);
+}
+}  // namespace
+
 // _____________________________________________________________________________
-size_t countSubgraphs(const Graph& graph, size_t budget) {
+size_t countSubgraphs(const Graph& graph, size_t budget, size_t numThreads) {
+  if (numThreads > 1 && budget >= MIN_BUDGET_FOR_PARALLELISM) {
+    return countSubgraphsInParallel(graph, budget, numThreads);
+  }
   size_t count = 0;
   // For each node `i`, recursively count all subgraphs that contain `i`, but no
   // node `k < i` (because these have already been counted previously, when we
@@ -30,51 +168,6 @@ size_t countSubgraphs(const Graph& graph, size_t budget) {
   return count;
 }
 
-// Return the set of nodes in `graph` that are adjacent to at least one of the
-// nodes in `nodes`. Nodes that are `ignored` are excluded from the result. Note
-// that the result may contain nodes from the `nodes` itself. The result is
-// returned using the same encoding as `nodes` and `ignored`.
-static uint64_t computeNeighbors(const Graph& graph, uint64_t nodes,
-                                 uint64_t ignored) {
-  uint64_t neighbors{};
-  for (size_t i = 0; i < 64; ++i) {
-    bool set = nodes & (1ULL << i);
-    if (set) {
-      neighbors |= graph[i].neighbors_;
-    }
-  }
-  neighbors &= (~ignored);
-  return neighbors;
-}
-
-// For a number `i` from 0 .. 2^`neighbors.size()` - 1, return the `i`th
-// subset of the elements of `neighbors`. All elements in `neighbors` have
-// to be from 0..63 so that the final result can be expressed as a bitmap.
-static uint64_t subsetIndexToBitmap(size_t i,
-                                    const std::vector<uint8_t>& neighbors) {
-  // Note: This can probably be done more efficiently using bit fiddling, but it
-  // is efficient enough for now.
-  uint64_t subset = 0;
-  for (size_t k = 0; k < neighbors.size(); ++k) {
-    if (1 << k & i) {
-      subset |= (1ULL << neighbors[k]);
-    }
-  }
-  return subset;
-}
-
-// Convert a bitset to a vector of the indices of the bits that are set. For
-// example, `13` (`1101` as bits) will be converted to `[0, 2, 3]`;
-static std::vector<uint8_t> bitsetToVector(uint64_t bitset) {
-  std::vector<uint8_t> result;
-  for (uint8_t i = 0; i < 64; ++i) {
-    if (bitset & (1ULL << i)) {
-      result.push_back(i);
-    }
-  }
-  return result;
-};
-
 // _____________________________________________________________________________
 std::string toBitsetString(uint64_t x) {
   auto res = std::bitset<64>{x}.to_string();
@@ -89,28 +182,8 @@ std::string toBitsetString(uint64_t x) {
 size_t countSubgraphsRecursively(const Graph& graph, uint64_t nodes,
                                  uint64_t ignored, size_t count,
                                  size_t budget) {
-  // Compute the set of direct neighbors of the `nodes` that is not
-  // ignored
-  uint64_t neighbors = computeNeighbors(graph, nodes, ignored);
-
-  std::vector<uint8_t> neighborsAsVector = bitsetToVector(neighbors);
-
-  // This is the recursion level which handles all the subsets of the neigrbors,
-  // and the above recursion levels deal with `nodes`, so we have to exclude
-  // them further down.
-  auto newIgnored = ignored | neighbors | nodes;
-
-  //   Iterate over all Subsets of the neighbors
-  size_t upperBound = 1ULL << neighborsAsVector.size();
-  for (size_t i = 1; i < upperBound; ++i) {
-    ++count;
-    if (count > budget) {
-      return budget + 1;
-    }
-    auto subset = subsetIndexToBitmap(i, neighborsAsVector);
-    count = countSubgraphsRecursively(graph, nodes | subset, newIgnored, count,
-                                      budget);
-  }
-  return count;
+  count = countRecursively(graph, nodes, ignored, count,
+                           [budget](size_t c) { return c > budget; });
+  return std::min(count, budget + 1);
 }
 }  // namespace countConnectedSubgraphs
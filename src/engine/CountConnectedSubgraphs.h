@@ -6,6 +6,8 @@
 #define QLEVER_SRC_ENGINE_COUNTCONNECTEDSUBGRAPHS_H
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 // This module implements the efficient counting of the number of connected
 // subgraphs in a given graph. This routine can be used to analyze the
@@ -24,8 +26,11 @@ struct Node {
 using Graph = std::vector<Node>;
 
 // Compute the number of connected subgraphs in the `graph`. If the number of
-// such subraphs is `> budget`, return `budget + 1`.
-size_t countSubgraphs(const Graph& graph, size_t budget);
+// such subraphs is `> budget`, return `budget + 1`. The counting stops as soon
+// as the budget is exceeded. For large budgets, the subgraphs are counted by
+// `numThreads` threads.
+size_t countSubgraphs(const Graph& graph, size_t budget,
+                      size_t numThreads = 1);
 
 // Recursive implementation of `countSubgraphs`. Compute the number of connected
 // subgraphs in `graph` that contains all the nodes in `nodes`, but none of the
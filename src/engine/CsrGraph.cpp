@@ -0,0 +1,54 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "engine/CsrGraph.h"
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+// _____________________________________________________________________________
+CsrGraph::CsrGraph(ql::span<const Id> startIds, ql::span<const Id> targetIds,
+                   const ad_utility::AllocatorWithLimit<Id>& allocator)
+    : nodes_(allocator), offsets_(allocator), neighbors_(targetIds) {
+  AD_CONTRACT_CHECK(startIds.size() == targetIds.size());
+  AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(startIds));
+  for (size_t i = 0; i < startIds.size(); ++i) {
+    if (i == 0 || startIds[i] != startIds[i - 1]) {
+      nodes_.push_back(startIds[i]);
+      offsets_.push_back(i);
+    }
+  }
+  offsets_.push_back(startIds.size());
+  nodes_.shrink_to_fit();
+  offsets_.shrink_to_fit();
+}
+
+// _____________________________________________________________________________
+std::optional<size_t> CsrGraph::getDenseIndex(Id node) const {
+  auto it = ql::ranges::lower_bound(nodes_, node);
+  if (it == nodes_.end() || *it != node) {
+    return std::nullopt;
+  }
+  return static_cast<size_t>(it - nodes_.begin());
+}
+
+// _____________________________________________________________________________
+std::pair<size_t, size_t> CsrGraph::getEdgeRange(Id node) const {
+  auto index = getDenseIndex(node);
+  if (!index.has_value()) {
+    return {0, 0};
+  }
+  return {offsets_[index.value()], offsets_[index.value() + 1]};
+}
+
+// _____________________________________________________________________________
+ql::span<const Id> CsrGraph::successors(Id node) const {
+  auto [begin, end] = getEdgeRange(node);
+  return neighbors_.subspan(begin, end - begin);
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize CsrGraph::getMemorySize() const {
+  return ad_utility::MemorySize::bytes(nodes_.capacity() * sizeof(Id) +
+                                       offsets_.capacity() * sizeof(uint64_t));
+}
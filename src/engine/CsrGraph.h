@@ -0,0 +1,68 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_CSRGRAPH_H
+#define QLEVER_SRC_ENGINE_CSRGRAPH_H
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/MemorySize/MemorySize.h"
+
+// The adjacency lists of a directed graph in the "compressed sparse row"
+// format. The distinct start nodes of the edges are stored in a sorted array,
+// and the position of a node in this array is its dense index. The successors
+// of the node with the dense index `i` are `neighbors_[offsets_[i]]` up to
+// `neighbors_[offsets_[i + 1]]`.
+//
+// The graph is built from the two columns of an `IdTable` that is sorted by
+// the start column. The edges keep the order of the rows, so the edge at
+// position `j` of the `CsrGraph` is the row `j` of that table (which is used
+// by the `PathSearch` to access further columns of an edge). The target column
+// of the table is used as the `neighbors_` without copying it, so the table
+// has to outlive the graph (which is the case when the graph is stored with
+// the `Result` that owns the table, see `Result::getCsrGraph`).
+//
+// Compared to a binary search over all the rows of the table, a lookup only
+// has to search the distinct start nodes and then walks a contiguous array.
+class CsrGraph {
+  std::vector<Id, ad_utility::AllocatorWithLimit<Id>> nodes_;
+  std::vector<uint64_t, ad_utility::AllocatorWithLimit<uint64_t>> offsets_;
+  ql::span<const Id> neighbors_;
+
+ public:
+  // Build the graph with the edges `startIds[i] -> targetIds[i]`. The
+  // `startIds` have to be sorted. The nodes and offsets are allocated with the
+  // `allocator`, the `targetIds` have to stay valid as long as the graph.
+  CsrGraph(ql::span<const Id> startIds, ql::span<const Id> targetIds,
+           const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  // The number of distinct start nodes and of edges.
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numEdges() const { return neighbors_.size(); }
+
+  // The sorted distinct start nodes.
+  ql::span<const Id> nodes() const { return nodes_; }
+
+  // Return the dense index of the `node`, or `std::nullopt` if it has no
+  // outgoing edges.
+  std::optional<size_t> getDenseIndex(Id node) const;
+
+  // The positions of the outgoing edges of the `node` (which are the rows of
+  // the table from which the graph was built) as a half-open range.
+  std::pair<size_t, size_t> getEdgeRange(Id node) const;
+
+  // The successors of the `node`, empty if the `node` has no outgoing edges.
+  ql::span<const Id> successors(Id node) const;
+
+  // The memory that is used by the nodes and offsets of the graph (the
+  // `neighbors_` belong to the table from which the graph was built).
+  ad_utility::MemorySize getMemorySize() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_CSRGRAPH_H
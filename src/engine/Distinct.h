@@ -25,6 +25,7 @@ class Distinct : public Operation {
            const std::vector<ColumnIndex>& keepIndices);
 
   [[nodiscard]] size_t getResultWidth() const override;
+  [[nodiscard]] bool canYieldLazyResult() const override { return true; }
 
   [[nodiscard]] std::string getDescriptor() const override;
 
@@ -59,6 +60,9 @@ class Distinct : public Operation {
 
  protected:
   [[nodiscard]] std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
@@ -54,6 +54,9 @@ class ExistsJoin : public Operation {
   // comments.
  protected:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   std::string getDescriptor() const override;
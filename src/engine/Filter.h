@@ -22,6 +22,7 @@ class Filter : public Operation {
 
  public:
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
  public:
   Filter(QueryExecutionContext* qec,
@@ -30,6 +31,9 @@ class Filter : public Operation {
 
  private:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   std::string getDescriptor() const override;
@@ -4,8 +4,11 @@
 
 #include "engine/GraphStoreProtocol.h"
 
+#include "index/DeltaTriples.h"
 #include "parser/SparqlParser.h"
 #include "parser/Tokenizer.h"
+#include "util/ParseException.h"
+#include "util/ThreadSafeQueue.h"
 #include "util/http/beast.h"
 
 // ____________________________________________________________________________
@@ -84,6 +87,107 @@ updateClause::GraphUpdate::Triples GraphStoreProtocol::convertTriples(
           blankNodeAdder.localVocab_.clone()};
 }
 
+// ____________________________________________________________________________
+UpdateMetadata GraphStoreProtocol::insertTriplesInBatches(
+    std::string_view body, ad_utility::MediaType contentType,
+    const GraphOrDefault& graph, const Index& index,
+    DeltaTriples& deltaTriples,
+    const ad_utility::SharedCancellationHandle& cancellationHandle,
+    size_t batchSize) {
+  using Re2Parser = RdfStringParser<TurtleParser<Tokenizer>>;
+  if (contentType != ad_utility::MediaType::turtle &&
+      contentType != ad_utility::MediaType::ntriples) {
+    throwUnsupportedMediatype(toString(contentType));
+  }
+  AD_CONTRACT_CHECK(batchSize > 0);
+
+  // Parse the batches in a separate thread. The queue has space for a single
+  // batch, so the parsing is at most two batches ahead of the insertion.
+  auto parser = std::make_shared<Re2Parser>(&index.encodedIriManager());
+  parser->setInputView(body);
+  auto batches = ad_utility::data_structures::queueManager<
+      ad_utility::data_structures::ThreadSafeQueue<std::vector<TurtleTriple>>>(
+      1, 1,
+      [parser, batchSize]() -> std::optional<std::vector<TurtleTriple>> {
+        auto triples = parser->parseNextTriples(batchSize);
+        if (triples.empty()) {
+          return std::nullopt;
+        }
+        return triples;
+      });
+
+  const auto& vocab = index.getVocab();
+  const auto& encodedIriManager = index.encodedIriManager();
+  // The blank nodes for the labels from the input. They are managed by the
+  // `LocalVocab` of the `deltaTriples`, so they are not renamed by
+  // `insertTriples` and the same label refers to the same blank node in all
+  // batches.
+  ad_utility::HashMap<std::string, Id> blankNodes;
+  Id defaultGraph = qlever::specialIds().at(DEFAULT_GRAPH_IRI);
+
+  UpdateMetadata metadata;
+  DeltaTriplesCount numTriplesInRequest{0, 0};
+  ad_utility::Timer preparationTimer{ad_utility::Timer::Stopped};
+  ad_utility::Timer insertionTimer{ad_utility::Timer::Stopped};
+  try {
+    while (auto triples = batches.get()) {
+      cancellationHandle->throwIfCancelled();
+      preparationTimer.cont();
+      // The `localVocab` has to stay alive until the triples are inserted.
+      LocalVocab localVocab;
+      auto toId = [&](TripleComponent&& tc) -> Id {
+        if (tc.isString()) {
+          auto [it, isNew] = blankNodes.try_emplace(std::move(tc.getString()),
+                                                    Id::makeUndefined());
+          if (isNew) {
+            it->second = deltaTriples.makeLocalBlankNode();
+          }
+          return it->second;
+        }
+        return std::move(tc).toValueId(vocab, localVocab, encodedIriManager);
+      };
+      Id graphId = std::holds_alternative<GraphRef>(graph)
+                       ? toId(TripleComponent{std::get<GraphRef>(graph)})
+                       : defaultGraph;
+      std::vector<IdTriple<0>> idTriples;
+      idTriples.reserve(triples->size());
+      for (TurtleTriple& triple : triples.value()) {
+        AD_CORRECTNESS_CHECK(triple.graphIri_.isId() &&
+                             triple.graphIri_.getId() == defaultGraph);
+        idTriples.emplace_back(std::array{toId(std::move(triple.subject_)),
+                                          toId(std::move(triple.predicate_)),
+                                          toId(std::move(triple.object_)),
+                                          graphId});
+      }
+      triples.reset();
+      ql::ranges::sort(idTriples);
+      idTriples.erase(std::unique(idTriples.begin(), idTriples.end()),
+                      idTriples.end());
+      numTriplesInRequest.triplesInserted_ +=
+          static_cast<int64_t>(idTriples.size());
+      preparationTimer.stop();
+
+      insertionTimer.cont();
+      deltaTriples.insertTriples(cancellationHandle, std::move(idTriples));
+      insertionTimer.stop();
+    }
+  } catch (const ParseException& e) {
+    // The batches before the syntax error remain inserted, so the client has
+    // to know how many triples that are.
+    throw ParseException{
+        absl::StrCat("The insertion was aborted after ",
+                     numTriplesInRequest.triplesInserted_,
+                     " triples of the request had been inserted, they are not "
+                     "rolled back. ",
+                     e.errorMessageWithoutPrefix()),
+        e.metadata()};
+  }
+  metadata.triplePreparationTime_ = preparationTimer.msecs();
+  metadata.insertionTime_ = insertionTimer.msecs();
+  metadata.inUpdate_ = numTriplesInRequest;
+  return metadata;
+}
+
 // ____________________________________________________________________________
 ParsedQuery GraphStoreProtocol::transformGet(
     const GraphOrDefault& graph, const EncodedIriManager* encodedIriManager) {
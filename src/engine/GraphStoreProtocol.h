@@ -7,6 +7,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include "engine/ExecuteUpdate.h"
 #include "engine/HttpError.h"
 #include "parser/ParsedQuery.h"
 #include "parser/Quads.h"
@@ -115,6 +116,23 @@ class GraphStoreProtocol {
   FRIEND_TEST(GraphStoreProtocolTest, transformPost);
   FRIEND_TEST(GraphStoreProtocolTest, EncodedIriManagerUsage);
 
+  // Parse the triples from the `body` in batches of `batchSize` triples and
+  // insert each batch into the `deltaTriples` before the next batch is
+  // converted. The parsing runs in a separate thread, so it is pipelined with
+  // the conversion to `Id`s and the locating of the triples in the
+  // permutations. At most three batches are in memory at the same time (one
+  // that is being parsed, one in the queue, and one that is being inserted).
+  // Blank node labels refer to the same blank node in all batches. The batches
+  // before a syntax error remain inserted, the `ParseException` then reports
+  // how many triples that are.
+  static UpdateMetadata insertTriplesInBatches(
+      std::string_view body, ad_utility::MediaType contentType,
+      const GraphOrDefault& graph, const Index& index,
+      DeltaTriples& deltaTriples,
+      const ad_utility::SharedCancellationHandle& cancellationHandle,
+      size_t batchSize);
+  FRIEND_TEST(GraphStoreProtocolTest, insertTriplesInBatches);
+
   // Transform a SPARQL Graph Store Protocol GET to an equivalent ParsedQuery
   // which is an SPARQL Query.
   static ParsedQuery transformGet(const GraphOrDefault& graph,
@@ -122,6 +140,32 @@ class GraphStoreProtocol {
   FRIEND_TEST(GraphStoreProtocolTest, transformGet);
 
  public:
+  // The default number of triples per batch for `insertInBatches`.
+  static constexpr size_t DEFAULT_INSERT_BATCH_SIZE = 100'000;
+
+  // Insert the triples from the body of a Graph Store Protocol POST request
+  // directly into the `deltaTriples` without first transforming them into a
+  // SPARQL Update, which would materialize all the triples several times (as
+  // `TurtleTriple`s, as a parsed update, and as `IdTriple`s). The body is
+  // parsed and inserted in batches (see `insertTriplesInBatches`), so the
+  // memory in addition to the body is bounded by the `batchSize`. Note that
+  // the HTTP server still receives the complete body (up to the runtime
+  // parameter `request-body-limit`) before this function is called. The caller
+  // must have exclusive access to the `deltaTriples`.
+  CPP_template_2(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<
+          RequestT>) static UpdateMetadata
+      insertInBatches(
+          const RequestT& rawRequest, const GraphOrDefault& graph,
+          const Index& index, DeltaTriples& deltaTriples,
+          const ad_utility::SharedCancellationHandle& cancellationHandle,
+          size_t batchSize = DEFAULT_INSERT_BATCH_SIZE) {
+    throwIfRequestBodyEmpty(rawRequest);
+    return insertTriplesInBatches(rawRequest.body(),
+                                  extractMediatype(rawRequest), graph, index,
+                                  deltaTriples, cancellationHandle, batchSize);
+  }
+
   // Every Graph Store Protocol request has equivalent SPARQL Query or Update.
   // Transform the Graph Store Protocol request into it's equivalent Query or
   // Update.
@@ -34,6 +34,9 @@ class GroupBy : public Operation {
   // Virtual functions inherited from the `Operation` base class.
   std::string getDescriptor() const override;
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
   size_t getResultWidth() const override;
   std::vector<ColumnIndex> resultSortedOn() const override;
   bool knownEmptyResult() override;
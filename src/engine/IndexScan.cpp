@@ -134,6 +134,26 @@ bool IndexScan::canResultBeCachedImpl() const {
   return !scanSpecAndBlocksIsPrefiltered_;
 };
 
+// _____________________________________________________________________________
+size_t IndexScan::getLocatedTriplesSnapshotIndexForCachingImpl() const {
+  const auto& versions = *locatedTriplesSnapshot().versions_;
+  if (predicate_.isVariable()) {
+    return versions.lastChange_;
+  }
+  // Find the `Id` of the predicate in the scan specification, which is in the
+  // order of the permutation.
+  const auto& keys = Permutation::toKeyOrder(permutation_).keys();
+  auto predicatePosition =
+      static_cast<size_t>(ql::ranges::find(keys, 1) - keys.begin());
+  const auto& scanSpec = scanSpecAndBlocks_.scanSpec_;
+  std::array colIds{&scanSpec.col0Id(), &scanSpec.col1Id(), &scanSpec.col2Id()};
+  const auto& predicateId = *colIds.at(predicatePosition);
+  if (!predicateId.has_value()) {
+    return versions.lastChange_;
+  }
+  return versions.lastChangeOfPredicate(predicateId.value());
+}
+
 // _____________________________________________________________________________
 string IndexScan::getDescriptor() const {
   return "IndexScan " + subject_.toString() + " " + predicate_.toString() +
@@ -74,6 +74,7 @@ class IndexScan final : public Operation {
   std::string getDescriptor() const override;
 
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
   std::vector<ColumnIndex> resultSortedOn() const override;
 
@@ -207,6 +208,10 @@ class IndexScan final : public Operation {
   // `false` if prefilterd `BlockMetadataRanges` are contained.
   bool canResultBeCachedImpl() const override;
 
+  // The result of a scan with a fixed predicate only depends on the delta
+  // triples with that predicate.
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override;
+
   VariableToColumnMap computeVariableToColumnMap() const override;
 
   // Return an updated QueryExecutionTree containing the new IndexScan which is
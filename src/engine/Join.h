@@ -45,6 +45,7 @@ class Join : public Operation {
   std::string getDescriptor() const override;
 
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
   std::vector<ColumnIndex> resultSortedOn() const override;
 
@@ -135,6 +136,9 @@ class Join : public Operation {
 
  protected:
   virtual std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
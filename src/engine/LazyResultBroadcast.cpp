@@ -0,0 +1,378 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "engine/LazyResultBroadcast.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "global/RuntimeParameters.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/CancellationHandle.h"
+#include "util/Exception.h"
+#include "util/HashMap.h"
+#include "util/Iterators.h"
+#include "util/Synchronized.h"
+
+using IdTableVocabPair = LazyResultBroadcast::IdTableVocabPair;
+using namespace std::chrono_literals;
+
+namespace {
+// The broadcasts that new consumers might still attach to.
+using Registry = ad_utility::Synchronized<ad_utility::HashMap<
+    LazyResultBroadcast::Key, std::weak_ptr<LazyResultBroadcast>>>;
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+
+// The size of the `chunk` for the `lazy-result-sharing-max-size`.
+size_t getNumBytes(const IdTableVocabPair& chunk) {
+  return CacheValue::getSize(chunk.idTable_).getBytes();
+}
+
+// Return a copy of the `chunk`, each consumer needs its own chunks.
+IdTableVocabPair copyChunk(const IdTableVocabPair& chunk) {
+  return {chunk.idTable_.clone(), chunk.localVocab_.clone()};
+}
+}  // namespace
+
+// A single consumer of the shared result.
+class LazyResultBroadcast::Consumer
+    : public ad_utility::InputRangeFromGet<IdTableVocabPair> {
+  std::shared_ptr<LazyResultBroadcast> broadcast_;
+  size_t index_;
+  bool isOwner_;
+  std::function<void()> checkCancellation_;
+  std::function<LazyResult()> recompute_;
+  // The number of rows that this consumer has read from the `broadcast_`,
+  // which are skipped in the `recomputed_` result.
+  size_t numRowsRead_ = 0;
+  // Once the consumer is detached from the `broadcast_`, the remaining chunks
+  // are read from its own computation of the result.
+  std::optional<LazyResult> recomputed_;
+
+ public:
+  Consumer(std::shared_ptr<LazyResultBroadcast> broadcast, size_t index,
+           bool isOwner, std::function<void()> checkCancellation,
+           std::function<LazyResult()> recompute)
+      : broadcast_{std::move(broadcast)},
+        index_{index},
+        isOwner_{isOwner},
+        checkCancellation_{std::move(checkCancellation)},
+        recompute_{std::move(recompute)} {}
+
+  Consumer(const Consumer&) = delete;
+  Consumer& operator=(const Consumer&) = delete;
+
+  // Return the next chunk, compute it if no other consumer has computed it
+  // yet.
+  std::optional<IdTableVocabPair> get() override {
+    if (recomputed_.has_value()) {
+      return getRecomputed();
+    }
+    auto& broadcast = *broadcast_;
+    std::unique_lock lock{broadcast.mutex_};
+    while (true) {
+      if (!broadcast.nextChunks_[index_].has_value()) {
+        // This consumer was too slow, see `detachLaggingConsumers`.
+        return detach(lock);
+      }
+      size_t& nextChunk = broadcast.nextChunks_[index_].value();
+      size_t numReleasedChunks = broadcast.numReleasedChunks_;
+      if (nextChunk < numReleasedChunks + broadcast.chunks_.size()) {
+        auto chunk = broadcast.chunks_[nextChunk - numReleasedChunks];
+        ++nextChunk;
+        broadcast.releaseChunks();
+        bool hasReleasedChunks =
+            broadcast.numReleasedChunks_ > numReleasedChunks;
+        lock.unlock();
+        if (hasReleasedChunks) {
+          broadcast.chunkAvailable_.notify_all();
+        }
+        numRowsRead_ += chunk->idTable_.numRows();
+        // If no other consumer needs the chunk anymore, it can be moved.
+        if (chunk.use_count() == 1) {
+          return std::move(*chunk);
+        }
+        return copyChunk(*chunk);
+      }
+      if (broadcast.isAbandoned_ && !isOwner_) {
+        return detach(lock);
+      }
+      if (broadcast.exception_) {
+        std::rethrow_exception(broadcast.exception_);
+      }
+      if (broadcast.isFinished_) {
+        return std::nullopt;
+      }
+      if (!broadcast.isComputing_) {
+        if (broadcast.chunks_.size() >= broadcast.maxNumBufferedChunks_ &&
+            !broadcast.detachLaggingConsumers()) {
+          // The owner is the slowest consumer.
+          return detach(lock);
+        }
+        auto chunk = broadcast.computeNextChunk(lock, index_);
+        if (chunk.has_value()) {
+          numRowsRead_ += chunk.value().idTable_.numRows();
+          return chunk;
+        }
+        continue;
+      }
+      // Another consumer is currently computing the next chunk.
+      broadcast.chunkAvailable_.wait_for(lock, 50ms);
+      if (checkCancellation_) {
+        lock.unlock();
+        checkCancellation_();
+        lock.lock();
+      }
+    }
+  }
+
+  // Detach the consumer. If the owner is detached before the result is
+  // complete, the other consumers have to recompute the remaining chunks, see
+  // the class comment of `LazyResultBroadcast`.
+  ~Consumer() override {
+    // Destroyed last, s.t. the generator is destroyed without holding the
+    // lock.
+    std::optional<LazyResult> source;
+    auto& broadcast = *broadcast_;
+    std::unique_lock lock{broadcast.mutex_};
+    broadcast.nextChunks_[index_] = std::nullopt;
+    if (isOwner_) {
+      // The generator can only be used while the query of the owner is
+      // running. Computing the remaining chunks for the other consumers here
+      // would block the owner's query, so they recompute them instead.
+      broadcast.acceptsConsumers_ = false;
+      broadcast.chunkAvailable_.wait(
+          lock, [&broadcast]() { return !broadcast.isComputing_; });
+      if (!broadcast.isFinished_ && !broadcast.exception_) {
+        broadcast.isAbandoned_ = true;
+      }
+      source = std::move(broadcast.source_);
+      broadcast.source_.reset();
+    }
+    broadcast.releaseChunks();
+    lock.unlock();
+    broadcast.chunkAvailable_.notify_all();
+    if (isOwner_) {
+      registry().withWriteLock([this](auto& map) {
+        auto it = map.find(broadcast_->key_);
+        if (it != map.end() && it->second.lock() == broadcast_) {
+          map.erase(it);
+        }
+      });
+    }
+  }
+
+ private:
+  // Stop reading from the `broadcast_` and continue with an own computation of
+  // the result. The `lock` must hold the mutex of the `broadcast_`.
+  std::optional<IdTableVocabPair> detach(std::unique_lock<std::mutex>& lock) {
+    AD_CORRECTNESS_CHECK(!isOwner_);
+    auto& broadcast = *broadcast_;
+    broadcast.nextChunks_[index_] = std::nullopt;
+    broadcast.releaseChunks();
+    lock.unlock();
+    broadcast.chunkAvailable_.notify_all();
+    recomputed_ = recompute_();
+    return getRecomputed();
+  }
+
+  // Return the next chunk of the `recomputed_` result, without the rows that
+  // were already read from the `broadcast_`.
+  std::optional<IdTableVocabPair> getRecomputed() {
+    while (true) {
+      auto chunk = recomputed_.value().get();
+      if (!chunk.has_value() || numRowsRead_ == 0) {
+        return chunk;
+      }
+      auto& idTable = chunk.value().idTable_;
+      size_t numRowsToSkip = std::min(numRowsRead_, idTable.numRows());
+      idTable.erase(idTable.begin(), idTable.begin() + numRowsToSkip);
+      numRowsRead_ -= numRowsToSkip;
+      if (!idTable.empty()) {
+        return chunk;
+      }
+    }
+  }
+};
+
+// _____________________________________________________________________________
+LazyResultBroadcast::LazyResultBroadcast(
+    Key key, const QueryExecutionContext* ownerContext, LazyResult source,
+    ad_utility::MemorySize maxSizeForAttaching, size_t maxNumBufferedChunks)
+    : key_{std::move(key)},
+      ownerContext_{ownerContext},
+      maxSizeForAttaching_{maxSizeForAttaching},
+      maxNumBufferedChunks_{std::max(maxNumBufferedChunks, size_t{1})},
+      source_{std::move(source)} {}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::share(Key key, const QueryExecutionContext* context,
+                                LazyResult result) -> LazyResult {
+  auto maxSize = RuntimeParameters().get<"lazy-result-sharing-max-size">();
+  if (maxSize.getBytes() == 0) {
+    return result;
+  }
+  auto broadcast = std::make_shared<LazyResultBroadcast>(
+      key, context, std::move(result), maxSize,
+      RuntimeParameters().get<"lazy-result-sharing-max-num-chunks">());
+  broadcast->nextChunks_.push_back(0);
+  registry().wlock()->insert_or_assign(std::move(key), broadcast);
+  return LazyResult{std::make_unique<Consumer>(std::move(broadcast), 0, true,
+                                               std::function<void()>{},
+                                               std::function<LazyResult()>{})};
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::tryAttach(const Key& key,
+                                    const QueryExecutionContext* context,
+                                    std::function<void()> checkCancellation,
+                                    std::function<LazyResult()> recompute)
+    -> std::optional<LazyResult> {
+  AD_CONTRACT_CHECK(recompute);
+  if (RuntimeParameters().get<"lazy-result-sharing-max-size">().getBytes() ==
+      0) {
+    return std::nullopt;
+  }
+  std::shared_ptr<LazyResultBroadcast> broadcast;
+  size_t index = 0;
+  registry().withWriteLock([&](auto& map) {
+    auto it = map.find(key);
+    if (it == map.end()) {
+      return;
+    }
+    broadcast = it->second.lock();
+    if (!broadcast) {
+      map.erase(it);
+      return;
+    }
+    bool isAttached = false;
+    {
+      std::lock_guard lock{broadcast->mutex_};
+      if (!broadcast->acceptsConsumers_) {
+        map.erase(it);
+      } else if (broadcast->ownerContext_ != context) {
+        index = broadcast->nextChunks_.size();
+        broadcast->nextChunks_.push_back(0);
+        isAttached = true;
+      }
+    }
+    if (!isAttached) {
+      broadcast.reset();
+    }
+  });
+  if (!broadcast) {
+    return std::nullopt;
+  }
+  return LazyResult{std::make_unique<Consumer>(
+      std::move(broadcast), index, false, std::move(checkCancellation),
+      std::move(recompute))};
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::computeNextChunk(std::unique_lock<std::mutex>& lock,
+                                           size_t consumer)
+    -> std::optional<IdTableVocabPair> {
+  AD_CORRECTNESS_CHECK(!isComputing_ && source_.has_value());
+  isComputing_ = true;
+  lock.unlock();
+  std::optional<IdTableVocabPair> chunk;
+  std::exception_ptr exception;
+  bool isOwnerSpecific = false;
+  try {
+    chunk = source_->get();
+  } catch (const ad_utility::CancellationException&) {
+    // The generator checks the cancellation of the owner's query.
+    exception = std::current_exception();
+    isOwnerSpecific = true;
+  } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+    // The generator uses the allocator (and the memory limit) of the owner's
+    // query.
+    exception = std::current_exception();
+    isOwnerSpecific = true;
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  lock.lock();
+  isComputing_ = false;
+  chunkAvailable_.notify_all();
+  if (exception) {
+    exception_ = std::move(exception);
+    // Only the owner fails if its query is cancelled or exceeds its memory
+    // limit, the other consumers recompute the result instead.
+    isAbandoned_ = isOwnerSpecific;
+    acceptsConsumers_ = false;
+    return std::nullopt;
+  }
+  if (!chunk.has_value()) {
+    isFinished_ = true;
+    return std::nullopt;
+  }
+  size_t chunkNumber = numReleasedChunks_ + chunks_.size();
+  if (hasOtherConsumers(consumer)) {
+    numBufferedBytes_ += getNumBytes(chunk.value());
+    chunks_.push_back(
+        std::make_shared<IdTableVocabPair>(copyChunk(chunk.value())));
+  } else {
+    // Nobody else needs this chunk, so it isn't copied. Consumers that attach
+    // later would miss it.
+    acceptsConsumers_ = false;
+    releaseChunks();
+    AD_CORRECTNESS_CHECK(chunks_.empty());
+    ++numReleasedChunks_;
+  }
+  nextChunks_[consumer] = chunkNumber + 1;
+  releaseChunks();
+  return chunk;
+}
+
+// _____________________________________________________________________________
+void LazyResultBroadcast::releaseChunks() {
+  if (numBufferedBytes_ > maxSizeForAttaching_.getBytes() ||
+      chunks_.size() >= maxNumBufferedChunks_) {
+    acceptsConsumers_ = false;
+  }
+  if (acceptsConsumers_) {
+    return;
+  }
+  size_t minNextChunk = numReleasedChunks_ + chunks_.size();
+  for (const auto& nextChunk : nextChunks_) {
+    if (nextChunk.has_value()) {
+      minNextChunk = std::min(minNextChunk, nextChunk.value());
+    }
+  }
+  while (numReleasedChunks_ < minNextChunk) {
+    numBufferedBytes_ -= getNumBytes(*chunks_.front());
+    chunks_.pop_front();
+    ++numReleasedChunks_;
+  }
+}
+
+// _____________________________________________________________________________
+bool LazyResultBroadcast::detachLaggingConsumers() {
+  // The owner (the consumer with index 0) can't be detached, because the
+  // generator belongs to its query.
+  if (nextChunks_[0] == numReleasedChunks_) {
+    return false;
+  }
+  for (auto& nextChunk : nextChunks_) {
+    if (nextChunk == numReleasedChunks_) {
+      nextChunk = std::nullopt;
+    }
+  }
+  releaseChunks();
+  chunkAvailable_.notify_all();
+  return true;
+}
+
+// _____________________________________________________________________________
+bool LazyResultBroadcast::hasOtherConsumers(size_t consumer) const {
+  for (size_t i = 0; i < nextChunks_.size(); ++i) {
+    if (nextChunks_[i].has_value() && i != consumer) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,139 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_LAZYRESULTBROADCAST_H
+#define QLEVER_SRC_ENGINE_LAZYRESULTBROADCAST_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/Result.h"
+#include "util/MemorySize/MemorySize.h"
+
+// Share the lazily computed result of an operation with the identical
+// operations (the ones with the same cache key) of other queries that are
+// processed at the same time, s.t. the result is only computed once. The query
+// cache can't help in this case, because lazy results are only stored in the
+// cache once they are complete (and only if they are small).
+//
+// The chunks of the result are pulled from the generator of the operation that
+// started the computation (the owner) by whichever consumer needs the next
+// chunk first, and each consumer reads them at its own pace. While other
+// consumers are attached, each chunk is buffered until all the consumers have
+// read it, but the buffer is a ring of at most
+// `lazy-result-sharing-max-num-chunks` chunks. If a consumer needs a new chunk
+// while the ring is full, the slowest consumers are detached (or the fast
+// consumer itself, if the owner is among the slowest ones). Waiting for them
+// instead could deadlock, because the slowest consumer might (indirectly) wait
+// for the query of the fast one. A new consumer can only
+// attach as long as the first chunk is still buffered. This is the case until
+// a chunk is computed while no other consumer is attached (such chunks are
+// not copied), or until the buffered chunks exceed the runtime parameter
+// `lazy-result-sharing-max-size` or the maximal number of chunks. The size 0
+// disables the sharing.
+//
+// A detached consumer computes the result on its own and skips the rows that it
+// has already read. The generator belongs to the query of the owner and can't
+// be used anymore once that query is finished or cancelled. If the owner stops
+// consuming the result before it is complete, or if its query is cancelled or
+// exceeds its memory limit, the other consumers therefore read the chunks that
+// are still buffered and are then detached. If the computation fails for
+// another reason, all the consumers get the exception.
+class LazyResultBroadcast {
+ public:
+  using IdTableVocabPair = Result::IdTableVocabPair;
+  using LazyResult = Result::LazyResult;
+  // The computations of the same result are identified by the query cache the
+  // result belongs to (the same cache key might have a different meaning for a
+  // different index) and by its cache key.
+  using Key = std::pair<const QueryResultCache*, QueryCacheKey>;
+
+ private:
+  class Consumer;
+
+  Key key_;
+  // The execution context of the owner. The consumers of the same query are
+  // not attached, because they are consumed by the same thread, which might
+  // then wait for itself.
+  const QueryExecutionContext* ownerContext_;
+  ad_utility::MemorySize maxSizeForAttaching_;
+  size_t maxNumBufferedChunks_;
+
+  std::mutex mutex_;
+  std::condition_variable chunkAvailable_;
+  // The generator of the owner. It is only used by the consumer that has set
+  // `isComputing_`, and without holding the `mutex_`.
+  std::optional<LazyResult> source_;
+  bool isComputing_ = false;
+  bool isFinished_ = false;
+  std::exception_ptr exception_;
+  // True iff the owner was destroyed, cancelled, or exceeded its memory limit
+  // before the result was complete, so the other consumers have to detach.
+  bool isAbandoned_ = false;
+  // The buffered chunks, `chunks_[i]` is the chunk with the number
+  // `numReleasedChunks_ + i`. A chunk is moved to the last consumer that reads
+  // it, and copied for the others.
+  std::deque<std::shared_ptr<IdTableVocabPair>> chunks_;
+  size_t numReleasedChunks_ = 0;
+  size_t numBufferedBytes_ = 0;
+  bool acceptsConsumers_ = true;
+  // The number of the next chunk for each consumer, `std::nullopt` for the
+  // consumers that are already destroyed or detached. The owner has index 0.
+  std::vector<std::optional<size_t>> nextChunks_;
+
+ public:
+  // Only used internally, use `share` below instead.
+  LazyResultBroadcast(Key key, const QueryExecutionContext* ownerContext,
+                      LazyResult source,
+                      ad_utility::MemorySize maxSizeForAttaching,
+                      size_t maxNumBufferedChunks);
+
+  // Start sharing the lazy `result` of the operation with the `key` that is
+  // computed for a query with the given `context`. Return the range from which
+  // the owner has to consume the result instead.
+  static LazyResult share(Key key, const QueryExecutionContext* context,
+                          LazyResult result);
+
+  // If the result with the `key` is currently computed by another query and
+  // new consumers can still attach, return a range that yields the complete
+  // result. `checkCancellation` is called regularly while the consumer waits
+  // for the next chunk. `recompute` computes the result for the query of the
+  // consumer, it is called if the consumer is detached.
+  static std::optional<LazyResult> tryAttach(
+      const Key& key, const QueryExecutionContext* context,
+      std::function<void()> checkCancellation,
+      std::function<LazyResult()> recompute);
+
+ private:
+  // Compute the next chunk from the `source_` for the given `consumer` and
+  // return it. The chunk is buffered if another consumer is attached. Return
+  // `std::nullopt` if there is no next chunk or if the computation failed
+  // (then `exception_` is set). The `lock` must hold the `mutex_` and is
+  // released during the computation.
+  std::optional<IdTableVocabPair> computeNextChunk(
+      std::unique_lock<std::mutex>& lock, size_t consumer);
+
+  // Release the buffered chunks that are no longer needed by any consumer.
+  // Requires the `mutex_`.
+  void releaseChunks();
+
+  // Detach the consumers that still have to read the oldest buffered chunk,
+  // s.t. it is released and the next chunk fits into the full ring. Return
+  // false (and detach nobody) if the owner is among these consumers. Requires
+  // the `mutex_`.
+  bool detachLaggingConsumers();
+
+  // Return true iff at least one consumer other than `consumer` is alive.
+  // Requires the `mutex_`.
+  bool hasOtherConsumers(size_t consumer) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_LAZYRESULTBROADCAST_H
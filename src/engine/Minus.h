@@ -27,6 +27,9 @@ class Minus : public Operation {
 
  protected:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   std::string getDescriptor() const override;
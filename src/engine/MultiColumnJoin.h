@@ -31,6 +31,9 @@ class MultiColumnJoin : public Operation {
 
  protected:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   std::string getDescriptor() const override;
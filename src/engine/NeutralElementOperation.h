@@ -21,6 +21,9 @@ class NeutralElementOperation : public Operation {
   [[nodiscard]] std::string getCacheKeyImpl() const override {
     return "Neutral Element";
   };
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   [[nodiscard]] std::string getDescriptor() const override {
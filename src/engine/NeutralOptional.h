@@ -19,6 +19,9 @@ class NeutralOptional : public Operation {
 
  private:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
   uint64_t getSizeEstimateBeforeLimit() override;
   std::unique_ptr<Operation> cloneImpl() const override;
   Result computeResult(bool requestLaziness) override;
@@ -32,6 +35,7 @@ class NeutralOptional : public Operation {
   std::vector<QueryExecutionTree*> getChildren() override;
   std::string getDescriptor() const override;
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
   size_t getCostEstimate() override;
   float getMultiplicity(size_t col) override;
   bool knownEmptyResult() override;
@@ -7,8 +7,16 @@
 #include <absl/cleanup/cleanup.h>
 #include <absl/container/inlined_vector.h>
 
+#include <boost/core/demangle.hpp>
+
+#include <shared_mutex>
+#include <typeindex>
+
+#include "engine/LazyResultBroadcast.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
+#include "util/HashMap.h"
+#include "util/Metrics.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/TransparentFunctors.h"
 
@@ -245,6 +253,19 @@ CacheValue Operation::runComputationAndPrepareForCache(
     const ad_utility::Timer& timer, ComputationMode computationMode,
     const QueryCacheKey& cacheKey, bool pinned, bool isRoot) {
   auto& cache = _executionContext->getQueryTreeCache();
+  bool canShareLazyResult = computationMode ==
+                                ComputationMode::LAZY_IF_SUPPORTED &&
+                            canResultBeCached() && !pinned;
+  LazyResultBroadcast::Key broadcastKey{&cache, cacheKey};
+  if (canShareLazyResult) {
+    auto sharedResult = LazyResultBroadcast::tryAttach(
+        broadcastKey, _executionContext, [this]() { checkCancellation(); },
+        [this]() { return computeLazyResultWithoutSharing(); });
+    if (sharedResult.has_value()) {
+      return CacheValue{readSharedLazyResult(std::move(sharedResult).value()),
+                        runtimeInfo()};
+    }
+  }
   auto result = runComputation(timer, computationMode);
   auto maxSize =
       isRoot ? cache.getMaxSizeSingleEntry()
@@ -279,11 +300,55 @@ CacheValue Operation::runComputationAndPrepareForCache(
     auto resultNumCols = result.idTable().numColumns();
     LOG(DEBUG) << "Computed result of size " << resultNumRows << " x "
                << resultNumCols << std::endl;
+  } else if (canShareLazyResult) {
+    auto sortedBy = result.sortedBy();
+    result = Result{LazyResultBroadcast::share(std::move(broadcastKey),
+                                               _executionContext,
+                                               result.idTables()),
+                    std::move(sortedBy)};
   }
 
   return CacheValue{std::move(result), runtimeInfo()};
 }
 
+// _____________________________________________________________________________
+Result::LazyResult Operation::computeLazyResultWithoutSharing() {
+  Result result = computeResult(true);
+  if (!supportsLimitOffset()) {
+    result.applyLimitOffset(limitOffset_,
+                            [](std::chrono::microseconds, const IdTable&) {});
+  }
+  if (!result.isFullyMaterialized()) {
+    return result.idTables();
+  }
+  return Result::LazyResult{
+      ad_utility::lazySingleValueRange([result = std::move(result)]() {
+        return Result::IdTableVocabPair{result.idTable().clone(),
+                                        result.getCopyOfLocalVocab()};
+      })};
+}
+
+// _____________________________________________________________________________
+Result Operation::readSharedLazyResult(Result::LazyResult sharedResult) {
+  auto& rti = runtimeInfo();
+  rti.status_ = RuntimeInformation::lazilyMaterialized;
+  rti.addDetail("shared-with-concurrent-query", true);
+  Result result{std::move(sharedResult), getResultSortedOn()};
+  result.runOnNewChunkComputed(
+      [this](const Result::IdTableVocabPair& pair,
+             std::chrono::microseconds duration) {
+        updateRuntimeStats(false, pair.idTable_.numRows(),
+                           pair.idTable_.numColumns(), duration);
+      },
+      [this](bool failed) {
+        if (failed) {
+          runtimeInfo().status_ = RuntimeInformation::failed;
+        }
+        signalQueryUpdate();
+      });
+  return result;
+}
+
 // ________________________________________________________________________
 std::shared_ptr<const Result> Operation::getResult(
     bool isRoot, ComputationMode computationMode) {
@@ -304,8 +369,7 @@ std::shared_ptr<const Result> Operation::getResult(
     signalQueryUpdate();
   }
   auto& cache = _executionContext->getQueryTreeCache();
-  const QueryCacheKey cacheKey = {
-      getCacheKey(), _executionContext->locatedTriplesSnapshot().index_};
+  const QueryCacheKey cacheKey = getQueryCacheKey();
   const bool pinFinalResultButNotSubtrees =
       _executionContext->_pinResult && isRoot;
   const bool pinResult =
@@ -357,7 +421,9 @@ std::shared_ptr<const Result> Operation::getResult(
       return nullptr;
     }
 
-    if (result._resultPointer->resultTable().isFullyMaterialized()) {
+    bool isFullyMaterialized =
+        result._resultPointer->resultTable().isFullyMaterialized();
+    if (isFullyMaterialized) {
       AD_CORRECTNESS_CHECK(
           result._resultPointer->resultTable().idTable().numColumns() ==
               getResultWidth(),
@@ -369,6 +435,7 @@ std::shared_ptr<const Result> Operation::getResult(
                 "key.");
       updateRuntimeInformationOnSuccess(result, timer.msecs());
     }
+    recordMetrics(result._cacheStatus, isFullyMaterialized);
 
     return result._resultPointer->resultTablePtr();
   } catch (ad_utility::CancellationException& e) {
@@ -407,6 +474,50 @@ std::shared_ptr<const Result> Operation::getResult(
   }
 }
 
+// _____________________________________________________________________________
+void Operation::recordMetrics(ad_utility::CacheStatus cacheStatus,
+                              bool isFullyMaterialized) const {
+  using namespace ad_utility::metrics;
+  static constexpr std::string_view cacheMetric = "qlever_cache_lookups_total";
+  static constexpr std::string_view cacheHelp =
+      "The number of results of operations that were read from the query "
+      "cache (hit) or computed (miss)";
+  static auto& hits = globalRegistry().counter(cacheMetric, cacheHelp,
+                                               {{"result", "hit"}});
+  static auto& misses = globalRegistry().counter(cacheMetric, cacheHelp,
+                                                 {{"result", "miss"}});
+  if (cacheStatus != ad_utility::CacheStatus::computed) {
+    hits.add();
+    return;
+  }
+  misses.add();
+  // The time of lazily computed results is only known after they have been
+  // consumed completely, so they are not part of the histogram.
+  if (!isFullyMaterialized) {
+    return;
+  }
+  // The histogram of each type of operation is only looked up in the registry
+  // once (which requires demangling the name of the class).
+  static ad_utility::Synchronized<
+      ad_utility::HashMap<std::type_index, Histogram*>, std::shared_mutex>
+      histograms;
+  std::type_index type{typeid(*this)};
+  Histogram* histogram =
+      histograms.withReadLock([&type](const auto& map) -> Histogram* {
+        auto it = map.find(type);
+        return it == map.end() ? nullptr : it->second;
+      });
+  if (histogram == nullptr) {
+    histogram = &globalRegistry().histogram(
+        "qlever_operation_duration_seconds",
+        "The time for computing the result of an operation, without the time "
+        "for computing its children",
+        {{"operation", boost::core::demangle(type.name())}});
+    histograms.wlock()->emplace(type, histogram);
+  }
+  histogram->observe(runtimeInfo().getOperationTime());
+}
+
 // ______________________________________________________________________
 
 std::chrono::milliseconds Operation::remainingTime() const {
@@ -415,6 +526,17 @@ std::chrono::milliseconds Operation::remainingTime() const {
       0ms, std::chrono::duration_cast<std::chrono::milliseconds>(interval));
 }
 
+// _______________________________________________________________________
+std::shared_ptr<const CsrGraph> Operation::getCsrGraphOfChild(
+    const QueryExecutionTree& child, const Result& result,
+    ColumnIndex startCol, ColumnIndex targetCol) const {
+  return result.getCsrGraph(startCol, targetCol, allocator(), [&child]() {
+    const auto& operation = *child.getRootOperation();
+    operation.getExecutionContext()->getQueryTreeCache().recomputeSize(
+        operation.getQueryCacheKey());
+  });
+}
+
 // _______________________________________________________________________
 void Operation::updateRuntimeInformationOnSuccess(
     size_t numRows, ad_utility::CacheStatus cacheStatus, Milliseconds duration,
@@ -553,8 +675,8 @@ void Operation::createRuntimeInfoFromEstimates(
   }
   _runtimeInfo->multiplicityEstimates_ = multiplicityEstimates;
 
-  auto cachedResult = _executionContext->getQueryTreeCache().getIfContained(
-      {getCacheKey(), locatedTriplesSnapshot().index_});
+  auto cachedResult =
+      _executionContext->getQueryTreeCache().getIfContained(getQueryCacheKey());
   if (cachedResult.has_value()) {
     const auto& [resultPointer, cacheStatus] = cachedResult.value();
     _runtimeInfo->cacheStatus_ = cacheStatus;
@@ -656,6 +778,16 @@ std::string Operation::getCacheKey() const {
   return result;
 }
 
+// _____________________________________________________________________________
+size_t Operation::getLocatedTriplesSnapshotIndexForCachingOfChildren() const {
+  size_t result = 0;
+  for (const auto* child : getChildren()) {
+    result = std::max(result, child->getRootOperation()
+                                  ->getLocatedTriplesSnapshotIndexForCaching());
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 uint64_t Operation::getSizeEstimate() {
   if (limitOffset_._limit.has_value()) {
@@ -182,12 +182,42 @@ class Operation {
   // above for details).
   virtual void disableStoringInCache() final { canResultBeCached_ = false; }
 
+  // Return the key under which the result of this `Operation` is stored in the
+  // query result cache. It consists of `getCacheKey()` and
+  // `getLocatedTriplesSnapshotIndexForCaching()`.
+  QueryCacheKey getQueryCacheKey() const {
+    return {getCacheKey(), getLocatedTriplesSnapshotIndexForCaching()};
+  }
+
+  // Return the index of the oldest `LocatedTriplesSnapshot` for which the
+  // result of this `Operation` is the same as for the current snapshot. This is
+  // part of the cache key, such that an update only invalidates the cached
+  // results of those operations that are affected by it.
+  size_t getLocatedTriplesSnapshotIndexForCaching() const {
+    return getLocatedTriplesSnapshotIndexForCachingImpl();
+  }
+
+ protected:
+  // Return the maximum of `getLocatedTriplesSnapshotIndexForCaching()` over all
+  // children (zero if there are no children). Operations whose result only
+  // depends on the results of their children can use this to implement
+  // `getLocatedTriplesSnapshotIndexForCachingImpl()`.
+  size_t getLocatedTriplesSnapshotIndexForCachingOfChildren() const;
+
  private:
   // Return if the result of this `Operation` can be cached at all. Caching can
   // still be disabled for other reason external to this operation with
   // `disableStoringInCache()`.
   virtual bool canResultBeCachedImpl() const { return true; }
 
+  // The individual implementation of
+  // `getLocatedTriplesSnapshotIndexForCaching()` (see above). The default
+  // implementation is conservative and returns the index of the current
+  // snapshot, that is, the cached result is invalidated by every update.
+  virtual size_t getLocatedTriplesSnapshotIndexForCachingImpl() const {
+    return locatedTriplesSnapshot().index_;
+  }
+
   // The individual implementation of `getCacheKey` (see above) that has to
   // be customized by every child class.
   virtual std::string getCacheKeyImpl() const = 0;
@@ -290,6 +320,12 @@ class Operation {
   // its result.
   [[nodiscard]] virtual bool supportsLimitOffset() const { return false; }
 
+  // True iff this operation yields its result in chunks (if laziness is
+  // requested) when it has no children or at least one of its children yields
+  // its result in chunks, s.t. its result is never materialized as a whole.
+  // This is used for the memory estimate of a query (see `QueryScheduler`).
+  [[nodiscard]] virtual bool canYieldLazyResult() const { return false; }
+
  private:
   // This function is called each time `applyLimitOffset` is called. It can be
   // overridden by subclasses to e.g. implement the LIMIT in a more efficient
@@ -393,6 +429,13 @@ class Operation {
 
   std::chrono::milliseconds remainingTime() const;
 
+  // Return `result.getCsrGraph(startCol, targetCol, ...)` for the `result` of
+  // the `child`. If the graph is built by this call, the size of the cache
+  // entry of the `child` is updated to include the graph.
+  std::shared_ptr<const CsrGraph> getCsrGraphOfChild(
+      const QueryExecutionTree& child, const Result& result,
+      ColumnIndex startCol, ColumnIndex targetCol) const;
+
   /// Pointer to the cancellation handle of this operation.
   SharedCancellationHandle cancellationHandle_ =
       std::make_shared<SharedCancellationHandle::element_type>();
@@ -430,12 +473,24 @@ class Operation {
                         ComputationMode computationMode);
 
   // Call `runComputation` and transform it into a value that could be inserted
-  // into the cache.
+  // into the cache. Lazy results are shared with the identical operations of
+  // concurrent queries, and if the result is currently computed lazily by such
+  // an operation, it is read from there (see `LazyResultBroadcast`).
   CacheValue runComputationAndPrepareForCache(const ad_utility::Timer& timer,
                                               ComputationMode computationMode,
                                               const QueryCacheKey& cacheKey,
                                               bool pinned, bool isRoot);
 
+  // Turn the `sharedResult` that is computed by a concurrent query into the
+  // result of this operation, and update the runtime information while it is
+  // consumed.
+  Result readSharedLazyResult(Result::LazyResult sharedResult);
+
+  // Compute the result of this operation lazily (including the `LIMIT` and
+  // `OFFSET`) for a consumer of a shared result that was detached from the
+  // concurrent query that computes it.
+  Result::LazyResult computeLazyResultWithoutSharing();
+
   // Create and store the complete runtime information for this operation after
   // it has either been successfully computed or read from the cache.
   virtual void updateRuntimeInformationOnSuccess(
@@ -504,6 +559,12 @@ class Operation {
   // failed.
   void updateRuntimeInformationOnFailure(Milliseconds duration);
 
+  // Record the cache lookup of `getResult` and (if the result was computed and
+  // fully materialized) the time of this operation without its children in
+  // the global metrics (see `util/Metrics.h`).
+  void recordMetrics(ad_utility::CacheStatus cacheStatus,
+                     bool isFullyMaterialized) const;
+
   // Compute the variable to column index mapping. Is used internally by
   // `getInternallyVisibleVariableColumns`.
   virtual VariableToColumnMap computeVariableToColumnMap() const = 0;
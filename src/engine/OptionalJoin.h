@@ -42,11 +42,15 @@ class OptionalJoin : public Operation {
 
  private:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   std::string getDescriptor() const override;
 
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
   std::vector<ColumnIndex> resultSortedOn() const override;
 
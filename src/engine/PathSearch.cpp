@@ -4,9 +4,13 @@
 
 #include "PathSearch.h"
 
+#include <absl/strings/str_cat.h>
+
 #include <functional>
 #include <iterator>
+#include <numeric>
 #include <optional>
+#include <queue>
 #include <ranges>
 #include <unordered_map>
 #include <variant>
@@ -22,14 +26,39 @@ using namespace pathSearch;
 
 // _____________________________________________________________________________
 BinSearchWrapper::BinSearchWrapper(const IdTable& table, size_t startCol,
-                                   size_t endCol, std::vector<size_t> edgeCols)
+                                   size_t endCol, std::vector<size_t> edgeCols,
+                                   std::optional<size_t> weightCol,
+                                   bool withIncomingEdges,
+                                   std::shared_ptr<const CsrGraph> csrGraph)
     : table_(table),
       startCol_(startCol),
       endCol_(endCol),
-      edgeCols_(std::move(edgeCols)) {}
+      edgeCols_(std::move(edgeCols)),
+      weightCol_(weightCol),
+      csrGraph_(std::move(csrGraph)) {
+  AD_CORRECTNESS_CHECK(csrGraph_ == nullptr ||
+                       csrGraph_->numEdges() == table_.numRows());
+  if (withIncomingEdges) {
+    rowsSortedByEnd_.resize(table_.numRows());
+    std::iota(rowsSortedByEnd_.begin(), rowsSortedByEnd_.end(), 0);
+    auto endIds = table_.getColumn(endCol_);
+    ql::ranges::stable_sort(rowsSortedByEnd_, std::less{},
+                            [&endIds](size_t row) { return endIds[row]; });
+  }
+}
 
 // _____________________________________________________________________________
 std::vector<Edge> BinSearchWrapper::outgoingEdes(const Id node) const {
+  if (csrGraph_ != nullptr) {
+    // The edges of the `CsrGraph` have the same order as the rows.
+    auto [begin, end] = csrGraph_->getEdgeRange(node);
+    std::vector<Edge> edges;
+    edges.reserve(end - begin);
+    for (size_t row = begin; row < end; ++row) {
+      edges.push_back(makeEdgeFromRow(row));
+    }
+    return edges;
+  }
   auto startIds = table_.getColumn(startCol_);
   auto range = ql::ranges::equal_range(startIds, node);
   auto startIndex = std::distance(startIds.begin(), range.begin());
@@ -43,8 +72,27 @@ std::vector<Edge> BinSearchWrapper::outgoingEdes(const Id node) const {
   return edges;
 }
 
+// _____________________________________________________________________________
+std::vector<Edge> BinSearchWrapper::incomingEdges(const Id node) const {
+  AD_CORRECTNESS_CHECK(rowsSortedByEnd_.size() == table_.numRows());
+  auto endIds = table_.getColumn(endCol_);
+  auto range = ql::ranges::equal_range(
+      rowsSortedByEnd_, node, std::less{},
+      [&endIds](size_t row) { return endIds[row]; });
+
+  std::vector<Edge> edges;
+  for (size_t row : range) {
+    edges.push_back(makeEdgeFromRow(row));
+  }
+  return edges;
+}
+
 // _____________________________________________________________________________
 std::vector<Id> BinSearchWrapper::getSources() const {
+  if (csrGraph_ != nullptr) {
+    auto nodes = csrGraph_->nodes();
+    return {nodes.begin(), nodes.end()};
+  }
   auto startIds = table_.getColumn(startCol_);
   std::vector<Id> sources;
   ql::ranges::unique_copy(startIds, std::back_inserter(sources));
@@ -61,6 +109,29 @@ std::vector<Id> BinSearchWrapper::getEdgeProperties(const Edge& edge) const {
   return edgeProperties;
 }
 
+// _____________________________________________________________________________
+double BinSearchWrapper::getWeight(const Edge& edge) const {
+  if (!weightCol_.has_value()) {
+    return 1;
+  }
+  Id weight = table_(edge.edgeRow_, weightCol_.value());
+  double result;
+  if (weight.getDatatype() == Datatype::Int) {
+    result = static_cast<double>(weight.getInt());
+  } else if (weight.getDatatype() == Datatype::Double) {
+    result = weight.getDouble();
+  } else {
+    throw std::runtime_error(
+        "The edge weights of a path search must be numeric values");
+  }
+  if (!(result >= 0)) {
+    throw std::runtime_error(absl::StrCat(
+        "The edge weights of a path search must not be negative, but found ",
+        result));
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 Edge BinSearchWrapper::makeEdgeFromRow(size_t row) const {
   Edge edge;
@@ -244,8 +315,21 @@ Result PathSearch::computeResult([[maybe_unused]] bool requestLaziness) {
     for (const auto& edgeProp : config_.edgeProperties_) {
       edgeColumns.push_back(subtree_->getVariableColumn(edgeProp));
     }
-    BinSearchWrapper binSearch{dynSub, subStartColumn, subEndColumn,
-                               std::move(edgeColumns)};
+    std::optional<size_t> weightColumn;
+    if (config_.edgeWeight_.has_value()) {
+      weightColumn = subtree_->getVariableColumn(config_.edgeWeight_.value());
+    }
+    auto csrGraph =
+        getCsrGraphOfChild(*subtree_, *subRes, subStartColumn, subEndColumn);
+    runtimeInfo().addDetail("csr-adjacency", csrGraph != nullptr);
+    BinSearchWrapper binSearch{
+        dynSub,
+        subStartColumn,
+        subEndColumn,
+        std::move(edgeColumns),
+        weightColumn,
+        config_.algorithm_ == PathSearchAlgorithm::BIDIRECTIONAL_SHORTEST_PATHS,
+        std::move(csrGraph)};
 
     timer.stop();
     auto buildingTime = timer.msecs();
@@ -332,6 +416,51 @@ PathsLimited PathSearch::findPaths(
     const Id& source, const std::unordered_set<uint64_t>& targets,
     const BinSearchWrapper& binSearch,
     std::optional<uint64_t> numPathsPerTarget) const {
+  using enum PathSearchAlgorithm;
+  if (config_.algorithm_ == ALL_PATHS) {
+    return findAllPaths(source, targets, binSearch, numPathsPerTarget);
+  }
+  if (config_.algorithm_ == SHORTEST_PATHS) {
+    return findShortestPaths(source, targets, binSearch);
+  }
+  // The other algorithms search the paths to each target separately. Without
+  // explicit targets, the targets are all the reachable nodes, which are found
+  // by a single shortest path search. The targets are processed in a fixed
+  // order to make the result deterministic.
+  std::vector<uint64_t> sortedTargets;
+  if (targets.empty()) {
+    for (const auto& path : findShortestPaths(source, targets, binSearch)) {
+      sortedTargets.push_back(path.edges_.back().end_.getBits());
+    }
+  } else {
+    sortedTargets.assign(targets.begin(), targets.end());
+  }
+  ql::ranges::sort(sortedTargets);
+
+  PathsLimited result{allocator()};
+  for (uint64_t targetBits : sortedTargets) {
+    Id target = Id::fromBits(targetBits);
+    if (config_.algorithm_ == BIDIRECTIONAL_SHORTEST_PATHS) {
+      auto path = findShortestPathBidirectional(source, target, binSearch);
+      if (path.has_value()) {
+        result.push_back(std::move(path.value()));
+      }
+    } else {
+      AD_CORRECTNESS_CHECK(config_.algorithm_ == K_SHORTEST_PATHS);
+      for (auto& path : findKShortestPaths(source, target, binSearch,
+                                           numPathsPerTarget.value_or(1))) {
+        result.push_back(std::move(path));
+      }
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::findAllPaths(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch,
+    std::optional<uint64_t> numPathsPerTarget) const {
   std::vector<Edge> edgeStack;
   Path currentPath{EdgesLimited(allocator())};
   std::unordered_map<
@@ -385,6 +514,281 @@ PathsLimited PathSearch::findPaths(
   return result;
 }
 
+// _____________________________________________________________________________
+PathsLimited PathSearch::findShortestPaths(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch) const {
+  PathsLimited result{allocator()};
+  NodeMap<Edge> predecessors{allocator()};
+  // The source itself is never reached by a (non-empty) path.
+  size_t numTargets = targets.size() - targets.contains(source.getBits());
+  if (!targets.empty() && numTargets == 0) {
+    return result;
+  }
+  size_t numTargetsReached = 0;
+  // Called when the shortest path to the `node` is known. Return true iff all
+  // the targets have been reached, s.t. the search can stop.
+  auto reached = [&](const Id& node) {
+    if (targets.empty() || targets.contains(node.getBits())) {
+      result.push_back(reconstructPath(source, node, predecessors));
+      ++numTargetsReached;
+    }
+    return !targets.empty() && numTargetsReached == numTargets;
+  };
+
+  if (!binSearch.hasWeights()) {
+    std::vector<Id> frontier{source};
+    std::vector<Id> nextFrontier;
+    while (!frontier.empty()) {
+      checkCancellation();
+      nextFrontier.clear();
+      for (const Id& node : frontier) {
+        for (const auto& edge : binSearch.outgoingEdes(node)) {
+          if (edge.end_ == source ||
+              !predecessors.try_emplace(edge.end_.getBits(), edge).second) {
+            continue;
+          }
+          if (reached(edge.end_)) {
+            return result;
+          }
+          nextFrontier.push_back(edge.end_);
+        }
+      }
+      std::swap(frontier, nextFrontier);
+    }
+    return result;
+  }
+
+  // Dijkstra's algorithm, the queue contains outdated entries for the nodes
+  // whose distance was decreased after they were inserted.
+  NodeMap<double> distances{allocator()};
+  using Entry = std::pair<double, uint64_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+  distances.emplace(source.getBits(), 0.0);
+  queue.emplace(0.0, source.getBits());
+  while (!queue.empty()) {
+    checkCancellation();
+    auto [distance, nodeBits] = queue.top();
+    queue.pop();
+    if (distance > distances.at(nodeBits)) {
+      continue;
+    }
+    Id node = Id::fromBits(nodeBits);
+    if (node != source && reached(node)) {
+      return result;
+    }
+    for (const auto& edge : binSearch.outgoingEdes(node)) {
+      double newDistance = distance + binSearch.getWeight(edge);
+      auto [it, isNew] =
+          distances.try_emplace(edge.end_.getBits(), newDistance);
+      if (isNew || newDistance < it->second) {
+        it->second = newDistance;
+        predecessors.insert_or_assign(edge.end_.getBits(), edge);
+        queue.emplace(newDistance, edge.end_.getBits());
+      }
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<Path> PathSearch::findShortestPathBidirectional(
+    const Id& source, const Id& target,
+    const BinSearchWrapper& binSearch) const {
+  if (source == target) {
+    return std::nullopt;
+  }
+  // For both directions, the distance of each reached node from the source
+  // (or to the target) and the edge over which it was reached.
+  NodeMap<size_t> forwardDistances{allocator()};
+  NodeMap<size_t> backwardDistances{allocator()};
+  NodeMap<Edge> forwardPredecessors{allocator()};
+  NodeMap<Edge> backwardPredecessors{allocator()};
+  forwardDistances.emplace(source.getBits(), 0);
+  backwardDistances.emplace(target.getBits(), 0);
+  std::vector<Id> forwardFrontier{source};
+  std::vector<Id> backwardFrontier{target};
+  size_t forwardLevel = 0;
+  size_t backwardLevel = 0;
+  std::vector<Id> nextFrontier;
+
+  while (!forwardFrontier.empty() && !backwardFrontier.empty()) {
+    checkCancellation();
+    // Expand the smaller frontier by one level.
+    bool forward = forwardFrontier.size() <= backwardFrontier.size();
+    auto& frontier = forward ? forwardFrontier : backwardFrontier;
+    auto& distances = forward ? forwardDistances : backwardDistances;
+    auto& predecessors = forward ? forwardPredecessors : backwardPredecessors;
+    const auto& otherDistances = forward ? backwardDistances : forwardDistances;
+    size_t level = ++(forward ? forwardLevel : backwardLevel);
+    // The node where the two searches meet on the shortest path (and the
+    // length of that path). All the meeting nodes of this level have to be
+    // considered, because their distances to the other side differ.
+    std::optional<std::pair<size_t, Id>> meeting;
+    nextFrontier.clear();
+    for (const Id& node : frontier) {
+      auto edges = forward ? binSearch.outgoingEdes(node)
+                           : binSearch.incomingEdges(node);
+      for (const auto& edge : edges) {
+        const Id& next = forward ? edge.end_ : edge.start_;
+        if (!distances.try_emplace(next.getBits(), level).second) {
+          continue;
+        }
+        predecessors.emplace(next.getBits(), edge);
+        nextFrontier.push_back(next);
+        auto other = otherDistances.find(next.getBits());
+        if (other != otherDistances.end() &&
+            (!meeting.has_value() || level + other->second < meeting->first)) {
+          meeting.emplace(level + other->second, next);
+        }
+      }
+    }
+    if (meeting.has_value()) {
+      Id middle = meeting->second;
+      Path path = reconstructPath(source, middle, forwardPredecessors);
+      for (Id node = middle; node != target;) {
+        const Edge& edge = backwardPredecessors.at(node.getBits());
+        path.push_back(edge);
+        node = edge.end_;
+      }
+      return path;
+    }
+    std::swap(frontier, nextFrontier);
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::findKShortestPaths(const Id& source, const Id& target,
+                                            const BinSearchWrapper& binSearch,
+                                            uint64_t k) const {
+  PathsLimited result{allocator()};
+  if (k == 0 || source == target) {
+    return result;
+  }
+  auto shortestPath = findShortestPath(source, target, binSearch, {}, {});
+  if (!shortestPath.has_value()) {
+    return result;
+  }
+  result.push_back(std::move(shortestPath.value().second));
+
+  auto sameEdge = [](const Edge& a, const Edge& b) {
+    return a.edgeRow_ == b.edgeRow_;
+  };
+  auto samePath = [&sameEdge](const Path& a, const Path& b) {
+    return ql::ranges::equal(a.edges_, b.edges_, sameEdge);
+  };
+  // The candidates for the next path together with their lengths.
+  std::vector<std::pair<double, Path>> candidates;
+  while (result.size() < k) {
+    checkCancellation();
+    const Path previous = result.back();
+    // Each node of the previous path is a "spur node": the new path shares
+    // the edges before it with the previous path ("root path"), and then
+    // continues differently, without visiting the nodes of the root path.
+    ad_utility::HashSet<uint64_t> rootPathNodes;
+    double rootPathLength = 0;
+    for (size_t i = 0; i < previous.size(); ++i) {
+      const Id spurNode = previous.edges_[i].start_;
+      // The edges that the paths found so far with the same root path take
+      // after the spur node.
+      ad_utility::HashSet<size_t> bannedEdgeRows;
+      for (const auto& path : result) {
+        if (path.size() > i &&
+            std::equal(path.edges_.begin(), path.edges_.begin() + i,
+                       previous.edges_.begin(), sameEdge)) {
+          bannedEdgeRows.insert(path.edges_[i].edgeRow_);
+        }
+      }
+      auto spurPath = findShortestPath(spurNode, target, binSearch,
+                                       bannedEdgeRows, rootPathNodes);
+      if (spurPath.has_value()) {
+        Path candidate{EdgesLimited(previous.edges_.begin(),
+                                    previous.edges_.begin() + i, allocator())};
+        for (const auto& edge : spurPath.value().second.edges_) {
+          candidate.push_back(edge);
+        }
+        auto isCandidate = [&](const Path& path) {
+          return samePath(path, candidate);
+        };
+        if (ql::ranges::none_of(candidates, isCandidate,
+                                &std::pair<double, Path>::second) &&
+            ql::ranges::none_of(result, isCandidate)) {
+          candidates.emplace_back(rootPathLength + spurPath.value().first,
+                                  std::move(candidate));
+        }
+      }
+      rootPathNodes.insert(spurNode.getBits());
+      rootPathLength += binSearch.getWeight(previous.edges_[i]);
+    }
+    if (candidates.empty()) {
+      break;
+    }
+    // Take the shortest candidate, and among those the one with the fewest
+    // edges.
+    auto best = ql::ranges::min_element(
+        candidates, std::less{}, [](const std::pair<double, Path>& candidate) {
+          return std::pair{candidate.first, candidate.second.size()};
+        });
+    result.push_back(std::move(best->second));
+    candidates.erase(best);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::pair<double, Path>> PathSearch::findShortestPath(
+    const Id& source, const Id& target, const BinSearchWrapper& binSearch,
+    const ad_utility::HashSet<size_t>& bannedEdgeRows,
+    const ad_utility::HashSet<uint64_t>& bannedNodes) const {
+  NodeMap<double> distances{allocator()};
+  NodeMap<Edge> predecessors{allocator()};
+  using Entry = std::pair<double, uint64_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+  distances.emplace(source.getBits(), 0.0);
+  queue.emplace(0.0, source.getBits());
+  while (!queue.empty()) {
+    checkCancellation();
+    auto [distance, nodeBits] = queue.top();
+    queue.pop();
+    if (distance > distances.at(nodeBits)) {
+      continue;
+    }
+    Id node = Id::fromBits(nodeBits);
+    if (node == target) {
+      return std::pair{distance, reconstructPath(source, target, predecessors)};
+    }
+    for (const auto& edge : binSearch.outgoingEdes(node)) {
+      if (bannedEdgeRows.contains(edge.edgeRow_) ||
+          bannedNodes.contains(edge.end_.getBits())) {
+        continue;
+      }
+      double newDistance = distance + binSearch.getWeight(edge);
+      auto [it, isNew] =
+          distances.try_emplace(edge.end_.getBits(), newDistance);
+      if (isNew || newDistance < it->second) {
+        it->second = newDistance;
+        predecessors.insert_or_assign(edge.end_.getBits(), edge);
+        queue.emplace(newDistance, edge.end_.getBits());
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+Path PathSearch::reconstructPath(const Id& source, const Id& target,
+                                 const NodeMap<Edge>& predecessors) const {
+  Path path{EdgesLimited(allocator())};
+  for (Id node = target; node != source;) {
+    const Edge& edge = predecessors.at(node.getBits());
+    path.push_back(edge);
+    node = edge.start_;
+  }
+  ql::ranges::reverse(path.edges_);
+  return path;
+}
+
 // _____________________________________________________________________________
 PathsLimited PathSearch::allPaths(
     ql::span<const Id> sources, ql::span<const Id> targets,
@@ -7,15 +7,35 @@
 
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <vector>
 
 #include "backports/span.h"
+#include "engine/CsrGraph.h"
 #include "engine/Operation.h"
 #include "global/Id.h"
 #include "util/AllocatorWithLimit.h"
-
-enum class PathSearchAlgorithm { ALL_PATHS };
+#include "util/HashSet.h"
+
+// The algorithms of the `PathSearch`:
+// - `ALL_PATHS`: All paths without cycles from the sources to the targets.
+// - `SHORTEST_PATHS`: One shortest path from each source to each target,
+//   computed with a BFS (or with Dijkstra's algorithm if there are edge
+//   weights) that stops as soon as all the targets have been reached.
+// - `BIDIRECTIONAL_SHORTEST_PATHS`: Like `SHORTEST_PATHS`, but each path is
+//   computed with a BFS from the source and from the target at the same time,
+//   which visits much fewer nodes on large graphs. Edge weights are not
+//   supported.
+// - `K_SHORTEST_PATHS`: The `numPathsPerTarget` shortest paths without
+//   cycles from each source to each target (Yen's algorithm).
+enum class PathSearchAlgorithm {
+  ALL_PATHS,
+  SHORTEST_PATHS,
+  BIDIRECTIONAL_SHORTEST_PATHS,
+  K_SHORTEST_PATHS
+};
 
 /**
  * @brief Represents the source or target side of a PathSearch.
@@ -50,6 +70,12 @@ struct Path {
 
 using PathsLimited = std::vector<Path, ad_utility::AllocatorWithLimit<Path>>;
 
+// A hash map from the bits of node `Id`s to values of type `T`.
+template <typename T>
+using NodeMap = std::unordered_map<
+    uint64_t, T, std::hash<uint64_t>, std::equal_to<uint64_t>,
+    ad_utility::AllocatorWithLimit<std::pair<const uint64_t, T>>>;
+
 /**
  * @class BinSearchWrapper
  * @brief Encapsulates logic for binary search of edges in
@@ -62,10 +88,22 @@ class BinSearchWrapper {
   size_t startCol_;
   size_t endCol_;
   std::vector<size_t> edgeCols_;
+  std::optional<size_t> weightCol_;
+  // If set, the outgoing edges are looked up in this adjacency of the
+  // `table_` instead of with a binary search over all the rows.
+  std::shared_ptr<const CsrGraph> csrGraph_;
+  // The rows of the `table_` sorted by the end column, only filled if the
+  // incoming edges are required.
+  std::vector<size_t> rowsSortedByEnd_;
 
  public:
+  // If `withIncomingEdges` is true, an additional index is built s.t. the
+  // incoming edges of a node can be retrieved via `incomingEdges`.
   BinSearchWrapper(const IdTable& table, size_t startCol, size_t endCol,
-                   std::vector<size_t> edgeCols);
+                   std::vector<size_t> edgeCols,
+                   std::optional<size_t> weightCol = std::nullopt,
+                   bool withIncomingEdges = false,
+                   std::shared_ptr<const CsrGraph> csrGraph = nullptr);
 
   /**
    * @brief Return all outgoing edges of a node
@@ -74,6 +112,14 @@ class BinSearchWrapper {
    */
   std::vector<Edge> outgoingEdes(const Id node) const;
 
+  /**
+   * @brief Return all incoming edges of a node. Requires that the
+   * `BinSearchWrapper` was created with `withIncomingEdges`.
+   *
+   * @param node The end node of the incoming edges
+   */
+  std::vector<Edge> incomingEdges(const Id node) const;
+
   /**
    * @brief Returns the start nodes of all edges.
    * In case the sources field for the path search is empty,
@@ -84,6 +130,12 @@ class BinSearchWrapper {
 
   std::vector<Id> getEdgeProperties(const Edge& edge) const;
 
+  bool hasWeights() const { return weightCol_.has_value(); }
+
+  // The weight of the `edge`, which is 1 if there is no weight column. Throw if
+  // the weight is not a non-negative number.
+  double getWeight(const Edge& edge) const;
+
  private:
   Edge makeEdgeFromRow(size_t row) const;
 };
@@ -100,6 +152,8 @@ struct PathSearchConfiguration {
   std::vector<Variable> edgeProperties_;
   bool cartesian_ = true;
   std::optional<uint64_t> numPathsPerTarget_ = std::nullopt;
+  // The numeric weights of the edges for the shortest path algorithms.
+  std::optional<Variable> edgeWeight_ = std::nullopt;
 
   bool sourceIsVariable() const {
     return std::holds_alternative<Variable>(sources_);
@@ -121,8 +175,20 @@ struct PathSearchConfiguration {
 
   std::string toString() const {
     std::ostringstream os;
-    if (algorithm_ == PathSearchAlgorithm::ALL_PATHS) {
-      os << "Algorithm: All paths" << '\n';
+    using enum PathSearchAlgorithm;
+    switch (algorithm_) {
+      case ALL_PATHS:
+        os << "Algorithm: All paths" << '\n';
+        break;
+      case SHORTEST_PATHS:
+        os << "Algorithm: Shortest paths" << '\n';
+        break;
+      case BIDIRECTIONAL_SHORTEST_PATHS:
+        os << "Algorithm: Bidirectional shortest paths" << '\n';
+        break;
+      case K_SHORTEST_PATHS:
+        os << "Algorithm: K shortest paths" << '\n';
+        break;
     }
 
     os << "Source: " << searchSideToString(sources_) << '\n';
@@ -137,6 +203,13 @@ struct PathSearchConfiguration {
     for (const auto& edgeProperty : edgeProperties_) {
       os << "  " << edgeProperty.toSparql() << '\n';
     }
+    if (edgeWeight_.has_value()) {
+      os << "EdgeWeight: " << edgeWeight_.value().toSparql() << '\n';
+    }
+    if (numPathsPerTarget_.has_value()) {
+      os << "NumPathsPerTarget: " << numPathsPerTarget_.value() << '\n';
+    }
+    os << "Cartesian: " << cartesian_ << '\n';
 
     return std::move(os).str();
   }
@@ -276,6 +349,67 @@ class PathSearch : public Operation {
       const pathSearch::BinSearchWrapper& binSearch, bool cartesian,
       std::optional<uint64_t> numPathsPerTarget) const;
 
+  /**
+   * @brief Finds all paths without cycles from the source (`ALL_PATHS`).
+   * @return A vector of all paths to the targets (or to all nodes if the
+   * targets are empty).
+   */
+  pathSearch::PathsLimited findAllPaths(
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch,
+      std::optional<uint64_t> numPathsPerTarget) const;
+
+  /**
+   * @brief Finds a shortest path from the source to each of the targets (to
+   * each reachable node if the targets are empty) with a BFS, or with
+   * Dijkstra's algorithm if there are edge weights. The search stops as soon
+   * as all the targets have been reached.
+   * @return The paths in the order in which the targets were reached.
+   */
+  pathSearch::PathsLimited findShortestPaths(
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch) const;
+
+  /**
+   * @brief Finds a shortest path from the source to the target with a BFS
+   * from both sides, where always the side with the smaller frontier is
+   * expanded.
+   * @return The path, or `std::nullopt` if the target can't be reached.
+   */
+  std::optional<pathSearch::Path> findShortestPathBidirectional(
+      const Id& source, const Id& target,
+      const pathSearch::BinSearchWrapper& binSearch) const;
+
+  /**
+   * @brief Finds the `k` shortest paths without cycles from the source to the
+   * target with Yen's algorithm.
+   * @return The paths, ordered by their length.
+   */
+  pathSearch::PathsLimited findKShortestPaths(
+      const Id& source, const Id& target,
+      const pathSearch::BinSearchWrapper& binSearch, uint64_t k) const;
+
+  /**
+   * @brief Finds a shortest path from the source to the target with
+   * Dijkstra's algorithm, without using the `bannedNodes` and the edges in
+   * the `bannedEdgeRows` (as required by Yen's algorithm).
+   * @return The length of the path and the path itself, or `std::nullopt` if
+   * the target can't be reached.
+   */
+  std::optional<std::pair<double, pathSearch::Path>> findShortestPath(
+      const Id& source, const Id& target,
+      const pathSearch::BinSearchWrapper& binSearch,
+      const ad_utility::HashSet<size_t>& bannedEdgeRows,
+      const ad_utility::HashSet<uint64_t>& bannedNodes) const;
+
+  /**
+   * @brief Follow the `predecessors` (the edge over which each node was
+   * reached) back from the target to the source.
+   */
+  pathSearch::Path reconstructPath(
+      const Id& source, const Id& target,
+      const pathSearch::NodeMap<pathSearch::Edge>& predecessors) const;
+
   /**
    * @brief Converts paths to a result table with a specified width.
    * @tparam WIDTH The width of the result table.
@@ -51,11 +51,14 @@ class CacheValue {
                                          sizeof(Id));
   }
 
-  // Calculates the `MemorySize` taken up by an instance of `CacheValue`.
+  // Calculates the `MemorySize` taken up by an instance of `CacheValue`. This
+  // includes the adjacencies that are built for the result while it is in the
+  // cache (see `Result::getCsrGraph` and `QueryResultCache::recomputeSize`).
   struct SizeGetter {
     ad_utility::MemorySize operator()(const CacheValue& cacheValue) const {
       if (const auto& resultPtr = cacheValue.result_; resultPtr) {
-        return getSize(resultPtr->idTable());
+        return getSize(resultPtr->idTable()) +
+               resultPtr->getCsrGraphsMemorySize();
       } else {
         return 0_B;
       }
@@ -64,11 +67,11 @@ class CacheValue {
 };
 
 // The key for the `QueryResultCache` below. It consists of a `string` (the
-// actual cache key of a `QueryExecutionTree` and the index of the
-// `LocatedTriplesSnapshot` that was used to create the corresponding value.
-// That way, two identical trees with different snapshot indices will have a
-// different cache key. This has the (desired!) effect that UPDATE requests
-// correctly invalidate preexisting cache results.
+// actual cache key of a `QueryExecutionTree` and the index of the oldest
+// `LocatedTriplesSnapshot` that yields the same value (see
+// `Operation::getLocatedTriplesSnapshotIndexForCaching`). That way, UPDATE
+// requests correctly invalidate preexisting cache results of the operations
+// they affect, while the cache results of all other operations remain valid.
 struct QueryCacheKey {
   std::string key_;
   size_t locatedTriplesSnapshotIndex_;
@@ -24,7 +24,7 @@ QueryExecutionTree::QueryExecutionTree(QueryExecutionContext* const qec)
     : qec_(qec) {}
 
 // _____________________________________________________________________________
-std::string QueryExecutionTree::getCacheKey() const {
+const std::string& QueryExecutionTree::getCacheKey() const {
   return cacheKey_.value();
 }
 
@@ -78,20 +78,25 @@ QueryExecutionTree::selectedVariablesToColumnIndices(
 
 // _____________________________________________________________________________
 size_t QueryExecutionTree::getCostEstimate() {
+  // The cost estimate of a subtree is requested once for every plan that is
+  // built on top of it during the query planning, and computing it recurses
+  // through the whole subtree, so we only compute it once.
+  if (costEstimate_.has_value()) {
+    return costEstimate_.value();
+  }
   // If the result is cached and `zero-cost-estimate-for-cached-subtrees` is set
   // to `true`, we set the cost estimate to zero.
   if (cachedResult_ &&
       RuntimeParameters().get<"zero-cost-estimate-for-cached-subtree">()) {
-    return 0;
-  }
-
-  // Otherwise, we return the cost estimate of the root operation. For index
-  // scans, we assume one unit of work per result row.
-  if (getRootOperation()->isIndexScanWithNumVariables(1)) {
-    return getSizeEstimate();
+    costEstimate_ = 0;
+  } else if (getRootOperation()->isIndexScanWithNumVariables(1)) {
+    // Otherwise, we return the cost estimate of the root operation. For index
+    // scans, we assume one unit of work per result row.
+    costEstimate_ = getSizeEstimate();
   } else {
-    return rootOperation_->getCostEstimate();
+    costEstimate_ = rootOperation_->getCostEstimate();
   }
+  return costEstimate_.value();
 }
 
 // _____________________________________________________________________________
@@ -150,7 +155,8 @@ void QueryExecutionTree::readFromCache() {
   }
   auto& cache = qec_->getQueryTreeCache();
   auto res = cache.getIfContained(
-      {getCacheKey(), qec_->locatedTriplesSnapshot().index_});
+      {getCacheKey(),
+       rootOperation_->getLocatedTriplesSnapshotIndexForCaching()});
   if (res.has_value()) {
     cachedResult_ = res->_resultPointer->resultTablePtr();
   }
@@ -179,15 +185,33 @@ std::shared_ptr<QueryExecutionTree> QueryExecutionTree::createSortedTree(
   if (rootOperation->isSortedBy(sortColumns)) {
     return qet;
   }
-  auto sortedQet = rootOperation->makeSortedTree(sortColumns);
-
-  if (sortedQet.has_value()) {
-    AD_CORRECTNESS_CHECK(sortedQet.value() != nullptr);
-    return std::move(sortedQet).value();
-  }
-
-  return ad_utility::makeExecutionTree<Sort>(
-      rootOperation->getExecutionContext(), std::move(qet), sortColumns);
+  auto createTree = [&]() -> std::shared_ptr<QueryExecutionTree> {
+    auto sortedQet = rootOperation->makeSortedTree(sortColumns);
+    if (sortedQet.has_value()) {
+      AD_CORRECTNESS_CHECK(sortedQet.value() != nullptr);
+      return std::move(sortedQet).value();
+    }
+    return ad_utility::makeExecutionTree<Sort>(
+        rootOperation->getExecutionContext(), qet, sortColumns);
+  };
+  return qet->sortedTrees_.withWriteLock([&](auto& sortedTrees) {
+    auto& sortedTree = sortedTrees[sortColumns];
+    // A `LIMIT` might have been applied to the existing tree in the meantime,
+    // then its result is different.
+    auto existingTree = sortedTree.lock();
+    if (existingTree &&
+        existingTree->getRootOperation()->getLimitOffset().isUnconstrained()) {
+      return existingTree;
+    }
+    auto result = createTree();
+    // The query planner may share the tree between several threads (see
+    // `QueryPlanner::merge`), so the lazily computed estimates have to be
+    // computed before the tree is shared.
+    result->getSizeEstimate();
+    result->getCostEstimate();
+    sortedTree = result;
+    return result;
+  });
 }
 
 // _____________________________________________________________________________
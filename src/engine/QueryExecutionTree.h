@@ -15,7 +15,9 @@
 #include "engine/QueryExecutionContext.h"
 #include "parser/ParsedQuery.h"
 #include "parser/data/Types.h"
+#include "util/HashMap.h"
 #include "util/HashSet.h"
+#include "util/Synchronized.h"
 
 // Strongly typed enum for controlling whether stripped variables are explicitly
 // stored as stripped in this class, or completely hidden. (this is used to
@@ -37,7 +39,9 @@ class QueryExecutionTree {
     readFromCache();
   }
 
-  std::string getCacheKey() const;
+  // The cache key is computed once, when the tree is created. It is returned
+  // by reference, because it can be very long for large trees.
+  const std::string& getCacheKey() const;
 
   const QueryExecutionContext* getQec() const { return qec_; }
 
@@ -169,7 +173,9 @@ class QueryExecutionTree {
 
   // Create a `QueryExecutionTree` that produces exactly the same result as
   // `qet`, but sorted according to the `sortColumns`. If `qet` is already
-  // sorted accordingly, it is simply returned.
+  // sorted accordingly, it is simply returned. As long as the sorted tree is
+  // alive, subsequent calls with the same `qet` and `sortColumns` return the
+  // same tree.
   static std::shared_ptr<QueryExecutionTree> createSortedTree(
       std::shared_ptr<QueryExecutionTree> qet,
       const std::vector<ColumnIndex>& sortColumns);
@@ -244,10 +250,11 @@ class QueryExecutionTree {
   // this operation.
   void applyLimit(const LimitOffsetClause& limitOffsetClause) {
     getRootOperation()->applyLimitOffset(limitOffsetClause);
-    // Setting the limit invalidates the `cacheKey` as well as the
-    // `sizeEstimate`.
+    // Setting the limit invalidates the `cacheKey`, the `sizeEstimate`, and
+    // the `costEstimate`.
     cacheKey_ = getRootOperation()->getCacheKey();
     sizeEstimate_ = getRootOperation()->getSizeEstimate();
+    costEstimate_ = std::nullopt;
   }
 
  private:
@@ -255,8 +262,17 @@ class QueryExecutionTree {
   std::shared_ptr<Operation> rootOperation_ =
       nullptr;  // Owned child. Will be deleted at deconstruction.
   std::optional<size_t> sizeEstimate_ = std::nullopt;
+  std::optional<size_t> costEstimate_ = std::nullopt;
   std::optional<std::string> cacheKey_ = std::nullopt;
   std::optional<size_t> resultWidth_ = std::nullopt;
+  // The trees that were created by `createSortedTree` for this tree, by their
+  // sort columns. During the query planning, the same subtree is sorted by the
+  // same columns for many join candidates, and sharing the sorted trees avoids
+  // computing their cache keys and estimates again and again. The trees are
+  // only referenced weakly, because they own this tree as their child.
+  ad_utility::Synchronized<ad_utility::HashMap<
+      std::vector<ColumnIndex>, std::weak_ptr<QueryExecutionTree>>>
+      sortedTrees_;
   bool isRoot_ = false;  // used to distinguish the root from child
                          // operations/subtrees when pinning only the result.
 
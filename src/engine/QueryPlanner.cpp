@@ -11,9 +11,12 @@
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_split.h>
 
+#include <atomic>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <range/v3/view/cartesian_product.hpp>
+#include <thread>
 #include <type_traits>
 #include <variant>
 
@@ -63,6 +66,7 @@
 #include "parser/SparqlParserHelpers.h"
 #include "rdfTypes/Variable.h"
 #include "util/Exception.h"
+#include "util/jthread.h"
 
 namespace p = parsedQuery;
 namespace {
@@ -106,6 +110,22 @@ void assignNodesFilterAndTextLimitIds(QueryPlanner::SubtreePlan& target,
   target.idsOfIncludedTextLimits_ = source.idsOfIncludedTextLimits_;
   target.containsFilterSubstitute_ = source.containsFilterSubstitute_;
 }
+
+// The minimal number of pairs of plans for which `merge` creates the join
+// candidates in parallel. For fewer pairs, starting the threads is more
+// expensive than the planning itself.
+constexpr size_t MIN_NUM_PAIRS_FOR_PARALLELISM = 256;
+
+// The number of threads that the query planner may use, see the runtime
+// parameter `query-planning-max-num-threads`.
+size_t getNumPlanningThreads() {
+  size_t numThreads =
+      RuntimeParameters().get<"query-planning-max-num-threads">();
+  size_t hardwareConcurrency =
+      std::max(size_t{std::thread::hardware_concurrency()}, size_t{1});
+  return numThreads == 0 ? hardwareConcurrency
+                         : std::min(numThreads, hardwareConcurrency);
+}
 }  // namespace
 
 // _____________________________________________________________________________
@@ -1203,13 +1223,13 @@ std::vector<SubtreePlan> QueryPlanner::merge(
   // Find all pairs between a and b that are connected by an edge.
   LOG(TRACE) << "Considering joins that merge " << a.size() << " and "
              << b.size() << " plans...\n";
-  for (const auto& ai : a) {
-    for (const auto& bj : b) {
-      for (auto& plan : createJoinCandidates(ai, bj, tg)) {
-        candidates[getPruningKey(plan, plan._qet->resultSortedOn())]
-            .emplace_back(std::move(plan));
-      }
-      checkCancellation();
+  // The candidates are inserted in the same order as for a sequential loop over
+  // all pairs, s.t. the ties in `findCheapestExecutionTree` are always broken
+  // in the same way.
+  for (auto& candidatesForPlan : createJoinCandidatesForAllPairs(a, b, tg)) {
+    for (auto& plan : candidatesForPlan) {
+      candidates[getPruningKey(plan, plan._qet->resultSortedOn())]
+          .emplace_back(std::move(plan));
     }
   }
 
@@ -1245,6 +1265,78 @@ std::vector<SubtreePlan> QueryPlanner::merge(
   return prunedPlans;
 }
 
+// _____________________________________________________________________________
+std::vector<std::vector<SubtreePlan>>
+QueryPlanner::createJoinCandidatesForAllPairs(const vector<SubtreePlan>& a,
+                                              const vector<SubtreePlan>& b,
+                                              const TripleGraph& tg) const {
+  std::vector<std::vector<SubtreePlan>> result(a.size());
+  auto compute = [&](size_t i) {
+    const auto& ai = a[i];
+    for (const auto& bj : b) {
+      // Plans that share a node are never joined (see `connected`), so we can
+      // skip them without creating the join candidates.
+      if ((ai._idsOfIncludedNodes & bj._idsOfIncludedNodes) == 0) {
+        for (auto& plan : createJoinCandidates(ai, bj, tg)) {
+          result[i].push_back(std::move(plan));
+        }
+      }
+      checkCancellation();
+    }
+  };
+  size_t numThreads = std::min(getNumPlanningThreads(), a.size());
+  if (numThreads <= 1 || a.size() * b.size() < MIN_NUM_PAIRS_FOR_PARALLELISM) {
+    for (size_t i = 0; i < a.size(); ++i) {
+      compute(i);
+    }
+    return result;
+  }
+
+  // The estimates of a subtree are computed lazily and without
+  // synchronization, so we compute them all before the subtrees are shared
+  // between the threads. The join candidates only read the estimates of their
+  // children.
+  auto computeEstimates = [](const SubtreePlan& plan) {
+    auto& qet = *plan._qet;
+    qet.getSizeEstimate();
+    qet.getCostEstimate();
+    for (size_t col = 0; col < qet.getResultWidth(); ++col) {
+      qet.getMultiplicity(col);
+    }
+  };
+  ql::ranges::for_each(a, computeEstimates);
+  ql::ranges::for_each(b, computeEstimates);
+
+  // The plans from `a` are distributed dynamically, because the number of
+  // plans from `b` that they can be joined with differs a lot.
+  std::atomic<size_t> nextIndex = 0;
+  std::atomic<bool> failed = false;
+  std::vector<std::exception_ptr> exceptions(numThreads);
+  {
+    std::vector<ad_utility::JThread> threads;
+    threads.reserve(numThreads);
+    for (size_t t = 0; t < numThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        try {
+          for (size_t i = nextIndex++; i < a.size() && !failed;
+               i = nextIndex++) {
+            compute(i);
+          }
+        } catch (...) {
+          exceptions[t] = std::current_exception();
+          failed = true;
+        }
+      });
+    }
+  }
+  for (const auto& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 std::string QueryPlanner::TripleGraph::asString() const {
   std::ostringstream os;
@@ -1608,7 +1700,8 @@ size_t QueryPlanner::countSubgraphs(std::vector<const SubtreePlan*> graph,
     g.push_back(v);
   }
 
-  return countConnectedSubgraphs::countSubgraphs(g, budget);
+  return countConnectedSubgraphs::countSubgraphs(g, budget,
+                                                 getNumPlanningThreads());
 }
 
 // _____________________________________________________________________________
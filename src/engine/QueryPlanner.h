@@ -379,6 +379,15 @@ class QueryPlanner {
                             const vector<SubtreePlan>& b,
                             const TripleGraph& tg) const;
 
+  // Create the join candidates for all the pairs of a plan from `a` and a plan
+  // from `b`. The `i`-th element of the result contains the candidates for
+  // `a[i]`, in the order of `b`. For many pairs, the work is distributed over
+  // several threads (see `query-planning-max-num-threads`), the result is the
+  // same as for the sequential computation.
+  std::vector<std::vector<SubtreePlan>> createJoinCandidatesForAllPairs(
+      const vector<SubtreePlan>& a, const vector<SubtreePlan>& b,
+      const TripleGraph& tg) const;
+
   // Create `SubtreePlan`s that join `a` and `b` together. The columns are
   // computed automatically.
   std::vector<SubtreePlan> createJoinCandidates(
@@ -0,0 +1,278 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "engine/QueryScheduler.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <boost/asio/as_tuple.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <tuple>
+
+#include "engine/HttpError.h"
+#include "engine/QueryExecutionTree.h"
+#include "global/Id.h"
+#include "util/Exception.h"
+#include "util/HashSet.h"
+#include "util/Timer.h"
+
+namespace net = boost::asio;
+
+// _____________________________________________________________________________
+QueryScheduler::QueryScheduler(size_t maxNumRunning,
+                               ad_utility::MemorySize memoryBudget,
+                               std::chrono::milliseconds agingInterval)
+    : maxNumRunning_{maxNumRunning},
+      memoryBudget_{memoryBudget},
+      agingInterval_{agingInterval} {
+  AD_CONTRACT_CHECK(maxNumRunning_ > 0);
+  AD_CONTRACT_CHECK(agingInterval_.count() > 0);
+}
+
+// _____________________________________________________________________________
+QueryScheduler::Admission::Admission(QueryScheduler* scheduler,
+                                     Request request)
+    : scheduler_{scheduler}, request_{std::move(request)} {}
+
+// _____________________________________________________________________________
+QueryScheduler::Admission::Admission(Admission&& other) noexcept
+    : scheduler_{std::exchange(other.scheduler_, nullptr)},
+      request_{std::move(other.request_)} {}
+
+// _____________________________________________________________________________
+auto QueryScheduler::Admission::operator=(Admission&& other) noexcept
+    -> Admission& {
+  if (this != &other) {
+    if (scheduler_ != nullptr) {
+      scheduler_->release(request_);
+    }
+    scheduler_ = std::exchange(other.scheduler_, nullptr);
+    request_ = std::move(other.request_);
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+QueryScheduler::Admission::~Admission() {
+  if (scheduler_ != nullptr) {
+    scheduler_->release(request_);
+  }
+}
+
+// _____________________________________________________________________________
+auto QueryScheduler::priorityFromString(std::string_view name) -> Priority {
+  if (name == "high") {
+    return Priority::High;
+  } else if (name == "normal") {
+    return Priority::Normal;
+  } else if (name == "low") {
+    return Priority::Low;
+  }
+  throw std::runtime_error(
+      absl::StrCat("Invalid priority \"", name,
+                   "\", must be one of \"high\", \"normal\", or \"low\""));
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize QueryScheduler::estimateMemory(size_t numRows,
+                                                      size_t numColumns) {
+  constexpr size_t maxBytes = ad_utility::MemorySize::max().getBytes();
+  size_t bytesPerRow = std::max(numColumns, size_t{1}) * sizeof(Id);
+  if (numRows > maxBytes / bytesPerRow) {
+    return ad_utility::MemorySize::max();
+  }
+  return ad_utility::MemorySize::bytes(numRows * bytesPerRow);
+}
+
+namespace {
+// Add the memory estimates of the operations in the `qet` whose results are
+// materialized to the `bytes` (saturated at the maximal `MemorySize`). Return
+// true iff the result of the `qet` itself is computed lazily.
+bool addMaterializedBytes(QueryExecutionTree& qet, size_t& bytes) {
+  auto& operation = *qet.getRootOperation();
+  auto children = operation.getChildren();
+  bool hasLazyChild = false;
+  for (auto* child : children) {
+    hasLazyChild |= addMaterializedBytes(*child, bytes);
+  }
+  if (operation.canYieldLazyResult() && (hasLazyChild || children.empty())) {
+    return true;
+  }
+  constexpr size_t maxBytes = ad_utility::MemorySize::max().getBytes();
+  size_t resultBytes = QueryScheduler::estimateMemory(qet.getSizeEstimate(),
+                                                      qet.getResultWidth())
+                           .getBytes();
+  bytes = resultBytes > maxBytes - bytes ? maxBytes : bytes + resultBytes;
+  return false;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ad_utility::MemorySize QueryScheduler::estimateMemory(QueryExecutionTree& qet) {
+  size_t bytes = 0;
+  addMaterializedBytes(qet, bytes);
+  return ad_utility::MemorySize::bytes(bytes);
+}
+
+// _____________________________________________________________________________
+bool QueryScheduler::fits(const State& state, const Request& request) const {
+  if (state.numRunning_ >= maxNumRunning_) {
+    return false;
+  }
+  return state.numRunning_ == 0 ||
+         state.runningMemory_.getBytes() + request.memoryEstimate_.getBytes() <=
+             memoryBudget_.getBytes();
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::startRunning(State& state, const Request& request) {
+  ++state.numRunning_;
+  state.runningMemory_ += request.memoryEstimate_;
+  ++state.numRunningPerClient_[request.client_];
+  ++state.numAdmitted_;
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::admitWaiting(State& state) const {
+  auto now = Clock::now();
+  auto numRunningOfClient = [&state](const std::string& client) -> size_t {
+    auto it = state.numRunningPerClient_.find(client);
+    return it == state.numRunningPerClient_.end() ? 0 : it->second;
+  };
+  // The waiting queries are admitted by their priority (which increases by one
+  // level for each `agingInterval_` that a query has waited), then by the
+  // number of running queries of their client, then by their arrival.
+  auto order = [&](const Waiter& waiter) {
+    auto numIntervals = (now - waiter.arrival_) / agingInterval_;
+    auto priority = static_cast<int64_t>(waiter.request_.priority_) -
+                    static_cast<int64_t>(numIntervals);
+    return std::tuple{priority, numRunningOfClient(waiter.request_.client_),
+                      waiter.arrival_};
+  };
+  using Queue = std::list<std::shared_ptr<Waiter>>;
+  // The waiting queries that don't fit and have been overtaken.
+  ad_utility::HashSet<const Waiter*> overtaken;
+  while (state.numRunning_ < maxNumRunning_) {
+    std::optional<std::pair<Queue*, Queue::iterator>> best;
+    for (auto& queue : state.queues_) {
+      for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (!overtaken.contains(it->get()) &&
+            (!best.has_value() || order(**it) < order(**best->second))) {
+          best.emplace(&queue, it);
+        }
+      }
+    }
+    if (!best.has_value()) {
+      return;
+    }
+    auto [queue, it] = best.value();
+    if (!fits(state, (*it)->request_)) {
+      // A query that has waited for at least one `agingInterval_` is not
+      // overtaken anymore, s.t. the queries with a large memory estimate are
+      // eventually admitted.
+      if (now - (*it)->arrival_ >= agingInterval_) {
+        return;
+      }
+      overtaken.insert(it->get());
+      continue;
+    }
+    auto waiter = std::move(*it);
+    queue->erase(it);
+    startRunning(state, waiter->request_);
+    waiter->admitted_ = true;
+    // Wake up the waiting coroutine, see `admit`.
+    net::post(waiter->strand_, [waiter]() {
+      waiter->timer_.expires_at(Clock::time_point::min());
+    });
+  }
+}
+
+// _____________________________________________________________________________
+void QueryScheduler::release(const Request& request) {
+  state_.withWriteLock([this, &request](State& state) {
+    AD_CORRECTNESS_CHECK(state.numRunning_ > 0);
+    --state.numRunning_;
+    state.runningMemory_ -= request.memoryEstimate_;
+    auto it = state.numRunningPerClient_.find(request.client_);
+    AD_CORRECTNESS_CHECK(it != state.numRunningPerClient_.end());
+    if (--it->second == 0) {
+      state.numRunningPerClient_.erase(it);
+    }
+    admitWaiting(state);
+  });
+}
+
+// _____________________________________________________________________________
+net::awaitable<QueryScheduler::Admission> QueryScheduler::admit(
+    Request request) {
+  request.memoryEstimate_ = std::min(request.memoryEstimate_, memoryBudget_);
+  auto executor = co_await net::this_coro::executor;
+  auto strand = net::make_strand(executor);
+  auto waiter = std::make_shared<Waiter>(request, strand);
+
+  // Start immediately if the query is admitted together with the queries that
+  // already wait.
+  bool startedImmediately =
+      state_.withWriteLock([this, &request, &waiter](State& state) {
+        state.queues_.at(static_cast<size_t>(request.priority_))
+            .push_back(waiter);
+        admitWaiting(state);
+        return waiter->admitted_;
+      });
+  if (startedImmediately) {
+    co_return Admission{this, std::move(request)};
+  }
+
+  // Wait until the timer expires, either because the query is admitted (then
+  // `admitWaiting` lets the timer expire immediately) or because the deadline
+  // is reached. All the operations on the timer are done on the `strand`.
+  ad_utility::Timer waitingTimer{ad_utility::Timer::Started};
+  auto wait = [waiter]() -> net::awaitable<void> {
+    co_await waiter->timer_.async_wait(net::as_tuple(net::use_awaitable));
+  };
+  co_await net::co_spawn(strand, wait(), net::use_awaitable);
+
+  bool admitted =
+      state_.withWriteLock([this, &waiter, &waitingTimer](State& state) {
+        if (waiter->admitted_) {
+          state.totalWaitingTime_ += waitingTimer.msecs();
+          return true;
+        }
+        auto& queue =
+            state.queues_.at(static_cast<size_t>(waiter->request_.priority_));
+        queue.remove(waiter);
+        ++state.numRejected_;
+        // The rejected query might have blocked other queries.
+        admitWaiting(state);
+        return false;
+      });
+  if (!admitted) {
+    throw HttpError(
+        boost::beast::http::status::service_unavailable,
+        "The query could not be started before its deadline because the "
+        "server is busy with other queries, please try again later");
+  }
+  co_return Admission{this, std::move(request)};
+}
+
+// _____________________________________________________________________________
+nlohmann::json QueryScheduler::getStatistics() const {
+  return state_.withReadLock([this](const State& state) {
+    nlohmann::json result;
+    result["max-num-running"] = maxNumRunning_;
+    result["num-running"] = state.numRunning_;
+    result["running-memory-estimate"] = state.runningMemory_.asString();
+    result["memory-budget"] = memoryBudget_.asString();
+    result["num-waiting-high"] = state.queues_[0].size();
+    result["num-waiting-normal"] = state.queues_[1].size();
+    result["num-waiting-low"] = state.queues_[2].size();
+    result["num-admitted"] = state.numAdmitted_;
+    result["num-rejected"] = state.numRejected_;
+    result["total-waiting-time-ms"] = state.totalWaitingTime_.count();
+    return result;
+  });
+}
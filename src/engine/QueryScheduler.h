@@ -0,0 +1,148 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
+#define QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
+
+#include <array>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/json.h"
+
+class QueryExecutionTree;
+
+// The admission control for the execution of queries in the `Server`. At most
+// `maxNumRunning` queries are executed at the same time, and the sum of the
+// memory estimates of the running queries must not exceed the `memoryBudget`
+// (a single query is always admitted if nothing else is running, s.t. queries
+// with a large estimate can't starve). The other queries wait in a queue until
+// they are admitted or their deadline is reached.
+//
+// The waiting queries are admitted in the order of their priority. Within the
+// same priority, the query of the client with the fewest running queries is
+// admitted first (and then the query that waited the longest), s.t. a single
+// client can't take all the slots with a burst of queries. A query that doesn't
+// fit can be overtaken by queries later in this order that do fit (for example,
+// because they have a smaller memory estimate). To avoid starvation, the
+// priority of a waiting query increases by one level for each `agingInterval`
+// that it has waited, and a query that has waited for at least one
+// `agingInterval` can't be overtaken anymore.
+class QueryScheduler {
+ public:
+  enum class Priority : uint8_t { High = 0, Normal = 1, Low = 2 };
+  static constexpr size_t NUM_PRIORITIES = 3;
+
+  using Clock = std::chrono::steady_clock;
+
+  // The description of a query that wants to be executed.
+  struct Request {
+    Priority priority_ = Priority::Normal;
+    // An identifier of the client for the fair scheduling (may be empty).
+    std::string client_;
+    ad_utility::MemorySize memoryEstimate_ = ad_utility::MemorySize::bytes(0);
+    // The query is rejected if it is not admitted until then.
+    Clock::time_point deadline_ = Clock::time_point::max();
+  };
+
+  // The right to execute a query. The slot and the memory are given back when
+  // this object is destroyed.
+  class Admission {
+   public:
+    Admission() = default;
+    Admission(Admission&& other) noexcept;
+    Admission& operator=(Admission&& other) noexcept;
+    ~Admission();
+
+   private:
+    friend class QueryScheduler;
+    Admission(QueryScheduler* scheduler, Request request);
+    QueryScheduler* scheduler_ = nullptr;
+    Request request_;
+  };
+
+  QueryScheduler(
+      size_t maxNumRunning, ad_utility::MemorySize memoryBudget,
+      std::chrono::milliseconds agingInterval = std::chrono::seconds{10});
+
+  // Wait until the query described by the `request` is admitted. Throw an
+  // `HttpError` with status 503 (service unavailable) if the deadline of the
+  // `request` is reached before.
+  boost::asio::awaitable<Admission> admit(Request request);
+
+  // Parse the priority from its name ("high", "normal", or "low"), throw if
+  // the name is invalid.
+  static Priority priorityFromString(std::string_view name);
+
+  // The memory estimate for a result with the given number of rows and
+  // columns (saturated at the maximal `MemorySize` for absurd estimates).
+  static ad_utility::MemorySize estimateMemory(size_t numRows,
+                                               size_t numColumns);
+
+  // The memory estimate for the execution of the `qet`. Only the results of
+  // the operations that are materialized as a whole are counted, not the ones
+  // that are computed lazily (see `Operation::canYieldLazyResult`).
+  static ad_utility::MemorySize estimateMemory(QueryExecutionTree& qet);
+
+  // Statistics about the running and waiting queries, for the `stats` command
+  // of the `Server`.
+  nlohmann::json getStatistics() const;
+
+ private:
+  // A query that waits in the queue. It is woken up by letting its `timer_`
+  // expire, which happens on its `strand_`.
+  struct Waiter {
+    using Strand = boost::asio::strand<boost::asio::any_io_executor>;
+    Waiter(Request request, Strand strand)
+        : request_{std::move(request)},
+          strand_{std::move(strand)},
+          timer_{strand_, request_.deadline_} {}
+    Request request_;
+    Strand strand_;
+    boost::asio::steady_timer timer_;
+    Clock::time_point arrival_ = Clock::now();
+    bool admitted_ = false;
+  };
+
+  struct State {
+    size_t numRunning_ = 0;
+    ad_utility::MemorySize runningMemory_ = ad_utility::MemorySize::bytes(0);
+    ad_utility::HashMap<std::string, size_t> numRunningPerClient_;
+    // The waiting queries for each priority, in the order of their arrival.
+    std::array<std::list<std::shared_ptr<Waiter>>, NUM_PRIORITIES> queues_;
+    size_t numAdmitted_ = 0;
+    size_t numRejected_ = 0;
+    std::chrono::milliseconds totalWaitingTime_{0};
+  };
+
+  // Return true if a query with the given `request` can be started now.
+  bool fits(const State& state, const Request& request) const;
+
+  // Book the resources of the `request` as running.
+  static void startRunning(State& state, const Request& request);
+
+  // Admit the waiting queries that fit into the free resources, in the order
+  // that is described at the beginning of this class.
+  void admitWaiting(State& state) const;
+
+  // Called by the destructor of `Admission`.
+  void release(const Request& request);
+
+  size_t maxNumRunning_;
+  ad_utility::MemorySize memoryBudget_;
+  std::chrono::milliseconds agingInterval_;
+  ad_utility::Synchronized<State> state_;
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYSCHEDULER_H
@@ -10,6 +10,8 @@
 #include <absl/cleanup/cleanup.h>
 
 #include "backports/shift.h"
+#include "engine/CsrGraph.h"
+#include "global/RuntimeParameters.h"
 #include "util/Exception.h"
 #include "util/Generators.h"
 #include "util/InputRangeUtils.h"
@@ -137,6 +139,8 @@ void Result::applyLimitOffset(
   // than the size of the `IdTable`, then this has no effect and runtime
   // `O(1)` (see the docs for `ql::shift_left`).
   AD_CONTRACT_CHECK(limitTimeCallback);
+  // The adjacencies would refer to the rows before the LIMIT and OFFSET.
+  csrGraphs_->wlock()->clear();
   if (limitOffset.isUnconstrained()) {
     return;
   }
@@ -284,6 +288,62 @@ bool Result::isFullyMaterialized() const noexcept {
   return std::holds_alternative<IdTableSharedLocalVocabPair>(data_);
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const CsrGraph> Result::getCsrGraph(
+    ColumnIndex startCol, ColumnIndex targetCol) const {
+  size_t minNumUses = RuntimeParameters().get<"csr-adjacency-min-num-uses">();
+  if (minNumUses == 0 || !isFullyMaterialized() || sortedBy_.empty() ||
+      sortedBy_.front() != startCol) {
+    return nullptr;
+  }
+  auto key = std::pair{startCol, targetCol};
+  bool build = false;
+  auto graph = csrGraphs_->withWriteLock([&](CsrGraphs& graphs) {
+    auto& entry = graphs[key];
+    if (entry.graph_ == nullptr && !entry.isBeingBuilt_ &&
+        ++entry.numRequests_ >= minNumUses) {
+      entry.isBeingBuilt_ = true;
+      build = true;
+    }
+    return entry.graph_;
+  });
+  if (!build) {
+    return graph;
+  }
+  // The graph is built without holding the lock, concurrent queries that need
+  // the same graph meanwhile use the table directly instead of waiting.
+  try {
+    const IdTable& table = idTable();
+    graph = std::make_shared<const CsrGraph>(
+        table.getColumn(startCol), table.getColumn(targetCol), allocator);
+  } catch (const ad_utility::detail::AllocationExceedsLimitException&) {
+    // The graph is only an optimization, so it is simply not used if there is
+    // not enough memory.
+  }
+  csrGraphs_->withWriteLock([&](CsrGraphs& graphs) {
+    auto& entry = graphs[key];
+    entry.isBeingBuilt_ = false;
+    entry.graph_ = graph;
+  });
+  if (graph != nullptr && onBuild) {
+    onBuild();
+  }
+  return graph;
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize Result::getCsrGraphsMemorySize() const {
+  return csrGraphs_->withWriteLock([](const CsrGraphs& graphs) {
+    auto size = ad_utility::MemorySize::bytes(0);
+    for (const auto& [columns, entry] : graphs) {
+      if (entry.graph_ != nullptr) {
+        size += entry.graph_->getMemorySize();
+      }
+    }
+    return size;
+  });
+}
+
 // _____________________________________________________________________________
 void Result::cacheDuringConsumption(
     std::function<bool(const std::optional<IdTableVocabPair>&,
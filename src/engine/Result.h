@@ -8,6 +8,7 @@
 #ifndef QLEVER_SRC_ENGINE_RESULT_H
 #define QLEVER_SRC_ENGINE_RESULT_H
 
+#include <memory>
 #include <ranges>
 #include <variant>
 #include <vector>
@@ -18,7 +19,11 @@
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/HashMap.h"
 #include "util/InputRangeUtils.h"
+#include "util/Synchronized.h"
+
+class CsrGraph;
 
 // The result of an `Operation`. This is the class QLever uses for all
 // intermediate or final results when processing a SPARQL query. The actual data
@@ -79,6 +84,19 @@ class Result {
   // Empty if the result is not sorted on any column.
   std::vector<ColumnIndex> sortedBy_;
 
+  // The adjacencies that were requested via `getCsrGraph`, for each pair of
+  // columns the number of requests and the graph (once it has been built). In
+  // a `unique_ptr`, because the mutex of the `Synchronized` can't be moved.
+  struct CsrGraphEntry {
+    size_t numRequests_ = 0;
+    bool isBeingBuilt_ = false;
+    std::shared_ptr<const CsrGraph> graph_;
+  };
+  using CsrGraphs =
+      ad_utility::HashMap<std::pair<ColumnIndex, ColumnIndex>, CsrGraphEntry>;
+  std::unique_ptr<ad_utility::Synchronized<CsrGraphs>> csrGraphs_ =
+      std::make_unique<ad_utility::Synchronized<CsrGraphs>>();
+
   // Note: If additional members and invariants are added to the class (for
   // example information about the datatypes in each column) make sure that
   // 1. The members and invariants remain valid after calling non-const function
@@ -234,6 +252,25 @@ class Result {
   // Return true if `data_` holds an `IdTable`, false otherwise.
   bool isFullyMaterialized() const noexcept;
 
+  // Return the adjacency of the graph with the edges `startCol -> targetCol`
+  // of this result, which is used by graph operations like the transitive
+  // path. The graph is only built when it is requested for the
+  // `csr-adjacency-min-num-uses`-th time, because then the result is most
+  // likely stored in the query cache and traversed by many queries. It is
+  // then kept with this result and shared by all its users. Return `nullptr`
+  // if the graph is not (yet) built, if it is currently built by another
+  // query, if it doesn't fit into the `allocator`, or if this result is not
+  // fully materialized or not sorted by the `startCol`. The `onBuild` callback
+  // is called after the graph has been built, so that the caller can update
+  // the size of the cache entry of this result.
+  std::shared_ptr<const CsrGraph> getCsrGraph(
+      ColumnIndex startCol, ColumnIndex targetCol,
+      const ad_utility::AllocatorWithLimit<Id>& allocator,
+      const std::function<void()>& onBuild = {}) const;
+
+  // The memory used by the graphs that were built by `getCsrGraph`.
+  ad_utility::MemorySize getCsrGraphsMemorySize() const;
+
   // Log the size of this result. We call this at several places in
   // `Server::processQuery`. Ideally, this should only be called in one
   // place, but for now, this method at least makes sure that these log
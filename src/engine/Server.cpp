@@ -26,8 +26,10 @@
 #include "global/RuntimeParameters.h"
 #include "index/IndexImpl.h"
 #include "parser/SparqlParser.h"
+#include "util/Algorithm.h"
 #include "util/AsioHelpers.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Metrics.h"
 #include "util/ParseableDuration.h"
 #include "util/TypeTraits.h"
 #include "util/http/HttpServer.h"
@@ -57,7 +59,10 @@ Server::Server(unsigned short port, size_t numThreads,
       enablePatternTrick_(usePatternTrick),
       // The number of server threads currently also is the number of queries
       // that can be processed simultaneously.
-      queryThreadPool_{numThreads} {
+      queryThreadPool_{numThreads},
+      // At most one query per thread is executed at the same time, and the
+      // memory estimates of these queries must fit into the memory limit.
+      queryScheduler_{numThreads, maxMem} {
   // This also directly triggers the update functions and propagates the
   // values of the parameters to the cache.
   RuntimeParameters().setOnUpdateAction<"cache-max-num-entries">(
@@ -68,6 +73,12 @@ Server::Server(unsigned short port, size_t numThreads,
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  RuntimeParameters().setOnUpdateAction<"parsed-query-cache-max-num-entries">(
+      [this](size_t newValue) {
+        parsedQueryCache_.setMaxNumEntries(newValue);
+      });
+  RuntimeParameters().setOnUpdateAction<"prepared-queries-max-num-entries">(
+      [this](size_t newValue) { preparedQueries_.setMaxNumQueries(newValue); });
 }
 
 // __________________________________________________________________________
@@ -347,6 +358,10 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   if (auto cmd = checkParameter("cmd", "stats")) {
     logCommand(cmd, "get index statistics");
     response = createJsonResponse(composeStatsJson(), request);
+  } else if (auto cmd = checkParameter("cmd", "metrics")) {
+    logCommand(cmd, "get metrics");
+    response =
+        createOkResponse(composeMetrics(), request, MediaType::textPlain);
   } else if (auto cmd = checkParameter("cmd", "cache-stats")) {
     logCommand(cmd, "get cache statistics");
     response = createJsonResponse(composeCacheStatsJson(), request);
@@ -439,6 +454,30 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     }
   }
 
+  // Prepare a query for repeated execution with different values for its
+  // parameters (see `PreparedQueries` and the "prepared-query" parameter
+  // below). The response contains the ID of the query and its parameters.
+  if (auto preparedQuery = checkParameter("prepare", std::nullopt)) {
+    LOG(INFO) << "Preparing query: "
+              << ad_utility::truncateOperationString(preparedQuery.value())
+              << std::endl;
+    using ad_utility::url_parser::parseDatasetClausesFrom;
+    auto datasets =
+        parseDatasetClausesFrom(parameters, "default-graph-uri", false);
+    ad_utility::appendVector(
+        datasets, parseDatasetClausesFrom(parameters, "named-graph-uri", true));
+    auto id = preparedQueries_.prepare(&index_.encodedIriManager(),
+                                       std::string{preparedQuery.value()},
+                                       std::move(datasets));
+    nlohmann::json json;
+    json["prepared-query-id"] = id;
+    json["parameters"] = nlohmann::json::array();
+    for (const auto& var : preparedQueries_.getParameters(id)) {
+      json["parameters"].push_back(var.name());
+    }
+    response = createJsonResponse(json, request);
+  }
+
   // Store the QueryExecutionTree outside the lambda, s.t. we have access in
   // case of errors to create an informative error message that includes the
   // runtime information.
@@ -476,15 +515,18 @@ CPP_template_def(typename RequestT, typename ResponseT)(
       ParsedQuery query = std::move(operations[0]);
       AD_CORRECTNESS_CHECK(query.hasSelectClause() || query.hasAskClause() ||
                            query.hasConstructClause());
+      auto schedulingRequest =
+          determineSchedulingRequest(parameters, request, accessTokenOk);
       co_return co_await processQuery(
           parameters, std::move(query), requestTimer, cancellationHandle, qec,
-          std::move(request), send, timeLimit.value(), plannedQuery);
+          std::move(request), send, timeLimit.value(), plannedQuery,
+          std::move(schedulingRequest));
     }
   };
   auto visitQuery = [this, &visitOperation](Query query) -> Awaitable<void> {
     // We need to copy the query string because `visitOperation` below also
     // needs it.
-    auto parsedQuery = SparqlParser::parseQuery(
+    auto parsedQuery = parsedQueryCache_.getOrParse(
         &index_.encodedIriManager(), query.query_, query.datasetClauses_);
     return visitOperation(
         {std::move(parsedQuery)}, "SPARQL Query", std::move(query.query_),
@@ -507,8 +549,18 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         "following query was sent instead of an update: ");
   };
   auto visitGraphStore =
-      [&request, &visitOperation, &requireValidAccessToken,
+      [&request, &send, &visitOperation, &requireValidAccessToken,
+       &checkParameter, &requestTimer,
        this](GraphStoreOperation operation) -> Awaitable<void> {
+    // With `insert-in-batches=true`, the triples of a POST request are
+    // inserted in batches, without first transforming them into a SPARQL
+    // Update.
+    if (request.method() == http::verb::post &&
+        checkParameter("insert-in-batches", "true")) {
+      requireValidAccessToken("Batched update from Graph Store Protocol");
+      return processBatchedInsert(std::move(operation.graph_), requestTimer,
+                                  request, send);
+    }
     std::vector<ParsedQuery> parsedOperations =
         GraphStoreProtocol::transformGraphStoreProtocol(std::move(operation),
                                                         request, index_);
@@ -529,7 +581,36 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                      ")"),
         std::move(operationString), trueFunc, "Unused dummy message");
   };
-  auto visitNone = [&response, &send, &request](None) -> Awaitable<void> {
+  // Execute a prepared query. The values of the parameters are passed as
+  // "bind-<name>=<value>", for example, "bind-person=<http://example.org/x>".
+  auto visitPreparedQuery = [this, &parameters, &visitOperation](
+                                const std::string& id) -> Awaitable<void> {
+    PreparedQueries::Bindings bindings;
+    static constexpr std::string_view bindPrefix = "bind-";
+    for (const auto& [key, values] : parameters) {
+      if (!key.starts_with(bindPrefix)) {
+        continue;
+      }
+      if (values.size() != 1) {
+        throw std::runtime_error(absl::StrCat(
+            "The parameter \"", key, "\" must be specified exactly once"));
+      }
+      bindings.emplace_back(key.substr(bindPrefix.size()), values.front());
+    }
+    ql::ranges::sort(bindings);
+    auto parsedQuery =
+        preparedQueries_.bind(&index_.encodedIriManager(), id, bindings);
+    std::string queryString = parsedQuery._originalString;
+    return visitOperation(
+        {std::move(parsedQuery)}, "Prepared SPARQL Query",
+        std::move(queryString), std::not_fn(&ParsedQuery::hasUpdateClause),
+        "A prepared query must not be an update: ");
+  };
+  auto visitNone = [&response, &send, &request, &checkParameter,
+                    &visitPreparedQuery](None) -> Awaitable<void> {
+    if (auto id = checkParameter("prepared-query", std::nullopt)) {
+      return visitPreparedQuery(std::string{id.value()});
+    }
     // If there was no "query", but any of the URL parameters processed before
     // produced a `response`, send that now. Note that if multiple URL
     // parameters were processed, only the `response` from the last one is sent.
@@ -567,11 +648,42 @@ std::pair<bool, bool> Server::determineResultPinning(
   return {pinSubtrees, pinResult};
 }
 
+// ____________________________________________________________________________
+CPP_template_def(typename RequestT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>) QueryScheduler::
+    Request Server::determineSchedulingRequest(
+        const ad_utility::url_parser::ParamValueMap& params,
+        const RequestT& request, bool accessTokenOk) {
+  using ad_utility::url_parser::getParameterCheckAtMostOnce;
+  auto getValue = [&params, &request](std::string_view parameterName,
+                                      std::string_view headerName) {
+    auto value = getParameterCheckAtMostOnce(params, parameterName);
+    return value.has_value() ? std::move(value.value())
+                             : std::string{request.base()[headerName]};
+  };
+  QueryScheduler::Request result;
+  auto priority = getValue("priority", "QLever-Priority");
+  if (!priority.empty()) {
+    result.priority_ = QueryScheduler::priorityFromString(priority);
+  }
+  if (result.priority_ == QueryScheduler::Priority::High && !accessTokenOk) {
+    throw std::runtime_error(
+        "The priority \"high\" requires a valid access token");
+  }
+  result.client_ = getValue("client-id", "QLever-Client-Id");
+  return result;
+}
+
 // ____________________________________________________________________________
 Server::PlannedQuery Server::planQuery(
     ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
     TimeLimit timeLimit, QueryExecutionContext& qec,
     ad_utility::SharedCancellationHandle handle) const {
+  static auto& planningHistogram =
+      ad_utility::metrics::globalRegistry().histogram(
+          "qlever_query_planning_duration_seconds",
+          "The time for planning a query or an update");
+  ad_utility::metrics::ScopedTimer planningTimer{planningHistogram};
   QueryPlanner qp(&qec, handle);
   auto executionTree = qp.createExecutionTree(operation);
   PlannedQuery plannedQuery{std::move(operation), std::move(executionTree)};
@@ -644,6 +756,7 @@ nlohmann::json Server::composeStatsJson() const {
   result["num-text-records"] = index_.getNofTextRecords();
   result["num-word-occurrences"] = index_.getNofWordPostings();
   result["num-entity-occurrences"] = index_.getNofEntityPostings();
+  result["query-scheduler"] = queryScheduler_.getStatistics();
   return result;
 }
 
@@ -657,9 +770,35 @@ nlohmann::json Server::composeCacheStatsJson() const {
   // converter.
   result["non-pinned-size"] = cache_.nonPinnedSize().getBytes();
   result["pinned-size"] = cache_.pinnedSize().getBytes();
+  result["num-parsed-queries"] = parsedQueryCache_.numEntries();
+  result["parsed-query-cache-hits"] = parsedQueryCache_.numHits();
+  result["parsed-query-cache-misses"] = parsedQueryCache_.numMisses();
+  result["num-prepared-queries"] = preparedQueries_.numQueries();
   return result;
 }
 
+// _____________________________________________________________________________
+std::string Server::composeMetrics() const {
+  using namespace ad_utility::metrics;
+  // The metrics of the cache are only updated when they are requested.
+  auto& registry = globalRegistry();
+  static constexpr std::string_view entries = "qlever_cache_entries";
+  static constexpr std::string_view entriesHelp =
+      "The number of results in the query cache";
+  registry.gauge(entries, entriesHelp, {{"pinned", "false"}})
+      .set(static_cast<int64_t>(cache_.numNonPinnedEntries()));
+  registry.gauge(entries, entriesHelp, {{"pinned", "true"}})
+      .set(static_cast<int64_t>(cache_.numPinnedEntries()));
+  static constexpr std::string_view size = "qlever_cache_size_bytes";
+  static constexpr std::string_view sizeHelp =
+      "The size of the results in the query cache";
+  registry.gauge(size, sizeHelp, {{"pinned", "false"}})
+      .set(static_cast<int64_t>(cache_.nonPinnedSize().getBytes()));
+  registry.gauge(size, sizeHelp, {{"pinned", "true"}})
+      .set(static_cast<int64_t>(cache_.pinnedSize().getBytes()));
+  return registry.toPrometheusText();
+}
+
 // _____________________________________________
 CPP_template_def(typename RequestT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -678,6 +817,22 @@ CPP_template_def(typename RequestT)(
   return std::move(queryId.value());
 }
 
+// _____________________________________________________________________________
+namespace {
+// Yield the chunks of the `generator` unchanged and count their bytes in the
+// metrics, to measure the throughput of the export.
+cppcoro::generator<std::string> countExportedBytes(
+    cppcoro::generator<std::string> generator) {
+  static auto& exportedBytes = ad_utility::metrics::globalRegistry().counter(
+      "qlever_export_bytes_total",
+      "The number of bytes of query results that were sent to clients");
+  for (auto& chunk : generator) {
+    exportedBytes.add(chunk.size());
+    co_yield chunk;
+  }
+}
+}  // namespace
+
 // _____________________________________________________________________________
 CPP_template_def(typename RequestT, typename ResponseT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -686,9 +841,15 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         const PlannedQuery& plannedQuery, const QueryExecutionTree& qet,
         const ad_utility::Timer& requestTimer,
         SharedCancellationHandle cancellationHandle) const {
-  auto responseGenerator = ExportQueryExecutionTrees::computeResult(
-      plannedQuery.parsedQuery_, qet, mediaType, requestTimer,
-      std::move(cancellationHandle));
+  auto responseGenerator = countExportedBytes(
+      ExportQueryExecutionTrees::computeResult(plannedQuery.parsedQuery_, qet,
+                                               mediaType, requestTimer,
+                                               std::move(cancellationHandle)));
+  using namespace ad_utility::metrics;
+  static auto& exportHistogram = globalRegistry().histogram(
+      "qlever_export_duration_seconds",
+      "The time for computing and sending the result of a query");
+  ScopedTimer exportTimer{exportHistogram};
 
   auto response = ad_utility::httpUtils::createOkResponse(
       std::move(responseGenerator), request, mediaType);
@@ -817,7 +978,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery&& query, const ad_utility::Timer& requestTimer,
         ad_utility::SharedCancellationHandle cancellationHandle,
         QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery) {
+        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+        QueryScheduler::Request schedulingRequest) {
   AD_CORRECTNESS_CHECK(!query.hasUpdateClause());
 
   auto mediaTypes = determineMediaTypes(params, request);
@@ -856,6 +1018,19 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // offset is not applied twice when exporting the query.
   adjustParsedQueryLimitOffset(plannedQuery.value(), mediaType, params);
 
+  // Wait until the query may be executed. The memory estimate is derived from
+  // the size estimates of the query planner for the results that are
+  // materialized, and the query is rejected if it can't be started before its
+  // time limit.
+  schedulingRequest.memoryEstimate_ = QueryScheduler::estimateMemory(qet);
+  auto remainingTime = timeLimit - requestTimer.msecs();
+  if (remainingTime < std::chrono::hours{24}) {
+    schedulingRequest.deadline_ =
+        QueryScheduler::Clock::now() +
+        std::max(remainingTime, std::chrono::milliseconds{0});
+  }
+  auto admission = co_await queryScheduler_.admit(std::move(schedulingRequest));
+
   // This actually processes the query and sends the result in the
   // requested format.
   co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
@@ -863,6 +1038,12 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                                   plannedQuery.value().queryExecutionTree_,
                                   requestTimer, cancellationHandle);
 
+  static auto& queryHistogram =
+      ad_utility::metrics::globalRegistry().histogram(
+          "qlever_query_duration_seconds",
+          "The total time for processing a query and sending its result");
+  queryHistogram.observe(requestTimer.value());
+
   // Print the runtime info. This needs to be done after the query
   // was computed.
   LOG(INFO) << "Done processing query and sending result"
@@ -905,6 +1086,24 @@ nlohmann::json Server::createResponseMetadataForUpdate(
       nlohmann::ordered_json(runtimeInfoWholeOp);
   response["runtimeInformation"]["query_execution_tree"] =
       nlohmann::ordered_json(runtimeInfo);
+  response["time"]["planning"] =
+      formatTime(runtimeInfoWholeOp.timeQueryPlanning);
+  response["time"]["where"] =
+      formatTime(std::chrono::duration_cast<std::chrono::milliseconds>(
+          runtimeInfo.totalTime_));
+  addUpdateStatisticsToResponse(response, requestTimer, index, deltaTriples,
+                                countBefore, updateMetadata, countAfter);
+  return response;
+}
+
+// ____________________________________________________________________________
+void Server::addUpdateStatisticsToResponse(
+    json& response, const ad_utility::Timer& requestTimer, const Index& index,
+    const DeltaTriples& deltaTriples, const DeltaTriplesCount& countBefore,
+    const UpdateMetadata& updateMetadata, const DeltaTriplesCount& countAfter) {
+  auto formatTime = [](std::chrono::milliseconds time) {
+    return absl::StrCat(time.count(), "ms");
+  };
   response["delta-triples"]["before"] = nlohmann::json(countBefore);
   response["delta-triples"]["after"] = nlohmann::json(countAfter);
   response["delta-triples"]["difference"] =
@@ -913,11 +1112,6 @@ nlohmann::json Server::createResponseMetadataForUpdate(
     response["delta-triples"]["operation"] =
         json(updateMetadata.inUpdate_.value());
   }
-  response["time"]["planning"] =
-      formatTime(runtimeInfoWholeOp.timeQueryPlanning);
-  response["time"]["where"] =
-      formatTime(std::chrono::duration_cast<std::chrono::milliseconds>(
-          runtimeInfo.totalTime_));
   json updateTime{
       {"total", formatTime(updateMetadata.triplePreparationTime_ +
                            updateMetadata.deletionTime_ +
@@ -939,7 +1133,6 @@ nlohmann::json Server::createResponseMetadataForUpdate(
     response["located-triples"][Permutation::toString(permutation)]
             ["blocks-total"] = numBlocks;
   }
-  return response;
 }
 // ____________________________________________________________________________
 nlohmann::json Server::processUpdateImpl(
@@ -961,10 +1154,15 @@ nlohmann::json Server::processUpdateImpl(
   LOG(DEBUG) << "Runtime Info:\n"
              << qet.getRootOperation()->runtimeInfo().toString() << std::endl;
 
-  // Clear the cache, because all cache entries have been invalidated by
-  // the update anyway (The index of the located triples snapshot is
-  // part of the cache key).
-  cache_.clearAll();
+  // NOTE: The non-pinned part of the cache is deliberately not cleared here.
+  // The cache entries of operations that are affected by the update can't be
+  // hit anymore, because the index of the last snapshot that changed their
+  // predicates is part of the cache key (see
+  // `Operation::getLocatedTriplesSnapshotIndexForCaching`). The entries of all
+  // other operations remain valid, and the stale ones are eventually evicted
+  // by the LRU policy. Pinned entries are never evicted, and we can't tell
+  // which of them are stale, so they are all removed.
+  cache_.clearPinnedOnly();
 
   return createResponseMetadataForUpdate(requestTimer, index_, deltaTriples,
                                          plannedUpdate, qet, countBefore,
@@ -1027,6 +1225,82 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   co_return;
 }
 
+// ____________________________________________________________________________
+CPP_template_def(typename RequestT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>) json
+    Server::processBatchedInsertImpl(
+        const RequestT& request, const GraphOrDefault& graph,
+        const ad_utility::Timer& requestTimer,
+        const ad_utility::SharedCancellationHandle& cancellationHandle,
+        const Index& index, QueryResultCache& cache,
+        DeltaTriples& deltaTriples) {
+  DeltaTriplesCount countBefore = deltaTriples.getCounts();
+  // Like for all other updates, the pinned entries are removed from the cache
+  // (see `processUpdateImpl`). This is also required if the request fails,
+  // because the batches before the error remain inserted.
+  absl::Cleanup clearPinnedEntries{[&cache] { cache.clearPinnedOnly(); }};
+  UpdateMetadata updateMetadata = GraphStoreProtocol::insertInBatches(
+      request, graph, index, deltaTriples, cancellationHandle);
+  DeltaTriplesCount countAfter = deltaTriples.getCounts();
+  LOG(INFO) << "Done processing batched insert"
+            << ", total time was " << requestTimer.msecs().count() << " ms"
+            << std::endl;
+  json response;
+  response["update"] =
+      absl::StrCat("Graph Store POST Operation (in batches)\n",
+                   ad_utility::truncateOperationString(request.body()));
+  response["status"] = "OK";
+  response["warnings"] = std::vector<std::string>{
+      "SPARQL 1.1 Update for QLever is experimental."};
+  addUpdateStatisticsToResponse(response, requestTimer, index, deltaTriples,
+                                countBefore, updateMetadata, countAfter);
+  return response;
+}
+
+// ____________________________________________________________________________
+CPP_template_def(typename RequestT, typename ResponseT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>)
+    Awaitable<void> Server::processBatchedInsert(
+        GraphOrDefault graph, const ad_utility::Timer& requestTimer,
+        const RequestT& request, ResponseT&& send) {
+  // The batches that have already been inserted can't be rolled back, so the
+  // insertion is not cancellable (in particular, it has no timeout).
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  // Like all other updates, the insertion runs on the `updateThreadPool_`,
+  // which serializes it with all other updates.
+  auto coroutine = computeInNewThread(
+      updateThreadPool_,
+      [this, &graph, &requestTimer, &request, &cancellationHandle]() {
+        // If the body contains a syntax error, the batches before the error
+        // have already been inserted. The error is only rethrown after
+        // `modify` has returned, so that the snapshot is consistent with the
+        // delta triples.
+        std::exception_ptr error;
+        auto response = index_.deltaTriplesManager().modify<json>(
+            [this, &graph, &requestTimer, &request, &cancellationHandle,
+             &error](DeltaTriples& deltaTriples) {
+              try {
+                return processBatchedInsertImpl(request, graph, requestTimer,
+                                                cancellationHandle, index_,
+                                                cache_, deltaTriples);
+              } catch (...) {
+                error = std::current_exception();
+                return json{};
+              }
+            });
+        if (error) {
+          std::rethrow_exception(error);
+        }
+        return response;
+      },
+      cancellationHandle);
+  auto response = co_await std::move(coroutine);
+  co_await send(
+      ad_utility::httpUtils::createJsonResponse(std::move(response), request));
+  co_return;
+}
+
 // ____________________________________________________________________________
 CPP_template_def(typename VisitorT, typename RequestT, typename ResponseT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
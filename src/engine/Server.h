@@ -16,8 +16,11 @@
 #include "engine/Engine.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryScheduler.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/Index.h"
+#include "parser/ParsedQueryCache.h"
+#include "parser/PreparedQueries.h"
 #include "util/AllocatorWithLimit.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/ParseException.h"
@@ -67,6 +70,9 @@ class Server {
   // Get server statistics.
   json composeStatsJson() const;
   json composeCacheStatsJson() const;
+  // Get all the metrics (see `util/Metrics.h`) in the text format of
+  // Prometheus.
+  std::string composeMetrics() const;
 
   // Helper struct bundling a parsed query with a query execution tree.
   struct PlannedQuery {
@@ -79,6 +85,10 @@ class Server {
   unsigned short port_;
   std::string accessToken_;
   QueryResultCache cache_;
+  // The size is set from the runtime parameters in the constructor.
+  ParsedQueryCache parsedQueryCache_{0};
+  // The size is set from the runtime parameters in the constructor.
+  PreparedQueries preparedQueries_{0};
   ad_utility::AllocatorWithLimit<Id> allocator_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   Index index_;
@@ -99,6 +109,10 @@ class Server {
   /// Executor with a single thread that is used to run timers asynchronously.
   boost::asio::static_thread_pool timerExecutor_{1};
 
+  // Decides when a query (after its planning) may be executed, see
+  // `QueryScheduler`.
+  QueryScheduler queryScheduler_;
+
   template <typename T>
   using Awaitable = boost::asio::awaitable<T>;
 
@@ -163,7 +177,8 @@ class Server {
           ParsedQuery&& query, const ad_utility::Timer& requestTimer,
           ad_utility::SharedCancellationHandle cancellationHandle,
           QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery);
+          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery,
+          QueryScheduler::Request schedulingRequest);
   // For an executed update create a json with some stats on the update (timing,
   // number of changed triples, etc.).
   static json createResponseMetadataForUpdate(
@@ -173,6 +188,15 @@ class Server {
       const UpdateMetadata& updateMetadata,
       const DeltaTriplesCount& countAfter);
   FRIEND_TEST(ServerTest, createResponseMetadata);
+  // Add the statistics that are common to all updates (the number of delta
+  // triples before and after, the timing, and the located triples) to the
+  // `response`.
+  static void addUpdateStatisticsToResponse(
+      json& response, const ad_utility::Timer& requestTimer,
+      const Index& index, const DeltaTriples& deltaTriples,
+      const DeltaTriplesCount& countBefore,
+      const UpdateMetadata& updateMetadata,
+      const DeltaTriplesCount& countAfter);
   // Do the actual execution of an update.
   CPP_template(typename RequestT, typename ResponseT)(
       requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -182,6 +206,24 @@ class Server {
           ad_utility::SharedCancellationHandle cancellationHandle,
           QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
           TimeLimit timeLimit, std::optional<PlannedQuery>& plannedUpdate);
+  // Insert the triples from the body of a Graph Store Protocol POST request in
+  // batches (see `GraphStoreProtocol::insertInBatches`).
+  CPP_template(typename RequestT, typename ResponseT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>)
+      Awaitable<void> processBatchedInsert(
+          GraphOrDefault graph, const ad_utility::Timer& requestTimer,
+          const RequestT& request, ResponseT&& send);
+  // The part of `processBatchedInsert` that requires exclusive access to the
+  // `deltaTriples`. Also removes the pinned entries from the `cache`.
+  CPP_template(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>) static json
+      processBatchedInsertImpl(
+          const RequestT& request, const GraphOrDefault& graph,
+          const ad_utility::Timer& requestTimer,
+          const ad_utility::SharedCancellationHandle& cancellationHandle,
+          const Index& index, QueryResultCache& cache,
+          DeltaTriples& deltaTriples);
+  FRIEND_TEST(ServerTest, processBatchedInsertImpl);
 
   // Determine media type candidates to be used for the result. Media types are
   // determined (in this order) by the current action (e.g.,
@@ -197,6 +239,16 @@ class Server {
   static std::pair<bool, bool> determineResultPinning(
       const ad_utility::url_parser::ParamValueMap& params);
   FRIEND_TEST(ServerTest, determineResultPinning);
+  // Determine the priority and the client of a query for the `QueryScheduler`
+  // from the URL parameters "priority" and "client-id", or (if these are not
+  // given) from the HTTP headers "QLever-Priority" and "QLever-Client-Id". The
+  // priority "high" requires a valid access token.
+  CPP_template(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>) static
+      QueryScheduler::Request determineSchedulingRequest(
+          const ad_utility::url_parser::ParamValueMap& params,
+          const RequestT& request, bool accessTokenOk);
+  FRIEND_TEST(ServerTest, determineSchedulingRequest);
   //  Prepare the execution of an operation
   auto prepareOperation(std::string_view operationName,
                         std::string_view operationSPARQL,
@@ -83,6 +83,9 @@ class Sort : public Operation {
   }
 
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 };
 
 #endif  // QLEVER_SRC_ENGINE_SORT_H
@@ -43,8 +43,12 @@ class StripColumns : public Operation {
   // each child class.
   std::vector<QueryExecutionTree*> getChildren() override;
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
   std::string getDescriptor() const override;
   size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
   size_t getCostEstimate() override;
 
@@ -24,6 +24,7 @@
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
 #include "util/Exception.h"
 
 // _____________________________________________________________________________
@@ -262,6 +263,40 @@ std::string TransitivePathBase::getCacheKeyImpl() const {
   return std::move(os).str();
 }
 
+// _____________________________________________________________________________
+const ReachabilityIndex* TransitivePathBase::getReachabilityIndex(
+    const TransitivePathSide& startSide) const {
+  // The index contains the paths of arbitrary length in the union of all
+  // graphs. If both sides are unbound, all the paths have to be enumerated
+  // anyway, so the index has no benefit.
+  if (minDist_ > 1 || maxDist_ < std::numeric_limits<size_t>::max() ||
+      activeGraphs_.has_value() || graphVariable_.has_value() ||
+      startSide.isUnboundVariable()) {
+    return nullptr;
+  }
+  auto scan =
+      std::dynamic_pointer_cast<IndexScan>(subtree_->getRootOperation());
+  if (scan == nullptr || scan->numVariables() != 2 ||
+      !scan->subject().isVariable() || !scan->object().isVariable() ||
+      !scan->additionalColumns().empty() ||
+      scan->graphsToFilter().has_value()) {
+    return nullptr;
+  }
+  const auto& index = getIndex();
+  auto predicate =
+      scan->predicate().toValueId(index.getVocab(), index.encodedIriManager());
+  if (!predicate.has_value() ||
+      locatedTriplesSnapshot().versions_->lastChangeOfPredicate(
+          predicate.value()) != 0) {
+    return nullptr;
+  }
+  // The edges go from the subject to the object of the scan, if the start
+  // side is the object, the reversed index is needed.
+  bool reversed = startSide.subCol_ !=
+                  subtree_->getVariableColumn(scan->subject().getVariable());
+  return index.getImpl().getReachabilityIndex(predicate.value(), reversed);
+}
+
 // _____________________________________________________________________________
 std::string TransitivePathBase::getDescriptor() const {
   std::ostringstream os;
@@ -13,6 +13,7 @@
 
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
+#include "index/ReachabilityIndex.h"
 
 using TreeAndCol = std::pair<std::shared_ptr<QueryExecutionTree>, size_t>;
 struct TransitivePathSide {
@@ -189,6 +190,14 @@ class TransitivePathBase : public Operation {
    */
   std::pair<TransitivePathSide&, TransitivePathSide&> decideDirection();
 
+  // Return the precomputed `ReachabilityIndex` (see
+  // `IndexImpl::getReachabilityIndex`) that can replace the hull computation
+  // from the given `startSide`, or `nullptr` if there is no such index or if it
+  // can't be used for this operation (for example, because the path has a
+  // bounded length or the predicate was changed by an update).
+  const ReachabilityIndex* getReachabilityIndex(
+      const TransitivePathSide& startSide) const;
+
   /**
    * @brief Fill the given table with the transitive hull and use the
    * startSideTable to fill in the rest of the columns.
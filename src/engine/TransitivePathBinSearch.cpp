@@ -14,14 +14,19 @@
 // _____________________________________________________________________________
 BinSearchMap::BinSearchMap(ql::span<const Id> startIds,
                            ql::span<const Id> targetIds,
-                           const std::optional<ql::span<const Id>>& graphIds)
+                           const std::optional<ql::span<const Id>>& graphIds,
+                           std::shared_ptr<const CsrGraph> csrGraph)
     : startIds_{startIds},
       targetIds_{targetIds},
       graphIds_{graphIds.has_value() ? graphIds.value() : ql::span<const Id>{}},
       // Set size to zero if graphs are active to avoid undefined behaviour in
       // case we forget to call `setActiveGraph`.
-      sizeOfActiveGraph_{graphIds.has_value() ? 0 : startIds_.size()} {
+      sizeOfActiveGraph_{graphIds.has_value() ? 0 : startIds_.size()},
+      csrGraph_{std::move(csrGraph)} {
   AD_CORRECTNESS_CHECK(startIds.size() == targetIds.size());
+  AD_CORRECTNESS_CHECK(csrGraph_ == nullptr ||
+                       (!graphIds.has_value() &&
+                        csrGraph_->numEdges() == startIds.size()));
   AD_CORRECTNESS_CHECK(startIds.size() == graphIds_.size() ||
                        !graphIds.has_value());
   if (graphIds.has_value()) {
@@ -34,6 +39,9 @@ BinSearchMap::BinSearchMap(ql::span<const Id> startIds,
 
 // _____________________________________________________________________________
 ql::span<const Id> BinSearchMap::successors(Id node) const {
+  if (csrGraph_ != nullptr) {
+    return csrGraph_->successors(node);
+  }
   auto range = ql::ranges::equal_range(
       startIds_.subspan(offsetOfActiveGraph_, sizeOfActiveGraph_), node);
 
@@ -48,7 +56,11 @@ IdWithGraphs BinSearchMap::getEquivalentIdAndMatchingGraphs(Id node) const {
   if (graphIds_.empty()) {
     // We fill the graph id with undefined here, because it's supposed to be
     // unused, and `setGraphId` is no-op in this case using this value.
-    if (node.isUndefined()) {
+    if (node.isUndefined() && csrGraph_ != nullptr) {
+      for (Id id : csrGraph_->nodes()) {
+        result.emplace_back(id, Id::makeUndefined());
+      }
+    } else if (node.isUndefined()) {
       for (Id id : startIds_) {
         if (result.empty() || result.back().first != id) {
           result.emplace_back(id, Id::makeUndefined());
@@ -113,11 +125,16 @@ TransitivePathBinSearch::TransitivePathBinSearch(
 
 // _____________________________________________________________________________
 BinSearchMap TransitivePathBinSearch::setupEdgesMap(
-    const IdTable& dynSub, const TransitivePathSide& startSide,
+    const Result& sub, const TransitivePathSide& startSide,
     const TransitivePathSide& targetSide) const {
   AD_CORRECTNESS_CHECK(!graphVariable_.has_value());
+  const IdTable& dynSub = sub.idTable();
+  auto csrGraph = getCsrGraphOfChild(*subtree_, sub, startSide.subCol_,
+                                     targetSide.subCol_);
+  runtimeInfo().addDetail("csr-adjacency", csrGraph != nullptr);
   return BinSearchMap{dynSub.getColumn(startSide.subCol_),
-                      dynSub.getColumn(targetSide.subCol_), std::nullopt};
+                      dynSub.getColumn(targetSide.subCol_), std::nullopt,
+                      std::move(csrGraph)};
 }
 
 // _____________________________________________________________________________
@@ -11,6 +11,7 @@
 
 #include <memory>
 
+#include "engine/CsrGraph.h"
 #include "engine/Operation.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/TransitivePathImpl.h"
@@ -47,11 +48,15 @@ class BinSearchMap {
   // Set the bounds of the currently active graph.
   size_t offsetOfActiveGraph_ = 0;
   size_t sizeOfActiveGraph_;
+  // If set, the successors are looked up in this adjacency of the same edges
+  // instead of the `startIds_`. Only supported without graphs.
+  std::shared_ptr<const CsrGraph> csrGraph_;
 
  public:
   BinSearchMap(
       ql::span<const Id> startIds, ql::span<const Id> targetIds,
-      const std::optional<ql::span<const Id>>& graphIds = std::nullopt);
+      const std::optional<ql::span<const Id>>& graphIds = std::nullopt,
+      std::shared_ptr<const CsrGraph> csrGraph = nullptr);
 
   /**
    * @brief Return the successors for the given id.
@@ -105,7 +110,7 @@ class TransitivePathBinSearch : public TransitivePathImpl<BinSearchMap> {
 
   // initialize the map from the subresult
   BinSearchMap setupEdgesMap(
-      const IdTable& dynSub, const TransitivePathSide& startSide,
+      const Result& sub, const TransitivePathSide& startSide,
       const TransitivePathSide& targetSide) const override;
 
   // We store the subtree in two different orderings such that the appropriate
@@ -66,8 +66,9 @@ void HashMapWrapper::setGraphId(Id graphId) {
 
 // _____________________________________________________________________________
 HashMapWrapper TransitivePathHashMap::setupEdgesMap(
-    const IdTable& sub, const TransitivePathSide& startSide,
+    const Result& subResult, const TransitivePathSide& startSide,
     const TransitivePathSide& targetSide) const {
+  const IdTable& sub = subResult.idTable();
   decltype(auto) startCol = sub.getColumn(startSide.subCol_);
   decltype(auto) targetCol = sub.getColumn(targetSide.subCol_);
   AD_CORRECTNESS_CHECK(!graphVariable_.has_value());
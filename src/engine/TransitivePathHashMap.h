@@ -96,7 +96,7 @@ class TransitivePathHashMap : public TransitivePathImpl<HashMapWrapper> {
 
   // Initialize the map from the subresult.
   HashMapWrapper setupEdgesMap(
-      const IdTable& sub, const TransitivePathSide& startSide,
+      const Result& subResult, const TransitivePathSide& startSide,
       const TransitivePathSide& targetSide) const override;
 };
 
@@ -7,10 +7,15 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <utility>
 
 #include "engine/TransitivePathBase.h"
+#include "global/RuntimeParameters.h"
 #include "util/Timer.h"
+#include "util/jthread.h"
 
 namespace detail {
 
@@ -48,6 +53,14 @@ template <typename T>
 class TransitivePathImpl : public TransitivePathBase {
   using TableColumnWithVocab = detail::TableColumnWithVocab<ql::span<const Id>>;
 
+  // The number of start nodes per thread that are processed together, see
+  // `transitiveHull`.
+  static constexpr size_t BATCH_SIZE_PER_THREAD = 64;
+
+  // If set, the connected nodes are looked up in this precomputed index
+  // instead of searching the graph, see `getReachabilityIndex`.
+  const ReachabilityIndex* reachabilityIndex_ = nullptr;
+
  public:
   using TransitivePathBase::TransitivePathBase;
 
@@ -70,7 +83,7 @@ class TransitivePathImpl : public TransitivePathBase {
       std::shared_ptr<const Result> startSideResult, bool yieldOnce) const {
     ad_utility::Timer timer{ad_utility::Timer::Started};
 
-    auto edges = setupEdgesMap(sub->idTable(), startSide, targetSide);
+    auto edges = setupEdgesMap(*sub, startSide, targetSide);
     auto nodes = setupNodes(startSide, std::move(startSideResult));
     // Setup nodes returns a generator, so this time measurement won't include
     // the time for each iteration, but every iteration step should have
@@ -108,7 +121,7 @@ class TransitivePathImpl : public TransitivePathBase {
                                           bool yieldOnce) const {
     ad_utility::Timer timer{ad_utility::Timer::Started};
 
-    auto edges = setupEdgesMap(sub->idTable(), startSide, targetSide);
+    auto edges = setupEdgesMap(*sub, startSide, targetSide);
     auto nodes = setupNodes(sub->idTable(), startSide, edges);
 
     runtimeInfo().addDetail("Initialization time", timer.msecs());
@@ -143,10 +156,20 @@ class TransitivePathImpl : public TransitivePathBase {
    */
   Result computeResult(bool requestLaziness) override {
     auto [startSide, targetSide] = decideDirection();
+    // With a precomputed reachability index, the graph doesn't have to be
+    // traversed, so its edges are not computed at all.
+    reachabilityIndex_ = getReachabilityIndex(startSide);
+    runtimeInfo().addDetail("reachability-index",
+                            reachabilityIndex_ != nullptr);
     // In order to traverse the graph represented by this result, we need random
     // access across the whole table, so it doesn't make sense to lazily compute
     // the result.
-    std::shared_ptr<const Result> subRes = subtree_->getResult(false);
+    std::shared_ptr<const Result> subRes =
+        reachabilityIndex_ != nullptr
+            ? std::make_shared<const Result>(
+                  IdTable{subtree_->getResultWidth(), allocator()},
+                  std::vector<ColumnIndex>{}, LocalVocab{})
+            : subtree_->getResult(false);
 
     if (startSide.isBoundVariable()) {
       std::shared_ptr<const Result> sideRes =
@@ -168,7 +191,9 @@ class TransitivePathImpl : public TransitivePathBase {
   }
 
   /**
-   * @brief Depth-first search to find connected nodes in the graph.
+   * @brief Breadth-first search to find connected nodes in the graph, i.e. the
+   * nodes that can be reached from the `startNode` with at least `minDist_`
+   * and at most `maxDist_` steps.
    * @param edges The adjacency lists, mapping Ids (nodes) to their connected
    * Ids.
    * @param startNode The node to start the search from.
@@ -178,33 +203,134 @@ class TransitivePathImpl : public TransitivePathBase {
    */
   Set findConnectedNodes(const T& edges, Id startNode,
                          const std::optional<Id>& target) const {
-    std::vector<std::pair<Id, size_t>> stack;
-    ad_utility::HashSetWithMemoryLimit<Id> marks{allocator()};
+    if (reachabilityIndex_ != nullptr) {
+      return findConnectedNodesWithIndex(startNode, target);
+    }
     Set connectedNodes{allocator()};
-    stack.emplace_back(startNode, 0);
-
-    while (!stack.empty()) {
+    // The nodes that have been reached with at least `minDist_` steps. Each of
+    // them only has to be expanded once, with the minimal number of steps.
+    ad_utility::HashSetWithMemoryLimit<Id> marks{allocator()};
+    // Below `minDist_`, a node can be reached with different numbers of steps,
+    // and has to be expanded for each of them. The nodes are then only
+    // deduplicated within the same number of steps.
+    ad_utility::HashSetWithMemoryLimit<Id> marksOfCurrentStep{allocator()};
+    // The nodes that are reached with exactly `steps` steps.
+    std::vector<Id> frontier{startNode};
+    std::vector<Id> nextFrontier;
+    if (minDist_ == 0) {
+      marks.insert(startNode);
+    }
+    for (size_t steps = 0; !frontier.empty(); ++steps) {
       checkCancellation();
-      auto [node, steps] = stack.back();
-      stack.pop_back();
-
-      if (steps <= maxDist_ && !marks.contains(node)) {
-        if (steps >= minDist_) {
-          marks.insert(node);
+      if (steps >= minDist_) {
+        for (Id node : frontier) {
           if (!target.has_value() || node == target.value()) {
             connectedNodes.insert(node);
           }
         }
-
-        const auto& successors = edges.successors(node);
-        for (auto successor : successors) {
-          stack.emplace_back(successor, steps + 1);
+      }
+      if (steps >= maxDist_) {
+        break;
+      }
+      auto& seen = steps + 1 >= minDist_ ? marks : marksOfCurrentStep;
+      marksOfCurrentStep.clear();
+      nextFrontier.clear();
+      for (Id node : frontier) {
+        for (Id successor : edges.successors(node)) {
+          if (seen.insert(successor).second) {
+            nextFrontier.push_back(successor);
+          }
         }
       }
+      std::swap(frontier, nextFrontier);
+    }
+    return connectedNodes;
+  }
+
+  // Same as `findConnectedNodes`, but the nodes are looked up in the
+  // `reachabilityIndex_`. This requires that `minDist_` is at most 1 and that
+  // `maxDist_` is unbounded (see `getReachabilityIndex`).
+  Set findConnectedNodesWithIndex(Id startNode,
+                                  const std::optional<Id>& target) const {
+    AD_CORRECTNESS_CHECK(minDist_ <= 1);
+    checkCancellation();
+    Set connectedNodes{allocator()};
+    if (target.has_value()) {
+      if ((minDist_ == 0 && target.value() == startNode) ||
+          reachabilityIndex_->reaches(startNode, target.value())) {
+        connectedNodes.insert(target.value());
+      }
+      return connectedNodes;
+    }
+    if (minDist_ == 0) {
+      connectedNodes.insert(startNode);
     }
+    reachabilityIndex_->forEachReachable(
+        startNode, [&connectedNodes](Id node) { connectedNodes.insert(node); });
     return connectedNodes;
   }
 
+  // Compute `findConnectedNodes` for each of the `startNodes` (with the
+  // `target` of `transitiveHull`), the searches for different start nodes run
+  // concurrently on up to `numThreads` threads.
+  std::vector<std::optional<Set>> findConnectedNodesForBatch(
+      const T& edges, const std::vector<Id>& startNodes,
+      const std::optional<Id>& target, bool sameVariableOnBothSides,
+      size_t numThreads) const {
+    std::vector<std::optional<Set>> result(startNodes.size());
+    auto compute = [&](size_t i) {
+      Id startNode = startNodes[i];
+      result[i] = findConnectedNodes(
+          edges, startNode,
+          sameVariableOnBothSides ? std::optional{startNode} : target);
+    };
+    numThreads = std::min(numThreads, startNodes.size());
+    if (numThreads <= 1) {
+      for (size_t i = 0; i < startNodes.size(); ++i) {
+        compute(i);
+      }
+      return result;
+    }
+    // The work is distributed dynamically, because the sizes of the hulls of
+    // different start nodes can differ a lot.
+    std::atomic<size_t> nextIndex = 0;
+    std::atomic<bool> failed = false;
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    {
+      std::vector<ad_utility::JThread> threads;
+      threads.reserve(numThreads);
+      for (size_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+          try {
+            for (size_t i = nextIndex++; i < startNodes.size() && !failed;
+                 i = nextIndex++) {
+              compute(i);
+            }
+          } catch (...) {
+            exceptions[t] = std::current_exception();
+            failed = true;
+          }
+        });
+      }
+    }
+    for (const auto& exception : exceptions) {
+      if (exception) {
+        std::rethrow_exception(exception);
+      }
+    }
+    return result;
+  }
+
+  // The number of threads for the computation of the transitive hull.
+  static size_t getNumThreads() {
+    size_t numThreads =
+        RuntimeParameters().get<"transitive-path-max-num-threads">();
+    size_t hardwareConcurrency =
+        std::max(size_t{std::thread::hardware_concurrency()}, size_t{1});
+    return numThreads == 0 ? hardwareConcurrency
+                           : std::min(numThreads, hardwareConcurrency);
+  }
+
   /**
    * @brief Compute the transitive hull starting at the given nodes,
    * using the given Map.
@@ -237,20 +363,37 @@ class TransitivePathImpl : public TransitivePathBase {
                   index.getVocab(), targetHelper, index.encodedIriManager())};
     bool sameVariableOnBothSides =
         !targetId.has_value() && lhs_.value_ == rhs_.value_;
+    // The start nodes are processed in batches. Within a batch, the hulls of
+    // the different start nodes are computed concurrently, and they are then
+    // yielded in the order of the start nodes. This way, the result is still
+    // computed lazily (one batch at a time).
+    const size_t numThreads = getNumThreads();
+    const size_t batchSize = numThreads * BATCH_SIZE_PER_THREAD;
+    runtimeInfo().addDetail("num-threads", numThreads);
+    std::vector<Id> batch;
+    batch.reserve(batchSize);
     for (auto&& tableColumn : startNodes) {
       timer.cont();
       LocalVocab mergedVocab = std::move(tableColumn.vocab_);
       mergedVocab.mergeWith(edgesVocab);
       size_t currentRow = 0;
-      for (Id startNode : tableColumn.startNodes_) {
-        if (sameVariableOnBothSides) {
-          targetId = startNode;
+      auto it = ql::ranges::begin(tableColumn.startNodes_);
+      auto end = ql::ranges::end(tableColumn.startNodes_);
+      while (it != end) {
+        batch.clear();
+        for (; it != end && batch.size() < batchSize; ++it) {
+          batch.push_back(*it);
         }
-        Set connectedNodes = findConnectedNodes(edges, startNode, targetId);
-        if (!connectedNodes.empty()) {
+        auto hulls = findConnectedNodesForBatch(
+            edges, batch, targetId, sameVariableOnBothSides, numThreads);
+        for (size_t i = 0; i < batch.size(); ++i, ++currentRow) {
+          Set& connectedNodes = hulls[i].value();
+          if (connectedNodes.empty()) {
+            continue;
+          }
           runtimeInfo().addDetail("Hull time", timer.msecs());
           timer.stop();
-          co_yield NodeWithTargets{startNode, std::move(connectedNodes),
+          co_yield NodeWithTargets{batch[i], std::move(connectedNodes),
                                    mergedVocab.clone(), tableColumn.payload_,
                                    currentRow};
           timer.cont();
@@ -259,7 +402,6 @@ class TransitivePathImpl : public TransitivePathBase {
             mergedVocab = LocalVocab{};
           }
         }
-        currentRow++;
       }
       timer.stop();
     }
@@ -290,6 +432,13 @@ class TransitivePathImpl : public TransitivePathBase {
     LocalVocab helperVocab;
     Id startId = TripleComponent{startSide.value_}.toValueId(
         getIndex().getVocab(), helperVocab, getIndex().encodedIriManager());
+    if (reachabilityIndex_ != nullptr) {
+      // The `edges` are empty in this case.
+      if (reachabilityIndex_->contains(startId)) {
+        result.insert(startId);
+      }
+      return result;
+    }
     // Make sure we retrieve the Id from an IndexScan, so we don't have to pass
     // this LocalVocab around. If it's not present then no result needs to be
     // returned anyways.
@@ -355,7 +504,7 @@ class TransitivePathImpl : public TransitivePathBase {
         }));
   }
 
-  virtual T setupEdgesMap(const IdTable& dynSub,
+  virtual T setupEdgesMap(const Result& sub,
                           const TransitivePathSide& startSide,
                           const TransitivePathSide& targetSide) const = 0;
 
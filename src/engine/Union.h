@@ -37,11 +37,15 @@ class Union : public Operation {
 
  protected:
   virtual std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   virtual std::string getDescriptor() const override;
 
   virtual size_t getResultWidth() const override;
+  bool canYieldLazyResult() const override { return true; }
 
   virtual std::vector<ColumnIndex> resultSortedOn() const override;
 
@@ -25,6 +25,9 @@ class Values : public Operation {
 
  protected:
   std::string getCacheKeyImpl() const override;
+  size_t getLocatedTriplesSnapshotIndexForCachingImpl() const override {
+    return getLocatedTriplesSnapshotIndexForCachingOfChildren();
+  }
 
  public:
   virtual std::string getDescriptor() const override;
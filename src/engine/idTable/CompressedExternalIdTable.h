@@ -21,6 +21,8 @@
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
 #include "util/TransparentFunctors.h"
 #include "util/Views.h"
 
@@ -56,6 +58,13 @@ class CompressedExternalIdTableWriter {
     size_t compressedSize_;
     size_t uncompressedSize_;
     size_t offsetInFile_;
+
+    // Allow this type to be trivially serializable.
+    CPP_template(typename T, typename U)(
+        requires ql::concepts::same_as<T, CompressedBlockMetadata>) friend std::
+        true_type allowTrivialSerialization(T, U&&) {
+      return {};
+    }
   };
 
   // The filename and actual file to which the `IdTable` is written .
@@ -85,7 +94,26 @@ class CompressedExternalIdTableWriter {
   // contents.
   size_t numActiveGenerators_ = 0;
 
+  // If false, the underlying file is kept when this writer is destroyed (see
+  // `persist()`).
+  bool deleteFileOnDestruction_ = true;
+
  public:
+  // The metadata that is required to read a file again that was written by a
+  // `CompressedExternalIdTableWriter` (see `persist()` and the corresponding
+  // constructor below).
+  struct PersistedMetadata {
+    std::vector<std::vector<CompressedBlockMetadata>> blocksPerColumn_;
+    std::vector<size_t> startOfSingleIdTables_;
+    size_t blockSizeUncompressedInBytes_ = 0;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(PersistedMetadata) {
+      serializer | arg.blocksPerColumn_;
+      serializer | arg.startOfSingleIdTables_;
+      serializer | arg.blockSizeUncompressedInBytes_;
+    }
+  };
+
   // Constructor. The file at `filename` will be overwritten. Each of the
   // `IdTables` that will be passed in has to have exactly `numCols` columns.
   explicit CompressedExternalIdTableWriter(
@@ -98,10 +126,49 @@ class CompressedExternalIdTableWriter {
         allocator_{std::move(allocator)},
         blockSizeUncompressed_(blockSizeUncompressed) {}
 
-  // Destructor. Deletes the stored file.
+  // Constructor that reopens the file at `filename`, which has previously been
+  // written by a writer on which `persist()` was called and which returned the
+  // `metadata`. The file is only read, and not deleted on destruction.
+  CompressedExternalIdTableWriter(std::string filename,
+                                  PersistedMetadata metadata,
+                                  ad_utility::AllocatorWithLimit<Id> allocator)
+      : filename_{std::move(filename)},
+        file_{filename_, "r"},
+        blocksPerColumn_(std::move(metadata.blocksPerColumn_)),
+        startOfSingleIdTables_(std::move(metadata.startOfSingleIdTables_)),
+        allocator_{std::move(allocator)},
+        blockSizeUncompressed_{ad_utility::MemorySize::bytes(
+            metadata.blockSizeUncompressedInBytes_)},
+        deleteFileOnDestruction_{false} {
+    AD_CONTRACT_CHECK(!blocksPerColumn_.empty());
+  }
+
+  // Destructor. Deletes the stored file, unless it was persisted.
   ~CompressedExternalIdTableWriter() {
     file_.wlock()->close();
-    ad_utility::deleteFile(filename_);
+    if (deleteFileOnDestruction_) {
+      ad_utility::deleteFile(filename_);
+    }
+  }
+
+  // Flush all the written `IdTable`s to the file, keep the file when this
+  // writer is destroyed, and return the metadata that is needed to reopen the
+  // file. The file then has to be deleted manually.
+  PersistedMetadata persist() {
+    AD_CONTRACT_CHECK(numActiveGenerators_ == 0);
+    file_.wlock()->flush();
+    deleteFileOnDestruction_ = false;
+    return {blocksPerColumn_, startOfSingleIdTables_,
+            blockSizeUncompressed_.getBytes()};
+  }
+
+  // The total number of rows of all the stored `IdTable`s.
+  size_t numRows() const {
+    size_t numBytes = 0;
+    for (const auto& block : blocksPerColumn_.at(0)) {
+      numBytes += block.uncompressedSize_;
+    }
+    return numBytes / sizeof(Id);
   }
 
   // Simple getters for the stored allocator and the number of columns;
@@ -323,6 +390,22 @@ class CompressedExternalIdTableBase {
     this->currentBlock_.reserve(blocksize_);
     AD_CONTRACT_CHECK(NumStaticCols == 0 || NumStaticCols == numCols);
   }
+
+  // Reopen the contents that were previously persisted to the file at
+  // `filename` (see `CompressedExternalIdTable::persist()`).
+  explicit CompressedExternalIdTableBase(
+      std::string filename, size_t numCols, ad_utility::MemorySize memory,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      CompressedExternalIdTableWriter::PersistedMetadata metadata)
+      : currentBlock_{numCols, allocator},
+        numColumns_{numCols},
+        memory_{memory},
+        writer_{std::move(filename), std::move(metadata), allocator} {
+    AD_CONTRACT_CHECK(NumStaticCols == 0 || NumStaticCols == numCols);
+    AD_CONTRACT_CHECK(writer_.numColumns() == numCols);
+    numElementsPushed_ = writer_.numRows();
+    numBlocksPushed_ = numElementsPushed_ == 0 ? 0 : 1;
+  }
   // Add a single row to the input. The type of `row` needs to be something that
   // can be `push_back`ed to a `IdTable`.
   CPP_template(typename R)(
@@ -397,11 +480,11 @@ class CompressedExternalIdTableBase {
     if (!isFirstIteration_) {
       return numBlocksPushed_ != 0;
     }
-    // If we have pushed at least one (complete) block, then the last future
-    // from pushing a block is still in flight. If we have never pushed a block,
-    // then also the future cannot be valid.
-    AD_CORRECTNESS_CHECK((numBlocksPushed_ == 0) !=
-                         compressAndWriteFuture_.valid());
+    // If we have never pushed a block, then the future cannot be valid. Note:
+    // If we have pushed at least one block, then the future is typically still
+    // in flight, unless the contents were persisted.
+    AD_CORRECTNESS_CHECK(numBlocksPushed_ != 0 ||
+                         !compressAndWriteFuture_.valid());
     // Optimization for inputs that are smaller than the blocksize, do not use
     // the external file, but simply sort and return the single block.
     if (numBlocksPushed_ == 0) {
@@ -452,6 +535,32 @@ class CompressedExternalIdTable
       : CompressedExternalIdTable(std::move(filename), NumStaticCols, memory,
                                   std::move(allocator), blocksizeCompression) {}
 
+  // Reopen a table that was previously persisted to the file at `filename`
+  // (see `persist()` below). Only `getRows()` may be called on the result.
+  explicit CompressedExternalIdTable(
+      std::string filename, size_t numCols, ad_utility::MemorySize memory,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      CompressedExternalIdTableWriter::PersistedMetadata metadata)
+      : Base{std::move(filename), numCols, memory, std::move(allocator),
+             std::move(metadata)} {}
+
+  // Write all the rows that have been pushed so far to the underlying file,
+  // keep that file when this table is destroyed, and return the metadata that
+  // is needed to reopen the file via the constructor above. This is used for
+  // the checkpoints of the index build. Afterward, `getRows()` can still be
+  // called on this table, but no more rows may be pushed.
+  CompressedExternalIdTableWriter::PersistedMetadata persist() {
+    AD_CONTRACT_CHECK(this->isFirstIteration_);
+    if (!this->currentBlock_.empty()) {
+      this->pushBlock(std::move(this->currentBlock_));
+      this->resetCurrentBlock(false);
+    }
+    if (this->compressAndWriteFuture_.valid()) {
+      this->compressAndWriteFuture_.get();
+    }
+    return this->writer_.persist();
+  }
+
   // Transition from the input phase, where `push()` may be called, to the
   // output phase and return a generator that yields the elements of the
   // `IdTable in the order that they were `push`ed. This function may be called
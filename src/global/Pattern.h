@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "util/File.h"
 #include "util/Generator.h"
 #include "util/Iterators.h"
+#include "util/ReadOnlyMmapFile.h"
 #include "util/ResetWhenMoved.h"
 #include "util/Serializer/FileSerializer.h"
 #include "util/Serializer/SerializeVector.h"
@@ -108,10 +110,45 @@ class CompactVectorOfStrings {
   CompactVectorOfStrings(const CompactVectorOfStrings&) = delete;
   CompactVectorOfStrings(CompactVectorOfStrings&&) noexcept = default;
 
+  // Create a `CompactVectorOfStrings` that directly reads its contents from
+  // the memory-mapped `file`, starting at byte `offset`. The contents must
+  // have been written using the serialization of a `CompactVectorOfStrings` or
+  // a `CompactStringVectorWriter`. Nothing is copied to the heap (except for
+  // the offsets if they are not properly aligned in the file), which makes
+  // this much faster than the deserialization for large vectors, and allows
+  // several processes to share the same physical memory.
+  static CompactVectorOfStrings fromMmappedFile(
+      std::shared_ptr<const ad_utility::ReadOnlyMmapFile> file,
+      size_t offset = 0) {
+    AD_CONTRACT_CHECK(file != nullptr);
+    CompactVectorOfStrings result;
+    auto dataSize = file->read<uint64_t>(offset);
+    offset += sizeof(uint64_t);
+    result.mmapData_ = file->view<data_type>(offset, dataSize);
+    offset += dataSize * sizeof(data_type);
+    auto numOffsets = file->read<uint64_t>(offset);
+    offset += sizeof(uint64_t);
+    if (file->isAligned<offset_type>(offset)) {
+      result.mmapOffsets_ = file->view<offset_type>(offset, numOffsets);
+    } else {
+      auto bytes = file->view<char>(offset, numOffsets * sizeof(offset_type));
+      result.offsets_.resize(numOffsets);
+      std::memcpy(result.offsets_.data(), bytes.data(), bytes.size());
+      result.mmapOffsets_ = result.offsets_;
+    }
+    AD_CORRECTNESS_CHECK(result.mmapOffsets_.empty() ||
+                         result.mmapOffsets_.back() == dataSize);
+    result.mmapFile_ = std::move(file);
+    return result;
+  }
+
   // There is one more offset than the number of elements.
-  size_t size() const { return ready() ? offsets_.size() - 1 : 0; }
+  size_t size() const { return ready() ? offsets().size() - 1 : 0; }
 
-  bool ready() const { return !offsets_.empty(); }
+  bool ready() const { return !offsets().empty(); }
+
+  // Return true iff the contents are memory-mapped (see `fromMmappedFile`).
+  bool isMmapped() const { return mmapFile_ != nullptr; }
 
   /**
    * @brief operator []
@@ -120,9 +157,10 @@ class CompactVectorOfStrings {
    *         elements stored at the pointers target.
    */
   const value_type operator[](size_t i) const {
-    offset_type offset = offsets_[i];
-    const data_type* ptr = data_.data() + offset;
-    size_t size = offsets_[i + 1] - offset;
+    auto offsets = this->offsets();
+    offset_type offset = offsets[i];
+    const data_type* ptr = data().data() + offset;
+    size_t size = offsets[i + 1] - offset;
     return {ptr, size};
   }
 
@@ -141,13 +179,40 @@ class CompactVectorOfStrings {
 
   // Allow serialization via the ad_utility::serialization interface.
   AD_SERIALIZE_FRIEND_FUNCTION(CompactVectorOfStrings) {
+    if constexpr (ad_utility::serialization::ReadSerializer<S>) {
+      arg.mmapFile_.reset();
+      arg.mmapData_ = {};
+      arg.mmapOffsets_ = {};
+    } else if (arg.isMmapped()) {
+      // Memory-mapped contents are written in the same format.
+      auto data = arg.data();
+      auto offsets = arg.offsets();
+      serializer << std::vector<data_type>(data.begin(), data.end());
+      serializer << std::vector<offset_type>(offsets.begin(), offsets.end());
+      return;
+    }
     serializer | arg.data_;
     serializer | arg.offsets_;
   }
 
  private:
+  // Access to the actual contents, which are either stored in `data_` and
+  // `offsets_` or in the `mmapFile_`.
+  ql::span<const data_type> data() const {
+    return isMmapped() ? mmapData_ : ql::span<const data_type>{data_};
+  }
+  ql::span<const offset_type> offsets() const {
+    return isMmapped() ? mmapOffsets_ : ql::span<const offset_type>{offsets_};
+  }
+
   std::vector<data_type> data_;
   std::vector<offset_type> offsets_;
+  // Only set if the contents are memory-mapped, in which case `mmapData_` and
+  // `mmapOffsets_` point into the mapped file. (The `offsets_` are only used
+  // as a buffer when the offsets in the file are not properly aligned.)
+  std::shared_ptr<const ad_utility::ReadOnlyMmapFile> mmapFile_;
+  ql::span<const data_type> mmapData_;
+  ql::span<const offset_type> mmapOffsets_;
 };
 
 namespace detail {
@@ -176,7 +241,7 @@ struct CompactStringVectorWriter {
 
  public:
   explicit CompactStringVectorWriter(const std::string& filename)
-      : d_{{filename, "w"}} {
+      : d_{{removeExistingFile(filename), "w"}} {
     commonInitialization();
   }
 
@@ -236,6 +301,15 @@ struct CompactStringVectorWriter {
   }
 
  private:
+  // Remove the file at `filename` (if it exists) and return the `filename`.
+  // This makes sure that the file is newly created instead of being truncated,
+  // so a `CompactVectorOfStrings` that is still memory-mapped from a previous
+  // file with the same name stays valid.
+  static const std::string& removeExistingFile(const std::string& filename) {
+    ad_utility::deleteFile(filename, false);
+    return filename;
+  }
+
   // Has to be run by all the constructors
   void commonInitialization() {
     AD_CORRECTNESS_CHECK(d_.file_.isOpen());
@@ -107,6 +107,42 @@ inline auto& RuntimeParameters() {
         // Push joins into both children of unions if this leads to a cheaper
         // cost-estimate.
         Bool<"enable-distributive-union">{true},
+        // The maximal number of parsed queries that are kept by the server, so
+        // that queries that are sent repeatedly don't have to be parsed again.
+        // The value 0 disables this cache.
+        SizeT<"parsed-query-cache-max-num-entries">{1000},
+        // Parse simple SELECT queries with a hand-written parser instead of
+        // the (much slower) parser that is generated by ANTLR, see
+        // `SparqlFastPathParser`.
+        Bool<"use-sparql-fast-path-parser">{true},
+        // The maximal number of prepared queries that are kept by the server
+        // (see `PreparedQueries`). The value 0 disables prepared queries.
+        SizeT<"prepared-queries-max-num-entries">{10'000},
+        // The maximal number of threads that compute the transitive hulls of
+        // different start nodes of a transitive path concurrently. The value 0
+        // means that all the available cores are used.
+        SizeT<"transitive-path-max-num-threads">{8},
+        // The transitive path and the path search traverse a result in the
+        // compressed sparse row format (see `CsrGraph`) once the same result
+        // is traversed this many times, typically because it is stored in the
+        // query cache. The value 0 disables these adjacencies.
+        SizeT<"csr-adjacency-min-num-uses">{2},
+        // The maximal number of threads that the query planner uses to count
+        // the connected subgraphs of a query graph (for large values of the
+        // `query-planning-budget`) and to create the join candidates of the
+        // dynamic programming. The value 0 means that all the available cores
+        // are used.
+        SizeT<"query-planning-max-num-threads">{4},
+        // A lazy result that is currently computed is shared with the
+        // identical operations of other queries (see `LazyResultBroadcast`),
+        // as long as at most this much of the result has been computed. The
+        // value 0 disables the sharing.
+        MemorySizeParameter<"lazy-result-sharing-max-size">{5_MB},
+        // The maximal number of chunks of a shared lazy result that are
+        // buffered for the slower consumers. If a consumer is this many chunks
+        // ahead of the slowest consumer, the slowest consumer is detached and
+        // computes the rest of the result on its own.
+        SizeT<"lazy-result-sharing-max-num-chunks">{16},
     };
   }();
   return params;
@@ -16,6 +16,7 @@
 #include "index/LocatedTriples.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Generator.h"
+#include "util/Metrics.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/OverloadCallOperator.h"
 #include "util/ProgressBar.h"
@@ -933,6 +934,14 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
 CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     const CompressedBlockMetadata& blockMetaData,
     ColumnIndicesRef columnIndices) const {
+  using namespace ad_utility::metrics;
+  static auto& readHistogram = globalRegistry().histogram(
+      "qlever_index_block_read_duration_seconds",
+      "The time for reading a compressed block of the index from disk");
+  static auto& readBytes = globalRegistry().counter(
+      "qlever_index_block_read_bytes_total",
+      "The number of compressed bytes read from the index blocks");
+  ScopedTimer timer{readHistogram};
   CompressedBlock compressedBuffer;
   compressedBuffer.resize(columnIndices.size());
   // TODO<C++23> Use `ql::views::zip`
@@ -942,6 +951,7 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     auto& currentCol = compressedBuffer[i];
     currentCol.resize(offset.compressedSize_);
     file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+    readBytes.add(offset.compressedSize_);
   }
   return compressedBuffer;
 }
@@ -949,6 +959,11 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
 // ____________________________________________________________________________
 DecompressedBlock CompressedRelationReader::decompressBlock(
     const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
+  static auto& decompressionHistogram =
+      ad_utility::metrics::globalRegistry().histogram(
+          "qlever_index_block_decompression_duration_seconds",
+          "The time for decompressing a block of the index");
+  ad_utility::metrics::ScopedTimer timer{decompressionHistogram};
   DecompressedBlock decompressedBlock{compressedBlock.size(), allocator_};
   decompressedBlock.resize(numRowsToRead);
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
@@ -56,6 +56,18 @@ constexpr inline std::string_view PARTIAL_VOCAB_FILE_NAME =
     ".tmp.partial-vocabulary.";
 constexpr inline std::string_view PARTIAL_MMAP_IDS = ".tmp.partial-ids-mmap.";
 
+// ________________________________________________________________
+// The (unsorted) triples with their partial IDs during the index build.
+constexpr inline std::string_view UNSORTED_TRIPLES_FILE_NAME =
+    ".unsorted-triples.dat";
+// The metadata that is needed to resume an index build from the checkpoint
+// after the vocabulary has been merged.
+constexpr inline std::string_view CHECKPOINT_METADATA_FILE_NAME =
+    ".tmp.checkpoint-metadata.dat";
+// The manifest of the completed phases of an index build.
+constexpr inline std::string_view INDEX_BUILD_MANIFEST_FILE_NAME =
+    ".index-build-manifest.json";
+
 // ________________________________________________________________
 constexpr inline std::string_view TMP_BASENAME_COMPRESSION =
     ".tmp.for-prefix-compression";
@@ -74,6 +86,18 @@ constexpr inline size_t NUM_PARALLEL_ITEM_MAPS = 10;
 // parser is used.
 constexpr inline size_t NUM_PARALLEL_PARSER_THREADS = 8;
 
+// During the index building we typically have two permutations present at the
+// same time, as we directly push the triples from the first sorting to the
+// second sorting. We therefore have to adjust the amount of memory per external
+// sorter.
+constexpr inline size_t NUM_EXTERNAL_SORTERS_AT_SAME_TIME = 2u;
+
+// The number of threads that are used to process a batch of merged words
+// during the vocabulary merging (checking the order, finding duplicates, and
+// writing the mappings from partial to global IDs). The merging itself is
+// parallelized independently (see `BLOCKSIZE_VOCABULARY_MERGING`).
+constexpr inline size_t NUM_THREADS_VOCABULARY_MERGE = 8;
+
 // Increasing the following two constants increases the RAM usage without much
 // benefit to the performance.
 
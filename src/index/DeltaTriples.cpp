@@ -16,12 +16,13 @@
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/LocatedTriples.h"
+#include "util/Metrics.h"
 #include "util/Serializer/TripleSerializer.h"
 
 // ____________________________________________________________________________
-LocatedTriples::iterator& DeltaTriples::LocatedTripleHandles::forPermutation(
+size_t& DeltaTriples::LocatedTripleHandles::forPermutation(
     Permutation::Enum permutation) {
-  return handles_[static_cast<size_t>(permutation)];
+  return blockIndices_[static_cast<size_t>(permutation)];
 }
 
 // ____________________________________________________________________________
@@ -29,6 +30,38 @@ void DeltaTriples::clear() {
   triplesInserted_.clear();
   triplesDeleted_.clear();
   ql::ranges::for_each(locatedTriples(), &LocatedTriplesPerBlock::clear);
+  auto& versions = mutableVersions();
+  // Without delta triples, the results for the original index are valid again.
+  versions.lastChangePerPredicate_.clear();
+  versions.lastChange_ = 0;
+}
+
+// ____________________________________________________________________________
+size_t LocatedTriplesVersions::lastChangeOfPredicate(Id predicate) const {
+  auto it = lastChangePerPredicate_.find(predicate);
+  return it == lastChangePerPredicate_.end() ? 0 : it->second;
+}
+
+// ____________________________________________________________________________
+LocatedTriplesVersions& DeltaTriples::mutableVersions() {
+  // See `LocatedTriplesPerBlock::mutableMap` for why checking the `use_count`
+  // is safe here.
+  if (versions_.use_count() > 1) {
+    versions_ = std::make_shared<LocatedTriplesVersions>(*versions_);
+  }
+  return *versions_;
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::recordChangedTriples(const Triples& triples) {
+  if (triples.empty()) {
+    return;
+  }
+  auto& versions = mutableVersions();
+  versions.lastChange_ = nextSnapshotIndex_;
+  for (const auto& triple : triples) {
+    versions.lastChangePerPredicate_[triple.ids().at(1)] = nextSnapshotIndex_;
+  }
 }
 
 // ____________________________________________________________________________
@@ -36,8 +69,7 @@ std::vector<DeltaTriples::LocatedTripleHandles>
 DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
                                   ql::span<const IdTriple<0>> triples,
                                   bool insertOrDelete) {
-  std::array<std::vector<LocatedTriples::iterator>, Permutation::ALL.size()>
-      intermediateHandles;
+  std::vector<DeltaTriples::LocatedTripleHandles> handles{triples.size()};
   for (auto permutation : Permutation::ALL) {
     auto& perm = index_.getPermutation(permutation);
     auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
@@ -46,28 +78,24 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
         triples, perm.metaData().blockData(), perm.keyOrder(), insertOrDelete,
         cancellationHandle);
     cancellationHandle->throwIfCancelled();
-    intermediateHandles[static_cast<size_t>(permutation)] =
-        this->locatedTriples()[static_cast<size_t>(permutation)].add(
-            locatedTriples);
-    cancellationHandle->throwIfCancelled();
-  }
-  std::vector<DeltaTriples::LocatedTripleHandles> handles{triples.size()};
-  for (auto permutation : Permutation::ALL) {
+    this->locatedTriples()[static_cast<size_t>(permutation)].add(
+        locatedTriples);
     for (size_t i = 0; i < triples.size(); i++) {
-      handles[i].forPermutation(permutation) =
-          intermediateHandles[static_cast<size_t>(permutation)][i];
+      handles[i].forPermutation(permutation) = locatedTriples[i].blockIndex_;
     }
+    cancellationHandle->throwIfCancelled();
   }
   return handles;
 }
 
 // ____________________________________________________________________________
-void DeltaTriples::eraseTripleInAllPermutations(LocatedTripleHandles& handles) {
+void DeltaTriples::eraseTripleInAllPermutations(const IdTriple<0>& triple,
+                                                LocatedTripleHandles& handles) {
   // Erase for all permutations.
   for (auto permutation : Permutation::ALL) {
-    auto ltIter = handles.forPermutation(permutation);
-    locatedTriples()[static_cast<int>(permutation)].erase(ltIter->blockIndex_,
-                                                          ltIter);
+    const auto& keyOrder = index_.getPermutation(permutation).keyOrder();
+    locatedTriples()[static_cast<int>(permutation)].erase(
+        handles.forPermutation(permutation), triple.permute(keyOrder));
   }
 }
 
@@ -96,6 +124,12 @@ void DeltaTriples::deleteTriples(CancellationHandle cancellationHandle,
                     triplesDeleted_, triplesInserted_);
 }
 
+// ____________________________________________________________________________
+Id DeltaTriples::makeLocalBlankNode() {
+  return Id::makeFromBlankNodeIndex(
+      localVocab_.getBlankNodeIndex(index_.getBlankNodeManager()));
+}
+
 // ____________________________________________________________________________
 void DeltaTriples::rewriteLocalVocabEntriesAndBlankNodes(Triples& triples) {
   // Remember which original blank node (from the parsing of an insert
@@ -163,10 +197,14 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   std::erase_if(triples, [&targetMap](const IdTriple<0>& triple) {
     return targetMap.contains(triple);
   });
+  // All the remaining triples change the state of the `DeltaTriples`, either
+  // because they cancel out a triple from the `inverseMap` or because they are
+  // added to the `targetMap`.
+  recordChangedTriples(triples);
   ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
     auto handle = inverseMap.find(triple);
     if (handle != inverseMap.end()) {
-      eraseTripleInAllPermutations(handle->second);
+      eraseTripleInAllPermutations(triple, handle->second);
       inverseMap.erase(triple);
     }
   });
@@ -194,13 +232,14 @@ LocatedTriplesSnapshot::getLocatedTriplesForPermutation(
 
 // ____________________________________________________________________________
 SharedLocatedTriplesSnapshot DeltaTriples::getSnapshot() {
-  // NOTE: Both members of the `LocatedTriplesSnapshot` are copied, but the
-  // `localVocab_` has no copy constructor (in order to avoid accidental
-  // copies), hence the explicit `clone`.
+  // NOTE: Copying the `LocatedTriplesPerBlock` only copies pointers to the
+  // structurally shared data, see `LocatedTriplesPerBlock`. The `localVocab_`
+  // is not copied at all, the snapshot only extends its lifetime.
   auto snapshotIndex = nextSnapshotIndex_;
   ++nextSnapshotIndex_;
   return SharedLocatedTriplesSnapshot{std::make_shared<LocatedTriplesSnapshot>(
-      locatedTriples(), localVocab_.getLifetimeExtender(), snapshotIndex)};
+      locatedTriples(), localVocab_.getLifetimeExtender(), snapshotIndex,
+      versions_)};
 }
 
 // ____________________________________________________________________________
@@ -226,6 +265,23 @@ DeltaTriplesManager::DeltaTriplesManager(const IndexImpl& index)
     : deltaTriples_{index},
       currentLocatedTriplesSnapshot_{deltaTriples_.wlock()->getSnapshot()} {}
 
+// _____________________________________________________________________________
+namespace {
+// Publish the number of delta triples in the metrics (see `util/Metrics.h`).
+void updateDeltaTriplesMetrics(const DeltaTriplesCount& counts) {
+  using namespace ad_utility::metrics;
+  static constexpr std::string_view name = "qlever_delta_triples";
+  static constexpr std::string_view help =
+      "The number of triples that were inserted or deleted by updates";
+  static auto& inserted =
+      globalRegistry().gauge(name, help, {{"type", "inserted"}});
+  static auto& deleted =
+      globalRegistry().gauge(name, help, {{"type", "deleted"}});
+  inserted.set(counts.triplesInserted_);
+  deleted.set(counts.triplesDeleted_);
+}
+}  // namespace
+
 // _____________________________________________________________________________
 template <typename ReturnType>
 ReturnType DeltaTriplesManager::modify(
@@ -243,6 +299,7 @@ ReturnType DeltaTriplesManager::modify(
               [&newSnapshot](auto& currentSnapshot) {
                 currentSnapshot = std::move(newSnapshot);
               });
+          updateDeltaTriplesMetrics(deltaTriples.getCounts());
         };
         auto writeAndUpdateSnapshot = [&updateSnapshot, &deltaTriples,
                                        writeToDiskAfterRequest]() {
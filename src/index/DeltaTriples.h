@@ -25,6 +25,25 @@
 using LocatedTriplesPerBlockAllPermutations =
     std::array<LocatedTriplesPerBlock, Permutation::ALL.size()>;
 
+// For each predicate, the index of the last `LocatedTriplesSnapshot` in which
+// the delta triples with that predicate were changed. This is used to only
+// invalidate those cached results that are actually affected by an update, see
+// `Operation::getLocatedTriplesSnapshotIndexForCaching`.
+struct LocatedTriplesVersions {
+  // The index of the last snapshot in which triples with the given predicate
+  // were changed. Predicates that are not contained have not been changed. All
+  // the entries are `0` when there are no delta triples (for example, after
+  // `DeltaTriples::clear`), because then the results of the original index are
+  // valid.
+  ad_utility::HashMap<Id, size_t> lastChangePerPredicate_;
+  // The index of the last snapshot in which any triple was changed.
+  size_t lastChange_ = 0;
+
+  // Return the index of the last snapshot in which the triples with the given
+  // `predicate` were (possibly) changed.
+  size_t lastChangeOfPredicate(Id predicate) const;
+};
+
 // The locations of a set of delta triples (triples that were inserted or
 // deleted since the index was built) in each of the six permutations, and a
 // local vocab. This is all the information that is required to perform a query
@@ -37,6 +56,8 @@ struct LocatedTriplesSnapshot {
   LocalVocab::LifetimeExtender localVocabLifetimeExtender_;
   // A unique index for this snapshot that is used in the query cache.
   size_t index_;
+  // The last changes per predicate, see `LocatedTriplesVersions` above.
+  std::shared_ptr<const LocatedTriplesVersions> versions_;
   // Get `TripleWithPosition` objects for given permutation.
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
       Permutation::Enum permutation) const;
@@ -75,8 +96,11 @@ struct DeltaTriplesCount {
 // 3. In the call of `PermutationImpl::scan`, use the respective lists to merge
 // the relevant delta triples into the index scan result.
 //
-// NOTE: The delta triples currently do not go well together with CACHING. See
-// the discussion at the end of this file.
+// NOTE: The index of the `LocatedTriplesSnapshot` is part of the key of the
+// query cache. For each operation, this is the index of the last snapshot that
+// changed one of the predicates the operation depends on, see
+// `LocatedTriplesVersions` above. That way, an update only invalidates those
+// cached results that read triples with one of the changed predicates.
 class DeltaTriples {
   FRIEND_TEST(DeltaTriplesTest, insertTriplesAndDeleteTriples);
   FRIEND_TEST(DeltaTriplesTest, clear);
@@ -99,6 +123,11 @@ class DeltaTriples {
   // which are not contained in the vocabulary of the original index).
   LocalVocab localVocab_;
 
+  // The last changes per predicate. This is shared with the snapshots and
+  // copied on write, see `mutableVersions()`.
+  std::shared_ptr<LocatedTriplesVersions> versions_ =
+      std::make_shared<LocatedTriplesVersions>();
+
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
@@ -114,12 +143,14 @@ class DeltaTriples {
   static_assert(Permutation::ALL.size() == 6);
 
   // Each delta triple needs to know where it is stored in each of the six
-  // `LocatedTriplesPerBlock` above.
+  // `LocatedTriplesPerBlock` above. We store the index of the block (and not
+  // an iterator into the set of located triples of that block), because the
+  // sets are copied on write when they are shared with a snapshot (see
+  // `LocatedTriplesPerBlock`), which would invalidate such iterators.
   struct LocatedTripleHandles {
-    using It = LocatedTriples::iterator;
-    std::array<It, Permutation::ALL.size()> handles_;
+    std::array<size_t, Permutation::ALL.size()> blockIndices_;
 
-    LocatedTriples::iterator& forPermutation(Permutation::Enum permutation);
+    size_t& forPermutation(Permutation::Enum permutation);
   };
   using TriplesToHandlesMap =
       ad_utility::HashMap<IdTriple<0>, LocatedTripleHandles>;
@@ -173,6 +204,11 @@ class DeltaTriples {
   // Delete triples.
   void deleteTriples(CancellationHandle cancellationHandle, Triples triples);
 
+  // Return a new blank node that is managed by the `localVocab_` of this class.
+  // Such blank nodes are not rewritten by `insertTriples`, so they can be used
+  // to refer to the same blank node across several calls to `insertTriples`.
+  Id makeLocalBlankNode();
+
   // If the `filename` is set, then `writeToDisk()` will write these
   // `DeltaTriples` to `filename.value()`. If `filename` is `nullopt`, then
   // `writeToDisk` will be a nullop.
@@ -184,9 +220,11 @@ class DeltaTriples {
   // Read the delta triples from disk to restore them after a restart.
   void readFromDisk();
 
-  // Return a deep copy of the `LocatedTriples` and the corresponding
-  // `LocalVocab` which form a snapshot of the current status of this
-  // `DeltaTriples` object.
+  // Return a copy of the `LocatedTriples` and the corresponding `LocalVocab`
+  // which form a snapshot of the current status of this `DeltaTriples` object.
+  // The located triples are structurally shared with this object (see
+  // `LocatedTriplesPerBlock`), so this is cheap regardless of the number of
+  // delta triples.
   SharedLocatedTriplesSnapshot getSnapshot();
 
   // Register the original `metadata` for the given `permutation`. This has to
@@ -199,8 +237,8 @@ class DeltaTriples {
   // Find the position of the given triple in the given permutation and add it
   // to each of the six `LocatedTriplesPerBlock` maps (one per permutation).
   // When `insertOrDelete` is `true`, the triples are inserted, otherwise
-  // deleted. Return the iterators of where it was added (so that we can easily
-  // delete it again from these maps later).
+  // deleted. Return the block indices of where it was added (so that we can
+  // easily delete it again from these maps later).
   std::vector<LocatedTripleHandles> locateAndAddTriples(
       CancellationHandle cancellationHandle,
       ql::span<const IdTriple<0>> triples, bool insertOrDelete);
@@ -225,14 +263,19 @@ class DeltaTriples {
   void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
   FRIEND_TEST(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes);
 
-  // Erase `LocatedTriple` object from each `LocatedTriplesPerBlock` list. The
-  // argument are iterators for each list, as returned by the method
-  // `locateTripleInAllPermutations` above.
-  //
-  // NOTE: The iterators are invalid afterward. That is OK, as long as we also
-  // delete the respective entry in `triplesInserted_` or `triplesDeleted_`,
-  // which stores these iterators.
-  void eraseTripleInAllPermutations(LocatedTripleHandles& handles);
+  // Erase the `LocatedTriple` object for `triple` from each
+  // `LocatedTriplesPerBlock` list. The `handles` are the block indices for each
+  // list, as returned by the method `locateAndAddTriples` above.
+  void eraseTripleInAllPermutations(const IdTriple<0>& triple,
+                                    LocatedTripleHandles& handles);
+
+  // Return the `versions_` for modification. They are copied first if they are
+  // shared with a snapshot.
+  LocatedTriplesVersions& mutableVersions();
+
+  // Record that the given `triples` are changed in the next snapshot (the one
+  // with index `nextSnapshotIndex_`).
+  void recordChangedTriples(const Triples& triples);
 
   friend class DeltaTriplesManager;
 };
@@ -266,8 +309,8 @@ class DeltaTriplesManager {
   // update the current snapshot.
   void clear();
 
-  // Return a shared pointer to a deep copy of the current snapshot. This can
-  // be safely used to execute a query without interfering with future updates.
+  // Return a shared pointer to the current snapshot. This can be safely used to
+  // execute a query without interfering with future updates.
   SharedLocatedTriplesSnapshot getCurrentSnapshot() const;
 };
 
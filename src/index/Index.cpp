@@ -25,6 +25,17 @@ void Index::createFromOnDiskIndex(const std::string& onDiskBase,
   pimpl_->createFromOnDiskIndex(onDiskBase, persistUpdatesOnDisk);
 }
 
+// ____________________________________________________________________________
+void Index::createReachabilityIndexes() const {
+  if (!pimpl_->hasReachabilityPredicates()) {
+    return;
+  }
+  // Loading the index builds and writes the missing reachability indexes.
+  Index completeIndex{ad_utility::makeUnlimitedAllocator<Id>()};
+  completeIndex.loadAllPermutations() = false;
+  completeIndex.createFromOnDiskIndex(getOnDiskBase(), false);
+}
+
 // ____________________________________________________________________________
 void Index::addTextFromOnDiskIndex() { pimpl_->addTextFromOnDiskIndex(); }
 
@@ -156,6 +167,14 @@ bool& Index::usePatterns() { return pimpl_->usePatterns(); }
 // ____________________________________________________________________________
 bool& Index::loadAllPermutations() { return pimpl_->loadAllPermutations(); }
 
+// ____________________________________________________________________________
+bool& Index::parallelPermutationCreation() {
+  return pimpl_->parallelPermutationCreation();
+}
+
+// ____________________________________________________________________________
+bool& Index::resumeIndexBuild() { return pimpl_->resumeIndexBuild(); }
+
 // ____________________________________________________________________________
 void Index::setKeepTempFiles(bool keepTempFiles) {
   return pimpl_->setKeepTempFiles(keepTempFiles);
@@ -97,6 +97,13 @@ class Index {
   void createFromOnDiskIndex(const std::string& onDiskBase,
                              bool persistUpdatesOnDisk);
 
+  // Build and write the reachability indexes for the predicates that are
+  // specified via the key `reachability-predicates` in the settings file (see
+  // `IndexImpl::getReachabilityIndex`). They are built from the complete
+  // permutations, so this has to be called after `createFromFiles`. Indexes
+  // that already exist on disk are not built again.
+  void createReachabilityIndexes() const;
+
   // Add text index from on-disk index that has previously been constructed.
   // Read necessary metadata into memory and open file handles.
   void addTextFromOnDiskIndex();
@@ -183,6 +190,10 @@ class Index {
 
   bool& loadAllPermutations();
 
+  bool& parallelPermutationCreation();
+
+  bool& resumeIndexBuild();
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding();
@@ -0,0 +1,112 @@
+// Copyright 2026, University of Freiburg
+// Chair of Algorithms and Data Structures
+
+#include "index/IndexBuildManifest.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <filesystem>
+
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+IndexBuildManifest::IndexBuildManifest(std::string filename,
+                                       nlohmann::json fingerprint)
+    : filename_{std::move(filename)} {
+  if (std::filesystem::exists(filename_)) {
+    nlohmann::json existing;
+    try {
+      auto f = ad_utility::makeIfstream(filename_);
+      f >> existing;
+    } catch (const nlohmann::json::exception& e) {
+      AD_LOG_WARN << "The manifest of the index build at \"" << filename_
+                  << "\" could not be parsed and is ignored: " << e.what()
+                  << std::endl;
+    }
+    if (existing.contains("fingerprint") &&
+        existing["fingerprint"] == fingerprint) {
+      json_ = std::move(existing);
+      return;
+    }
+    AD_LOG_INFO << "The manifest of the index build at \"" << filename_
+                << "\" belongs to a different input or different settings "
+                   "and is ignored"
+                << std::endl;
+  }
+  json_["fingerprint"] = std::move(fingerprint);
+  json_["phases"] = nlohmann::json::object();
+}
+
+// _____________________________________________________________________________
+std::string IndexBuildManifest::toString(Phase phase) {
+  switch (phase) {
+    case Phase::TriplesAndVocabulary:
+      return "triples-and-vocabulary";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+bool IndexBuildManifest::isCompleted(Phase phase) const {
+  const auto& phases = json_.at("phases");
+  auto it = phases.find(toString(phase));
+  if (it == phases.end()) {
+    return false;
+  }
+  for (const auto& key : {"files", "output-files"}) {
+    for (const auto& file : it->at(key)) {
+      if (!std::filesystem::exists(file.get<std::string>())) {
+        AD_LOG_WARN << "The file " << file
+                    << " of the completed index build phase "
+                    << toString(phase) << " does not exist anymore"
+                    << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+const nlohmann::json& IndexBuildManifest::data(Phase phase) const {
+  AD_CONTRACT_CHECK(isCompleted(phase));
+  return json_.at("phases").at(toString(phase)).at("data");
+}
+
+// _____________________________________________________________________________
+void IndexBuildManifest::markCompleted(
+    Phase phase, std::vector<std::string> temporaryFiles,
+    std::vector<std::string> outputFiles, nlohmann::json data) {
+  auto& entry = json_["phases"][toString(phase)];
+  entry["files"] = std::move(temporaryFiles);
+  entry["output-files"] = std::move(outputFiles);
+  entry["data"] = std::move(data);
+  write();
+}
+
+// _____________________________________________________________________________
+void IndexBuildManifest::finish(bool keepFiles) {
+  if (!keepFiles) {
+    for (const auto& [phase, entry] : json_.at("phases").items()) {
+      for (const auto& file : entry.at("files")) {
+        ad_utility::deleteFile(file.get<std::string>(), false);
+      }
+    }
+  }
+  json_["phases"] = nlohmann::json::object();
+  ad_utility::deleteFile(filename_, false);
+}
+
+// _____________________________________________________________________________
+void IndexBuildManifest::write() const {
+  // Write to a temporary file first and then rename it, s.t. a crash during the
+  // writing never leaves a corrupt manifest behind.
+  auto tmpFilename = absl::StrCat(filename_, ".tmp");
+  {
+    auto f = ad_utility::makeOfstream(tmpFilename);
+    f << json_.dump(2);
+  }
+  std::filesystem::rename(tmpFilename, filename_);
+}
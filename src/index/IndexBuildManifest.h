@@ -0,0 +1,68 @@
+// Copyright 2026, University of Freiburg
+// Chair of Algorithms and Data Structures
+
+#ifndef QLEVER_SRC_INDEX_INDEXBUILDMANIFEST_H
+#define QLEVER_SRC_INDEX_INDEXBUILDMANIFEST_H
+
+#include <string>
+#include <vector>
+
+#include "util/json.h"
+
+// The manifest of an index build. It records which phases of the index build
+// have been completed, together with the files that these phases have
+// produced. The manifest is stored as a JSON file next to the index files and
+// is rewritten whenever a phase is completed, s.t. an index build that was
+// interrupted (e.g. by a crash) can be resumed after the last completed phase
+// (see the `--resume` option of the `IndexBuilderMain`).
+class IndexBuildManifest {
+ public:
+  // The phases of the index build after which a checkpoint is written.
+  enum struct Phase {
+    // The input was parsed, the vocabulary was merged and written to disk, and
+    // the triples are stored with their partial IDs, together with the
+    // mappings from the partial to the global IDs.
+    TriplesAndVocabulary
+  };
+
+ private:
+  std::string filename_;
+  nlohmann::json json_;
+
+ public:
+  // Create a manifest that is stored at `filename`. The `fingerprint` has to
+  // identify the input and the settings of the index build. If a manifest with
+  // the same fingerprint already exists at `filename`, its completed phases are
+  // read, otherwise the manifest starts without any completed phases.
+  IndexBuildManifest(std::string filename, nlohmann::json fingerprint);
+
+  // Return true iff the `phase` has been completed and all the files that it
+  // produced (the temporary as well as the output files) still exist.
+  bool isCompleted(Phase phase) const;
+
+  // Return the additional data that was stored when the `phase` was completed.
+  // The `phase` must have been completed.
+  const nlohmann::json& data(Phase phase) const;
+
+  // Mark the `phase` as completed and store the names of the files which it
+  // produced as well as the additional `data`. The `temporaryFiles` are only
+  // needed to resume the index build, the `outputFiles` are part of the final
+  // index. The manifest is then written to disk.
+  void markCompleted(Phase phase, std::vector<std::string> temporaryFiles,
+                     std::vector<std::string> outputFiles = {},
+                     nlohmann::json data = nlohmann::json::object());
+
+  // Delete the manifest file. Unless `keepFiles` is true, also delete the
+  // temporary files of the completed phases. To be called when the index build
+  // has finished successfully.
+  void finish(bool keepFiles);
+
+ private:
+  // The key under which the `phase` is stored in the JSON.
+  static std::string toString(Phase phase);
+
+  // Atomically (over)write the manifest file with the current `json_`.
+  void write() const;
+};
+
+#endif  // QLEVER_SRC_INDEX_INDEXBUILDMANIFEST_H
@@ -18,6 +18,7 @@
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/TextIndexBuilder.h"
+#include "parser/ParallelBuffer.h"
 #include "parser/RdfParser.h"
 #include "parser/Tokenizer.h"
 #include "util/File.h"
@@ -52,9 +53,10 @@ static void checkNumParameterValues(const T& values, size_t numFiles,
   throw std::runtime_error{error};
 }
 
-// Convert the `filetype` string, which must be "ttl", "nt", or "nq" to the
-// corresponding `qlever::Filetype` value. If no filetyp is given, try to deduce
-// the type from the filename.
+// Convert the `filetype` string, which must be "ttl", "nt", "nq", or "rdfbin"
+// to the corresponding `qlever::Filetype` value. If no filetyp is given, try
+// to deduce the type from the filename (the suffix of a compressed file, e.g.
+// `.gz` or `.zst`, is ignored).
 qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
                              std::string_view filename) {
   auto impl = [](std::string_view s) -> std::optional<qlever::Filetype> {
@@ -62,6 +64,8 @@ qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
       return qlever::Filetype::Turtle;
     } else if (s == "nq") {
       return qlever::Filetype::NQuad;
+    } else if (s == "rdfbin") {
+      return qlever::Filetype::Binary;
     } else {
       return std::nullopt;
     }
@@ -73,22 +77,24 @@ qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
     } else {
       throw std::runtime_error{
           absl::StrCat("The value of --file-format or -F must be one of "
-                       "`ttl`, `nt`, or `nq`, but is `",
+                       "`ttl`, `nt`, `nq`, or `rdfbin`, but is `",
                        filetype.value(), "`")};
     }
   }
 
-  auto posOfDot = filename.rfind('.');
+  auto posOfDot = stripCompressionSuffix(filename).rfind('.');
   auto throwNotDeducable = [&filename]() {
     throw std::runtime_error{absl::StrCat(
         "Could not deduce the file format from the filename \"", filename,
-        "\". Either use files with names that end on `.ttl`, `.nt`, or `.nq`, "
-        "or explicitly set the format of the file via --file-format or -F")};
+        "\". Either use files with names that end on `.ttl`, `.nt`, `.nq`, or "
+        "`.rdfbin`, or explicitly set the format of the file via --file-format "
+        "or -F")};
   };
   if (posOfDot == std::string::npos) {
     throwNotDeducable();
   }
-  auto deducedType = impl(filename.substr(posOfDot + 1));
+  auto deducedType =
+      impl(stripCompressionSuffix(filename).substr(posOfDot + 1));
   if (deducedType.has_value()) {
     return deducedType.value();
   } else {
@@ -141,6 +147,8 @@ int main(int argc, char** argv) {
   bool onlyAddTextIndex = false;
   bool keepTemporaryFiles = false;
   bool onlyPsoAndPos = false;
+  bool parallelPermutations = false;
+  bool resumeIndexBuild = false;
   bool addWordsFromLiterals = false;
   float bScoringParam = 0.75;
   float kScoringParam = 1.75;
@@ -162,12 +170,15 @@ int main(int argc, char** argv) {
       "The basename of the output files (required).");
   add("kg-input-file,f", po::value(&inputFile),
       "The file with the knowledge graph data to be parsed from. If omitted, "
-      "will read from stdin.");
+      "will read from stdin. Files that end on `.gz` or `.zst` are "
+      "decompressed while parsing.");
   add("file-format,F", po::value(&filetype),
       "The format of the input file with the knowledge graph data. Must be one "
-      "of [nt|ttl|nq]. Can be specified once (then all files use that format), "
-      "or once per file, or not at all (in that case, the format is deduced "
-      "from the filename suffix if possible).");
+      "of [nt|ttl|nq|rdfbin], where `rdfbin` is a binary format with a "
+      "dictionary and integer triples (see `BinaryRdfParser.h`). Can be "
+      "specified once (then all files use that format), or once per file, or "
+      "not at all (in that case, the format is deduced from the filename "
+      "suffix if possible).");
   add("default-graph,g", po::value(&defaultGraphs),
       "The graph IRI without angle brackets. Write `-` for the default graph. "
       "Can be omitted (then all files use the default graph), specified once "
@@ -177,7 +188,8 @@ int main(int argc, char** argv) {
       "or once per input file. Parallel parsing works for all input files "
       "using the N-Triples or N-Quads format, as well as for well-behaved "
       "Turtle files, where all the prefix declarations come in one block at "
-      "the beginning and there are no multiline literals");
+      "the beginning and there are no multiline literals. If not specified, "
+      "files in the N-Quads format are parsed in parallel");
   add("kg-index-name,K", po::value(&kbIndexName),
       "The name of the knowledge graph index (default: basename of "
       "`kg-input-file`).");
@@ -217,6 +229,19 @@ int main(int argc, char** argv) {
   add("only-pso-and-pos-permutations,o", po::bool_switch(&onlyPsoAndPos),
       "Only build the PSO and POS permutations. This is faster, but then "
       "queries with predicate variables are not supported");
+  add("parallel-permutations", po::bool_switch(&parallelPermutations),
+      "Sort and write the OSP/OPS and PSO/POS permutations concurrently. This "
+      "is faster on machines with many cores and fast disks. The memory "
+      "specified via `stxxl-memory` is split between the concurrent sorters. "
+      "Currently only has an effect together with `no-patterns`.");
+  add("resume", po::bool_switch(&resumeIndexBuild),
+      "Make the index build resumable, and resume an index build that was "
+      "interrupted. With this option, a checkpoint is written after the input "
+      "was parsed and the vocabulary was merged (which keeps some temporary "
+      "files until the end of the index build). The checkpoint is only used "
+      "if the input files and the settings are the same as for the "
+      "interrupted build (which must also have used this option), otherwise "
+      "the index is built from scratch.");
   auto msg = absl::StrCat(
       "The vocabulary implementation for strings in qlever, can be any of ",
       ad_utility::VocabularyType::getListOfSupportedValues());
@@ -304,6 +329,8 @@ int main(int argc, char** argv) {
     index.setKeepTempFiles(keepTemporaryFiles);
     index.setSettingsFile(settingsFile);
     index.loadAllPermutations() = !onlyPsoAndPos;
+    index.parallelPermutationCreation() = parallelPermutations;
+    index.resumeIndexBuild() = resumeIndexBuild;
     index.getImpl().setPrefixesForEncodedValues(prefixesForIdEncodedIris);
 
     // Convert the parameters for the filenames, file types, and default graphs
@@ -343,6 +370,7 @@ int main(int argc, char** argv) {
       auto fileSpecifications = getFileSpecifications();
       AD_CONTRACT_CHECK(!fileSpecifications.empty());
       index.createFromFiles(fileSpecifications);
+      index.createReachabilityIndexes();
     }
     bool wordsAndDocsFileSpecified = !(wordsfile.empty() || docsfile.empty());
 
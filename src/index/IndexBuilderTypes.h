@@ -7,7 +7,9 @@
 #ifndef QLEVER_SRC_INDEX_INDEXBUILDERTYPES_H
 #define QLEVER_SRC_INDEX_INDEXBUILDERTYPES_H
 
+#include <functional>
 #include <memory_resource>
+#include <string_view>
 
 #include "global/Constants.h"
 #include "global/Id.h"
@@ -131,10 +133,18 @@ using ItemMapArray = std::array<ItemMapAndBuffer, NUM_PARALLEL_ITEM_MAPS>;
  */
 // Align each ItemMapManager on its own cache line to avoid false sharing.
 struct alignas(256) ItemMapManager {
+  // Decide whether a word (in its RDF representation) belongs to the external
+  // vocabulary.
+  using ShouldBeExternalized = std::function<bool(std::string_view)>;
+
   /// Construct by assigning the minimum ID that should be returned by the map.
   explicit ItemMapManager(uint64_t minId, const TripleComponentComparator* cmp,
-                          ItemAlloc alloc)
-      : map_(alloc), minId_(minId), comparator_(cmp) {
+                          ItemAlloc alloc,
+                          ShouldBeExternalized shouldBeExternalized)
+      : map_(alloc),
+        minId_(minId),
+        comparator_(cmp),
+        shouldBeExternalized_(std::move(shouldBeExternalized)) {
     // Precompute the mapping from the `specialIds` to their norma IDs in the
     // vocabulary. This makes resolving such IRIs much cheaper.
     for (const auto& [specialIri, specialId] : qlever::specialIds()) {
@@ -153,7 +163,9 @@ struct alignas(256) ItemMapManager {
   Id getId(const TripleComponentOrId& keyOrId) {
     if (std::holds_alternative<Id>(keyOrId)) {
       auto id = std::get<Id>(keyOrId);
-      if (id.getDatatype() != Datatype::Undefined) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        return getIdForDictionaryEntry(id.getLocalVocabIndex());
+      } else if (id.getDatatype() != Datatype::Undefined) {
         return id;
       } else {
         // The only IDs with `Undefined` types ca be the `specialIds`.
@@ -161,9 +173,29 @@ struct alignas(256) ItemMapManager {
       }
     }
     const auto& key = std::get<PossiblyExternalizedIriOrLiteral>(keyOrId);
+    return getIdForWord(key.iriOrLiteral_.toRdfLiteral(), key.isExternal_);
+  }
+
+  /// The IRIs and literals of a dictionary-encoded input (see
+  /// `BinaryRdfParser`) are passed as an `Id` of type `LocalVocabIndex` that
+  /// points into the dictionary of the parser. Each such entry is hashed and
+  /// checked for externalization only on its first occurrence, all further
+  /// occurrences are resolved via its address.
+  Id getIdForDictionaryEntry(LocalVocabIndex entry) {
+    auto it = dictionaryIdMapping_.find(entry);
+    if (it != dictionaryIdMapping_.end()) {
+      return it->second;
+    }
+    const auto& repr = entry->toStringRepresentation();
+    auto id = getIdForWord(repr, shouldBeExternalized_(repr));
+    dictionaryIdMapping_.emplace(entry, id);
+    return id;
+  }
+
+  /// Return the ID of the word with the RDF representation `repr`.
+  Id getIdForWord(std::string_view repr, bool isExternal) {
     auto& map = map_.map_;
     auto& buffer = map_.buffer_;
-    auto repr = key.iriOrLiteral_.toRdfLiteral();
     auto it = map.find(repr);
     if (it == map.end()) {
       uint64_t res = map.size() + minId_;
@@ -176,7 +208,7 @@ struct alignas(256) ItemMapManager {
           keyView, LocalVocabIndexAndSplitVal{
                        res, comparator_->extractAndTransformComparableNonOwning(
                                 repr, TripleComponentComparator::Level::TOTAL,
-                                key.isExternal_, &buffer.charAllocator())});
+                                isExternal, &buffer.charAllocator())});
       return Id::makeFromVocabIndex(VocabIndex::make(res));
     } else {
       return Id::makeFromVocabIndex(VocabIndex::make(it->second.id_));
@@ -190,8 +222,10 @@ struct alignas(256) ItemMapManager {
   }
   ItemMapAndBuffer map_;
   ad_utility::HashMap<Id, Id> specialIdMapping_;
+  ad_utility::HashMap<LocalVocabIndex, Id> dictionaryIdMapping_;
   uint64_t minId_ = 0;
   const TripleComponentComparator* comparator_ = nullptr;
+  ShouldBeExternalized shouldBeExternalized_;
 };
 
 /// Combines a triple (three strings) together with the (possibly empty)
@@ -237,7 +271,11 @@ auto getIdMapLambdas(
   // that way the different ids won't interfere
   auto& itemArray = *itemArrayPtr;
   for (size_t j = 0; j < NumThreads; ++j) {
-    itemArray[j].emplace(j * 100 * maxNumberOfTriples, comp, alloc);
+    itemArray[j].emplace(j * 100 * maxNumberOfTriples, comp, alloc,
+                         [indexPtr](std::string_view word) {
+                           return indexPtr->getVocab().shouldBeExternalized(
+                               word);
+                         });
     // This `reserve` is for a guaranteed upper bound that stays the same during
     // the whole index building. That's why we use the `CachingMemoryResource`
     // as an underlying memory pool for the allocator of the hash map to make
@@ -275,9 +313,14 @@ auto getIdMapLambdas(
         auto langTagId = map.getId(TripleComponent{
             ad_utility::convertLangtagToEntityUri(lt.langtag_)});
         // get the Id for the tagged predicate, e.g. @en@rdfs:label
+        // The predicate of a dictionary-encoded input is an `Id` (see
+        // `ItemMapManager::getIdForDictionaryEntry`).
+        const auto& predicate = lt.triple_[1];
         const auto& iri =
-            std::get<PossiblyExternalizedIriOrLiteral>(lt.triple_[1])
-                .iriOrLiteral_.getIri();
+            std::holds_alternative<Id>(predicate)
+                ? std::get<Id>(predicate).getLocalVocabIndex()->getIri()
+                : std::get<PossiblyExternalizedIriOrLiteral>(predicate)
+                      .iriOrLiteral_.getIri();
         auto langTaggedPredId = map.getId(TripleComponent{
             ad_utility::convertToLanguageTaggedPredicate(iri, lt.langtag_)});
         auto& spoIds = *res[0];  // ids of original triple
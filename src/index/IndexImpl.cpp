@@ -8,6 +8,7 @@
 #include <absl/strings/str_join.h>
 
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
@@ -19,6 +20,7 @@
 #include "index/Index.h"
 #include "index/IndexFormatVersion.h"
 #include "index/VocabularyMerger.h"
+#include "parser/ParallelBuffer.h"
 #include "parser/ParallelParseBuffer.h"
 #include "util/BatchedPipeline.h"
 #include "util/CachingMemoryResource.h"
@@ -26,6 +28,7 @@
 #include "util/Iterators.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
 #include "util/ProgressBar.h"
+#include "util/Serializer/FileSerializer.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -34,12 +37,6 @@
 using std::array;
 using namespace ad_utility::memory_literals;
 
-// During the index building we typically have two permutations present at the
-// same time, as we directly push the triples from the first sorting to the
-// second sorting. We therefore have to adjust the amount of memory per external
-// sorter.
-static constexpr size_t NUM_EXTERNAL_SORTERS_AT_SAME_TIME = 2u;
-
 // _____________________________________________________________________________
 IndexImpl::IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator)
     : allocator_{std::move(allocator)} {
@@ -49,9 +46,25 @@ IndexImpl::IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator)
 
 // _____________________________________________________________________________
 IndexBuilderDataAsFirstPermutationSorter IndexImpl::createIdTriplesAndVocab(
-    std::shared_ptr<RdfParserBase> parser) {
-  auto indexBuilderData =
-      passFileForVocabulary(std::move(parser), numTriplesPerBatch_);
+    const std::vector<Index::InputFileSpecification>& files,
+    IndexBuildManifest& manifest) {
+  auto indexBuilderData = [&]() {
+    if (resumeIndexBuild_ &&
+        manifest.isCompleted(IndexBuildManifest::Phase::TriplesAndVocabulary)) {
+      return readTriplesAndVocabularyCheckpoint(manifest);
+    }
+    auto result =
+        passFileForVocabulary(makeRdfParser(files), numTriplesPerBatch_);
+    // The checkpoint keeps the (large) temporary files until the end of the
+    // index build, so it is only written if it might be used later.
+    if (resumeIndexBuild_) {
+      writeTriplesAndVocabularyCheckpoint(result, manifest);
+      if (afterCheckpointOnlyForTesting_) {
+        afterCheckpointOnlyForTesting_();
+      }
+    }
+    return result;
+  }();
 
   auto isQleverInternalTriple = [&indexBuilderData](const auto& triple) {
     auto internal = [&indexBuilderData](Id id) {
@@ -67,9 +80,138 @@ IndexBuilderDataAsFirstPermutationSorter IndexImpl::createIdTriplesAndVocab(
   return {indexBuilderData, std::move(firstSorter)};
 }
 
+// _____________________________________________________________________________
+void IndexImpl::writeTriplesAndVocabularyCheckpoint(
+    IndexBuilderDataAsExternalVector& data, IndexBuildManifest& manifest) {
+  auto triplesFilename = absl::StrCat(onDiskBase_, UNSORTED_TRIPLES_FILE_NAME);
+  auto metadataFilename =
+      absl::StrCat(onDiskBase_, CHECKPOINT_METADATA_FILE_NAME);
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{metadataFilename};
+    serializer << data.idTriples->persist();
+    serializer << data.vocabularyMetaData_;
+  }
+  std::vector<std::string> files{triplesFilename, metadataFilename};
+  for (size_t i = 0; i < data.actualPartialSizes.size(); ++i) {
+    files.push_back(absl::StrCat(onDiskBase_, PARTIAL_MMAP_IDS, i));
+  }
+  // The vocabulary is already part of the final index, but it is also
+  // required to resume. Depending on the vocabulary type, it consists of one
+  // or more files that all start with the same prefix.
+  std::vector<std::string> vocabularyFiles;
+  std::filesystem::path vocabularyPrefix{
+      absl::StrCat(onDiskBase_, VOCAB_SUFFIX)};
+  auto directory = vocabularyPrefix.parent_path();
+  for (const auto& entry : std::filesystem::directory_iterator{
+           directory.empty() ? std::filesystem::path{"."} : directory}) {
+    if (entry.path().filename().string().starts_with(
+            vocabularyPrefix.filename().string())) {
+      vocabularyFiles.push_back((directory / entry.path().filename()).string());
+    }
+  }
+  ql::ranges::sort(vocabularyFiles);
+  nlohmann::json checkpointData;
+  checkpointData["actual-partial-sizes"] = data.actualPartialSizes;
+  manifest.markCompleted(IndexBuildManifest::Phase::TriplesAndVocabulary,
+                         std::move(files), std::move(vocabularyFiles),
+                         std::move(checkpointData));
+}
+
+// _____________________________________________________________________________
+IndexBuilderDataAsExternalVector IndexImpl::readTriplesAndVocabularyCheckpoint(
+    const IndexBuildManifest& manifest) {
+  AD_LOG_INFO << "Resuming the index build from the checkpoint after the "
+                 "merging of the vocabulary, the input is not parsed again"
+              << std::endl;
+  IndexBuilderDataAsExternalVector res;
+  ad_utility::CompressedExternalIdTableWriter::PersistedMetadata
+      triplesMetadata;
+  {
+    ad_utility::serialization::FileReadSerializer serializer{
+        absl::StrCat(onDiskBase_, CHECKPOINT_METADATA_FILE_NAME)};
+    serializer >> triplesMetadata;
+    serializer >> res.vocabularyMetaData_;
+  }
+  res.idTriples = std::make_unique<TripleVec>(
+      absl::StrCat(onDiskBase_, UNSORTED_TRIPLES_FILE_NAME),
+      NumColumnsIndexBuilding, 1_GB, allocator_, std::move(triplesMetadata));
+  res.actualPartialSizes =
+      manifest.data(IndexBuildManifest::Phase::TriplesAndVocabulary)
+          .at("actual-partial-sizes")
+          .get<std::vector<size_t>>();
+  const auto& specialIds = res.vocabularyMetaData_.specialIdMapping();
+  idOfHasPatternDuringIndexBuilding_ = specialIds.at(HAS_PATTERN_PREDICATE);
+  idOfInternalGraphDuringIndexBuilding_ =
+      specialIds.at(QLEVER_INTERNAL_GRAPH_IRI);
+  AD_LOG_INFO << "Number of triples read from the checkpoint: "
+              << res.idTriples->size() << std::endl;
+  return res;
+}
+
+// _____________________________________________________________________________
+nlohmann::json IndexImpl::indexBuildFingerprint(
+    const std::vector<Index::InputFileSpecification>& files) const {
+  nlohmann::json fingerprint;
+  auto& inputFiles = fingerprint["input-files"];
+  inputFiles = nlohmann::json::array();
+  for (const auto& file : files) {
+    nlohmann::json j;
+    j["filename"] = file.filename_;
+    j["filetype"] = static_cast<int>(file.filetype_);
+    j["default-graph"] = file.defaultGraph_.value_or("");
+    j["parse-in-parallel"] = file.parseInParallel_;
+    // Input streams (e.g. named pipes) have no meaningful size or modification
+    // time, for those we have to trust the filename.
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(file.filename_, ec)) {
+      j["size"] = std::filesystem::file_size(file.filename_);
+      j["last-modified"] = std::filesystem::last_write_time(file.filename_)
+                               .time_since_epoch()
+                               .count();
+    }
+    inputFiles.push_back(std::move(j));
+  }
+  // The contents of the settings file (e.g. the language filters and the
+  // externalized prefixes) are compared in their normalized form, s.t. changes
+  // of the formatting don't prevent the resuming.
+  fingerprint["settings-file"] = settingsFileName_;
+  if (!settingsFileName_.empty()) {
+    nlohmann::json settings;
+    auto f = ad_utility::makeIfstream(settingsFileName_);
+    f >> settings;
+    fingerprint["settings-hash"] = std::hash<std::string>{}(settings.dump());
+  }
+  // All the other settings that affect the parsing of the triples or the
+  // vocabulary.
+  fingerprint["encoded-iri-prefixes"] = encodedIriManager();
+  fingerprint["vocabulary-type"] = vocabularyTypeForIndexBuilding_;
+  fingerprint["num-triples-per-batch"] = numTriplesPerBatch_;
+  fingerprint["parser-batch-size"] = parserBatchSize_;
+  fingerprint["parser-buffer-size"] = parserBufferSize_.getBytes();
+  fingerprint["ascii-prefixes-only"] = onlyAsciiTurtlePrefixes_;
+  fingerprint["integer-overflow-behavior"] =
+      static_cast<int>(turtleParserIntegerOverflowBehavior_);
+  fingerprint["skip-invalid-literals"] = turtleParserSkipIllegalLiterals_;
+  fingerprint["use-patterns"] = usePatterns_;
+  fingerprint["load-all-permutations"] = loadAllPermutations_;
+  fingerprint["index-format-version"] = qlever::indexFormatVersion;
+  return fingerprint;
+}
+
 // _____________________________________________________________________________
 std::unique_ptr<RdfParserBase> IndexImpl::makeRdfParser(
     const std::vector<Index::InputFileSpecification>& files) const {
+  // Compressed input files are decompressed by the `ParallelBuffer` of the
+  // respective parser, see `ParallelDecompressingBuffer`.
+  for (const auto& file : files) {
+    auto compression = getInputCompression(file.filename_);
+    if (compression != InputCompression::None) {
+      AD_LOG_INFO << "Input file " << file.filename_ << " is "
+                  << (compression == InputCompression::Zstd ? "zstd" : "gzip")
+                  << "-compressed and will be decompressed while parsing"
+                  << std::endl;
+    }
+  }
   return std::make_unique<RdfMultifileParser>(files, &encodedIriManager(),
                                               parserBufferSize());
 }
@@ -316,10 +458,27 @@ void IndexImpl::updateInputFileSpecificationsAndLog(
           pleaseUseParallelParsingOption)};
     }
   }
+  // N-Quads are line-based, so the parallel parser can always split them at
+  // newlines. If parallel parsing is not specified explicitly for an N-Quads
+  // input stream, we therefore parse it in parallel.
+  auto isImplicitNQuads = [&parallelParsingSpecifiedViaJson](
+                              const Index::InputFileSpecification& file) {
+    return !parallelParsingSpecifiedViaJson.has_value() &&
+           !file.parseInParallelSetExplicitly_ &&
+           file.filetype_ == Index::Filetype::NQuad;
+  };
+  for (auto& file : spec) {
+    if (isImplicitNQuads(file)) {
+      file.parseInParallel_ = true;
+    }
+  }
   // For a single input stream, if parallel parsing is not specified explicitly
-  // on the command line, we set if implicitly for backward compatibility.
+  // on the command line, we set if implicitly for backward compatibility. The
+  // binary format is always read sequentially, so the setting is irrelevant.
   if (!parallelParsingSpecifiedViaJson.has_value() && spec.size() == 1 &&
-      !spec.at(0).parseInParallelSetExplicitly_) {
+      !spec.at(0).parseInParallelSetExplicitly_ &&
+      !isImplicitNQuads(spec.at(0)) &&
+      spec.at(0).filetype_ != Index::Filetype::Binary) {
     AD_LOG_WARN
         << "Implicitly using the parallel parser for a single input file "
            "for reasons of backward compatibility; this is deprecated, "
@@ -354,8 +513,11 @@ void IndexImpl::createFromFiles(
   readIndexBuilderSettingsFromFile();
 
   updateInputFileSpecificationsAndLog(files, useParallelParser_);
+  IndexBuildManifest manifest{
+      absl::StrCat(onDiskBase_, INDEX_BUILD_MANIFEST_FILE_NAME),
+      indexBuildFingerprint(files)};
   IndexBuilderDataAsFirstPermutationSorter indexBuilderData =
-      createIdTriplesAndVocab(makeRdfParser(files));
+      createIdTriplesAndVocab(files, manifest);
 
   // Write the configuration already at this point, so we have it available in
   // case any of the permutations fail.
@@ -389,6 +551,11 @@ void IndexImpl::createFromFiles(
     createFirstPermutationPair(NumColumnsIndexBuilding,
                                std::move(firstSorterWithUnique));
     configurationJson_["has-all-permutations"] = false;
+  } else if (!usePatterns_ && parallelPermutationCreation_) {
+    createInternalPsoAndPosAndSetMetadata();
+    createAllPermutationPairsConcurrently(std::move(firstSorterWithUnique),
+                                          firstSorter);
+    configurationJson_["has-all-permutations"] = true;
   } else if (!usePatterns_) {
     createInternalPsoAndPosAndSetMetadata();
     // Without patterns, we explicitly have to pass in the next sorters to all
@@ -426,6 +593,8 @@ void IndexImpl::createFromFiles(
 
   addInternalStatisticsToConfiguration(numTriplesInternal,
                                        numPredicatesInternal);
+  // The checkpoints are no longer needed.
+  manifest.finish(keepTempFiles_);
   AD_LOG_INFO << "Index build completed" << std::endl;
 }
 
@@ -451,8 +620,9 @@ IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
   parser->integerOverflowBehavior() = turtleParserIntegerOverflowBehavior_;
   parser->invalidLiteralsAreSkipped() = turtleParserSkipIllegalLiterals_;
   ad_utility::Synchronized<std::unique_ptr<TripleVec>> idTriples(
-      std::make_unique<TripleVec>(onDiskBase_ + ".unsorted-triples.dat", 1_GB,
-                                  allocator_));
+      std::make_unique<TripleVec>(
+          absl::StrCat(onDiskBase_, UNSORTED_TRIPLES_FILE_NAME), 1_GB,
+          allocator_));
   AD_LOG_INFO << "Parsing input triples and creating partial vocabularies, one "
                  "per batch ..."
               << std::endl;
@@ -749,8 +919,12 @@ auto IndexImpl::convertPartialToGlobalIds(
     std::string mmapFilename = absl::StrCat(onDiskBase_, PARTIAL_MMAP_IDS, idx);
     auto map =
         ad_utility::vocabulary_merger::IdMapFromPartialIdMapFile(mmapFilename);
-    // Delete the temporary file in which we stored this map
-    deleteTemporaryFile(mmapFilename);
+    // Delete the temporary file in which we stored this map. If the index
+    // build might be resumed, the file is part of the checkpoint, and it is
+    // deleted when the index build has finished (see `createFromFiles`).
+    if (!resumeIndexBuild_) {
+      deleteTemporaryFile(mmapFilename);
+    }
     return std::pair{idx, std::move(map)};
   };
 
@@ -983,6 +1157,7 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
       usePatterns_ = false;
     }
   }
+  loadOrBuildReachabilityIndexes();
   if (persistUpdatesOnDisk) {
     deltaTriples_.value().setFilenameForPersistentUpdatesAndReadFromDisk(
         onDiskBase + ".update-triples");
@@ -1003,6 +1178,79 @@ const CompactVectorOfStrings<Id>& IndexImpl::getPatterns() const {
   return patterns_;
 }
 
+// _____________________________________________________________________________
+const ReachabilityIndex* IndexImpl::getReachabilityIndex(Id predicate,
+                                                         bool reversed) const {
+  auto it = reachabilityIndexes_.find(predicate);
+  if (it == reachabilityIndexes_.end()) {
+    return nullptr;
+  }
+  return &it->second[reversed ? 1 : 0];
+}
+
+// _____________________________________________________________________________
+bool IndexImpl::hasReachabilityPredicates() const {
+  return configurationJson_.contains("reachability-predicates") &&
+         !configurationJson_["reachability-predicates"].empty();
+}
+
+// _____________________________________________________________________________
+void IndexImpl::loadOrBuildReachabilityIndexes() {
+  if (!hasReachabilityPredicates()) {
+    return;
+  }
+  auto predicates = configurationJson_["reachability-predicates"]
+                        .get<std::vector<std::string>>();
+  for (size_t i = 0; i < predicates.size(); ++i) {
+    const auto& iri = predicates[i];
+    auto predicate = TripleComponent{TripleComponent::Iri::fromIriref(iri)}
+                         .toValueId(vocab_, encodedIriManager());
+    if (!predicate.has_value()) {
+      AD_LOG_WARN << "The predicate " << iri
+                  << " for the reachability index is not contained in the "
+                     "vocabulary, no reachability index is built for it"
+                  << std::endl;
+      continue;
+    }
+    auto filename = absl::StrCat(onDiskBase_, REACHABILITY_INDEX_SUFFIX, i);
+    auto& indexes = reachabilityIndexes_[predicate.value()];
+    if (std::filesystem::exists(filename)) {
+      ad_utility::serialization::FileReadSerializer serializer{filename};
+      serializer >> indexes[0];
+      serializer >> indexes[1];
+      continue;
+    }
+    AD_LOG_INFO << "Building the reachability index for the predicate " << iri
+                << " ..." << std::endl;
+    auto snapshot = deltaTriplesManager().getCurrentSnapshot();
+    ScanSpecification scanSpec{predicate.value(), std::nullopt, std::nullopt};
+    IdTable edges = pso_.scan(
+        pso_.getScanSpecAndBlocks(scanSpec, *snapshot), {},
+        std::make_shared<ad_utility::CancellationHandle<>>(), *snapshot);
+    AD_CORRECTNESS_CHECK(edges.numColumns() == 2);
+    auto subjects = edges.getColumn(0);
+    auto objects = edges.getColumn(1);
+    indexes[0] = ReachabilityIndex{subjects, objects};
+    indexes[1] = ReachabilityIndex{objects, subjects};
+    AD_LOG_INFO << "Done, the graph has " << indexes[0].numNodes()
+                << " nodes and " << indexes[0].numComponents()
+                << " strongly connected components, the reachability index "
+                   "consists of "
+                << indexes[0].numIntervals() + indexes[1].numIntervals()
+                << " intervals" << std::endl;
+    try {
+      ad_utility::serialization::FileWriteSerializer serializer{filename};
+      serializer << indexes[0];
+      serializer << indexes[1];
+    } catch (const std::exception& e) {
+      AD_LOG_WARN << "Could not write the reachability index to " << filename
+                  << ", it will be built again when the index is loaded the "
+                     "next time. The error message was "
+                  << e.what() << std::endl;
+    }
+  }
+}
+
 // _____________________________________________________________________________
 double IndexImpl::getAvgNumDistinctPredicatesPerSubject() const {
   throwExceptionIfNoPatterns();
@@ -1052,6 +1300,14 @@ bool& IndexImpl::usePatterns() { return usePatterns_; }
 // _____________________________________________________________________________
 bool& IndexImpl::loadAllPermutations() { return loadAllPermutations_; }
 
+// _____________________________________________________________________________
+bool& IndexImpl::parallelPermutationCreation() {
+  return parallelPermutationCreation_;
+}
+
+// _____________________________________________________________________________
+bool& IndexImpl::resumeIndexBuild() { return resumeIndexBuild_; }
+
 // ____________________________________________________________________________
 void IndexImpl::setSettingsFile(const std::string& filename) {
   settingsFileName_ = filename;
@@ -1219,6 +1475,15 @@ LangtagAndTriple IndexImpl::tripleToInternalRepresentation(
     if (lit.hasLanguageTag()) {
       result.langtag_ = std::string(asStringViewUnsafe(lit.getLanguageTag()));
     }
+  } else if (triple.object_.isId() &&
+             triple.object_.getId().getDatatype() ==
+                 Datatype::LocalVocabIndex) {
+    // An IRI or literal from the dictionary of a dictionary-encoded input (see
+    // `BinaryRdfParser`).
+    const auto& entry = *triple.object_.getId().getLocalVocabIndex();
+    if (entry.isLiteral() && entry.hasLanguageTag()) {
+      result.langtag_ = std::string(asStringViewUnsafe(entry.getLanguageTag()));
+    }
   }
 
   // The following lambda deals with triple elements that might be strings
@@ -1365,6 +1630,14 @@ void IndexImpl::readIndexBuilderSettingsFromFile() {
                 << std::endl;
   }
 
+  if (j.count("reachability-predicates")) {
+    auto predicates =
+        j["reachability-predicates"].get<std::vector<std::string>>();
+    AD_LOG_INFO << "A reachability index will be built for the predicates "
+                << absl::StrJoin(predicates, ", ") << std::endl;
+    configurationJson_["reachability-predicates"] = std::move(predicates);
+  }
+
   std::string overflowingIntegersThrow = "overflowing-integers-throw";
   std::string overflowingIntegersBecomeDoubles =
       "overflowing-integers-become-doubles";
@@ -1716,6 +1989,7 @@ CPP_template_def(typename... NextSorter)(requires(
       createPermutationPair(numColumns, AD_FWD(sortedTriples), pso_, pos_,
                             nextSorter.makePushCallback()...,
                             std::ref(predicateCounter), countTriplesNormal);
+  std::lock_guard lock{configurationMutex_};
   configurationJson_["num-predicates"] =
       NumNormalAndInternal::fromNormalAndTotal(numPredicatesNormal,
                                                numPredicatesTotal);
@@ -1800,6 +2074,7 @@ CPP_template_def(typename... NextSorter)(
   size_t numObjectsTotal = createPermutationPair(
       numColumns, AD_FWD(sortedTriples), osp_, ops_,
       nextSorter.makePushCallback()..., std::ref(objectCounter));
+  std::lock_guard lock{configurationMutex_};
   configurationJson_["num-objects"] = NumNormalAndInternal::fromNormalAndTotal(
       numObjectsNormal, numObjectsTotal);
   configurationJson_["has-all-permutations"] = true;
@@ -1808,7 +2083,8 @@ CPP_template_def(typename... NextSorter)(
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I, bool returnPtr>
-auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
+auto IndexImpl::makeSorterImpl(std::string_view permutationName,
+                               size_t numSortersAtSameTime) const {
   using Sorter = ExternalSorter<Comparator, I>;
   auto apply = [](auto&&... args) {
     if constexpr (returnPtr) {
@@ -1818,21 +2094,74 @@ auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
     }
   };
   return apply(absl::StrCat(onDiskBase_, ".", permutationName, "-sorter.dat"),
-               memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME,
-               allocator_);
+               memoryLimitIndexBuilding() / numSortersAtSameTime, allocator_);
 }
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
 ExternalSorter<Comparator, I> IndexImpl::makeSorter(
-    std::string_view permutationName) const {
-  return makeSorterImpl<Comparator, I, false>(permutationName);
+    std::string_view permutationName, size_t numSortersAtSameTime) const {
+  return makeSorterImpl<Comparator, I, false>(permutationName,
+                                              numSortersAtSameTime);
 }
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
 std::unique_ptr<ExternalSorter<Comparator, I>> IndexImpl::makeSorterPtr(
-    std::string_view permutationName) const {
-  return makeSorterImpl<Comparator, I, true>(permutationName);
+    std::string_view permutationName, size_t numSortersAtSameTime) const {
+  return makeSorterImpl<Comparator, I, true>(permutationName,
+                                             numSortersAtSameTime);
+}
+
+namespace {
+// Forward each pushed triple to both of the sorters. Can be used as the
+// `nextSorter` argument of the functions that create the permutations, s.t.
+// a single pass over the sorted triples fills two sorters.
+template <typename Sorter1, typename Sorter2>
+struct PushToBothSorters {
+  Sorter1& sorter1_;
+  Sorter2& sorter2_;
+  auto makePushCallback() {
+    return [push1 = sorter1_.makePushCallback(),
+            push2 = sorter2_.makePushCallback()](const auto& triple) mutable {
+      push1(triple);
+      push2(triple);
+    };
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+void IndexImpl::createAllPermutationPairsConcurrently(
+    BlocksOfTriples sortedTriples, FirstPermutationSorter& firstSorter) {
+  AD_CONTRACT_CHECK(loadAllPermutations_ && !usePatterns_);
+  // While the first pair is written, the `firstSorter` and the two following
+  // sorters exist at the same time, so the latter two share the memory that
+  // is usually given to a single sorter.
+  constexpr size_t numSorters = 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME;
+  auto secondSorter = makeSorter<SecondPermutation>("second", numSorters);
+  auto thirdSorter = makeSorter<ThirdPermutation>("third", numSorters);
+  createFirstPermutationPair(
+      NumColumnsIndexBuilding, std::move(sortedTriples),
+      PushToBothSorters<decltype(secondSorter), decltype(thirdSorter)>{
+          secondSorter, thirdSorter});
+  firstSorter.clearUnderlying();
+
+  // The two remaining pairs are independent of each other. The updates of the
+  // configuration in the `create...` functions are protected by the
+  // `configurationMutex_`.
+  AD_LOG_INFO << "Creating the remaining permutations concurrently ..."
+              << std::endl;
+  // Note: If the creation of the third pair throws, the destructor of the
+  // `std::future` waits for the second pair, so the sorters are still alive.
+  auto secondPair = std::async(std::launch::async, [this, &secondSorter]() {
+    createSecondPermutationPair(NumColumnsIndexBuilding,
+                                secondSorter.getSortedBlocks<0>());
+    secondSorter.clear();
+  });
+  createThirdPermutationPair(NumColumnsIndexBuilding,
+                             thirdSorter.getSortedBlocks<0>());
+  thirdSorter.clear();
+  secondPair.get();
 }
 
 // _____________________________________________________________________________
@@ -7,7 +7,10 @@
 #ifndef QLEVER_SRC_INDEX_INDEXIMPL_H
 #define QLEVER_SRC_INDEX_INDEXIMPL_H
 
+#include <array>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,10 +27,12 @@
 #include "index/EncodedIriManager.h"
 #include "index/ExternalSortFunctors.h"
 #include "index/Index.h"
+#include "index/IndexBuildManifest.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexMetaData.h"
 #include "index/PatternCreator.h"
 #include "index/Permutation.h"
+#include "index/ReachabilityIndex.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoring.h"
 #include "index/Vocabulary.h"
@@ -37,6 +42,7 @@
 #include "util/BufferedVector.h"
 #include "util/CancellationHandle.h"
 #include "util/File.h"
+#include "util/HashMap.h"
 #include "util/Forward.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/MmapVector.h"
@@ -133,6 +139,23 @@ class IndexImpl {
   // If false, only PSO and POS permutations are loaded and expected.
   bool loadAllPermutations_ = true;
 
+  // If true, the OSP/OPS and the PSO/POS permutations are sorted and written
+  // concurrently during the index build (currently only supported if no
+  // patterns are built).
+  bool parallelPermutationCreation_ = false;
+  // If true, an index build writes checkpoints after its phases, and skips the
+  // phases that have already been completed by a previous (interrupted) index
+  // build with the same input and settings (see `IndexBuildManifest`).
+  // Otherwise, no checkpoints are written, s.t. the temporary files can be
+  // deleted as early as possible.
+  bool resumeIndexBuild_ = false;
+  // Called after the checkpoint of the vocabulary phase has been written, used
+  // to simulate an interrupted index build in the tests.
+  std::function<void()> afterCheckpointOnlyForTesting_;
+  // Protects the `configurationJson_` and the configuration file when
+  // several permutations are created concurrently.
+  std::mutex configurationMutex_;
+
   // Pattern trick data
   bool usePatterns_ = false;
   double avgNumDistinctPredicatesPerSubject_;
@@ -167,6 +190,12 @@ class IndexImpl {
    * @brief Maps pattern ids to sets of predicate ids.
    */
   CompactVectorOfStrings<Id> patterns_;
+  // The reachability indexes for the predicates that are specified via the
+  // key `reachability-predicates` in the settings file. The first index
+  // follows the triples from the subject to the object, the second index in
+  // the reverse direction.
+  ad_utility::HashMap<Id, std::array<ReachabilityIndex, 2>>
+      reachabilityIndexes_;
   ad_utility::AllocatorWithLimit<Id> allocator_;
 
   // TODO: make those private and allow only const access
@@ -255,6 +284,9 @@ class IndexImpl {
 
   const auto& getVocab() const { return vocab_; };
   auto& getNonConstVocabForTesting() { return vocab_; }
+  auto& afterCheckpointOnlyForTesting() {
+    return afterCheckpointOnlyForTesting_;
+  }
 
   const auto& getTextVocab() const { return textVocab_; };
 
@@ -312,6 +344,16 @@ class IndexImpl {
   Index::Vocab::PrefixRanges prefixRanges(std::string_view prefix) const;
 
   const CompactVectorOfStrings<Id>& getPatterns() const;
+
+  // Return the `ReachabilityIndex` for the given `predicate` (if `reversed`
+  // is true, for the inverse predicate), or `nullptr` if no such index was
+  // built. Note that the index doesn't reflect the delta triples.
+  const ReachabilityIndex* getReachabilityIndex(Id predicate,
+                                                bool reversed) const;
+
+  // Return true iff the settings of the index build specify predicates for
+  // which a `ReachabilityIndex` is built.
+  bool hasReachabilityPredicates() const;
   /**
    * @return The multiplicity of the Entities column (0) of the full
    * has-relation relation after unrolling the patterns.
@@ -428,6 +470,10 @@ class IndexImpl {
 
   bool& loadAllPermutations();
 
+  bool& parallelPermutationCreation();
+
+  bool& resumeIndexBuild();
+
   void setKeepTempFiles(bool keepTempFiles);
 
   ad_utility::MemorySize& memoryLimitIndexBuilding() {
@@ -507,9 +553,27 @@ class IndexImpl {
   // the triples converted to id space. This Vec can be used for creating
   // permutations. Member vocab_ will be empty after this because it is not
   // needed for index creation once the TripleVec is set up and it would be a
-  // waste of RAM.
+  // waste of RAM. If `resumeIndexBuild_` is set and the `manifest` contains
+  // a checkpoint for the vocabulary, then the `files` are not parsed again.
   IndexBuilderDataAsFirstPermutationSorter createIdTriplesAndVocab(
-      std::shared_ptr<RdfParserBase> parser);
+      const std::vector<Index::InputFileSpecification>& files,
+      IndexBuildManifest& manifest);
+
+  // Persist the result of `passFileForVocabulary` and mark the corresponding
+  // phase as completed in the `manifest`.
+  void writeTriplesAndVocabularyCheckpoint(
+      IndexBuilderDataAsExternalVector& data, IndexBuildManifest& manifest);
+
+  // Restore the result of `passFileForVocabulary` from the checkpoint that was
+  // written by `writeTriplesAndVocabularyCheckpoint`.
+  IndexBuilderDataAsExternalVector readTriplesAndVocabularyCheckpoint(
+      const IndexBuildManifest& manifest);
+
+  // Return a JSON object that identifies the input `files` and the settings of
+  // an index build. A checkpoint is only used to resume an index build if its
+  // fingerprint is the same.
+  nlohmann::json indexBuildFingerprint(
+      const std::vector<Index::InputFileSpecification>& files) const;
 
   // ___________________________________________________________________
   IndexBuilderDataAsExternalVector passFileForVocabulary(
@@ -663,6 +727,12 @@ class IndexImpl {
    */
   void throwExceptionIfNoPatterns() const;
 
+  // Read the reachability indexes for the `reachability-predicates` from disk.
+  // The indexes that don't exist yet are built from the PSO permutation and
+  // written to disk, so this has to be called after the permutations have
+  // been loaded.
+  void loadOrBuildReachabilityIndexes();
+
   void writeConfiguration() const;
   void readConfiguration();
 
@@ -731,17 +801,30 @@ class IndexImpl {
 
   // Set up one of the permutation sorters with the appropriate memory limit.
   // The `permutationName` is used to determine the filename and must be unique
-  // for each call during one index build.
+  // for each call during one index build. The memory limit for the index
+  // building is evenly split between `numSortersAtSameTime` sorters.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   ExternalSorter<Comparator, N> makeSorter(
-      std::string_view permutationName) const;
+      std::string_view permutationName,
+      size_t numSortersAtSameTime = NUM_EXTERNAL_SORTERS_AT_SAME_TIME) const;
   // Same as the same function, but return a `unique_ptr`.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   std::unique_ptr<ExternalSorter<Comparator, N>> makeSorterPtr(
-      std::string_view permutationName) const;
+      std::string_view permutationName,
+      size_t numSortersAtSameTime = NUM_EXTERNAL_SORTERS_AT_SAME_TIME) const;
   // The common implementation of the above two functions.
   template <typename Comparator, size_t N, bool returnPtr>
-  auto makeSorterImpl(std::string_view permutationName) const;
+  auto makeSorterImpl(std::string_view permutationName,
+                      size_t numSortersAtSameTime) const;
+
+  // Create all three pairs of permutations (without patterns) from the
+  // `sortedTriples`, which must be sorted by the `FirstPermutation`. The
+  // `sortedTriples` are read only once and simultaneously pushed to the sorters
+  // of the second and third pair, which are then sorted and written
+  // concurrently. The `firstSorter` is cleared as soon as it is no longer
+  // needed.
+  void createAllPermutationPairsConcurrently(
+      BlocksOfTriples sortedTriples, FirstPermutationSorter& firstSorter);
 
   // Aliases for the three functions above that should be consistently used.
   // They assert that the order of the permutations as communicated by the
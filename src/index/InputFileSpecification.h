@@ -9,8 +9,9 @@
 #include <string>
 namespace qlever {
 
-// An enum to distinguish between `Turtle` and `NQuad` files.
-enum class Filetype { Turtle, NQuad };
+// An enum to distinguish between `Turtle` and `NQuad` files, and files in the
+// binary RDF format (see `BinaryRdfParser`).
+enum class Filetype { Turtle, NQuad, Binary };
 
 // Specify a single input file or stream for the index builder.
 struct InputFileSpecification {
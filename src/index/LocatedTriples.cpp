@@ -45,7 +45,7 @@ std::vector<LocatedTriple> LocatedTriple::locateTriplesInPermutation(
 
 // ____________________________________________________________________________
 bool LocatedTriplesPerBlock::hasUpdates(size_t blockIndex) const {
-  return map_.contains(blockIndex);
+  return map_->contains(blockIndex);
 }
 
 // ____________________________________________________________________________
@@ -53,7 +53,7 @@ NumAddedAndDeleted LocatedTriplesPerBlock::numTriples(size_t blockIndex) const {
   if (!hasUpdates(blockIndex)) {
     return {0, 0};
   } else {
-    const auto& blockUpdateTriples = map_.at(blockIndex);
+    const auto& blockUpdateTriples = *map_->at(blockIndex);
     // Simply return the number of located triples twice. See the comment in the
     // header file for the reasons and potential improvements.
     return {blockUpdateTriples.size(), blockUpdateTriples.size()};
@@ -115,7 +115,7 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
                                                  const IdTable& block) const {
   // This method should only be called if there are located triples in the
   // specified block.
-  AD_CONTRACT_CHECK(map_.contains(blockIndex));
+  AD_CONTRACT_CHECK(map_->contains(blockIndex));
 
   AD_CONTRACT_CHECK(numIndexColumns + static_cast<size_t>(includeGraphColumn) <=
                     block.numColumns());
@@ -124,7 +124,7 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
   IdTable result{block.numColumns(), block.getAllocator()};
   result.resize(block.numRows() + numInsertsAndDeletes.numAdded_);
 
-  const auto& locatedTriples = map_.at(blockIndex);
+  const auto& locatedTriples = *map_->at(blockIndex);
 
   auto lessThan = [](const auto& lt, const auto& row) {
     return tieLocatedTriple<numIndexColumns, includeGraphColumn>(lt) <
@@ -223,35 +223,50 @@ IdTable LocatedTriplesPerBlock::mergeTriples(size_t blockIndex,
 }
 
 // ____________________________________________________________________________
-std::vector<LocatedTriples::iterator> LocatedTriplesPerBlock::add(
-    ql::span<const LocatedTriple> locatedTriples) {
-  std::vector<LocatedTriples::iterator> handles;
-  handles.reserve(locatedTriples.size());
+LocatedTriplesPerBlock::BlockMap& LocatedTriplesPerBlock::mutableMap() {
+  if (map_.use_count() > 1) {
+    map_ = std::make_shared<BlockMap>(*map_);
+  }
+  return *map_;
+}
+
+// ____________________________________________________________________________
+LocatedTriples& LocatedTriplesPerBlock::mutableBlock(size_t blockIndex) {
+  auto& block = mutableMap()[blockIndex];
+  if (block == nullptr) {
+    block = std::make_shared<LocatedTriples>();
+  } else if (block.use_count() > 1) {
+    block = std::make_shared<LocatedTriples>(*block);
+  }
+  return *block;
+}
+
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::add(ql::span<const LocatedTriple> locatedTriples) {
   for (auto triple : locatedTriples) {
-    LocatedTriples& locatedTriplesInBlock = map_[triple.blockIndex_];
+    LocatedTriples& locatedTriplesInBlock = mutableBlock(triple.blockIndex_);
     auto [handle, wasInserted] = locatedTriplesInBlock.emplace(triple);
     AD_CORRECTNESS_CHECK(wasInserted == true);
     AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock.end());
     ++numTriples_;
-    handles.emplace_back(handle);
   }
 
   updateAugmentedMetadata();
-
-  return handles;
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::erase(size_t blockIndex,
-                                   LocatedTriples::iterator iter) {
-  auto blockIter = map_.find(blockIndex);
-  AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+                                   const IdTriple<0>& triple) {
+  AD_CONTRACT_CHECK(map_->contains(blockIndex), "Block ", blockIndex,
                     " is not contained.");
-  auto& block = blockIter->second;
-  block.erase(iter);
+  auto& block = mutableBlock(blockIndex);
+  // The comparison of `LocatedTriple`s only considers the `triple_`, so the
+  // remaining members of the lookup key are irrelevant.
+  auto numErased = block.erase(LocatedTriple{blockIndex, triple, true});
+  AD_CORRECTNESS_CHECK(numErased == 1);
   numTriples_--;
   if (block.empty()) {
-    map_.erase(blockIndex);
+    mutableMap().erase(blockIndex);
   }
 }
 
@@ -307,17 +322,19 @@ static auto updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
 void LocatedTriplesPerBlock::updateAugmentedMetadata() {
   // TODO<C++23> use view::enumerate
   size_t blockIndex = 0;
-  // Copy to preserve originalMetadata_.
+  // Copy to preserve originalMetadata_. We build a new vector instead of
+  // modifying the current one, because the latter might be shared with a
+  // snapshot.
+  std::vector<CompressedBlockMetadata> augmentedMetadata;
   if (!originalMetadata_.has_value()) {
     AD_LOG_WARN << "The original metadata has not been set, but updates are "
                    "being performed. This should only happen in unit tests\n";
-    augmentedMetadata_.emplace();
   } else {
-    augmentedMetadata_ = *originalMetadata_.value();
+    augmentedMetadata = *originalMetadata_.value();
   }
-  for (auto& blockMetadata : augmentedMetadata_.value()) {
+  for (auto& blockMetadata : augmentedMetadata) {
     if (hasUpdates(blockIndex)) {
-      const auto& blockUpdates = map_.at(blockIndex);
+      const auto& blockUpdates = *map_->at(blockIndex);
       blockMetadata.firstTriple_ =
           std::min(blockMetadata.firstTriple_,
                    blockUpdates.begin()->triple_.toPermutedTriple());
@@ -331,7 +348,7 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
   // Also account for the last block that contains the triples that are larger
   // than all the inserted triples.
   if (hasUpdates(blockIndex)) {
-    const auto& blockUpdates = map_.at(blockIndex);
+    const auto& blockUpdates = *map_->at(blockIndex);
     auto firstTriple = blockUpdates.begin()->triple_.toPermutedTriple();
     auto lastTriple = blockUpdates.rbegin()->triple_.toPermutedTriple();
 
@@ -350,8 +367,11 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
     lastBlockN.graphInfo_.emplace();
     CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
     updateGraphMetadata(lastBlock, blockUpdates);
-    augmentedMetadata_->push_back(lastBlock);
+    augmentedMetadata.push_back(lastBlock);
   }
+  augmentedMetadata_ =
+      std::make_shared<const std::vector<CompressedBlockMetadata>>(
+          std::move(augmentedMetadata));
 }
 
 // ____________________________________________________________________________
@@ -378,8 +398,8 @@ bool LocatedTriplesPerBlock::isLocatedTriple(const IdTriple<0>& triple,
     return ad_utility::contains(lt, locatedTriple);
   };
 
-  return ql::ranges::any_of(map_, [&blockContains](auto& indexAndBlock) {
+  return ql::ranges::any_of(*map_, [&blockContains](auto& indexAndBlock) {
     const auto& [index, block] = indexAndBlock;
-    return blockContains(block, index);
+    return blockContains(*block, index);
   });
 }
@@ -77,16 +77,44 @@ std::ostream& operator<<(std::ostream& os, const LocatedTriples& lts);
 
 // Sorted sets of located triples, grouped by block. We use this to store all
 // located triples for a permutation.
+//
+// The data is stored in a structurally shared way: copying a
+// `LocatedTriplesPerBlock` only copies a few `shared_ptr`s (this is what happens
+// for each `LocatedTriplesSnapshot`). A subsequent modification of one of the
+// copies then copies the map from block indices to located triples (which only
+// consists of pointers), and the located triples of those blocks that are
+// actually modified (copy-on-write). The located triples of all other blocks
+// remain shared between the copies.
 class LocatedTriplesPerBlock {
+ public:
+  // For each block with a non-empty set of located triples, the located triples
+  // in that block.
+  using BlockMap = ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>>;
+
  private:
   // The total number of `LocatedTriple` objects stored (for all blocks).
   size_t numTriples_ = 0;
 
-  // For each block with a non-empty set of located triples, the located triples
-  // in that block.
-  ad_utility::HashMap<size_t, LocatedTriples> map_;
+  // The located triples per block, see `BlockMap` above. Never `nullptr`.
+  std::shared_ptr<BlockMap> map_ = std::make_shared<BlockMap>();
 
   FRIEND_TEST(LocatedTriplesTest, numTriplesInBlock);
+  FRIEND_TEST(LocatedTriplesTest, copiesShareUnmodifiedBlocks);
+
+  // Return the `map_` for modification. If it is shared with another copy of
+  // this `LocatedTriplesPerBlock`, it is copied first.
+  //
+  // NOTE: Checking the `use_count()` is safe here, because all copies of a
+  // `LocatedTriplesPerBlock` are made from the object that is modified (while
+  // holding the lock in `DeltaTriplesManager`). The count might concurrently
+  // decrease, when a snapshot is destroyed, which only leads to an unnecessary
+  // copy.
+  BlockMap& mutableMap();
+
+  // Return the located triples for the block with the given index for
+  // modification. The set is created if it doesn't exist yet, and copied first
+  // if it is shared with another copy of this `LocatedTriplesPerBlock`.
+  LocatedTriples& mutableBlock(size_t blockIndex);
 
   // Implementation of the `mergeTriples` function (which has `numIndexColumns`
   // as a normal argument, and translates it into a template argument).
@@ -94,8 +122,11 @@ class LocatedTriplesPerBlock {
   IdTable mergeTriplesImpl(size_t blockIndex, const IdTable& block) const;
 
   // Stores the block metadata where the block borders have been adjusted for
-  // the updated triples.
-  std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
+  // the updated triples. This is a `shared_ptr` so that copies (snapshots)
+  // share it, it is recomputed (and not modified) by
+  // `updateAugmentedMetadata()`.
+  std::shared_ptr<const std::vector<CompressedBlockMetadata>>
+      augmentedMetadata_;
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
 
@@ -150,30 +181,29 @@ class LocatedTriplesPerBlock {
   // Return true iff there are located triples in the block with the given
   // index.
   bool containsTriples(size_t blockIndex) const {
-    return map_.contains(blockIndex);
+    return map_->contains(blockIndex);
   }
 
-  // Add `locatedTriples` to the `LocatedTriplesPerBlock` and return handles to
-  // where they were added (`LocatedTriples` is a sorted set, see above). Using
-  // these handles, we can easily remove the `locatedTriples` from the set again
-  // when we need to.
+  // Add `locatedTriples` to the `LocatedTriplesPerBlock`. Only the blocks to
+  // which triples are added are copied if they are shared with a snapshot.
   //
   // PRECONDITION: The `locatedTriples` must not already exist in
   // `LocatedTriplesPerBlock`.
-  std::vector<LocatedTriples::iterator> add(
-      ql::span<const LocatedTriple> locatedTriples);
+  void add(ql::span<const LocatedTriple> locatedTriples);
 
-  // Removes the given `LocatedTriple` from the `LocatedTriplesPerBlock`.
+  // Remove the located triple with the given `triple` (in the order of the
+  // permutation) from the block with the given index. Throws if there is no
+  // such block.
   //
   // NOTE: `updateAugmentedMetadata()` must be called to update the block
   // metadata.
-  void erase(size_t blockIndex, LocatedTriples::iterator iter);
+  void erase(size_t blockIndex, const IdTriple<0>& triple);
 
   // Get the total number of `LocatedTriple`s (for all blocks).
   size_t numTriples() const { return numTriples_; }
 
   // Get the number of blocks with a non-empty set of located triples.
-  size_t numBlocks() const { return map_.size(); }
+  size_t numBlocks() const { return map_->size(); }
 
   // Must be called initially before using the `LocatedTriplesPerBlock` to
   // initialize the original block metadata that is augmented for updated
@@ -190,8 +220,8 @@ class LocatedTriplesPerBlock {
   // account for the update triples. All triples (both insert and delete) will
   // enlarge the block borders.
   const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const {
-    if (augmentedMetadata_.has_value()) {
-      return augmentedMetadata_.value();
+    if (augmentedMetadata_ != nullptr) {
+      return *augmentedMetadata_;
     }
     AD_CONTRACT_CHECK(originalMetadata_.has_value());
     return *originalMetadata_.value();
@@ -199,7 +229,7 @@ class LocatedTriplesPerBlock {
 
   // Remove all located triples.
   void clear() {
-    map_.clear();
+    map_ = std::make_shared<BlockMap>();
     numTriples_ = 0;
     augmentedMetadata_.reset();
   }
@@ -217,12 +247,12 @@ class LocatedTriplesPerBlock {
                                   const LocatedTriplesPerBlock& ltpb) {
     // Get the block indices in sorted order.
     std::vector<size_t> blockIndices;
-    ql::ranges::copy(ltpb.map_ | ql::views::keys,
+    ql::ranges::copy(*ltpb.map_ | ql::views::keys,
                      std::back_inserter(blockIndices));
     ql::ranges::sort(blockIndices);
     for (auto blockIndex : blockIndices) {
-      os << "LTs in Block #" << blockIndex << ": " << ltpb.map_.at(blockIndex)
-         << std::endl;
+      os << "LTs in Block #" << blockIndex << ": "
+         << *ltpb.map_->at(blockIndex) << std::endl;
     }
     return os;
   };
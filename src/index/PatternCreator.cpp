@@ -136,10 +136,15 @@ void PatternCreator::readPatternsFromFile(
   // Read the subjectToPatternMap.
   ad_utility::serialization::FileReadSerializer patternReader(filename);
 
-  // Read the statistics and the patterns.
+  // Read the statistics. The patterns which follow them are not copied to RAM,
+  // but directly memory-mapped.
   PatternStatistics statistics;
   patternReader >> statistics;
-  patternReader >> patterns;
+  auto offsetOfPatterns =
+      static_cast<size_t>(std::move(patternReader).file().tell());
+  patterns = CompactVectorOfStrings<Id>::fromMmappedFile(
+      std::make_shared<const ad_utility::ReadOnlyMmapFile>(filename),
+      offsetOfPatterns);
 
   numDistinctSubjectPredicatePairs =
       statistics.numDistinctSubjectPredicatePairs_;
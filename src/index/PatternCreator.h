@@ -168,7 +168,8 @@ class PatternCreator {
   // Read the patterns from the files with the given `basename`. The patterns
   // must have been written to files with this `basename` using
   // `PatternCreator`. The patterns and all their statistics will be written
-  // to the various arguments.
+  // to the various arguments. The patterns are memory-mapped and not copied to
+  // RAM.
   static void readPatternsFromFile(const std::string& filename,
                                    double& avgNumSubjectsPerPredicate,
                                    double& avgNumPredicatesPerSubject,
@@ -0,0 +1,298 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "index/ReachabilityIndex.h"
+
+#include <limits>
+#include <numeric>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+
+namespace {
+// The adjacency lists of a graph with dense node indices. The successors of
+// the node `u` are `targets_[offsets_[u]]` up to `targets_[offsets_[u + 1]]`.
+struct Adjacency {
+  std::vector<uint32_t> offsets_;
+  std::vector<uint32_t> targets_;
+
+  size_t numNodes() const { return offsets_.size() - 1; }
+  ql::span<const uint32_t> successors(uint32_t u) const {
+    return ql::span{targets_}.subspan(offsets_[u],
+                                      offsets_[u + 1] - offsets_[u]);
+  }
+};
+
+// Create the `Adjacency` for a graph with `numNodes` nodes from the sorted
+// `edges`.
+Adjacency makeAdjacency(
+    size_t numNodes, const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+  Adjacency result;
+  result.offsets_.assign(numNodes + 1, 0);
+  result.targets_.reserve(edges.size());
+  for (const auto& [from, to] : edges) {
+    ++result.offsets_[from + 1];
+    result.targets_.push_back(to);
+  }
+  for (size_t i = 1; i <= numNodes; ++i) {
+    result.offsets_[i] += result.offsets_[i - 1];
+  }
+  return result;
+}
+
+// Sort the `edges` and remove the duplicates.
+void sortAndDeduplicate(std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+  ql::ranges::sort(edges);
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+// Compute the strongly connected components of the `graph` with an iterative
+// version of Tarjan's algorithm (the graphs can be too deep for recursion).
+// Return the component of each node and the number of components. The
+// components are numbered in reverse topological order, i.e. the successors
+// of a component always have smaller numbers.
+std::pair<std::vector<uint32_t>, uint32_t> computeStronglyConnectedComponents(
+    const Adjacency& graph) {
+  size_t numNodes = graph.numNodes();
+  std::vector<uint32_t> order(numNodes, NONE);
+  std::vector<uint32_t> lowLink(numNodes);
+  std::vector<uint32_t> component(numNodes, NONE);
+  std::vector<uint32_t> stack;
+  // The nodes of the current DFS path, together with the position of the
+  // next successor that has to be visited.
+  std::vector<std::pair<uint32_t, uint32_t>> path;
+  uint32_t nextOrder = 0;
+  uint32_t numComponents = 0;
+  auto visit = [&](uint32_t node) {
+    order[node] = lowLink[node] = nextOrder++;
+    stack.push_back(node);
+    path.emplace_back(node, graph.offsets_[node]);
+  };
+  for (uint32_t root = 0; root < numNodes; ++root) {
+    if (order[root] != NONE) {
+      continue;
+    }
+    visit(root);
+    while (!path.empty()) {
+      auto [node, next] = path.back();
+      if (next < graph.offsets_[node + 1]) {
+        ++path.back().second;
+        uint32_t successor = graph.targets_[next];
+        if (order[successor] == NONE) {
+          visit(successor);
+        } else if (component[successor] == NONE) {
+          lowLink[node] = std::min(lowLink[node], order[successor]);
+        }
+        continue;
+      }
+      // All the successors of the `node` have been visited.
+      path.pop_back();
+      if (!path.empty()) {
+        uint32_t parent = path.back().first;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+      }
+      if (lowLink[node] == order[node]) {
+        uint32_t member;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          component[member] = numComponents;
+        } while (member != node);
+        ++numComponents;
+      }
+    }
+  }
+  return {std::move(component), numComponents};
+}
+
+// Merge the sorted `intervals` that overlap or are adjacent.
+void mergeIntervals(std::vector<ReachabilityIndex::Interval>& intervals) {
+  ql::ranges::sort(intervals);
+  size_t numMerged = 0;
+  for (const auto& interval : intervals) {
+    if (numMerged > 0 &&
+        interval.first <= intervals[numMerged - 1].second + 1) {
+      auto& last = intervals[numMerged - 1].second;
+      last = std::max(last, interval.second);
+    } else {
+      intervals[numMerged++] = interval;
+    }
+  }
+  intervals.resize(numMerged);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ReachabilityIndex::ReachabilityIndex(ql::span<const Id> from,
+                                     ql::span<const Id> to) {
+  AD_CONTRACT_CHECK(from.size() == to.size());
+  // Map the nodes to dense indices.
+  nodes_.reserve(2 * from.size());
+  nodes_.insert(nodes_.end(), from.begin(), from.end());
+  nodes_.insert(nodes_.end(), to.begin(), to.end());
+  ql::ranges::sort(nodes_, std::less{}, &Id::getBits);
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  nodes_.shrink_to_fit();
+  AD_CONTRACT_CHECK(nodes_.size() < NONE,
+                    "Too many nodes for the reachability index");
+  size_t numNodes = nodes_.size();
+  auto indexOf = [this](Id id) {
+    return static_cast<uint32_t>(getComponent(id).value());
+  };
+  // Until the components are known, `componentOfNode_` is the identity, s.t.
+  // `indexOf` returns the dense index of a node.
+  componentOfNode_.resize(numNodes);
+  std::iota(componentOfNode_.begin(), componentOfNode_.end(), 0);
+
+  std::vector<uint8_t> hasSelfLoop(numNodes, 0);
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  edges.reserve(from.size());
+  for (size_t i = 0; i < from.size(); ++i) {
+    uint32_t u = indexOf(from[i]);
+    uint32_t v = indexOf(to[i]);
+    if (u == v) {
+      hasSelfLoop[u] = 1;
+    } else {
+      edges.emplace_back(u, v);
+    }
+  }
+  sortAndDeduplicate(edges);
+  auto [component, numComponents] =
+      computeStronglyConnectedComponents(makeAdjacency(numNodes, edges));
+
+  // Contract the components to a DAG.
+  std::vector<uint32_t> componentSize(numComponents, 0);
+  std::vector<uint8_t> isCyclic(numComponents, 0);
+  for (uint32_t u = 0; u < numNodes; ++u) {
+    ++componentSize[component[u]];
+    isCyclic[component[u]] |= hasSelfLoop[u];
+  }
+  for (uint32_t c = 0; c < numComponents; ++c) {
+    isCyclic[c] |= componentSize[c] > 1;
+  }
+  for (auto& [u, v] : edges) {
+    u = component[u];
+    v = component[v];
+  }
+  std::erase_if(edges, [](const auto& edge) {
+    return edge.first == edge.second;
+  });
+  sortAndDeduplicate(edges);
+  auto dag = makeAdjacency(numComponents, edges);
+  edges.clear();
+  edges.shrink_to_fit();
+
+  // Choose a spanning forest of the DAG. The components are visited in
+  // topological order (from the larger to the smaller numbers), and the first
+  // visited predecessor becomes the parent.
+  std::vector<uint32_t> parent(numComponents, NONE);
+  std::vector<std::pair<uint32_t, uint32_t>> treeEdges;
+  for (uint32_t c = numComponents; c-- > 0;) {
+    for (uint32_t successor : dag.successors(c)) {
+      if (parent[successor] == NONE) {
+        parent[successor] = c;
+        treeEdges.emplace_back(c, successor);
+      }
+    }
+  }
+  sortAndDeduplicate(treeEdges);
+  auto tree = makeAdjacency(numComponents, treeEdges);
+  treeEdges.clear();
+  treeEdges.shrink_to_fit();
+
+  // Number the forest in post-order. The descendants of the component `c`
+  // then have the numbers from `firstDescendant[c]` to `postOrder[c]`.
+  std::vector<uint32_t> postOrder(numComponents, NONE);
+  std::vector<uint32_t> firstDescendant(numComponents);
+  std::vector<std::pair<uint32_t, uint32_t>> path;
+  uint32_t nextNumber = 0;
+  for (uint32_t root = 0; root < numComponents; ++root) {
+    if (parent[root] != NONE) {
+      continue;
+    }
+    firstDescendant[root] = nextNumber;
+    path.emplace_back(root, 0);
+    while (!path.empty()) {
+      auto [c, next] = path.back();
+      auto children = tree.successors(c);
+      if (next < children.size()) {
+        ++path.back().second;
+        uint32_t child = children[next];
+        firstDescendant[child] = nextNumber;
+        path.emplace_back(child, 0);
+        continue;
+      }
+      postOrder[c] = nextNumber++;
+      path.pop_back();
+    }
+  }
+  AD_CORRECTNESS_CHECK(nextNumber == numComponents);
+
+  // Compute the intervals of the reachable components. The successors of a
+  // component have smaller numbers, so their intervals are already complete.
+  std::vector<std::vector<Interval>> reachable(numComponents);
+  for (uint32_t c = 0; c < numComponents; ++c) {
+    auto& intervals = reachable[c];
+    intervals.emplace_back(firstDescendant[c], postOrder[c]);
+    for (uint32_t successor : dag.successors(c)) {
+      ql::ranges::copy(reachable[successor], std::back_inserter(intervals));
+    }
+    mergeIntervals(intervals);
+  }
+
+  // Store everything with the post-order numbers as the component numbers.
+  std::vector<uint32_t> componentOfNumber(numComponents);
+  for (uint32_t c = 0; c < numComponents; ++c) {
+    componentOfNumber[postOrder[c]] = c;
+  }
+  isCyclic_.resize(numComponents);
+  intervalOffsets_.reserve(numComponents + 1);
+  intervalOffsets_.push_back(0);
+  memberOffsets_.assign(numComponents + 1, 0);
+  for (uint32_t number = 0; number < numComponents; ++number) {
+    uint32_t c = componentOfNumber[number];
+    isCyclic_[number] = isCyclic[c];
+    ql::ranges::copy(reachable[c], std::back_inserter(intervals_));
+    intervalOffsets_.push_back(static_cast<uint32_t>(intervals_.size()));
+    memberOffsets_[number + 1] = memberOffsets_[number] + componentSize[c];
+  }
+  members_.resize(numNodes);
+  std::vector<uint32_t> nextMember(memberOffsets_.begin(),
+                                   memberOffsets_.end() - 1);
+  for (uint32_t u = 0; u < numNodes; ++u) {
+    uint32_t number = postOrder[component[u]];
+    componentOfNode_[u] = number;
+    members_[nextMember[number]++] = nodes_[u];
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<uint32_t> ReachabilityIndex::getComponent(Id node) const {
+  auto it = ql::ranges::lower_bound(nodes_, node.getBits(), std::less{},
+                                    &Id::getBits);
+  if (it == nodes_.end() || it->getBits() != node.getBits()) {
+    return std::nullopt;
+  }
+  return componentOfNode_[it - nodes_.begin()];
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::reaches(Id from, Id to) const {
+  auto fromComponent = getComponent(from);
+  auto toComponent = getComponent(to);
+  if (!fromComponent.has_value() || !toComponent.has_value()) {
+    return false;
+  }
+  uint32_t c = fromComponent.value();
+  uint32_t target = toComponent.value();
+  if (c == target) {
+    return isCyclic_[c];
+  }
+  // Find the last interval that starts at or before the `target`.
+  auto intervals = getIntervals(c);
+  auto it = ql::ranges::upper_bound(intervals, target, std::less{},
+                                    &Interval::first);
+  return it != intervals.begin() && std::prev(it)->second >= target;
+}
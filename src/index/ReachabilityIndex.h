@@ -0,0 +1,116 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+#define QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// A precomputed index that answers reachability queries for the graph that is
+// formed by the triples of a single predicate (for example `rdfs:subClassOf`),
+// s.t. the property paths `p+` and `p*` don't require a graph search.
+//
+// The strongly connected components of the graph are contracted, which yields
+// a DAG. A spanning forest of this DAG is numbered in post-order, s.t. the
+// descendants of each component in the forest have contiguous numbers, and the
+// components are identified by these numbers. Each component then stores the
+// merged intervals of the numbers of all the components that are reachable
+// from it (the "tree cover" labelling by Agrawal, Borgida, and Jagadish). For
+// hierarchies, which are almost trees, there are only a few intervals per
+// component.
+class ReachabilityIndex {
+ public:
+  // An interval of component numbers, both ends are inclusive.
+  using Interval = std::pair<uint32_t, uint32_t>;
+
+ private:
+  // The sorted nodes of the graph and the component of each node.
+  std::vector<Id> nodes_;
+  std::vector<uint32_t> componentOfNode_;
+  // The nodes of each component, `members_[memberOffsets_[c]]` up to
+  // `members_[memberOffsets_[c + 1]]` are the nodes of the component `c`.
+  std::vector<uint32_t> memberOffsets_;
+  std::vector<Id> members_;
+  // True iff a component can be reached from itself with at least one step,
+  // i.e. it consists of more than one node or its node has a self-loop.
+  std::vector<uint8_t> isCyclic_;
+  // The sorted, disjoint intervals of the components that are reachable from
+  // each component (with the same layout as the `members_`).
+  std::vector<uint32_t> intervalOffsets_;
+  std::vector<Interval> intervals_;
+
+ public:
+  ReachabilityIndex() = default;
+
+  // Build the index for the graph with the edges `from[i] -> to[i]`. The edges
+  // may contain duplicates.
+  ReachabilityIndex(ql::span<const Id> from, ql::span<const Id> to);
+
+  // The number of distinct nodes and of strongly connected components.
+  size_t numNodes() const { return nodes_.size(); }
+  size_t numComponents() const { return isCyclic_.size(); }
+  // The total number of stored intervals (a measure for the size of the
+  // index).
+  size_t numIntervals() const { return intervals_.size(); }
+
+  // Return true iff the `node` is the subject or object of at least one edge.
+  bool contains(Id node) const { return getComponent(node).has_value(); }
+
+  // Return true iff `to` can be reached from `from` with at least one step.
+  bool reaches(Id from, Id to) const;
+
+  // Call `function` for each node that can be reached from `node` with at least
+  // one step. Each node is passed exactly once, in no particular order.
+  template <typename F>
+  void forEachReachable(Id node, F&& function) const {
+    auto component = getComponent(node);
+    if (!component.has_value()) {
+      return;
+    }
+    uint32_t c = component.value();
+    for (const auto& [first, last] : getIntervals(c)) {
+      for (uint32_t other = first; other <= last; ++other) {
+        if (other == c && !isCyclic_[c]) {
+          continue;
+        }
+        for (size_t i = memberOffsets_[other]; i < memberOffsets_[other + 1];
+             ++i) {
+          function(members_[i]);
+        }
+      }
+    }
+  }
+
+  // Allow serialization via the `ad_utility::serialization` interface.
+  AD_SERIALIZE_FRIEND_FUNCTION(ReachabilityIndex) {
+    serializer | arg.nodes_;
+    serializer | arg.componentOfNode_;
+    serializer | arg.memberOffsets_;
+    serializer | arg.members_;
+    serializer | arg.isCyclic_;
+    serializer | arg.intervalOffsets_;
+    serializer | arg.intervals_;
+  }
+
+ private:
+  // Return the component of the `node`, or `std::nullopt` if the `node` is not
+  // part of the graph.
+  std::optional<uint32_t> getComponent(Id node) const;
+
+  // Return the intervals of the component `c`.
+  ql::span<const Interval> getIntervals(uint32_t c) const {
+    return ql::span{intervals_}.subspan(
+        intervalOffsets_[c], intervalOffsets_[c + 1] - intervalOffsets_[c]);
+  }
+};
+
+#endif  // QLEVER_SRC_INDEX_REACHABILITYINDEX_H
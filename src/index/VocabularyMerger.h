@@ -18,6 +18,9 @@
 #include "util/HashMap.h"
 #include "util/MmapVector.h"
 #include "util/ProgressBar.h"
+#include "util/Serializer/SerializeHashMap.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/TaskQueue.h"
 #include "util/TypeTraits.h"
 
 using IdPairMMapVec = ad_utility::MmapVector<std::pair<Id, Id>>;
@@ -72,6 +75,13 @@ struct VocabularyMetaData {
     // Return true if the `id` belongs to this range.
     bool contains(Id id) const { return begin_ <= id && id < end_; }
 
+    AD_SERIALIZE_FRIEND_FUNCTION(IdRangeForPrefix) {
+      serializer | arg.begin_;
+      serializer | arg.end_;
+      serializer | arg.prefix_;
+      serializer | arg.beginWasSeen_;
+    }
+
    private:
     Id begin_ = Id::makeUndefined();
     Id end_ = Id::makeUndefined();
@@ -124,6 +134,16 @@ struct VocabularyMetaData {
     return internalEntities_.contains(id) || langTaggedPredicates_.contains(id);
   }
 
+  // Serialization, used for the checkpoints of the index build. The pointer to
+  // the global special IDs is not serialized.
+  AD_SERIALIZE_FRIEND_FUNCTION(VocabularyMetaData) {
+    serializer | arg.numWordsTotal_;
+    serializer | arg.numBlankNodesTotal_;
+    serializer | arg.langTaggedPredicates_;
+    serializer | arg.internalEntities_;
+    serializer | arg.specialIdMapping_;
+  }
+
  private:
   // The number of distinct words (size of the created vocabulary).
   size_t numWordsTotal_ = 0;
@@ -168,6 +188,10 @@ class VocabularyMerger {
   std::vector<IdPairMMapVec> idVecs_;
 
   const size_t bufferSize_ = BATCH_SIZE_VOCABULARY_MERGE;
+  // The number of threads that work on a single batch of merged words.
+  const size_t numThreads_ = NUM_THREADS_VOCABULARY_MERGE;
+  // The threads are reused for all the batches.
+  mutable ad_utility::TaskQueue<false> threadPool_{numThreads_, numThreads_};
 
   // Friend declaration for the publicly available function.
   template <typename W, typename C>
@@ -232,11 +256,27 @@ class VocabularyMerger {
     idVecs_.clear();
   }
 
-  // Inner helper function for the parallel pipeline, which performs the actual
-  // write to the IdPairVecs. Format of argument is `<vecToWriteTo<internalId,
-  // globalId>>`.
-  void doActualWrite(
-      const std::vector<std::pair<size_t, std::pair<size_t, Id>>>& buffer);
+  // Run `task(i)` for all `i` in `[0, numTasks)` on the `threadPool_` and wait
+  // for all of them to finish. Requires `numTasks <= numThreads_`.
+  template <typename F>
+  void runInParallel(size_t numTasks, const F& task) const;
+
+  // For each word in the `buffer` determine, whether it is different from its
+  // predecessor (for the first word this is the `lastTripleComponent_` from
+  // the previous batch). Additionally check that the words are strictly
+  // ascending wrt `lessThan`. The work is split between `numThreads_` threads,
+  // as the comparisons are the most expensive part of the batch.
+  template <typename L>
+  std::vector<char> findNewWords(const std::vector<QueueWord>& buffer,
+                                 const L& lessThan) const;
+
+  // Inner helper function, which performs the actual write to the
+  // `idVecs_`. For each `buffer[i]` the pair `<buffer[i].id(), globalIds[i]>`
+  // is appended to `idVecs_[buffer[i].partialFileId_]`, and the relative order
+  // of the pairs in each of them is preserved. Each of the `numThreads_`
+  // threads handles a contiguous range of the `buffer`.
+  void doActualWrite(const std::vector<QueueWord>& buffer,
+                     const std::vector<Id>& globalIds);
 };
 
 // ____________________________________________________________________________
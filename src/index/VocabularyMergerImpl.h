@@ -8,6 +8,7 @@
 #include <fstream>
 #include <future>
 #include <iostream>
+#include <memory>
 #include <queue>
 #include <string>
 #include <unordered_set>
@@ -158,28 +159,28 @@ CPP_template_def(typename C, typename L)(
                            ad_utility::ProgressBar& progressBar) {
   LOG(TIMING) << "Start writing a batch of merged words\n";
 
-  // Smaller grained buffer for the actual inner write.
-  auto bufSize = bufferSize_ / 5;
-  std::future<void> writeFut;
-  std::vector<std::pair<size_t, std::pair<size_t, Id>>> writeBuffer;
-  writeBuffer.reserve(bufSize);
-
-  // Iterate (avoid duplicates).
-  for (auto& top : buffer) {
-    if (!lastTripleComponent_.has_value() ||
-        top.iriOrLiteral() != lastTripleComponent_.value().iriOrLiteral()) {
-      if (lastTripleComponent_.has_value() &&
-          !lessThan(lastTripleComponent_.value(), top.entry_)) {
-        LOG(WARN) << "Total vocabulary order violated for "
-                  << lastTripleComponent_->iriOrLiteral() << " and "
-                  << top.iriOrLiteral() << std::endl;
+  // The expensive comparisons of the words don't depend on the assigned
+  // indices, so we perform them in parallel before the sequential pass.
+  const auto isNewWord = findNewWords(buffer, lessThan);
+
+  // The global ID of each of the queue words in the `buffer`.
+  std::vector<Id> globalIds(buffer.size());
+
+  // The word callback has to be called in the global order of the words, so
+  // this loop is inherently sequential, but it only has to deal with the words
+  // and not with the comparisons anymore.
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    const auto& top = buffer[i];
+    if (isNewWord[i]) {
+      // If a word appears with different values for `isExternal`, then we
+      // externalize it. Duplicates are adjacent, so we only have to look at
+      // the following words that are not new.
+      bool isExternal = top.isExternal();
+      for (size_t j = i + 1; j < buffer.size() && !isNewWord[j]; ++j) {
+        isExternal = isExternal || buffer[j].isExternal();
       }
       lastTripleComponent_ = TripleComponentWithIndex{
-          top.iriOrLiteral(), top.isExternal(), metaData_.numWordsTotal()};
-
-      // TODO<optimization> If we aim to further speed this up, we could
-      // order all the write requests to _outfile _externalOutfile and all the
-      // idVecs to have a more useful external access pattern.
+          top.iriOrLiteral(), isExternal, metaData_.numWordsTotal()};
 
       // Write the new word to the vocabulary.
       auto& nextWord = lastTripleComponent_.value();
@@ -193,49 +194,125 @@ CPP_template_def(typename C, typename L)(
       if (progressBar.update()) {
         LOG(INFO) << progressBar.getProgressString() << std::flush;
       }
-    } else {
-      // If a word appears with different values for `isExternal`, then we
-      // externalize it.
-      bool& external = lastTripleComponent_.value().isExternal();
-      external = external || top.isExternal();
     }
     const auto& word = lastTripleComponent_.value();
-    Id targetId =
+    globalIds[i] =
         word.isBlankNode()
             ? Id::makeFromBlankNodeIndex(BlankNodeIndex::make(word.index_))
             : Id::makeFromVocabIndex(VocabIndex::make(word.index_));
-    // Write pair of local and global ID to buffer.
-    writeBuffer.emplace_back(top.partialFileId_, std::pair{top.id(), targetId});
-
-    if (writeBuffer.size() >= bufSize) {
-      auto task = [this, buffer = std::move(writeBuffer)]() {
-        this->doActualWrite(buffer);
-      };
-      if (writeFut.valid()) {
-        writeFut.get();
-      }
-      writeFut = std::async(task);
-      writeBuffer.clear();
-      writeBuffer.reserve(bufSize);
-    }
   }
 
-  if (writeFut.valid()) {
-    writeFut.get();
+  doActualWrite(buffer, globalIds);
+}
+
+// ____________________________________________________________________________
+template <typename F>
+void VocabularyMerger::runInParallel(size_t numTasks, const F& task) const {
+  AD_CORRECTNESS_CHECK(numTasks <= numThreads_);
+  std::vector<std::future<void>> futures;
+  futures.reserve(numTasks);
+  for (size_t i = 0; i < numTasks; ++i) {
+    // The `packaged_task` stores the exceptions for the `future`, the threads
+    // of the pool must not throw. It is wrapped in a `shared_ptr`, because the
+    // tasks of the pool have to be copyable.
+    auto packagedTask =
+        std::make_shared<std::packaged_task<void()>>([&task, i] { task(i); });
+    futures.push_back(packagedTask->get_future());
+    threadPool_.push([packagedTask] { (*packagedTask)(); });
   }
+  for (auto& future : futures) {
+    future.get();
+  }
+}
 
-  if (!writeBuffer.empty()) {
-    doActualWrite(writeBuffer);
+// ____________________________________________________________________________
+template <typename L>
+std::vector<char> VocabularyMerger::findNewWords(
+    const std::vector<QueueWord>& buffer, const L& lessThan) const {
+  // We use `char` instead of `bool` s.t. the threads can safely write to
+  // adjacent elements.
+  std::vector<char> isNewWord(buffer.size());
+  if (buffer.empty()) {
+    return isNewWord;
   }
+  const size_t numChunks = std::min(numThreads_, buffer.size());
+  const size_t chunkSize = (buffer.size() + numChunks - 1) / numChunks;
+  runInParallel(numChunks, [&](size_t chunk) {
+    const size_t begin = chunk * chunkSize;
+    const size_t end = std::min(begin + chunkSize, buffer.size());
+    for (size_t i = begin; i < end; ++i) {
+      const TripleComponentWithIndex* previous =
+          i == 0 ? (lastTripleComponent_.has_value()
+                        ? &lastTripleComponent_.value()
+                        : nullptr)
+                 : &buffer[i - 1].entry_;
+      const auto& current = buffer[i].entry_;
+      if (previous == nullptr) {
+        isNewWord[i] = true;
+        continue;
+      }
+      isNewWord[i] = current.iriOrLiteral() != previous->iriOrLiteral();
+      if (isNewWord[i] && !lessThan(*previous, current)) {
+        LOG(WARN) << "Total vocabulary order violated for "
+                  << previous->iriOrLiteral() << " and "
+                  << current.iriOrLiteral() << std::endl;
+      }
+    }
+  });
+  return isNewWord;
 }
 
 // ____________________________________________________________________________
-inline void VocabularyMerger::doActualWrite(
-    const std::vector<std::pair<size_t, std::pair<size_t, Id>>>& buffer) {
-  for (const auto& [id, value] : buffer) {
-    idVecs_[id].push_back(
-        {Id::makeFromVocabIndex(VocabIndex::make(value.first)), value.second});
+inline void VocabularyMerger::doActualWrite(const std::vector<QueueWord>& buffer,
+                                            const std::vector<Id>& globalIds) {
+  AD_CORRECTNESS_CHECK(buffer.size() == globalIds.size());
+  if (buffer.empty()) {
+    return;
   }
+  const size_t numChunks = std::min(numThreads_, buffer.size());
+  const size_t chunkSize = (buffer.size() + numChunks - 1) / numChunks;
+  auto forEachInChunk = [&](size_t chunk, const auto& action) {
+    const size_t begin = chunk * chunkSize;
+    const size_t end = std::min(begin + chunkSize, buffer.size());
+    for (size_t i = begin; i < end; ++i) {
+      action(i);
+    }
+  };
+
+  // First count the pairs per chunk of the buffer and per partial file.
+  std::vector<std::vector<size_t>> positions(
+      numChunks, std::vector<size_t>(idVecs_.size(), 0));
+  runInParallel(numChunks, [&](size_t chunk) {
+    forEachInChunk(chunk, [&counts = positions[chunk], &buffer](size_t i) {
+      ++counts[buffer[i].partialFileId_];
+    });
+  });
+
+  // Then turn the counts into the positions at which each chunk writes its
+  // pairs, s.t. the relative order of the pairs in each file is preserved, and
+  // resize the `idVecs_` accordingly.
+  for (size_t fileId = 0; fileId < idVecs_.size(); ++fileId) {
+    auto& idVec = idVecs_[fileId];
+    size_t position = idVec.size();
+    for (auto& chunkPositions : positions) {
+      position += std::exchange(chunkPositions[fileId], position);
+    }
+    if (position > idVec.capacity()) {
+      idVec.reserve(std::max(position, 2 * idVec.capacity()));
+    }
+    idVec.resize(position);
+  }
+
+  // Finally, each chunk writes its pairs to the disjoint positions.
+  runInParallel(numChunks, [&](size_t chunk) {
+    forEachInChunk(chunk, [this, &nextPosition = positions[chunk], &buffer,
+                           &globalIds](size_t i) {
+      const auto fileId = buffer[i].partialFileId_;
+      idVecs_[fileId][nextPosition[fileId]++] = {
+          Id::makeFromVocabIndex(VocabIndex::make(buffer[i].id())),
+          globalIds[i]};
+    });
+  });
 }
 
 // ____________________________________________________________________________________________________________
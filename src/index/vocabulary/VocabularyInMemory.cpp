@@ -10,9 +10,9 @@ using std::string;
 void VocabularyInMemory::open(const string& fileName) {
   AD_LOG_INFO << "Reading vocabulary from file " << fileName << " ..."
               << std::endl;
-  _words.clear();
-  ad_utility::serialization::FileReadSerializer file(fileName);
-  file >> _words;
+  // The words are memory-mapped, so this is fast also for large vocabularies.
+  _words = Words::fromMmappedFile(
+      std::make_shared<const ad_utility::ReadOnlyMmapFile>(fileName));
   AD_LOG_INFO << "Done, number of words: " << size() << std::endl;
 }
 
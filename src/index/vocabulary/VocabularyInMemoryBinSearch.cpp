@@ -11,10 +11,8 @@ void VocabularyInMemoryBinSearch::open(const string& fileName) {
   AD_CORRECTNESS_CHECK(
       words_.size() == 0 && indices_.empty(),
       "Calling open on the same vocabulary twice is probably a bug");
-  {
-    ad_utility::serialization::FileReadSerializer file(fileName);
-    file >> words_;
-  }
+  words_ = Words::fromMmappedFile(
+      std::make_shared<const ad_utility::ReadOnlyMmapFile>(fileName));
   {
     ad_utility::serialization::FileReadSerializer idFile(fileName + ".ids");
     idFile >> indices_;
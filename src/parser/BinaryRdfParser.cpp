@@ -0,0 +1,180 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "parser/BinaryRdfParser.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "parser/Tokenizer.h"
+#include "util/Log.h"
+
+// The integers are read with a plain `memcpy`.
+static_assert(std::endian::native == std::endian::little,
+              "The binary RDF format is only supported on little-endian "
+              "platforms");
+
+// _____________________________________________________________________________
+BinaryRdfParser::BinaryRdfParser(const std::string& filename,
+                                 const EncodedIriManager* encodedIriManager,
+                                 ad_utility::MemorySize bufferSize,
+                                 TripleComponent defaultGraphIri)
+    : RdfParserBase{encodedIriManager},
+      filename_{filename},
+      defaultGraphIri_{std::move(defaultGraphIri)} {
+  if (getInputCompression(filename) == InputCompression::None) {
+    fileBuffer_ = std::make_unique<ParallelFileBuffer>(bufferSize.getBytes());
+  } else {
+    fileBuffer_ =
+        std::make_unique<ParallelDecompressingBuffer>(bufferSize.getBytes());
+  }
+  fileBuffer_->open(filename);
+  readDictionary();
+}
+
+// _____________________________________________________________________________
+bool BinaryRdfParser::fillBuffer(size_t numBytes) {
+  while (buffer_.size() - posInBuffer_ < numBytes) {
+    auto block = fileBuffer_->getNextBlock();
+    if (!block.has_value()) {
+      return false;
+    }
+    numBytesBeforeBuffer_ += posInBuffer_;
+    if (posInBuffer_ == buffer_.size()) {
+      // Everything has been consumed, so we can avoid the copy.
+      buffer_ = std::move(block.value());
+    } else {
+      buffer_.erase(buffer_.begin(), buffer_.begin() + posInBuffer_);
+      buffer_.insert(buffer_.end(), block->begin(), block->end());
+    }
+    posInBuffer_ = 0;
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+std::string_view BinaryRdfParser::readBytes(size_t numBytes) {
+  if (!fillBuffer(numBytes)) {
+    raise(absl::StrCat("Unexpected end of input, expected ", numBytes,
+                       " more bytes"));
+  }
+  std::string_view result{buffer_.data() + posInBuffer_, numBytes};
+  posInBuffer_ += numBytes;
+  return result;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+T BinaryRdfParser::readInteger() {
+  T result;
+  std::memcpy(&result, readBytes(sizeof(T)).data(), sizeof(T));
+  return result;
+}
+
+// _____________________________________________________________________________
+void BinaryRdfParser::readDictionary() {
+  if (readBytes(MAGIC.size()) != MAGIC) {
+    raise(absl::StrCat("The input is not in the binary RDF format, it has to "
+                       "start with \"",
+                       MAGIC, "\""));
+  }
+  auto version = readInteger<uint64_t>();
+  if (version != VERSION) {
+    raise(absl::StrCat("Unsupported version ", version,
+                       " of the binary RDF format, supported is version ",
+                       VERSION));
+  }
+  auto numTerms = readInteger<uint64_t>();
+  LOG(INFO) << "Reading the dictionary of " << numTerms
+            << " terms from the binary RDF file " << filename_ << " ..."
+            << std::endl;
+
+  // Each term is parsed as a single RDF term by the Turtle parser,
+  // which takes care of the unescaping and the normalization of the literals
+  // and of encoding values like numbers directly into an `Id`.
+  RdfStringParser<TurtleParser<Tokenizer>> parser{&encodedIriManager()};
+  terms_.reserve(std::min(numTerms, uint64_t{1} << 24));
+  termKinds_.reserve(terms_.capacity());
+  for (uint64_t i = 0; i < numTerms; ++i) {
+    auto length = readInteger<uint32_t>();
+    auto term = readBytes(length);
+    if (term.empty()) {
+      raise(absl::StrCat("Term #", i, " of the dictionary is empty"));
+    }
+    termKinds_.push_back(term.starts_with('<')   ? TermKind::Iri
+                         : term.starts_with('_') ? TermKind::BlankNode
+                                                 : TermKind::Literal);
+    try {
+      terms_.push_back(parser.parseSingleTerm(term));
+    } catch (const std::exception& e) {
+      raise(absl::StrCat("Term #", i, " of the dictionary (", term,
+                         ") is invalid: ", e.what()));
+    }
+  }
+
+  // Move the IRIs and literals to the `dictionary_`, s.t. the triples only
+  // have to copy an `Id` per term.
+  auto needsEntry = [](const TripleComponent& term) {
+    return term.isIri() || term.isLiteral();
+  };
+  dictionary_ = std::make_shared<std::vector<LocalVocabEntry>>();
+  dictionary_->reserve(
+      static_cast<size_t>(ql::ranges::count_if(terms_, needsEntry)));
+  for (auto& term : terms_) {
+    if (term.isIri()) {
+      dictionary_->emplace_back(std::move(term.getIri()));
+    } else if (term.isLiteral()) {
+      dictionary_->emplace_back(std::move(term.getLiteral()));
+    } else {
+      continue;
+    }
+    term = TripleComponent{Id::makeFromLocalVocabIndex(&dictionary_->back())};
+  }
+}
+
+// _____________________________________________________________________________
+const TripleComponent& BinaryRdfParser::getTerm(
+    uint64_t id, std::string_view positionName,
+    std::initializer_list<TermKind> allowedKinds) {
+  if (id >= terms_.size()) {
+    raise(absl::StrCat("The ", positionName, " of a triple is ", id,
+                       ", but the dictionary only has ", terms_.size(),
+                       " terms"));
+  }
+  if (ql::ranges::find(allowedKinds, termKinds_[id]) == allowedKinds.end()) {
+    raise(absl::StrCat("The term #", id, " can't be the ", positionName,
+                       " of a triple"));
+  }
+  return terms_[id];
+}
+
+// _____________________________________________________________________________
+bool BinaryRdfParser::getLineImpl(TurtleTriple* triple) {
+  static constexpr size_t tripleSize = 4 * sizeof(uint64_t);
+  if (!fillBuffer(tripleSize)) {
+    if (posInBuffer_ != buffer_.size()) {
+      raise("The input ends in the middle of a triple");
+    }
+    return false;
+  }
+  std::array<uint64_t, 4> ids;
+  std::memcpy(ids.data(), buffer_.data() + posInBuffer_, tripleSize);
+  posInBuffer_ += tripleSize;
+  using enum TermKind;
+  triple->subject_ = getTerm(ids[0], "subject", {Iri, BlankNode});
+  triple->predicate_ = getTerm(ids[1], "predicate", {Iri});
+  triple->object_ = getTerm(ids[2], "object", {Iri, BlankNode, Literal});
+  triple->graphIri_ = ids[3] == NO_GRAPH ? defaultGraphIri_
+                                         : getTerm(ids[3], "graph", {Iri});
+  return true;
+}
+
+// _____________________________________________________________________________
+void BinaryRdfParser::raise(std::string_view message) const {
+  throw std::runtime_error{absl::StrCat("Error in the binary RDF file ",
+                                        filename_, " at byte position ",
+                                        getParsePosition(), ": ", message)};
+}
@@ -0,0 +1,122 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_BINARYRDFPARSER_H
+#define QLEVER_SRC_PARSER_BINARYRDFPARSER_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "index/LocalVocabEntry.h"
+#include "parser/ParallelBuffer.h"
+#include "parser/RdfParser.h"
+#include "util/MemorySize/MemorySize.h"
+
+// A parser for a simple binary input format for RDF data that is already
+// dictionary-encoded (for example, because the upstream system that produces
+// the data has its own dictionary). The format consists of a dictionary of the
+// RDF terms followed by the triples as indices into this dictionary:
+//
+//   magic      8 bytes, `QLRDFBIN`
+//   version    uint64, currently 1
+//   numTerms   uint64
+//   terms      `numTerms` times: uint32 `length`, followed by `length` bytes
+//              with the term in N-Triples syntax (`<iri>`, `"literal"@en`,
+//              `"42"^^<http://www.w3.org/2001/XMLSchema#integer>`, `_:label`)
+//   triples    until the end of the input: four uint64 per triple (subject,
+//              predicate, object, graph), each an index into the terms. The
+//              graph `NO_GRAPH` stands for the default graph of the input file.
+//
+// All integers are little-endian. Each term is parsed only once when the
+// dictionary is read, the triples are then created without any tokenizing. The
+// input can be compressed (see `getInputCompression`).
+//
+// The IRIs and literals of the dictionary are stored once as `LocalVocabEntry`s
+// and the triples only refer to them via an `Id` with the datatype
+// `LocalVocabIndex`. That way, no strings are copied per triple, and the
+// `ItemMapManager` in `IndexImpl::passFileForVocabulary` hashes each term only
+// once per batch instead of once per occurrence. The entries are owned by the
+// object returned by `getTermStorage()`, which has to outlive the triples.
+class BinaryRdfParser : public RdfParserBase {
+ public:
+  static constexpr std::string_view MAGIC = "QLRDFBIN";
+  static constexpr uint64_t VERSION = 1;
+  static constexpr uint64_t NO_GRAPH = std::numeric_limits<uint64_t>::max();
+
+  // Open the file and read the complete dictionary. Throw if the file is not
+  // in the format described above or if one of the terms is invalid.
+  BinaryRdfParser(
+      const std::string& filename, const EncodedIriManager* encodedIriManager,
+      ad_utility::MemorySize bufferSize = DEFAULT_PARSER_BUFFER_SIZE,
+      TripleComponent defaultGraphIri =
+          qlever::specialIds().at(DEFAULT_GRAPH_IRI));
+
+  bool getLineImpl(TurtleTriple* triple) override;
+
+  size_t getParsePosition() const override {
+    return numBytesBeforeBuffer_ + posInBuffer_;
+  }
+
+  // The number of terms in the dictionary.
+  size_t numTerms() const { return terms_.size(); }
+
+  // The IRIs and literals of the dictionary, see above.
+  std::shared_ptr<const void> getTermStorage() const override {
+    return dictionary_;
+  }
+
+ private:
+  // The kind of a term determines in which positions of a triple it may occur.
+  enum class TermKind : uint8_t { Iri, Literal, BlankNode };
+
+  // Make sure that at least `numBytes` unread bytes are in the `buffer_`.
+  // Return false if the input ends before.
+  bool fillBuffer(size_t numBytes);
+
+  // Read the next `numBytes` from the input. The result is only valid until
+  // the next call to one of the reading functions. Throw if the input ends
+  // before.
+  std::string_view readBytes(size_t numBytes);
+
+  // Read a single little-endian integer from the input.
+  template <typename T>
+  T readInteger();
+
+  // Read the header and the dictionary and fill `terms_`, `termKinds_`, and
+  // `dictionary_`.
+  void readDictionary();
+
+  // Return the term with the given `id` for the position `positionName` (e.g.
+  // "subject") of a triple. Throw if the `id` is out of range or if its kind
+  // is not one of the `allowedKinds`.
+  const TripleComponent& getTerm(uint64_t id, std::string_view positionName,
+                                 std::initializer_list<TermKind> allowedKinds);
+
+  // Throw an exception that contains the filename and the current position.
+  [[noreturn]] void raise(std::string_view message) const;
+
+  std::string filename_;
+  std::unique_ptr<ParallelBuffer> fileBuffer_;
+  // The bytes that have been read from the `fileBuffer_`, of which the first
+  // `posInBuffer_` have already been consumed.
+  ParallelBuffer::BufferType buffer_;
+  size_t posInBuffer_ = 0;
+  size_t numBytesBeforeBuffer_ = 0;
+
+  // The terms of the dictionary. IRIs and literals are stored in the
+  // `dictionary_` and referenced by an `Id`, blank nodes and values that can
+  // be folded into an `Id` (e.g. numbers) are stored directly.
+  std::vector<TripleComponent> terms_;
+  std::vector<TermKind> termKinds_;
+  // Never resized after the dictionary has been read, so the `Id`s in `terms_`
+  // stay valid.
+  std::shared_ptr<std::vector<LocalVocabEntry>> dictionary_;
+  TripleComponent defaultGraphIri_;
+};
+
+#endif  // QLEVER_SRC_PARSER_BINARYRDFPARSER_H
@@ -3,6 +3,317 @@
 
 #include "./ParallelBuffer.h"
 
+#include <absl/strings/match.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <functional>
+#include <mutex>
+
+// For some include orders the EOF constant is not defined although `<cstdio>`
+// was included, so we define it manually (see `util/CompressorStream.h`).
+#ifndef EOF
+#define EOF std::char_traits<char>::eof()
+#endif
+#include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "../util/ReadOnlyMmapFile.h"
+#include "../util/ThreadSafeQueue.h"
+
+// _____________________________________________________________________________
+InputCompression getInputCompression(std::string_view filename) {
+  if (absl::EndsWith(filename, ".gz")) {
+    return InputCompression::Gzip;
+  }
+  if (absl::EndsWith(filename, ".zst") || absl::EndsWith(filename, ".zstd")) {
+    return InputCompression::Zstd;
+  }
+  return InputCompression::None;
+}
+
+// _____________________________________________________________________________
+std::string_view stripCompressionSuffix(std::string_view filename) {
+  if (getInputCompression(filename) == InputCompression::None) {
+    return filename;
+  }
+  return filename.substr(0, filename.rfind('.'));
+}
+
+namespace {
+using BufferType = ParallelBuffer::BufferType;
+
+// Throw if `returnValue` of one of the functions of zstd indicates an error.
+void throwIfZstdError(size_t returnValue, std::string_view filename) {
+  if (ZSTD_isError(returnValue)) {
+    throw std::runtime_error{absl::StrCat("Error while decompressing the file ",
+                                          filename, " with zstd: ",
+                                          ZSTD_getErrorName(returnValue))};
+  }
+}
+
+using ZstdContext = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+ZstdContext makeZstdContext() {
+  return {ZSTD_createDCtx(), &ZSTD_freeDCtx};
+}
+
+// Decompress `input`, which has to consist of complete zstd frames, and
+// return the concatenation of the decompressed frames. `sizeHint` is the
+// expected size of the result.
+BufferType decompressZstdFrames(std::string_view input, size_t sizeHint,
+                                std::string_view filename) {
+  auto context = makeZstdContext();
+  BufferType result;
+  result.resize(std::max(sizeHint, ZSTD_DStreamOutSize()));
+  ZSTD_inBuffer in{input.data(), input.size(), 0};
+  size_t numBytesWritten = 0;
+  while (true) {
+    if (numBytesWritten == result.size()) {
+      result.resize(2 * result.size());
+    }
+    ZSTD_outBuffer out{result.data() + numBytesWritten,
+                       result.size() - numBytesWritten, 0};
+    auto returnValue = ZSTD_decompressStream(context.get(), &out, &in);
+    throwIfZstdError(returnValue, filename);
+    numBytesWritten += out.pos;
+    // If all the input has been consumed, and the output buffer was not
+    // filled, then the decoder has flushed all of its data.
+    if (in.pos == in.size && out.pos < out.size) {
+      AD_CORRECTNESS_CHECK(returnValue == 0);
+      break;
+    }
+  }
+  result.resize(numBytesWritten);
+  return result;
+}
+
+// Decompress a zstd file sequentially and yield the decompressed data in
+// blocks of `blocksize` bytes. Also works for pipes and for files with a
+// single frame (which is what `zstd` writes by default).
+class ZstdStreamDecompressor {
+ private:
+  std::string filename_;
+  ad_utility::File file_;
+  size_t blocksize_;
+  ZstdContext context_ = makeZstdContext();
+  std::vector<char> input_ = std::vector<char>(ZSTD_DStreamInSize());
+  ZSTD_inBuffer inBuffer_{input_.data(), 0, 0};
+  bool eof_ = false;
+
+ public:
+  ZstdStreamDecompressor(const std::string& filename, size_t blocksize)
+      : filename_{filename}, file_{filename, "r"}, blocksize_{blocksize} {}
+
+  // Return the next block of decompressed data, or `nullopt` at the end of
+  // the file.
+  std::optional<BufferType> operator()() {
+    BufferType block;
+    block.resize(blocksize_);
+    size_t numBytesWritten = 0;
+    while (numBytesWritten < block.size()) {
+      if (inBuffer_.pos == inBuffer_.size && !eof_) {
+        inBuffer_.size = file_.read(input_.data(), input_.size());
+        inBuffer_.pos = 0;
+        eof_ = inBuffer_.size == 0;
+      }
+      ZSTD_outBuffer out{block.data() + numBytesWritten,
+                         block.size() - numBytesWritten, 0};
+      auto returnValue =
+          ZSTD_decompressStream(context_.get(), &out, &inBuffer_);
+      throwIfZstdError(returnValue, filename_);
+      numBytesWritten += out.pos;
+      // At the end of the input, the decoder has to flush all the data it has
+      // buffered. A return value different from zero then means that the last
+      // frame is incomplete.
+      if (eof_ && out.pos == 0) {
+        if (returnValue != 0) {
+          throw std::runtime_error{absl::StrCat(
+              "The zstd-compressed file ", filename_, " is truncated")};
+        }
+        break;
+      }
+    }
+    if (numBytesWritten == 0) {
+      return std::nullopt;
+    }
+    block.resize(numBytesWritten);
+    return block;
+  }
+};
+
+// Decompress a gzip file sequentially and yield the decompressed data in
+// blocks of `blocksize` bytes. A file that consists of several gzip members
+// (e.g. the result of concatenating gzip files) is also supported.
+class GzipStreamDecompressor {
+ private:
+  std::string filename_;
+  size_t blocksize_;
+  boost::iostreams::filtering_istream stream_;
+
+ public:
+  GzipStreamDecompressor(const std::string& filename, size_t blocksize)
+      : filename_{filename}, blocksize_{blocksize} {
+    // `file_source` does not report a missing file before the first read.
+    if (!std::filesystem::exists(filename_)) {
+      throw std::runtime_error{
+          absl::StrCat("Could not open file ", filename_, " for reading")};
+    }
+    stream_.push(boost::iostreams::gzip_decompressor{});
+    stream_.push(
+        boost::iostreams::file_source{filename_, std::ios_base::binary});
+    stream_.exceptions(std::ios_base::badbit);
+  }
+
+  // Return the next block of decompressed data, or `nullopt` at the end of
+  // the file.
+  std::optional<BufferType> operator()() {
+    BufferType block;
+    block.resize(blocksize_);
+    try {
+      stream_.read(block.data(), static_cast<std::streamsize>(block.size()));
+    } catch (const std::exception& e) {
+      throw std::runtime_error{
+          absl::StrCat("Error while decompressing the file ", filename_,
+                       " with gzip: ", e.what())};
+    }
+    auto numBytesRead = static_cast<size_t>(stream_.gcount());
+    if (numBytesRead == 0) {
+      return std::nullopt;
+    }
+    block.resize(numBytesRead);
+    return block;
+  }
+};
+
+// The state that is shared between the threads that decompress the frames of
+// a memory-mapped zstd file concurrently. The frames are assigned to the
+// threads in groups that have a decompressed size of (approximately)
+// `blocksize` bytes.
+class ZstdFrameGroups {
+ private:
+  std::shared_ptr<const ad_utility::ReadOnlyMmapFile> file_;
+  size_t blocksize_;
+  std::mutex mutex_;
+  size_t offset_ = 0;
+  size_t nextIndex_ = 0;
+
+ public:
+  ZstdFrameGroups(std::shared_ptr<const ad_utility::ReadOnlyMmapFile> file,
+                  size_t blocksize)
+      : file_{std::move(file)}, blocksize_{blocksize} {}
+
+  // Return a memory-mapped zstd file if it exists, is a regular file, and
+  // consists of more than one frame, else `nullptr`.
+  static std::shared_ptr<const ad_utility::ReadOnlyMmapFile> mapIfMultiFrame(
+      const std::string& filename) {
+    if (!std::filesystem::is_regular_file(filename)) {
+      return nullptr;
+    }
+    auto file = std::make_shared<const ad_utility::ReadOnlyMmapFile>(filename);
+    auto firstFrameSize =
+        ZSTD_findFrameCompressedSize(file->data(), file->size());
+    if (ZSTD_isError(firstFrameSize) || firstFrameSize >= file->size()) {
+      return nullptr;
+    }
+    return file;
+  }
+
+  // Determine the next group of frames (under the lock), and decompress it
+  // (without the lock). Return the index of the group together with the
+  // decompressed data, or `nullopt` if all frames have been assigned.
+  std::optional<std::pair<size_t, BufferType>> decompressNextGroup() {
+    std::unique_lock lock{mutex_};
+    if (offset_ == file_->size()) {
+      return std::nullopt;
+    }
+    size_t begin = offset_;
+    size_t expectedSize = 0;
+    while (offset_ < file_->size() && expectedSize < blocksize_) {
+      const char* frame = file_->data() + offset_;
+      size_t remaining = file_->size() - offset_;
+      auto frameSize = ZSTD_findFrameCompressedSize(frame, remaining);
+      throwIfZstdError(frameSize, file_->filename());
+      auto contentSize = ZSTD_getFrameContentSize(frame, remaining);
+      // Frames whose decompressed size is not stored in the header end the
+      // group.
+      expectedSize += contentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+                              contentSize == ZSTD_CONTENTSIZE_ERROR
+                          ? blocksize_
+                          : contentSize;
+      offset_ += frameSize;
+    }
+    auto index = nextIndex_++;
+    std::string_view group{file_->data() + begin, offset_ - begin};
+    lock.unlock();
+    return std::pair{index, decompressZstdFrames(group, expectedSize,
+                                                 file_->filename())};
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+ParallelDecompressingBuffer::ParallelDecompressingBuffer(size_t blocksize,
+                                                         size_t numThreads)
+    : ParallelBuffer{blocksize}, numThreads_{std::max(numThreads, 1UL)} {}
+
+// _____________________________________________________________________________
+void ParallelDecompressingBuffer::open(const std::string& filename) {
+  using namespace ad_utility::data_structures;
+  auto compression = getInputCompression(filename);
+  AD_CONTRACT_CHECK(compression != InputCompression::None);
+  blocks_.reset();
+  if (compression == InputCompression::Zstd && numThreads_ > 1) {
+    if (auto file = ZstdFrameGroups::mapIfMultiFrame(filename)) {
+      auto groups = std::make_shared<ZstdFrameGroups>(std::move(file),
+                                                      blocksize_);
+      blocks_ = queueManager<OrderedThreadSafeQueue<BufferType>>(
+          numThreads_, numThreads_,
+          [groups]() { return groups->decompressNextGroup(); });
+      return;
+    }
+  }
+  // Sequential decompression, which is still pipelined with the consumer of
+  // the blocks because it runs in a separate thread.
+  using Producer = std::function<std::optional<BufferType>()>;
+  auto decompressNextBlock = [&]() -> Producer {
+    if (compression == InputCompression::Zstd) {
+      auto decompressor =
+          std::make_shared<ZstdStreamDecompressor>(filename, blocksize_);
+      return [decompressor]() { return (*decompressor)(); };
+    }
+    auto decompressor =
+        std::make_shared<GzipStreamDecompressor>(filename, blocksize_);
+    return [decompressor]() { return (*decompressor)(); };
+  }();
+  blocks_ = queueManager<ThreadSafeQueue<BufferType>>(
+      1, 1, std::move(decompressNextBlock));
+}
+
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelDecompressingBuffer::getNextBlock() {
+  AD_CONTRACT_CHECK(blocks_.has_value(),
+                    "`open` has to be called before `getNextBlock`");
+  // Skip empty blocks (e.g. from groups that only consist of skippable zstd
+  // frames), the consumers of a `ParallelBuffer` expect nonempty blocks.
+  auto block = blocks_->get();
+  while (block.has_value() && block->empty()) {
+    block = blocks_->get();
+  }
+  return block;
+}
+
+// _____________________________________________________________________________
+void ParallelBufferWithEndRegex::open(const std::string& filename) {
+  if (getInputCompression(filename) == InputCompression::None) {
+    rawBuffer_ = std::make_unique<ParallelFileBuffer>(blocksize_);
+  } else {
+    rawBuffer_ = std::make_unique<ParallelDecompressingBuffer>(blocksize_);
+  }
+  rawBuffer_->open(filename);
+}
+
 // _________________________________________________________________________
 void ParallelFileBuffer::open(const std::string& filename) {
   file_.open(filename, "r");
@@ -72,9 +383,11 @@ std::optional<size_t> ParallelBufferWithEndRegex::findRegexNearEnd(
 // _____________________________________________________________________________
 std::optional<ParallelBuffer::BufferType>
 ParallelBufferWithEndRegex::getNextBlock() {
+  AD_CONTRACT_CHECK(rawBuffer_ != nullptr,
+                    "`open` has to be called before `getNextBlock`");
   // Get the block of data read asynchronously after the previous call
   // to `getNextBlock`.
-  auto rawInput = rawBuffer_.getNextBlock();
+  auto rawInput = rawBuffer_->getNextBlock();
 
   // If there was no more data, return the remainder or `std::nullopt` if
   // it is empty.
@@ -100,7 +413,7 @@ ParallelBufferWithEndRegex::getNextBlock() {
   // last block (then `getNextBlock` will return `std::nullopt`, and we simply
   // concatenate it to the remainder).
   if (!endPosition) {
-    if (rawBuffer_.getNextBlock()) {
+    if (rawBuffer_->getNextBlock()) {
       throw std::runtime_error(absl::StrCat(
           "The regex ", endRegexAsString_,
           " which marks the end of a statement was not found in the current "
@@ -9,13 +9,27 @@
 #include <re2/re2.h>
 
 #include <future>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../util/File.h"
+#include "../util/Iterators.h"
 #include "../util/UninitializedAllocator.h"
 
+// The compression of an input file, which is determined by the suffix of its
+// name (`.gz` for gzip, `.zst` or `.zstd` for zstd).
+enum class InputCompression { None, Gzip, Zstd };
+
+// Return the compression of the file with the given `filename`.
+InputCompression getInputCompression(std::string_view filename);
+
+// Return the `filename` without the suffix that indicates its compression (if
+// any), e.g. `data.ttl` for `data.ttl.zst`.
+std::string_view stripCompressionSuffix(std::string_view filename);
+
 /**
  * @brief Abstract base class for certain input buffers.
  *
@@ -81,8 +95,39 @@ class ParallelFileBuffer : public ParallelBuffer {
   std::future<size_t> fut_;
 };
 
+// A parallel buffer that reads a gzip- or zstd-compressed file and yields the
+// decompressed data in blocks of (approximately) `blocksize` bytes. The
+// decompression runs in the background, so that it overlaps with the
+// processing of the previous blocks. If a zstd file consists of several
+// independent frames (as written by `pzstd` or by the seekable format of zstd),
+// then these frames are additionally decompressed concurrently by
+// `numThreads` threads. A gzip file (and a zstd file with a single frame) can
+// only be decompressed sequentially.
+class ParallelDecompressingBuffer : public ParallelBuffer {
+ public:
+  explicit ParallelDecompressingBuffer(
+      size_t blocksize,
+      size_t numThreads = DEFAULT_NUM_DECOMPRESSION_THREADS);
+
+  // Open the file, the compression is determined by `getInputCompression`.
+  void open(const std::string& filename) override;
+
+  // Get the next block of the decompressed data.
+  std::optional<BufferType> getNextBlock() override;
+
+  // The default for the number of threads that decompress the frames of a
+  // zstd file concurrently. A single thread decompresses zstd at roughly
+  // 1 GB/s, so a few threads suffice to keep up with the parsing.
+  static constexpr size_t DEFAULT_NUM_DECOMPRESSION_THREADS = 4;
+
+ private:
+  size_t numThreads_;
+  std::optional<ad_utility::InputRangeTypeErased<BufferType>> blocks_;
+};
+
 // A parallel buffer that reads input from the file in blocks, where each block,
-// except possibly the last, ends with `endRegex`.
+// except possibly the last, ends with `endRegex`. If the file is compressed
+// (see `getInputCompression`), then it is transparently decompressed.
 class ParallelBufferWithEndRegex : public ParallelBuffer {
  public:
   ParallelBufferWithEndRegex(size_t blocksize, std::string endRegex)
@@ -97,7 +142,7 @@ class ParallelBufferWithEndRegex : public ParallelBuffer {
   std::optional<BufferType> getNextBlock() override;
 
   // Open the file from which the blocks are read.
-  void open(const std::string& filename) override { rawBuffer_.open(filename); }
+  void open(const std::string& filename) override;
 
  private:
   // Find `regex` near the end of `vec` by searching in blocks of 1000, 2000,
@@ -106,7 +151,9 @@ class ParallelBufferWithEndRegex : public ParallelBuffer {
   // of the regex match, or std::nullopt if the regex was not found at all.
   static std::optional<size_t> findRegexNearEnd(const BufferType& vec,
                                                 const re2::RE2& regex);
-  ParallelFileBuffer rawBuffer_{blocksize_};
+  // A `ParallelFileBuffer` or a `ParallelDecompressingBuffer`, depending on
+  // the compression of the file. Is set by `open`.
+  std::unique_ptr<ParallelBuffer> rawBuffer_;
   BufferType remainder_;
   re2::RE2 endRegex_;
   std::string endRegexAsString_;
@@ -76,6 +76,10 @@ class ParsedQuery {
   std::string _originalString;
   std::optional<parsedQuery::Values> postQueryValuesClause_ = std::nullopt;
 
+  // False if this query must not be reused for more than one execution (see
+  // `SparqlQleverVisitor::parsedQueryMayBeReused_`).
+  bool mayBeReused_ = true;
+
   // Contains warnings about queries that are valid according to the SPARQL
   // standard, but are probably semantically wrong.
   std::vector<std::string> warnings_;
@@ -0,0 +1,195 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "parser/ParsedQueryCache.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <functional>
+#include <utility>
+
+#include "global/Constants.h"
+#include "global/RuntimeParameters.h"
+#include "parser/SparqlParser.h"
+#include "util/Algorithm.h"
+
+// _____________________________________________________________________________
+ParsedQueryCache::ParsedQueryCache(size_t maxNumEntries) {
+  setMaxNumEntries(maxNumEntries);
+}
+
+// _____________________________________________________________________________
+void ParsedQueryCache::setMaxNumEntries(size_t maxNumEntries) {
+  cache_.withWriteLock([maxNumEntries](std::optional<Cache>& cache) {
+    cache.reset();
+    if (maxNumEntries > 0) {
+      cache.emplace(maxNumEntries);
+    }
+  });
+}
+
+// _____________________________________________________________________________
+size_t ParsedQueryCache::numEntries() const {
+  return cache_.withReadLock([](const std::optional<Cache>& cache) {
+    return cache.has_value() ? cache->size() : 0;
+  });
+}
+
+// _____________________________________________________________________________
+std::string ParsedQueryCache::makeKey(
+    const QueryTemplate& queryTemplate,
+    const std::vector<DatasetClause>& datasets) {
+  auto params = RuntimeParameters();
+  std::string key = absl::StrCat(params.get<"syntax-test-mode">(),
+                                 params.get<"throw-on-unbound-variables">());
+  for (const auto& dataset : datasets) {
+    absl::StrAppend(&key, dataset.isNamed_ ? "N" : "D",
+                    dataset.dataset_.toStringRepresentation(), "\n");
+  }
+  absl::StrAppend(&key, "\n", queryTemplate.key());
+  return key;
+}
+
+// _____________________________________________________________________________
+auto ParsedQueryCache::makeEntry(const EncodedIriManager* encodedIriManager,
+                                 const QueryTemplate& queryTemplate,
+                                 ParsedQuery parsedQuery,
+                                 const std::vector<DatasetClause>& datasets)
+    -> Entry {
+  const auto& constants = queryTemplate.constants();
+  Entry entry{std::move(parsedQuery), {constants.begin(), constants.end()}};
+  if (constants.empty()) {
+    return entry;
+  }
+  // Parse the query with placeholders for all the constants to find out which
+  // of them only occur as the subject or object of a triple. The triples with
+  // QLever-internal predicates (for example, `ql:contains-word`) are excluded,
+  // because the parser derives additional information from their objects.
+  std::vector<bool> isSubstituted(constants.size(), false);
+  std::optional<ParsedQuery> withPlaceholders;
+  try {
+    withPlaceholders = SparqlParser::parseQuery(
+        encodedIriManager,
+        queryTemplate.withPlaceholders(
+            std::vector<bool>(constants.size(), true)),
+        datasets);
+  } catch (const std::exception&) {
+    // For example, a literal that was replaced by an IRI in a place where only
+    // literals are allowed. Then no constant is substituted.
+    return entry;
+  }
+  std::vector<bool> isInInternalTriple(constants.size(), false);
+  QueryTemplate::forEachTriple(
+      std::as_const(withPlaceholders->_rootGraphPattern),
+      [&](const SparqlTriple& triple) {
+        auto predicate = triple.getSimplePredicate();
+        bool isInternal =
+            predicate.has_value() &&
+            predicate->starts_with(
+                QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET);
+        for (const auto* term : {&triple.s_, &triple.o_}) {
+          if (auto i = QueryTemplate::getPlaceholderIndex(*term)) {
+            (isInternal ? isInInternalTriple : isSubstituted).at(i.value()) =
+                true;
+          }
+        }
+      });
+  for (size_t i = 0; i < constants.size(); ++i) {
+    isSubstituted[i] = isSubstituted[i] && !isInInternalTriple[i];
+  }
+  if (ql::ranges::none_of(isSubstituted, std::identity{})) {
+    return entry;
+  }
+  // Each constant occurs only once in the query, so if it was found in a
+  // triple, it doesn't occur anywhere else.
+  if (!ql::ranges::all_of(isSubstituted, std::identity{})) {
+    try {
+      withPlaceholders = SparqlParser::parseQuery(
+          encodedIriManager, queryTemplate.withPlaceholders(isSubstituted),
+          datasets);
+    } catch (const std::exception&) {
+      return entry;
+    }
+  }
+  entry.parsedQuery_ = std::move(withPlaceholders.value());
+  for (size_t i = 0; i < constants.size(); ++i) {
+    if (isSubstituted[i]) {
+      entry.fixedConstants_[i] = std::nullopt;
+    }
+  }
+  return entry;
+}
+
+// _____________________________________________________________________________
+std::optional<ParsedQuery> ParsedQueryCache::instantiate(
+    const EncodedIriManager* encodedIriManager, const Entry& entry,
+    const QueryTemplate& queryTemplate) {
+  const auto& constants = queryTemplate.constants();
+  // The number of constants is part of the key.
+  AD_CORRECTNESS_CHECK(constants.size() == entry.fixedConstants_.size());
+  std::vector<std::optional<TripleComponent>> values(constants.size());
+  for (size_t i = 0; i < constants.size(); ++i) {
+    const auto& fixed = entry.fixedConstants_[i];
+    if (fixed.has_value()) {
+      if (fixed.value() != constants[i]) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    try {
+      values[i] = QueryTemplate::parseConstant(encodedIriManager, constants[i]);
+    } catch (const std::exception&) {
+      // The query is parsed completely, which reports the error if the
+      // constant is invalid.
+      return std::nullopt;
+    }
+  }
+  ParsedQuery result = entry.parsedQuery_;
+  QueryTemplate::forEachTriple(
+      result._rootGraphPattern, [&values](SparqlTriple& triple) {
+        for (auto* term : {&triple.s_, &triple.o_}) {
+          if (auto i = QueryTemplate::getPlaceholderIndex(*term)) {
+            *term = values.at(i.value()).value();
+          }
+        }
+      });
+  return result;
+}
+
+// _____________________________________________________________________________
+ParsedQuery ParsedQueryCache::getOrParse(
+    const EncodedIriManager* encodedIriManager, const std::string& query,
+    const std::vector<DatasetClause>& datasets) {
+  QueryTemplate queryTemplate{query};
+  auto key = makeKey(queryTemplate, datasets);
+  using Ptr = std::shared_ptr<const Entry>;
+  auto cached = cache_.withWriteLock([&key](std::optional<Cache>& cache) {
+    const Ptr* result =
+        cache.has_value() ? cache->getIfContained(key) : nullptr;
+    return result != nullptr ? *result : Ptr{};
+  });
+  if (cached != nullptr) {
+    auto result = instantiate(encodedIriManager, *cached, queryTemplate);
+    if (result.has_value()) {
+      ++numHits_;
+      result->_originalString = query;
+      return std::move(result.value());
+    }
+  }
+  ++numMisses_;
+
+  // The parsing is done without holding the lock. If the query is invalid, the
+  // exception is propagated and nothing is stored.
+  auto parsed = SparqlParser::parseQuery(encodedIriManager, query, datasets);
+  if (!parsed.mayBeReused_) {
+    return parsed;
+  }
+  auto entry = std::make_shared<const Entry>(
+      makeEntry(encodedIriManager, queryTemplate, parsed, datasets));
+  cache_.withWriteLock([&key, &entry](std::optional<Cache>& cache) {
+    if (cache.has_value()) {
+      cache->insertOrAssign(key, std::move(entry));
+    }
+  });
+  return parsed;
+}
@@ -0,0 +1,93 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_PARSEDQUERYCACHE_H
+#define QLEVER_SRC_PARSER_PARSEDQUERYCACHE_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/QueryTemplate.h"
+#include "parser/sparqlParser/DatasetClause.h"
+#include "util/LruCache.h"
+#include "util/Synchronized.h"
+
+// A thread-safe LRU cache for the results of `SparqlParser::parseQuery`, s.t.
+// queries that are sent repeatedly (for example, by an application that always
+// sends the same few queries) don't have to be parsed again. The key is the
+// `QueryTemplate` of the query (the normalized text without the IRIs and
+// literals) together with the datasets from the SPARQL protocol. That way,
+// queries that only differ in their constants share an entry: The entry
+// contains the query parsed with placeholders for the constants that only
+// occur as the subject or object of a triple. For a hit, these constants are
+// parsed on their own and substituted into a copy of the parsed query. All the
+// other constants (for example, in a `FILTER` or as a graph IRI) have to be
+// equal to the ones of the cached query, otherwise the query is parsed again
+// and replaces the entry.
+//
+// The results of the query planning are not cached, because the operations are
+// bound to the `QueryExecutionContext` of a single request and their estimates
+// depend on the current state of the index (including the updates).
+class ParsedQueryCache {
+ public:
+  // A cache with `maxNumEntries == 0` is disabled, then every query is parsed.
+  explicit ParsedQueryCache(size_t maxNumEntries);
+
+  // Return the result of `SparqlParser::parseQuery` for the given arguments,
+  // either from the cache or by parsing the query (and then storing the result
+  // in the cache). A query that can't be parsed throws the same exception as
+  // `SparqlParser::parseQuery` and is not cached. Neither is a query that must
+  // not be reused for more than one execution (see `ParsedQuery::mayBeReused_`,
+  // for example, because it contains `NOW()`).
+  ParsedQuery getOrParse(const EncodedIriManager* encodedIriManager,
+                         const std::string& query,
+                         const std::vector<DatasetClause>& datasets = {});
+
+  // Change the maximal number of entries. This clears the cache.
+  void setMaxNumEntries(size_t maxNumEntries);
+
+  size_t numEntries() const;
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+
+ private:
+  struct Entry {
+    // The query, parsed with the placeholders (see `QueryTemplate`) for the
+    // constants that are substituted.
+    ParsedQuery parsedQuery_;
+    // For each constant of the template: `std::nullopt` if it is substituted,
+    // else the constant that a query needs to use this entry.
+    std::vector<std::optional<std::string>> fixedConstants_;
+  };
+
+  // Return the key for the given `queryTemplate` and `datasets`. It also
+  // contains the runtime parameters that change the result of the parsing.
+  static std::string makeKey(const QueryTemplate& queryTemplate,
+                             const std::vector<DatasetClause>& datasets);
+
+  // Create the entry for a query with the given `queryTemplate` that was
+  // parsed to `parsedQuery`.
+  static Entry makeEntry(const EncodedIriManager* encodedIriManager,
+                         const QueryTemplate& queryTemplate,
+                         ParsedQuery parsedQuery,
+                         const std::vector<DatasetClause>& datasets);
+
+  // Return the query with the given `queryTemplate` from the `entry`, or
+  // `std::nullopt` if the `entry` can't be used for it (see above).
+  static std::optional<ParsedQuery> instantiate(
+      const EncodedIriManager* encodedIriManager, const Entry& entry,
+      const QueryTemplate& queryTemplate);
+
+  using Cache =
+      ad_utility::util::LRUCache<std::string, std::shared_ptr<const Entry>>;
+  // `std::nullopt` iff the cache is disabled.
+  ad_utility::Synchronized<std::optional<Cache>> cache_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+};
+
+#endif  // QLEVER_SRC_PARSER_PARSEDQUERYCACHE_H
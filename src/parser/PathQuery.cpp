@@ -33,6 +33,8 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
     setVariable("edgeColumn", object, edgeColumn_);
   } else if (predString == "edgeProperty") {
     edgeProperties_.push_back(getVariable("edgeProperty", object));
+  } else if (predString == "weight") {
+    setVariable("weight", object, edgeWeight_);
   } else if (predString == "cartesian") {
     if (!object.isBool()) {
       throw PathSearchException("The parameter <cartesian> expects a boolean");
@@ -52,16 +54,24 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
 
     if (objString == "allPaths") {
       algorithm_ = PathSearchAlgorithm::ALL_PATHS;
+    } else if (objString == "shortestPaths") {
+      algorithm_ = PathSearchAlgorithm::SHORTEST_PATHS;
+    } else if (objString == "bidirectionalShortestPaths") {
+      algorithm_ = PathSearchAlgorithm::BIDIRECTIONAL_SHORTEST_PATHS;
+    } else if (objString == "kShortestPaths") {
+      algorithm_ = PathSearchAlgorithm::K_SHORTEST_PATHS;
     } else {
-      throw PathSearchException(
-          absl::StrCat("Unsupported algorithm in pathSearch: ", objString,
-                       ". Supported Algorithms: <allPaths>."));
+      throw PathSearchException(absl::StrCat(
+          "Unsupported algorithm in pathSearch: ", objString,
+          ". Supported Algorithms: <allPaths>, <shortestPaths>, "
+          "<bidirectionalShortestPaths>, <kShortestPaths>."));
     }
   } else {
     throw PathSearchException(absl::StrCat(
         "Unsupported argument <", predString,
         "> in PathSearch. Supported Arguments: <source>, <target>, <start>, "
-        "<end>, <pathColumn>, <edgeColumn>, <edgeProperty>, <algorithm>."));
+        "<end>, <pathColumn>, <edgeColumn>, <edgeProperty>, <weight>, "
+        "<algorithm>."));
   }
 }
 
@@ -106,12 +116,19 @@ PathSearchConfiguration PathQuery::toPathSearchConfiguration(
   } else if (!edgeColumn_.has_value()) {
     throw PathSearchException("Missing parameter <edgeColumn> in path search.");
   }
+  if (edgeWeight_.has_value() &&
+      algorithm_ != PathSearchAlgorithm::SHORTEST_PATHS &&
+      algorithm_ != PathSearchAlgorithm::K_SHORTEST_PATHS) {
+    throw PathSearchException(
+        "The parameter <weight> is only supported by the algorithms "
+        "<shortestPaths> and <kShortestPaths>.");
+  }
 
   return PathSearchConfiguration{
       algorithm_,          sources,         targets,
       start_.value(),      end_.value(),    pathColumn_.value(),
       edgeColumn_.value(), edgeProperties_, cartesian_,
-      numPathsPerTarget_};
+      numPathsPerTarget_, edgeWeight_};
 }
 
 }  // namespace parsedQuery
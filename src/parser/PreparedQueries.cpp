@@ -0,0 +1,188 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "parser/PreparedQueries.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <iterator>
+#include <random>
+#include <type_traits>
+
+#include "parser/QueryTemplate.h"
+#include "parser/SparqlParser.h"
+#include "util/Algorithm.h"
+#include "util/HashSet.h"
+
+namespace {
+// Return a random ID with 128 bits from a non-deterministic source.
+std::string generateId() {
+  std::random_device randomDevice;
+  std::string id;
+  for (size_t i = 0; i < 4; ++i) {
+    absl::StrAppendFormat(&id, "%08x", randomDevice());
+  }
+  return id;
+}
+
+// Add the variables that are assigned by a `BIND` or `VALUES` clause in the
+// `pattern` or in a graph pattern that is nested in it to `result`.
+void addAssignedVariables(const parsedQuery::GraphPattern& pattern,
+                          ad_utility::HashSet<Variable>& result) {
+  using namespace parsedQuery;
+  for (const auto& operation : pattern._graphPatterns) {
+    operation.visit([&result](const auto& arg) {
+      using T = std::decay_t<decltype(arg)>;
+      if constexpr (std::is_same_v<T, Bind>) {
+        result.insert(arg._target);
+      } else if constexpr (std::is_same_v<T, Values>) {
+        result.insert(arg._inlineValues._variables.begin(),
+                      arg._inlineValues._variables.end());
+      } else if constexpr (std::is_same_v<T, Optional> ||
+                           std::is_same_v<T, Minus> ||
+                           std::is_same_v<T, GroupGraphPattern>) {
+        addAssignedVariables(arg._child, result);
+      } else if constexpr (std::is_same_v<T, Union>) {
+        addAssignedVariables(arg._child1, result);
+        addAssignedVariables(arg._child2, result);
+      } else if constexpr (std::is_same_v<T, Subquery>) {
+        addAssignedVariables(arg.get()._rootGraphPattern, result);
+      }
+    });
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+PreparedQueries::PreparedQueries(size_t maxNumQueries) {
+  setMaxNumQueries(maxNumQueries);
+}
+
+// _____________________________________________________________________________
+void PreparedQueries::setMaxNumQueries(size_t maxNumQueries) {
+  registry_.withWriteLock([maxNumQueries](std::optional<Registry>& registry) {
+    registry.reset();
+    if (maxNumQueries > 0) {
+      registry.emplace(maxNumQueries);
+    }
+  });
+}
+
+// _____________________________________________________________________________
+size_t PreparedQueries::numQueries() const {
+  return registry_.withWriteLock([](const std::optional<Registry>& registry) {
+    return registry.has_value() ? registry->size() : 0;
+  });
+}
+
+// _____________________________________________________________________________
+std::string PreparedQueries::prepare(const EncodedIriManager* encodedIriManager,
+                                     std::string query,
+                                     std::vector<DatasetClause> datasets) {
+  // The parsing is done without holding the lock.
+  auto parsedQuery =
+      SparqlParser::parseQuery(encodedIriManager, query, datasets);
+  auto prepared = std::make_shared<PreparedQuery>();
+  // The variables that are assigned in the query itself are not parameters,
+  // because the `VALUES` clause of `bind` would be joined with them instead of
+  // substituting them.
+  ad_utility::HashSet<Variable> assignedVariables;
+  addAssignedVariables(parsedQuery._rootGraphPattern, assignedVariables);
+  if (parsedQuery.postQueryValuesClause_.has_value()) {
+    const auto& variables =
+        parsedQuery.postQueryValuesClause_->_inlineValues._variables;
+    assignedVariables.insert(variables.begin(), variables.end());
+  }
+  ql::ranges::copy_if(parsedQuery.getVisibleVariables(),
+                      std::back_inserter(prepared->parameters_),
+                      [&assignedVariables](const Variable& var) {
+                        return !assignedVariables.contains(var);
+                      });
+  if (parsedQuery.mayBeReused_) {
+    prepared->parsedQuery_ = std::move(parsedQuery);
+  }
+  prepared->query_ = std::move(query);
+  prepared->datasets_ = std::move(datasets);
+
+  auto id = generateId();
+  registry_.withWriteLock([&id, &prepared](std::optional<Registry>& registry) {
+    if (!registry.has_value()) {
+      throw std::runtime_error(
+          "Preparing queries is disabled (the runtime parameter "
+          "\"prepared-queries-max-num-entries\" is 0)");
+    }
+    registry->getOrCompute(
+        id, [&prepared](const std::string&) -> Ptr { return prepared; });
+  });
+  return id;
+}
+
+// _____________________________________________________________________________
+auto PreparedQueries::get(const std::string& id) -> Ptr {
+  auto prepared =
+      registry_.withWriteLock([&id](std::optional<Registry>& registry) {
+        const Ptr* result =
+            registry.has_value() ? registry->getIfContained(id) : nullptr;
+        return result != nullptr ? *result : Ptr{};
+      });
+  if (prepared == nullptr) {
+    throw std::runtime_error(
+        absl::StrCat("There is no prepared query with ID \"", id,
+                     "\", it might have been removed because too many queries "
+                     "were prepared. Prepare the query again."));
+  }
+  return prepared;
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> PreparedQueries::getParameters(const std::string& id) {
+  return get(id)->parameters_;
+}
+
+// _____________________________________________________________________________
+ParsedQuery PreparedQueries::bind(const EncodedIriManager* encodedIriManager,
+                                  const std::string& id,
+                                  const Bindings& bindings) {
+  auto prepared = get(id);
+  parsedQuery::SparqlValues values;
+  values._values.emplace_back();
+  for (const auto& [name, value] : bindings) {
+    std::string_view varName = name;
+    if (varName.starts_with('?') || varName.starts_with('$')) {
+      varName.remove_prefix(1);
+    }
+    Variable var{absl::StrCat("?", varName)};
+    if (!ad_utility::contains(prepared->parameters_, var)) {
+      throw std::runtime_error(absl::StrCat(
+          "The variable ", var.name(),
+          " is not a parameter of the prepared query with ID \"", id,
+          "\" (the variables that are assigned by BIND or VALUES are no "
+          "parameters)"));
+    }
+    if (ad_utility::contains(values._variables, var)) {
+      throw std::runtime_error(absl::StrCat(
+          "The parameter ", var.name(), " has more than one value"));
+    }
+    try {
+      values._values.front().push_back(
+          QueryTemplate::parseConstant(encodedIriManager, value));
+    } catch (const std::exception& e) {
+      throw std::runtime_error(
+          absl::StrCat("The value ", value, " for the parameter ", var.name(),
+                       " is not a single IRI or literal: ", e.what()));
+    }
+    values._variables.push_back(std::move(var));
+  }
+
+  ParsedQuery query =
+      prepared->parsedQuery_.has_value()
+          ? prepared->parsedQuery_.value()
+          : SparqlParser::parseQuery(encodedIriManager, prepared->query_,
+                                     prepared->datasets_);
+  if (!values._variables.empty()) {
+    auto& patterns = query._rootGraphPattern._graphPatterns;
+    patterns.emplace(patterns.begin(), parsedQuery::Values{std::move(values)});
+  }
+  return query;
+}
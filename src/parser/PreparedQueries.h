@@ -0,0 +1,90 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_PREPAREDQUERIES_H
+#define QLEVER_SRC_PARSER_PREPAREDQUERIES_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/sparqlParser/DatasetClause.h"
+#include "util/LruCache.h"
+#include "util/Synchronized.h"
+
+// A thread-safe registry of prepared queries. A query is parsed once when it
+// is prepared, and can then be executed repeatedly with different values for
+// its parameters, without parsing it again. The parameters are the variables
+// that are visible in the body of the query (for example, `?person` or
+// `$person` in `SELECT ?name { $person <name> ?name }`), except for the ones
+// that are assigned by a `BIND` or `VALUES` clause of the query. The values
+// are bound by adding a `VALUES` clause with a single row to the beginning of
+// the `WHERE` clause, so a parameter without a value remains a variable. Each
+// execution is planned separately, because the query planning depends on the
+// `QueryExecutionContext` of the request and on the current state of the
+// index, so there are no plans that could become outdated.
+//
+// When the maximal number of prepared queries is reached, the least recently
+// used one is removed (a client then gets an error and has to prepare the
+// query again).
+class PreparedQueries {
+ public:
+  // The values for the parameters of a single execution. The first element of
+  // each pair is the name of the variable (with or without the leading `?` or
+  // `$`), the second element is a single IRI or literal in SPARQL syntax (for
+  // example, `<http://example.org/x>`, `"text"@en`, or `42`).
+  using Bindings = std::vector<std::pair<std::string, std::string>>;
+
+  // A registry with `maxNumQueries == 0` is disabled, then `prepare` throws.
+  explicit PreparedQueries(size_t maxNumQueries);
+
+  // Parse the `query` with the given `datasets` and store it. Return the ID
+  // with which the query can be executed. The ID is random, s.t. a client
+  // can't guess the IDs of the queries that were prepared by other clients.
+  // Throw the same exception as `SparqlParser::parseQuery` if the query is
+  // invalid.
+  std::string prepare(const EncodedIriManager* encodedIriManager,
+                      std::string query,
+                      std::vector<DatasetClause> datasets = {});
+
+  // Return the parameters of the prepared query with the given `id`. Throw if
+  // there is no such query.
+  std::vector<Variable> getParameters(const std::string& id);
+
+  // Return the prepared query with the given `id` with the `bindings` applied.
+  // Throw if there is no such query, or if the `bindings` contain a variable
+  // that is not a parameter of the query, the same variable twice, or an
+  // invalid value.
+  ParsedQuery bind(const EncodedIriManager* encodedIriManager,
+                   const std::string& id, const Bindings& bindings);
+
+  // Change the maximal number of prepared queries. This removes all the
+  // prepared queries.
+  void setMaxNumQueries(size_t maxNumQueries);
+
+  size_t numQueries() const;
+
+ private:
+  struct PreparedQuery {
+    std::string query_;
+    std::vector<DatasetClause> datasets_;
+    std::vector<Variable> parameters_;
+    // `std::nullopt` if the parsed query must not be shared between different
+    // executions (see `ParsedQuery::mayBeReused_`), then it is parsed
+    // again for each execution.
+    std::optional<ParsedQuery> parsedQuery_;
+  };
+  using Ptr = std::shared_ptr<const PreparedQuery>;
+
+  // Return the prepared query with the given `id`, or throw.
+  Ptr get(const std::string& id);
+
+  using Registry = ad_utility::util::LRUCache<std::string, Ptr>;
+  // `std::nullopt` iff preparing queries is disabled.
+  ad_utility::Synchronized<std::optional<Registry>> registry_;
+};
+
+#endif  // QLEVER_SRC_PARSER_PREPAREDQUERIES_H
@@ -0,0 +1,263 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "parser/QueryTemplate.h"
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <charconv>
+#include <utility>
+
+#include "global/Constants.h"
+#include "index/EncodedIriManager.h"
+#include "parser/RdfParser.h"
+#include "parser/Tokenizer.h"
+
+namespace {
+// The marker for a lifted constant in the key. Because the `\0` characters of
+// the query are doubled in the key, it is unambiguous.
+constexpr std::string_view keyMarker{"\0C", 2};
+
+// The characters of keywords, prefixed names, and variable names.
+bool isNameChar(char c) {
+  return absl::ascii_isalnum(c) || c == '_' || c == '-' || c == ':' ||
+         !absl::ascii_isascii(c);
+}
+
+// Return the position of the first character at or after `pos` that is
+// neither whitespace nor part of a comment.
+size_t skipWhitespaceAndComments(std::string_view query, size_t pos) {
+  while (pos < query.size()) {
+    if (query[pos] == '#') {
+      pos = std::min(query.find('\n', pos), query.size());
+    } else if (absl::ascii_isspace(query[pos])) {
+      ++pos;
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+// Return the end of the IRIREF that starts at `pos`, or `std::nullopt` if
+// the `<` at `pos` doesn't start an IRIREF (but, for example, is the less-than
+// operator).
+std::optional<size_t> irirefEnd(std::string_view query, size_t pos) {
+  for (size_t i = pos + 1; i < query.size(); ++i) {
+    char c = query[i];
+    if (c == '>') {
+      return i + 1;
+    }
+    if (static_cast<unsigned char>(c) <= 0x20 ||
+        std::string_view{"<\"{}|^`"}.find(c) != std::string_view::npos) {
+      return std::nullopt;
+    }
+  }
+  return std::nullopt;
+}
+
+// Return the end of the string literal that starts at `pos` (without a
+// language tag or datatype), or `std::nullopt` if the literal is not
+// terminated. Set `isLiftable` to false if the literal is a long string (with
+// three quotes) or contains an escape sequence.
+std::optional<size_t> stringEnd(std::string_view query, size_t pos,
+                                bool& isLiftable) {
+  char quote = query[pos];
+  std::string longQuote(3, quote);
+  bool isLong = query.substr(pos).starts_with(longQuote);
+  isLiftable = !isLong;
+  size_t i = pos + (isLong ? 3 : 1);
+  while (i < query.size()) {
+    char c = query[i];
+    if (c == '\\') {
+      isLiftable = false;
+      i += 2;
+    } else if (isLong && query.substr(i).starts_with(longQuote)) {
+      return i + 3;
+    } else if (!isLong && c == quote) {
+      return i + 1;
+    } else if (!isLong && (c == '\n' || c == '\r')) {
+      return std::nullopt;
+    } else {
+      ++i;
+    }
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+QueryTemplate::QueryTemplate(std::string_view query) {
+  // Split the query. If `allowLifting` is false, no constant is lifted. Return
+  // true if the query has a `BASE` declaration.
+  auto split = [this, query](bool allowLifting) {
+    pieces_.clear();
+    constants_.clear();
+    key_.clear();
+    std::string piece;
+    bool hasBase = false;
+    // True directly after `PREFIX` or `BASE`, the next IRI must not be lifted.
+    bool isDeclaration = false;
+    // True directly after `^^`, the next IRI is a datatype.
+    bool isDatatype = false;
+    size_t i = 0;
+    auto emit = [&](size_t end) {
+      for (char c : query.substr(i, end - i)) {
+        piece.push_back(c);
+        key_.push_back(c);
+        if (c == '\0') {
+          key_.push_back(c);
+        }
+      }
+      i = end;
+    };
+    auto emitOrLift = [&](size_t end, bool lift) {
+      if (!lift || !allowLifting) {
+        emit(end);
+        return;
+      }
+      constants_.emplace_back(query.substr(i, end - i));
+      pieces_.push_back(std::exchange(piece, {}));
+      key_.append(keyMarker);
+      i = end;
+    };
+    // True if the next token after `pos` starts with one of the `chars`.
+    auto nextTokenStartsWith = [query](size_t pos, std::string_view chars) {
+      pos = skipWhitespaceAndComments(query, pos);
+      return pos < query.size() && chars.find(query[pos]) != chars.npos;
+    };
+
+    while (i < query.size()) {
+      char c = query[i];
+      bool previousIsDeclaration = std::exchange(isDeclaration, false);
+      bool previousIsDatatype = std::exchange(isDatatype, false);
+      if (absl::ascii_isspace(c) || c == '#') {
+        size_t end = skipWhitespaceAndComments(query, i);
+        piece.append(query.substr(i, end - i));
+        key_.push_back(' ');
+        i = end;
+        isDeclaration = previousIsDeclaration;
+        isDatatype = previousIsDatatype;
+      } else if (c == '<' && irirefEnd(query, i).has_value()) {
+        size_t end = irirefEnd(query, i).value();
+        auto iri = query.substr(i, end - i);
+        // A function call `<iri>(...)` is not lifted.
+        bool lift = !previousIsDeclaration && !previousIsDatatype &&
+                    absl::StrContains(iri, ':') &&
+                    !absl::StrContains(iri, '\\') &&
+                    !nextTokenStartsWith(end, "(");
+        emitOrLift(end, lift);
+      } else if (c == '"' || c == '\'') {
+        bool lift = false;
+        auto end = stringEnd(query, i, lift);
+        if (!end.has_value()) {
+          // The parser will report the error.
+          emit(query.size());
+          break;
+        }
+        // The language tag or datatype has to directly follow the literal.
+        size_t suffixEnd = end.value();
+        if (query.substr(suffixEnd).starts_with('@')) {
+          ++suffixEnd;
+          while (suffixEnd < query.size() &&
+                 (absl::ascii_isalnum(query[suffixEnd]) ||
+                  query[suffixEnd] == '-')) {
+            ++suffixEnd;
+          }
+        } else if (query.substr(suffixEnd).starts_with("^^<") &&
+                   irirefEnd(query, suffixEnd + 2).has_value()) {
+          suffixEnd = irirefEnd(query, suffixEnd + 2).value();
+        } else if (nextTokenStartsWith(suffixEnd, "@^")) {
+          lift = false;
+        }
+        emitOrLift(lift ? suffixEnd : end.value(), lift);
+      } else if (isNameChar(c) || c == '?' || c == '$') {
+        size_t end = i + 1;
+        while (end < query.size() && isNameChar(query[end])) {
+          ++end;
+        }
+        auto word = query.substr(i, end - i);
+        hasBase = hasBase || absl::EqualsIgnoreCase(word, "BASE");
+        isDeclaration = absl::EqualsIgnoreCase(word, "BASE") ||
+                        absl::EqualsIgnoreCase(word, "PREFIX") ||
+                        (previousIsDeclaration && word.ends_with(':'));
+        emit(end);
+      } else if (query.substr(i).starts_with("^^")) {
+        isDatatype = true;
+        emit(i + 2);
+      } else {
+        emit(i + 1);
+      }
+    }
+    pieces_.push_back(std::move(piece));
+    return hasBase;
+  };
+  // Relative IRIs depend on the `BASE` declaration.
+  if (split(true) && !constants_.empty()) {
+    split(false);
+  }
+}
+
+// _____________________________________________________________________________
+std::string QueryTemplate::withPlaceholders(
+    const std::vector<bool>& usePlaceholder) const {
+  AD_CONTRACT_CHECK(usePlaceholder.size() == constants_.size());
+  std::string result = pieces_.front();
+  for (size_t i = 0; i < constants_.size(); ++i) {
+    absl::StrAppend(&result,
+                    usePlaceholder[i] ? placeholder(i) : constants_[i],
+                    pieces_[i + 1]);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string QueryTemplate::placeholder(size_t i) {
+  return makeQleverInternalIri("query-template-constant-", i);
+}
+
+// _____________________________________________________________________________
+std::optional<size_t> QueryTemplate::getPlaceholderIndex(
+    const TripleComponent& term) {
+  static constexpr std::string_view prefix =
+      ad_utility::constexprStrCat<"<", QLEVER_INTERNAL_PREFIX_URL,
+                                  "query-template-constant-">();
+  if (!term.isIri()) {
+    return std::nullopt;
+  }
+  std::string_view iri = term.getIri().toStringRepresentation();
+  if (!iri.starts_with(prefix) || !iri.ends_with('>')) {
+    return std::nullopt;
+  }
+  iri.remove_prefix(prefix.size());
+  iri.remove_suffix(1);
+  size_t index;
+  auto [ptr, ec] = std::from_chars(iri.data(), iri.data() + iri.size(), index);
+  if (ec != std::errc{} || ptr != iri.data() + iri.size()) {
+    return std::nullopt;
+  }
+  return index;
+}
+
+// _____________________________________________________________________________
+TripleComponent QueryTemplate::parseConstant(
+    const EncodedIriManager* encodedIriManager, std::string_view constant) {
+  // Same as the conversion of the `SparqlQleverVisitor` for the subjects and
+  // objects of triples.
+  if (constant.starts_with('<')) {
+    if (auto encodedId = encodedIriManager->encode(constant)) {
+      return encodedId.value();
+    }
+  }
+  EncodedIriManager noEncoding;
+  RdfStringParser<TurtleParser<Tokenizer>> parser{&noEncoding};
+  auto term = parser.parseSingleTerm(constant);
+  if (term.isString() || term.isVariable()) {
+    throw std::runtime_error{absl::StrCat(
+        "\"", constant, "\" is neither an IRI nor a literal")};
+  }
+  return term;
+}
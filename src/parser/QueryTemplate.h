@@ -0,0 +1,98 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_QUERYTEMPLATE_H
+#define QLEVER_SRC_PARSER_QUERYTEMPLATE_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/TripleComponent.h"
+
+class EncodedIriManager;
+
+// The template of a SPARQL query, where the constants (IRIs and string
+// literals) are lifted out of the query text, and whitespace and comments are
+// normalized. Queries that only differ in these constants (for example, the
+// queries of an application that always sends the same query for a different
+// entity) have the same `key()`. This allows to parse such a query only once
+// and then to substitute the constants of each further query into the result
+// (see `ParsedQueryCache`).
+//
+// Only the constants that can be parsed on their own are lifted: absolute IRIs
+// in angle brackets, and string literals without escape sequences with an
+// optional language tag or a datatype in angle brackets. IRIs of `PREFIX` and
+// `BASE` declarations, datatypes, and functions are never lifted, and neither
+// are the constants of a query with a `BASE` declaration.
+class QueryTemplate {
+ public:
+  explicit QueryTemplate(std::string_view query);
+
+  // The normalized query text, in which each lifted constant is replaced by
+  // a marker. Two queries with the same key only differ in their constants.
+  const std::string& key() const { return key_; }
+
+  // The lifted constants in the order in which they occur in the query.
+  const std::vector<std::string>& constants() const { return constants_; }
+
+  // Return the (not normalized) query, where each constant `i` for which
+  // `usePlaceholder[i]` is true is replaced by `placeholder(i)`, and all other
+  // constants are kept.
+  std::string withPlaceholders(const std::vector<bool>& usePlaceholder) const;
+
+  // The IRI that replaces the `i`-th constant in `withPlaceholders`.
+  static std::string placeholder(size_t i);
+
+  // If the `term` is an IRI that was created by `placeholder(i)`, return `i`.
+  static std::optional<size_t> getPlaceholderIndex(const TripleComponent& term);
+
+  // Parse a single constant in SPARQL syntax to the `TripleComponent` that the
+  // `SparqlParser` creates for it in a triple. Throw a `std::runtime_error` if
+  // the `constant` is not a single IRI or literal.
+  static TripleComponent parseConstant(
+      const EncodedIriManager* encodedIriManager, std::string_view constant);
+
+  // Call `function` for each triple in the `pattern` and in all the graph
+  // patterns that are nested in it (including subqueries). The triples of
+  // other operations (for example, `SERVICE`) are not visited.
+  template <typename GraphPatternT, typename F>
+  static void forEachTriple(GraphPatternT& pattern, const F& function);
+
+ private:
+  // The query text between the constants, `pieces_.size()` is
+  // `constants_.size() + 1`.
+  std::vector<std::string> pieces_;
+  std::vector<std::string> constants_;
+  std::string key_;
+};
+
+// _____________________________________________________________________________
+template <typename GraphPatternT, typename F>
+void QueryTemplate::forEachTriple(GraphPatternT& pattern, const F& function) {
+  using namespace parsedQuery;
+  for (auto& operation : pattern._graphPatterns) {
+    operation.visit([&function](auto& arg) {
+      using T = std::decay_t<decltype(arg)>;
+      if constexpr (std::is_same_v<T, BasicGraphPattern>) {
+        for (auto& triple : arg._triples) {
+          function(triple);
+        }
+      } else if constexpr (std::is_same_v<T, Optional> ||
+                           std::is_same_v<T, Minus> ||
+                           std::is_same_v<T, GroupGraphPattern>) {
+        forEachTriple(arg._child, function);
+      } else if constexpr (std::is_same_v<T, Union>) {
+        forEachTriple(arg._child1, function);
+        forEachTriple(arg._child2, function);
+      } else if constexpr (std::is_same_v<T, Subquery>) {
+        forEachTriple(arg.get()._rootGraphPattern, function);
+      }
+    });
+  }
+}
+
+#endif  // QLEVER_SRC_PARSER_QUERYTEMPLATE_H
@@ -15,13 +15,16 @@
 #include "engine/CallFixedSize.h"
 #include "global/Constants.h"
 #include "index/EncodedIriManager.h"
+#include "parser/BinaryRdfParser.h"
 #include "parser/NormalizedString.h"
+#include "parser/SimdScanner.h"
 #include "parser/Tokenizer.h"
 #include "parser/TokenizerCtre.h"
 #include "rdfTypes/GeoPoint.h"
 #include "util/DateYearDuration.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/TransparentFunctors.h"
+#include "util/TypeTraits.h"
 
 using namespace std::chrono_literals;
 
@@ -855,7 +858,8 @@ bool TurtleParser<T>::pnameLnRelaxed() {
   // these can also be part of a collection etc.
   // find any character that can end a pnameLn when assuming that no
   // escape sequences were used
-  auto posEnd = view.find_first_of(" \t\r\n,;", pos);
+  auto posEnd =
+      simdScanner::findFirstOf<' ', '\t', '\r', '\n', ',', ';'>(view, pos);
   if (posEnd == std::string::npos) {
     // make tests work
     posEnd = view.size();
@@ -880,7 +884,7 @@ bool TurtleParser<T>::iriref() {
   if (!view.starts_with('<')) {
     return false;
   }
-  auto endPos = view.find_first_of("<>\"\n", 1);
+  auto endPos = simdScanner::findFirstOf<'<', '>', '"', '\n'>(view, 1);
   if (endPos == std::string::npos || view[endPos] != '>') {
     raise(
         "Unterminated IRI reference (found '<' but no '>' before "
@@ -1174,8 +1178,17 @@ void RdfParallelParser<T>::feedBatchesToParser(
 template <typename T>
 void RdfParallelParser<T>::initialize(const std::string& filename,
                                       ad_utility::MemorySize bufferSize) {
+  // In Turtle, a block may only end after a `.` that is followed by a newline
+  // (see the documentation of `--parse-parallel` for the assumptions this
+  // makes). N-Quads are line-based (there are no multiline literals, and an
+  // IRI or literal can't contain a raw newline), so for them every newline is
+  // the end of a statement or comment, and a block can end at any newline.
+  // This also supports comments after the final `.` of a statement.
+  static constexpr bool isLineBased =
+      ad_utility::isInstantiation<T, NQuadParser>;
   fileBuffer_ = std::make_unique<ParallelBufferWithEndRegex>(
-      bufferSize.getBytes(), "\\.[\\t ]*([\\r\\n]+)");
+      bufferSize.getBytes(),
+      isLineBased ? "([\\r\\n]+)" : "\\.[\\t ]*([\\r\\n]+)");
   ParallelBuffer::BufferType remainingBatchFromInitialization;
   fileBuffer_->open(filename);
   RdfStringParser<T> declarationParser{&this->encodedIriManager()};
@@ -1288,6 +1301,11 @@ static std::unique_ptr<RdfParserBase> makeSingleRdfParser(
       return qlever::specialIds().at(DEFAULT_GRAPH_IRI);
     }
   };
+  // The binary format is read sequentially, there is nothing to tokenize.
+  if (file.filetype_ == Index::Filetype::Binary) {
+    return std::make_unique<BinaryRdfParser>(file.filename_, ev, bufferSize,
+                                             graph());
+  }
   auto makeRdfParserImpl = ad_utility::ApplyAsValueIdentity{
       [&filename = file.filename_, &bufferSize, &graph, ev](
           auto useParallel,
@@ -1343,6 +1361,9 @@ RdfMultifileParser::RdfMultifileParser(
     try {
       auto parser =
           makeSingleRdfParser<Tokenizer>(file, encodedIriManager, bufferSize);
+      if (auto termStorage = parser->getTermStorage()) {
+        termStorages_.wlock()->push_back(std::move(termStorage));
+      }
       while (auto batch = parser->getBatch()) {
         bool active = finishedBatchQueue_.push(std::move(batch.value()));
         if (!active) {
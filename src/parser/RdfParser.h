@@ -10,6 +10,7 @@
 
 #include <future>
 #include <locale>
+#include <memory>
 #include <stdexcept>
 #include <string_view>
 
@@ -26,6 +27,7 @@
 #include "util/HashMap.h"
 #include "util/Log.h"
 #include "util/ParseException.h"
+#include "util/Synchronized.h"
 #include "util/TaskQueue.h"
 #include "util/ThreadSafeQueue.h"
 
@@ -96,6 +98,12 @@ class RdfParserBase {
   // exhausted, return `nullopt`.
   virtual std::optional<std::vector<TurtleTriple>> getBatch();
 
+  // Some parsers (e.g. the `BinaryRdfParser`) emit triples with `Id`s of type
+  // `LocalVocabIndex` that point into memory owned by the parser. Return a
+  // handle that keeps this memory alive, or `nullptr` if the triples are
+  // self-contained.
+  virtual std::shared_ptr<const void> getTermStorage() const { return nullptr; }
+
  protected:
   const auto& encodedIriManager() const { return *encodedIriManager_; }
 };
@@ -426,7 +434,7 @@ CPP_template(typename Parser)(
   }
 
   size_t getParsePosition() const override {
-    return positionOffset_ + tmpToParse_.size() - this->tok_.data().size();
+    return positionOffset_ + input_.size() - this->tok_.data().size();
   }
 
   void initialize(const std::string&, ad_utility::MemorySize) {
@@ -454,6 +462,27 @@ CPP_template(typename Parser)(
     return std::move(this->triples_);
   }
 
+  // Parse statements until at least `minNumTriples` triples have been parsed
+  // or the end of the input is reached, and return the parsed triples. The
+  // parser keeps its state (prefixes, blank node labels, etc.) between calls,
+  // so a large input can be consumed in batches of bounded size. An empty
+  // result means that the complete input has been parsed.
+  std::vector<TurtleTriple> parseNextTriples(size_t minNumTriples) {
+    while (this->triples_.size() < minNumTriples) {
+      if (!this->statement()) {
+        auto d = this->tok_.view();
+        if (!d.empty()) {
+          this->raise(
+              absl::StrCat("Parsing failed before end of input, remaining "
+                           "bytes: ",
+                           d.size()));
+        }
+        break;
+      }
+    }
+    return std::exchange(this->triples_, {});
+  }
+
   // Parse only a single object.
   static TripleComponent parseTripleObject(std::string_view objectString) {
     // TODO<joka921> Make it possible to use an optional here.
@@ -464,6 +493,24 @@ CPP_template(typename Parser)(
     return std::move(parser.triples_[0].object_);
   }
 
+  // Parse the `input` as a single RDF term, the same way as the object of a
+  // triple (for example `<iri>`, `"literal"@en`, `42`, or `_:label`). Throw a
+  // `std::runtime_error` if the `input` is invalid or consists of more than
+  // one term (for example `<a> , <b>` or `<x> . <a> <b> <c>`). In contrast to
+  // `parseTripleObject`, this is safe for untrusted input.
+  TripleComponent parseSingleTerm(std::string_view input) {
+    this->triples_.clear();
+    setInputStream(absl::StrCat("<a> <b> ", input, " ."));
+    bool isStatement = this->statement();
+    this->tok_.skipWhitespaceAndComments();
+    auto triples = std::exchange(this->triples_, {});
+    if (!isStatement || triples.size() != 1 || !this->tok_.view().empty()) {
+      throw std::runtime_error{
+          absl::StrCat("\"", input, "\" is not a single RDF term")};
+    }
+    return std::move(triples.front().object_);
+  }
+
   std::string_view getUnparsedRemainder() const { return this->tok_.view(); }
 
   // Parse directive and return true if a directive was found.
@@ -474,12 +521,22 @@ CPP_template(typename Parser)(
   void setPositionOffset(size_t offset) { positionOffset_ = offset; }
 
  private:
-  // The complete input to this parser.
+  // The buffer that owns the input of this parser (unless `setInputView` was
+  // used).
   ParallelBuffer::BufferType tmpToParse_;
+  // The complete input to this parser. It either points to `tmpToParse_` or
+  // to external memory (see `setInputView`).
+  std::string_view input_;
   // Used to add a certain offset to the parsing position when using this
   // in a parallel setting.
   size_t positionOffset_ = 0;
 
+  // Let the tokenizer parse the complete `tmpToParse_`.
+  void resetTokenizer() {
+    input_ = std::string_view{tmpToParse_.data(), tmpToParse_.size()};
+    this->tok_.reset(input_.data(), input_.size());
+  }
+
  public:
   // testing interface for reusing a parser
   // only specifies the tokenizers input stream.
@@ -488,7 +545,7 @@ CPP_template(typename Parser)(
     tmpToParse_.clear();
     tmpToParse_.reserve(toParse.size());
     tmpToParse_.insert(tmpToParse_.end(), toParse.begin(), toParse.end());
-    this->tok_.reset(tmpToParse_.data(), tmpToParse_.size());
+    resetTokenizer();
   }
 
   const auto& getPrefixMap() const { return prefixMap_; }
@@ -496,14 +553,22 @@ CPP_template(typename Parser)(
   // __________________________________________________________
   void setInputStream(ParallelBuffer::BufferType&& toParse) {
     tmpToParse_ = std::move(toParse);
-    this->tok_.reset(tmpToParse_.data(), tmpToParse_.size());
+    resetTokenizer();
+  }
+
+  // Parse the `toParse` without copying it. The caller has to make sure that
+  // the underlying memory stays valid while this parser is used.
+  void setInputView(std::string_view toParse) {
+    tmpToParse_.clear();
+    input_ = toParse;
+    this->tok_.reset(input_.data(), input_.size());
   }
 
   // testing interface, only works when parsing from an utf8-string
   // return the current position of the tokenizer in the input string
   // can be used to test if the advancing of the tokenizer works
   // as expected
-  size_t getPosition() const { return this->tok_.begin() - tmpToParse_.data(); }
+  size_t getPosition() const { return this->tok_.begin() - input_.data(); }
 
   // Disable use of @base, @prefix and multiline string literals for turtle
   // parsers during parallel parsing.
@@ -523,9 +588,9 @@ CPP_template(typename Parser)(
 };
 
 /**
- * This class is a TurtleParser that always assumes that
- * its input file is an uncompressed .ttl file that will be read in
- * chunks. Input file can also be a stream like stdin.
+ * This class is a TurtleParser (or NQuadParser) that reads its input file in
+ * chunks and parses them sequentially. A statement may span the boundary
+ * between two chunks. Input file can also be a stream like stdin.
  */
 template <typename Parser>
 class RdfStreamParser : public Parser {
@@ -592,9 +657,9 @@ class RdfStreamParser : public Parser {
 };
 
 /**
- * This class is a TurtleParser that always assumes that
- * its input file is an uncompressed .ttl file that will be read in
- * chunks. Input file can also be a stream like stdin.
+ * This class is a TurtleParser (or NQuadParser) that reads its input file in
+ * chunks which end at statement boundaries and parses the chunks in parallel.
+ * Input file can also be a stream like stdin.
  */
 template <typename Parser>
 class RdfParallelParser : public Parser {
@@ -745,6 +810,13 @@ class RdfMultifileParser : public RdfParserBase {
  private:
   // A thread that feeds the file specifications to the actual parser threads.
   ad_utility::JThread feederThread_;
+  // The term storages (see `RdfParserBase::getTermStorage`) of the parsers for
+  // the individual files. They have to stay alive after the parser of a file
+  // is finished, because its triples might still be in use. Note: It is
+  // declared before the `finishedBatchQueue_`, s.t. it is destroyed after the
+  // triples in it.
+  ad_utility::Synchronized<std::vector<std::shared_ptr<const void>>>
+      termStorages_;
   // The buffer for the finished batches.
   ad_utility::data_structures::ThreadSafeQueue<std::vector<TurtleTriple>>
       finishedBatchQueue_{10};
@@ -0,0 +1,128 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_SIMDSCANNER_H
+#define QLEVER_SRC_PARSER_SIMDSCANNER_H
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Functions that find the structural characters of Turtle and N-Triples
+// (`<`, `>`, `"`, whitespace, etc.) in the input. They classify a complete
+// chunk of the input at once (32 bytes with AVX2, 16 bytes with SSE2) instead
+// of comparing byte by byte, which is what `std::string_view::find_first_of`
+// does. On other platforms, a scalar fallback is used.
+namespace simdScanner {
+
+static constexpr size_t npos = std::string_view::npos;
+
+namespace detail {
+// Return true iff `c` is one of the `Chars`.
+template <char... Chars>
+constexpr bool isOneOf(char c) {
+  return ((c == Chars) || ...);
+}
+
+// Return the position of the first character in `input` at or after `pos` for
+// which `isOneOf<Chars...>` is `!Negate`, or `npos` if there is no such
+// character.
+template <bool Negate, char... Chars>
+size_t scalarFind(std::string_view input, size_t pos) {
+  for (; pos < input.size(); ++pos) {
+    if (isOneOf<Chars...>(input[pos]) != Negate) {
+      return pos;
+    }
+  }
+  return npos;
+}
+
+#if defined(__AVX2__)
+static constexpr size_t chunkSize = 32;
+static constexpr uint32_t allBitsOfChunk = ~uint32_t{0};
+// Return a bitmask, where the `i`-th bit is set iff `ptr[i]` is one of the
+// `Chars`.
+template <char... Chars>
+inline uint32_t matchMask(const char* ptr) {
+  __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+  __m256i matches = _mm256_setzero_si256();
+  ((matches = _mm256_or_si256(
+        matches, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(Chars)))),
+   ...);
+  return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+#elif defined(__SSE2__)
+static constexpr size_t chunkSize = 16;
+static constexpr uint32_t allBitsOfChunk = (uint32_t{1} << chunkSize) - 1;
+// Return a bitmask, where the `i`-th bit is set iff `ptr[i]` is one of the
+// `Chars`.
+template <char... Chars>
+inline uint32_t matchMask(const char* ptr) {
+  __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+  __m128i matches = _mm_setzero_si128();
+  ((matches =
+        _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(Chars)))),
+   ...);
+  return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+#endif
+
+// The common implementation of `findFirstOf` and `findFirstNotOf` below.
+template <bool Negate, char... Chars>
+size_t find(std::string_view input, size_t pos) {
+  static_assert(sizeof...(Chars) > 0);
+  if (pos >= input.size()) {
+    return npos;
+  }
+#if defined(__AVX2__) || defined(__SSE2__)
+  while (pos + chunkSize <= input.size()) {
+    uint32_t mask = matchMask<Chars...>(input.data() + pos);
+    if constexpr (Negate) {
+      mask = ~mask & allBitsOfChunk;
+    }
+    if (mask != 0) {
+      return pos + std::countr_zero(mask);
+    }
+    pos += chunkSize;
+  }
+#endif
+  // The remaining bytes (less than one chunk).
+  return scalarFind<Negate, Chars...>(input, pos);
+}
+}  // namespace detail
+
+// Return the position of the first character in `input` at or after `pos` that
+// is one of the `Chars`, or `npos` if there is no such character. Equivalent to
+// `input.find_first_of({Chars...}, pos)`, but much faster for long inputs.
+template <char... Chars>
+size_t findFirstOf(std::string_view input, size_t pos = 0) {
+  return detail::find<false, Chars...>(input, pos);
+}
+
+// Return the position of the first character in `input` at or after `pos` that
+// is not one of the `Chars`, or `npos` if there is no such character.
+template <char... Chars>
+size_t findFirstNotOf(std::string_view input, size_t pos = 0) {
+  // Runs of the `Chars` (typically whitespace) are often very short, so first
+  // check the first character without loading a complete chunk.
+  if (pos < input.size() && !detail::isOneOf<Chars...>(input[pos])) {
+    return pos;
+  }
+  return detail::find<true, Chars...>(input, pos);
+}
+
+// Return the number of whitespace characters (as defined by the Turtle
+// grammar) at the beginning of the `input`.
+inline size_t numLeadingWhitespace(std::string_view input) {
+  auto pos = findFirstNotOf<' ', '\t', '\r', '\n'>(input);
+  return pos == npos ? input.size() : pos;
+}
+
+}  // namespace simdScanner
+
+#endif  // QLEVER_SRC_PARSER_SIMDSCANNER_H
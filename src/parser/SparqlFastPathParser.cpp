@@ -0,0 +1,597 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "parser/SparqlFastPathParser.h"
+
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/str_cat.h>
+
+#include <charconv>
+#include <memory>
+#include <string_view>
+#include <variant>
+
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/RelationalExpressions.h"
+#include "global/Constants.h"
+#include "parser/RdfParser.h"
+#include "parser/TokenizerCtre.h"
+#include "util/HashMap.h"
+#include "util/OverloadCallOperator.h"
+
+namespace {
+
+using ExpressionPtr = sparqlExpression::SparqlExpression::Ptr;
+using Iri = TripleComponent::Iri;
+using TripleObjectParser = RdfStringParser<TurtleParser<TokenizerCtre>>;
+
+// Thrown for all inputs that are not supported by the fast path. It is caught
+// in `SparqlFastPathParser::tryParseQuery`.
+struct Unsupported {};
+[[noreturn]] void unsupported() { throw Unsupported{}; }
+
+// The terms that can occur in the triples and in the `FILTER`s. The IRIs are
+// stored with angle brackets, the literals as they occur in the query.
+struct IriTerm {
+  std::string iri_;
+};
+struct LiteralTerm {
+  std::string literal_;
+};
+struct IntegerTerm {
+  int64_t value_;
+};
+using Term = std::variant<Variable, IriTerm, LiteralTerm, IntegerTerm>;
+
+// The characters of a (simplified) variable name, prefix, or local name.
+bool isNameChar(char c) {
+  return absl::ascii_isalnum(c) || c == '_' || c == '-';
+}
+
+// The state of the parsing of a single query. All the member functions throw
+// `Unsupported` if the input is not in the supported subset.
+class FastPathParser {
+ public:
+  FastPathParser(const EncodedIriManager* encodedIriManager,
+                 std::string_view input)
+      : encodedIriManager_{encodedIriManager}, input_{input} {}
+
+  ParsedQuery parseQuery(const std::vector<DatasetClause>& datasets) {
+    // The general parser unescapes unicode sequences before the parsing, and
+    // non-ASCII characters change the positions that are used for the
+    // descriptors of the `FILTER`s.
+    if (ql::ranges::any_of(input_, [](char c) {
+          return c == '\\' || c == '\0' || !absl::ascii_isascii(c);
+        })) {
+      unsupported();
+    }
+    parsePrologue();
+
+    ParsedQuery query;
+    auto& selectClause = query._clause.emplace<parsedQuery::SelectClause>();
+    parseSelectClause(selectClause);
+    query.datasetClauses_ = parsedQuery::DatasetClauses::fromClauses(datasets);
+    skipWhitespace();
+    tryKeyword("WHERE");
+    query._rootGraphPattern = parseGroupGraphPattern();
+    query.registerVariablesVisibleInQueryBody(visibleVariables_);
+    query.addSolutionModifiers(parseSolutionModifiers(), [this]() {
+      return Variable{absl::StrCat(QLEVER_INTERNAL_VARIABLE_PREFIX,
+                                   numInternalVariables_++)};
+    });
+    skipWhitespace();
+    if (pos_ != input_.size()) {
+      unsupported();
+    }
+    query._originalString = std::string{input_};
+    return query;
+  }
+
+ private:
+  const EncodedIriManager* encodedIriManager_;
+  std::string_view input_;
+  size_t pos_ = 0;
+  ad_utility::HashMap<std::string, std::string> prefixMap_{
+      {QLEVER_INTERNAL_PREFIX_NAME, std::string{QLEVER_INTERNAL_PREFIX_IRI}}};
+  std::vector<Variable> visibleVariables_;
+  size_t numInternalVariables_ = 0;
+
+  char peek() const { return pos_ < input_.size() ? input_[pos_] : '\0'; }
+
+  // Skip whitespace and comments.
+  void skipWhitespace() {
+    while (pos_ < input_.size()) {
+      char c = input_[pos_];
+      if (c == '#') {
+        pos_ = std::min(input_.find('\n', pos_), input_.size());
+      } else if (absl::ascii_isspace(c)) {
+        ++pos_;
+      } else {
+        break;
+      }
+    }
+  }
+
+  // Return true if a token that ends before `pos` can't be continued at
+  // `pos`, so that the general parser would end the token at the same
+  // position.
+  bool isDelimiter(size_t pos) const {
+    if (pos >= input_.size()) {
+      return true;
+    }
+    char c = input_[pos];
+    if (c == '.') {
+      return pos + 1 >= input_.size() || !isNameChar(input_[pos + 1]);
+    }
+    return absl::ascii_isspace(c) ||
+           std::string_view{"{}(),;<>=!#"}.find(c) != std::string_view::npos;
+  }
+
+  // Return true if the (case-insensitive) `keyword` starts at the current
+  // position.
+  bool atKeyword(std::string_view keyword) const {
+    size_t end = pos_ + keyword.size();
+    return absl::EqualsIgnoreCase(input_.substr(pos_, keyword.size()),
+                                  keyword) &&
+           (end >= input_.size() ||
+            !(isNameChar(input_[end]) || input_[end] == ':'));
+  }
+
+  // If the `keyword` starts at the current position, skip it and return true.
+  bool tryKeyword(std::string_view keyword) {
+    if (!atKeyword(keyword)) {
+      return false;
+    }
+    pos_ += keyword.size();
+    return true;
+  }
+
+  // Skip whitespace, then the character `c`.
+  void expect(char c) {
+    skipWhitespace();
+    if (peek() != c) {
+      unsupported();
+    }
+    ++pos_;
+  }
+
+  // Return the end of the IRIREF that starts at `pos`, or `std::nullopt` if
+  // there is none.
+  std::optional<size_t> irirefEnd(size_t pos) const {
+    if (pos >= input_.size() || input_[pos] != '<') {
+      return std::nullopt;
+    }
+    for (size_t i = pos + 1; i < input_.size(); ++i) {
+      char c = input_[i];
+      if (c == '>') {
+        return i + 1;
+      }
+      if (static_cast<unsigned char>(c) <= 0x20 ||
+          std::string_view{"<\"{}|^`"}.find(c) != std::string_view::npos) {
+        return std::nullopt;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Parse an IRI (`<...>` or a prefixed name) and return it with angle
+  // brackets.
+  std::string parseIri() {
+    skipWhitespace();
+    if (auto end = irirefEnd(pos_)) {
+      std::string result{input_.substr(pos_, end.value() - pos_)};
+      pos_ = end.value();
+      return result;
+    }
+    size_t start = pos_;
+    if (absl::ascii_isalpha(peek())) {
+      while (isNameChar(peek())) {
+        ++pos_;
+      }
+    }
+    auto prefix = input_.substr(start, pos_ - start);
+    if (peek() != ':') {
+      unsupported();
+    }
+    ++pos_;
+    size_t localStart = pos_;
+    while (isNameChar(peek())) {
+      ++pos_;
+    }
+    auto local = input_.substr(localStart, pos_ - localStart);
+    if (local.starts_with('-') || !isDelimiter(pos_)) {
+      unsupported();
+    }
+    auto it = prefixMap_.find(std::string{prefix});
+    if (it == prefixMap_.end()) {
+      unsupported();
+    }
+    std::string_view prefixIri = it->second;
+    prefixIri.remove_suffix(1);
+    return absl::StrCat(prefixIri, local, ">");
+  }
+
+  Variable parseVariable() {
+    skipWhitespace();
+    size_t start = pos_;
+    if (peek() != '?') {
+      unsupported();
+    }
+    ++pos_;
+    while (absl::ascii_isalnum(peek()) || peek() == '_') {
+      ++pos_;
+    }
+    if (pos_ - start < 2 || !isDelimiter(pos_)) {
+      unsupported();
+    }
+    return Variable{std::string{input_.substr(start, pos_ - start)}, false};
+  }
+
+  // Parse a string literal with an optional language tag or datatype.
+  LiteralTerm parseLiteral() {
+    if (input_.substr(pos_).starts_with(R"(""")")) {
+      unsupported();
+    }
+    size_t end = input_.find_first_of("\"\n\r", pos_ + 1);
+    if (end == std::string_view::npos || input_[end] != '"') {
+      unsupported();
+    }
+    std::string literal{input_.substr(pos_, end + 1 - pos_)};
+    pos_ = end + 1;
+    skipWhitespace();
+    if (peek() == '@') {
+      size_t start = pos_;
+      ++pos_;
+      while (absl::ascii_isalpha(peek())) {
+        ++pos_;
+      }
+      if (pos_ - start < 2) {
+        unsupported();
+      }
+      while (peek() == '-' && pos_ + 1 < input_.size() &&
+             absl::ascii_isalnum(input_[pos_ + 1])) {
+        ++pos_;
+        while (absl::ascii_isalnum(peek())) {
+          ++pos_;
+        }
+      }
+      if (!isDelimiter(pos_)) {
+        unsupported();
+      }
+      absl::StrAppend(&literal, input_.substr(start, pos_ - start));
+    } else if (input_.substr(pos_).starts_with("^^")) {
+      pos_ += 2;
+      absl::StrAppend(&literal, "^^",
+                      Iri::fromIriref(parseIri()).toStringRepresentation());
+    }
+    return {std::move(literal)};
+  }
+
+  IntegerTerm parseInteger() {
+    size_t start = pos_;
+    while (absl::ascii_isdigit(peek())) {
+      ++pos_;
+    }
+    if (!isDelimiter(pos_)) {
+      unsupported();
+    }
+    int64_t value;
+    auto result = std::from_chars(input_.data() + start, input_.data() + pos_,
+                                  value);
+    if (result.ec != std::errc{}) {
+      unsupported();
+    }
+    return {value};
+  }
+
+  // Parse a variable or an IRI, and if `allowLiterals` is true, also a string
+  // literal or an integer.
+  Term parseTerm(bool allowLiterals) {
+    skipWhitespace();
+    char c = peek();
+    if (c == '?') {
+      return parseVariable();
+    } else if (allowLiterals && c == '"') {
+      return parseLiteral();
+    } else if (allowLiterals && absl::ascii_isdigit(c)) {
+      return parseInteger();
+    } else {
+      return IriTerm{parseIri()};
+    }
+  }
+
+  // Parse the predicate of a triple.
+  ad_utility::sparql_types::VarOrPath parsePredicate() {
+    skipWhitespace();
+    if (peek() == '?') {
+      return parseVariable();
+    }
+    if (peek() == 'a' && isDelimiter(pos_ + 1)) {
+      ++pos_;
+      return PropertyPath::fromIri(Iri::fromIriref(
+          "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>"));
+    }
+    auto iri = parseIri();
+    // These predicates implicitly make additional variables visible.
+    if (iri == CONTAINS_WORD_PREDICATE || iri == CONTAINS_ENTITY_PREDICATE) {
+      unsupported();
+    }
+    return PropertyPath::fromIri(Iri::fromIriref(iri));
+  }
+
+  // Convert a subject or object of a triple.
+  TripleComponent toTripleComponent(Term term) const {
+    return std::visit(
+        ad_utility::OverloadCallOperator{
+            [](Variable& var) -> TripleComponent { return std::move(var); },
+            [this](const IriTerm& iri) -> TripleComponent {
+              if (auto encodedId = encodedIriManager_->encode(iri.iri_)) {
+                return encodedId.value();
+              }
+              return TripleObjectParser::parseTripleObject(iri.iri_);
+            },
+            [](const LiteralTerm& literal) -> TripleComponent {
+              return TripleObjectParser::parseTripleObject(literal.literal_);
+            },
+            [](const IntegerTerm& integer) -> TripleComponent {
+              return TripleObjectParser::parseTripleObject(
+                  std::to_string(integer.value_));
+            }},
+        term);
+  }
+
+  // Convert an operand of a `FILTER`.
+  ExpressionPtr toExpression(Term term) const {
+    using namespace sparqlExpression;
+    return std::visit(
+        ad_utility::OverloadCallOperator{
+            [](Variable& var) -> ExpressionPtr {
+              return std::make_unique<VariableExpression>(std::move(var));
+            },
+            [](const IriTerm& iri) -> ExpressionPtr {
+              return std::make_unique<IriExpression>(
+                  Iri::fromIriref(iri.iri_));
+            },
+            [this](const LiteralTerm& literal) -> ExpressionPtr {
+              auto tripleComponent =
+                  TripleObjectParser::parseTripleObject(literal.literal_);
+              if (tripleComponent.isIri() || tripleComponent.isString()) {
+                unsupported();
+              }
+              if (tripleComponent.isLiteral()) {
+                return std::make_unique<StringLiteralExpression>(
+                    tripleComponent.getLiteral());
+              }
+              auto id =
+                  tripleComponent.toValueIdIfNotString(encodedIriManager_);
+              if (!id.has_value()) {
+                unsupported();
+              }
+              return std::make_unique<IdExpression>(id.value());
+            },
+            [](const IntegerTerm& integer) -> ExpressionPtr {
+              return std::make_unique<IdExpression>(
+                  Id::makeFromInt(integer.value_));
+            }},
+        term);
+  }
+
+  void registerIfVariable(const auto& term) {
+    if (const auto* var = std::get_if<Variable>(&term)) {
+      visibleVariables_.push_back(*var);
+    }
+  }
+
+  // Parse the `PREFIX` declarations.
+  void parsePrologue() {
+    while (true) {
+      skipWhitespace();
+      if (!tryKeyword("PREFIX")) {
+        return;
+      }
+      skipWhitespace();
+      size_t start = pos_;
+      if (absl::ascii_isalpha(peek())) {
+        while (isNameChar(peek())) {
+          ++pos_;
+        }
+      }
+      std::string label{input_.substr(start, pos_ - start)};
+      if (peek() != ':') {
+        unsupported();
+      }
+      ++pos_;
+      skipWhitespace();
+      auto end = irirefEnd(pos_);
+      if (!end.has_value()) {
+        unsupported();
+      }
+      prefixMap_[label] = std::string{input_.substr(pos_, end.value() - pos_)};
+      pos_ = end.value();
+    }
+  }
+
+  void parseSelectClause(parsedQuery::SelectClause& selectClause) {
+    skipWhitespace();
+    if (!tryKeyword("SELECT")) {
+      unsupported();
+    }
+    skipWhitespace();
+    selectClause.distinct_ = tryKeyword("DISTINCT");
+    skipWhitespace();
+    if (peek() == '*') {
+      ++pos_;
+      selectClause.setAsterisk();
+      return;
+    }
+    std::vector<parsedQuery::SelectClause::VarOrAlias> selected;
+    while (peek() == '?') {
+      selected.emplace_back(parseVariable());
+      skipWhitespace();
+    }
+    if (selected.empty()) {
+      unsupported();
+    }
+    selectClause.setSelected(std::move(selected));
+  }
+
+  // Parse the triples with the same subject (including the predicate and
+  // object lists) and append them to the `triples`.
+  void parseTriplesSameSubject(std::vector<SparqlTriple>& triples) {
+    Term subject = parseTerm(false);
+    while (true) {
+      auto predicate = parsePredicate();
+      while (true) {
+        Term object = parseTerm(true);
+        registerIfVariable(subject);
+        registerIfVariable(predicate);
+        registerIfVariable(object);
+        triples.emplace_back(toTripleComponent(subject), predicate,
+                             toTripleComponent(std::move(object)));
+        skipWhitespace();
+        if (peek() != ',') {
+          break;
+        }
+        ++pos_;
+      }
+      if (peek() != ';') {
+        return;
+      }
+      while (peek() == ';') {
+        ++pos_;
+        skipWhitespace();
+      }
+      // The predicate after the last `;` is optional.
+      if (peek() == '.' || peek() == '}' || atKeyword("FILTER")) {
+        return;
+      }
+    }
+  }
+
+  // Parse `FILTER(operand op operand)`, the keyword has already been parsed.
+  SparqlFilter parseFilter() {
+    using namespace sparqlExpression;
+    expect('(');
+    size_t start = pos_ - 1;
+    auto left = toExpression(parseTerm(true));
+    skipWhitespace();
+    auto relation = input_.substr(pos_, 2);
+    if (relation.starts_with('<') && irirefEnd(pos_).has_value()) {
+      // The general parser would read an IRI here.
+      unsupported();
+    }
+    if (relation != "<=" && relation != ">=" && relation != "!=") {
+      relation = relation.substr(0, 1);
+    }
+    pos_ += relation.size();
+    auto right = toExpression(parseTerm(true));
+    std::array<ExpressionPtr, 2> children{std::move(left), std::move(right)};
+    ExpressionPtr expression;
+    if (relation == "=") {
+      expression = std::make_unique<EqualExpression>(std::move(children));
+    } else if (relation == "!=") {
+      expression = std::make_unique<NotEqualExpression>(std::move(children));
+    } else if (relation == "<") {
+      expression = std::make_unique<LessThanExpression>(std::move(children));
+    } else if (relation == ">") {
+      expression =
+          std::make_unique<GreaterThanExpression>(std::move(children));
+    } else if (relation == "<=") {
+      expression = std::make_unique<LessEqualExpression>(std::move(children));
+    } else if (relation == ">=") {
+      expression =
+          std::make_unique<GreaterEqualExpression>(std::move(children));
+    } else {
+      unsupported();
+    }
+    expect(')');
+    std::string descriptor{input_.substr(start, pos_ - start)};
+    return SparqlFilter{
+        SparqlExpressionPimpl{std::move(expression), std::move(descriptor)}};
+  }
+
+  ParsedQuery::GraphPattern parseGroupGraphPattern() {
+    expect('{');
+    ParsedQuery::GraphPattern pattern;
+    std::vector<SparqlTriple> triples;
+    while (true) {
+      skipWhitespace();
+      if (peek() == '}') {
+        ++pos_;
+        break;
+      }
+      if (tryKeyword("FILTER")) {
+        pattern._filters.push_back(parseFilter());
+        skipWhitespace();
+        if (peek() == '.') {
+          ++pos_;
+        }
+        continue;
+      }
+      parseTriplesSameSubject(triples);
+      skipWhitespace();
+      if (peek() == '.') {
+        ++pos_;
+      } else if (peek() != '}' && !atKeyword("FILTER")) {
+        unsupported();
+      }
+    }
+    // Without `OPTIONAL`, `UNION` etc., all the triples form a single basic
+    // graph pattern.
+    if (!triples.empty()) {
+      pattern._graphPatterns.emplace_back(
+          parsedQuery::BasicGraphPattern{std::move(triples)});
+    }
+    return pattern;
+  }
+
+  // Parse `LIMIT` and `OFFSET`, each at most once and in any order.
+  SolutionModifiers parseSolutionModifiers() {
+    SolutionModifiers modifiers;
+    auto& limitOffset = modifiers.limitOffset_;
+    bool hasLimit = false;
+    bool hasOffset = false;
+    auto parseValue = [this]() {
+      skipWhitespace();
+      size_t start = pos_;
+      while (absl::ascii_isdigit(peek())) {
+        ++pos_;
+      }
+      uint64_t value;
+      auto result = std::from_chars(input_.data() + start,
+                                    input_.data() + pos_, value);
+      if (pos_ == start || result.ec != std::errc{} || !isDelimiter(pos_)) {
+        unsupported();
+      }
+      return value;
+    };
+    while (true) {
+      skipWhitespace();
+      if (!hasLimit && tryKeyword("LIMIT")) {
+        hasLimit = true;
+        limitOffset._limit = parseValue();
+      } else if (!hasOffset && tryKeyword("OFFSET")) {
+        hasOffset = true;
+        limitOffset._offset = parseValue();
+      } else {
+        return modifiers;
+      }
+    }
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<ParsedQuery> SparqlFastPathParser::tryParseQuery(
+    const EncodedIriManager* encodedIriManager, const std::string& query,
+    const std::vector<DatasetClause>& datasets) {
+  try {
+    return FastPathParser{encodedIriManager, query}.parseQuery(datasets);
+  } catch (const Unsupported&) {
+    return std::nullopt;
+  } catch (const std::exception&) {
+    // The query is invalid, the general parser reports the error.
+    return std::nullopt;
+  }
+}
@@ -0,0 +1,46 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_PARSER_SPARQLFASTPATHPARSER_H
+#define QLEVER_SRC_PARSER_SPARQLFASTPATHPARSER_H
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/sparqlParser/DatasetClause.h"
+
+class EncodedIriManager;
+
+// A hand-written parser for a small, but frequent subset of SPARQL queries,
+// which is much faster than the parser that is generated by ANTLR. The
+// supported subset is:
+//
+//   (PREFIX pname: <iri>)*
+//   SELECT [DISTINCT] (?var+ | *) [WHERE] {
+//     triples, separated by `.`, with `;` and `,` for predicate and object
+//     lists, where the subject is a variable or IRI, the predicate is a
+//     variable, an IRI or `a`, and the object is a variable, an IRI, a string
+//     literal (optionally with a language tag or datatype), or an integer,
+//     FILTER(operand op operand) with `op` one of `= != < > <= >=` and the
+//     operands as for the object of a triple.
+//   }
+//   [LIMIT n] [OFFSET n] (in any order)
+//
+// IRIs are either `<...>` or prefixed names with simple local names. Queries
+// with non-ASCII characters, backslashes (escape sequences), or any other
+// construct are not supported. The result is the same `ParsedQuery` that the
+// `SparqlParser` produces for the query.
+class SparqlFastPathParser {
+ public:
+  // Parse the `query` with the given `datasets` (see
+  // `SparqlParser::parseQuery`). Return `std::nullopt` if the query is not in
+  // the supported subset, or if it is invalid, then the query has to be parsed
+  // by the general parser (which also reports the errors).
+  static std::optional<ParsedQuery> tryParseQuery(
+      const EncodedIriManager* encodedIriManager, const std::string& query,
+      const std::vector<DatasetClause>& datasets = {});
+};
+
+#endif  // QLEVER_SRC_PARSER_SPARQLFASTPATHPARSER_H
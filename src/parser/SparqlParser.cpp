@@ -4,7 +4,10 @@
 
 #include "./SparqlParser.h"
 
+#include "global/RuntimeParameters.h"
+#include "parser/SparqlFastPathParser.h"
 #include "parser/SparqlParserHelpers.h"
+#include "util/Metrics.h"
 
 using AntlrParser = SparqlAutomaticParser;
 
@@ -45,6 +48,26 @@ auto parseOperation(BnodeMgr bnodeMgr,
 ParsedQuery SparqlParser::parseQuery(
     const EncodedIriManager* encodedIriManager, std::string query,
     const std::vector<DatasetClause>& datasets) {
+  using namespace ad_utility::metrics;
+  static constexpr std::string_view metricName =
+      "qlever_query_parsing_duration_seconds";
+  static constexpr std::string_view help = "The time for parsing a query";
+  static auto& fastPathHistogram = globalRegistry().histogram(
+      metricName, help, {{"parser", "fast-path"}});
+  static auto& antlrHistogram =
+      globalRegistry().histogram(metricName, help, {{"parser", "antlr"}});
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  // Simple queries are parsed by the much faster hand-written parser, all
+  // other queries by the parser that is generated by ANTLR.
+  if (RuntimeParameters().get<"use-sparql-fast-path-parser">()) {
+    auto fastPathResult =
+        SparqlFastPathParser::tryParseQuery(encodedIriManager, query, datasets);
+    if (fastPathResult.has_value()) {
+      fastPathHistogram.observe(timer.value());
+      return std::move(fastPathResult.value());
+    }
+  }
+  ScopedTimer antlrTimer{antlrHistogram};
   ad_utility::BlankNodeManager bnodeMgr;
   auto res = parseOperation(&bnodeMgr, encodedIriManager, &AntlrParser::query,
                             std::move(query), datasets);
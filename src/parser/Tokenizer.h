@@ -9,6 +9,7 @@
 #include <gtest/gtest_prod.h>
 #include <re2/re2.h>
 
+#include "parser/SimdScanner.h"
 #include "parser/TurtleTokenId.h"
 #include "util/CompilerWarnings.h"
 #include "util/Log.h"
@@ -231,9 +232,8 @@ struct SkipWhitespaceAndCommentsMixin {
  private:
   // _________________________________________________________________________
   bool skipWhitespace() {
-    auto v = self().view();
-    auto numLeadingWhitespace = v.find_first_not_of("\x20\x09\x0D\x0A");
-    numLeadingWhitespace = std::min(numLeadingWhitespace, v.size());
+    auto numLeadingWhitespace =
+        simdScanner::numLeadingWhitespace(self().view());
     self()._data.remove_prefix(numLeadingWhitespace);
     return numLeadingWhitespace > 0;
   }
@@ -317,11 +317,13 @@ ParsedQuery Visitor::visit(Parser::QueryContext* ctx) {
   // The prologue (BASE and PREFIX declarations)  only affects the internal
   // state of the visitor.
   visit(ctx->prologue());
+  parsedQueryMayBeReused_ = true;
   auto query =
       visitAlternative<ParsedQuery>(ctx->selectQuery(), ctx->constructQuery(),
                                     ctx->describeQuery(), ctx->askQuery());
 
   query.postQueryValuesClause_ = visit(ctx->valuesClause());
+  query.mayBeReused_ = parsedQueryMayBeReused_;
 
   query._originalString = ctx->getStart()->getInputStream()->toString();
 
@@ -1432,6 +1434,7 @@ OrderClause Visitor::visit(Parser::OrderClauseContext* ctx) {
 
 // ____________________________________________________________________________________
 std::vector<GroupKey> Visitor::visit(Parser::GroupClauseContext* ctx) {
+  parsedQueryMayBeReused_ = false;
   return visitVector(ctx->groupCondition());
 }
 
@@ -2706,6 +2709,7 @@ ExpressionPtr Visitor::visit([[maybe_unused]] Parser::BuiltInCallContext* ctx) {
     return createUnary(&makeTimezoneExpression);
   } else if (functionName == "now") {
     AD_CONTRACT_CHECK(argList.empty());
+    parsedQueryMayBeReused_ = false;
     return std::make_unique<NowDatetimeExpression>(startTime_);
   } else if (functionName == "hours") {
     return createUnary(&makeHoursExpression);
@@ -2885,6 +2889,7 @@ ExpressionPtr Visitor::visit(Parser::NotExistsFuncContext* ctx) {
 // ____________________________________________________________________________________
 ExpressionPtr Visitor::visit(Parser::AggregateContext* ctx) {
   using namespace sparqlExpression;
+  parsedQueryMayBeReused_ = false;
   const auto& children = ctx->children;
   std::string functionName =
       ad_utility::getLowercase(children.at(0)->getText());
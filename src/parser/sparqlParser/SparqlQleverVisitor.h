@@ -555,6 +555,14 @@ class SparqlQleverVisitor {
   // 2011-01-10T14:45:13.815-05:00
   std::string startTime_ = currentTimeAsXsdString();
 
+  // Is set to false when the query contains an expression that must not be
+  // shared between different executions of the query: `NOW()` refers to the
+  // `startTime_` of the parsing, and the `GroupBy` temporarily (and for the
+  // hash map optimization, permanently) replaces parts of the expression trees
+  // of aggregates during the evaluation, but a copy of a `ParsedQuery` shares
+  // its expressions with the original.
+  bool parsedQueryMayBeReused_ = true;
+
   template <typename Visitor, typename Ctx>
   static constexpr bool voidWhenVisited =
       std::is_void_v<decltype(std::declval<Visitor&>().visit(
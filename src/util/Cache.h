@@ -168,7 +168,8 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
       return {};
     }
     Score s = _scoreCalculator(*valPtr);
-    _totalSizeNonPinned += _valueSizeGetter(*valPtr);
+    _totalSizeNonPinned += sizeOfNewEntry;
+    _sizes[key] = sizeOfNewEntry;
     auto handle = _entries.insert(std::move(s), Entry(key, std::move(valPtr)));
     _accessMap[key] = handle;
     // The first value is the value part of the key-value pair in the priority
@@ -198,10 +199,30 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     // Make room for the new entry.
     makeRoomIfFits(sizeOfNewEntry);
     _pinnedMap[key] = valPtr;
-    _totalSizePinned += _valueSizeGetter(*valPtr);
+    _totalSizePinned += sizeOfNewEntry;
+    _sizes[key] = sizeOfNewEntry;
     return valPtr;
   }
 
+  // Recompute the size of the entry with the `key` (if it exists), for a value
+  // whose size has changed since it was inserted. If the cache is then too
+  // large, non-pinned entries (possibly including this one) are removed.
+  void recomputeSize(const Key& key) {
+    auto sizeIt = _sizes.find(key);
+    if (sizeIt == _sizes.end()) {
+      return;
+    }
+    auto pinnedIt = _pinnedMap.find(key);
+    bool isPinned = pinnedIt != _pinnedMap.end();
+    const Value& value = isPinned ? *pinnedIt->second
+                                  : *_accessMap.at(key).value().value();
+    auto newSize = _valueSizeGetter(value);
+    auto& totalSize = isPinned ? _totalSizePinned : _totalSizeNonPinned;
+    totalSize = totalSize - sizeIt->second + newSize;
+    sizeIt->second = newSize;
+    makeRoomIfFits(0_B);
+  }
+
   //! Set or change the maximum number of entries
   void setMaxNumEntries(const size_t maxNumEntries) {
     _maxNumEntries = maxNumEntries;
@@ -250,7 +271,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     const ValuePtr valuePtr = handle.value().value();
 
     // adapt the sizes of the pinned and non-pinned part of the cache
-    auto sz = _valueSizeGetter(*valuePtr);
+    auto sz = _sizes.at(key);
     _totalSizeNonPinned -= sz;
     _totalSizePinned += sz;
     // Move the entry to the _pinnedMap and remove it from the non-pinned data
@@ -266,7 +287,8 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   void erase(const Key& key) {
     const auto pinnedIt = _pinnedMap.find(key);
     if (pinnedIt != _pinnedMap.end()) {
-      _totalSizePinned -= _valueSizeGetter(*pinnedIt->second);
+      _totalSizePinned -= _sizes.at(key);
+      _sizes.erase(key);
       _pinnedMap.erase(pinnedIt);
       return;
     }
@@ -277,7 +299,8 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
       return;
     }
     // the entry exists in the non-pinned part of the cache, erase it.
-    _totalSizeNonPinned -= _valueSizeGetter(*mapIt->second);
+    _totalSizeNonPinned -= _sizes.at(key);
+    _sizes.erase(key);
     _entries.erase(std::move(mapIt->second));
     _accessMap.erase(mapIt);
   }
@@ -287,11 +310,26 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     // Since we are using shared_ptr this does not free the underlying
     // memory if it is still accessible through a previously returned
     // shared_ptr
+    for (const auto& [key, handle] : _accessMap) {
+      _sizes.erase(key);
+    }
     _entries.clear();
     _accessMap.clear();
     _totalSizeNonPinned = 0_B;
   }
 
+  /// Clear the pinned entries but leave the non-pinned entries alone
+  void clearPinnedOnly() {
+    // Since we are using shared_ptr this does not free the underlying
+    // memory if it is still accessible through a previously returned
+    // shared_ptr
+    for (const auto& [key, value] : _pinnedMap) {
+      _sizes.erase(key);
+    }
+    _pinnedMap.clear();
+    _totalSizePinned = 0_B;
+  }
+
   /// Clear the cache AND the pinned entries
   void clearAll() {
     // Since we are using shared_ptr this does not free the underlying
@@ -300,6 +338,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     _entries.clear();
     _pinnedMap.clear();
     _accessMap.clear();
+    _sizes.clear();
     _totalSizeNonPinned = 0_B;
     _totalSizePinned = 0_B;
   }
@@ -309,8 +348,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return std::accumulate(
         _pinnedMap.begin(), _pinnedMap.end(), 0_B,
         [this](const MemorySize& x, const auto& el) {
-          // entries of the pinned Map are shared_ptrs
-          return x + (el.second ? _valueSizeGetter(*el.second) : 0_B);
+          return x + _sizes.at(el.first);
         });
   }
 
@@ -319,8 +357,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return std::accumulate(
         _accessMap.begin(), _accessMap.end(), 0_B,
         [this](const MemorySize& x, const auto& el) {
-          // entries of the accessMap are shared_ptrs
-          return x + _valueSizeGetter(*el.second.value().value());
+          return x + _sizes.at(el.first);
         });
   }
 
@@ -384,9 +421,10 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   void removeOneEntry() {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
-    _totalSizeNonPinned =
-        _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
-    _accessMap.erase(handle.value().key());
+    const Key& key = handle.value().key();
+    _totalSizeNonPinned = _totalSizeNonPinned - _sizes.at(key);
+    _sizes.erase(key);
+    _accessMap.erase(key);
   }
   size_t _maxNumEntries;
   MemorySize _maxSize;
@@ -401,6 +439,11 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   ValueSizeGetterT _valueSizeGetter;
   PinnedMap _pinnedMap;
   AccessMap _accessMap;
+  // The size of each (pinned or non-pinned) entry, as it was computed on
+  // insertion or by the last call to `recomputeSize`. The total sizes above
+  // are the sums of these sizes, so they stay consistent even if the size of
+  // a value changes while it is in the cache.
+  SizeMap _sizes;
 };
 
 // Partial instantiation of FlexibleCache using the heap-based priority queue
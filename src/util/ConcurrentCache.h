@@ -249,11 +249,22 @@ class ConcurrentCache {
     }
   }
 
+  // Recompute the size of the entry with the `key` if its value has grown or
+  // shrunk since it was inserted (see `FlexibleCache::recomputeSize`).
+  void recomputeSize(const Key& key) {
+    _cacheAndInProgressMap.wlock()->_cache.recomputeSize(key);
+  }
+
   /// Clear the cache (but not the pinned entries)
   void clearUnpinnedOnly() {
     _cacheAndInProgressMap.wlock()->_cache.clearUnpinnedOnly();
   }
 
+  /// Clear the pinned entries (but not the rest of the cache).
+  void clearPinnedOnly() {
+    _cacheAndInProgressMap.wlock()->_cache.clearPinnedOnly();
+  }
+
   /// Clear the cache, including the pinned entries.
   void clearAll() { _cacheAndInProgressMap.wlock()->_cache.clearAll(); }
 
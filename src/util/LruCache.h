@@ -62,6 +62,36 @@ class LRUCache {
     AD_CORRECTNESS_CHECK(result.second);
     return result.first->second.first;
   }
+
+  // Return a pointer to the value for `key` and mark it as the most recently
+  // used element if it is in the cache, else return `nullptr`. The pointer is
+  // only valid until the next non-const call to this cache.
+  const V* getIfContained(const K& key) {
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      return nullptr;
+    }
+    const auto& [value, listIterator] = it->second;
+    keys_.splice(keys_.begin(), keys_, listIterator);
+    return &value;
+  }
+
+  // Store the `value` for `key` (replacing a previous value) and mark it as
+  // the most recently used element. If the cache is already at maximum
+  // capacity, evict the least recently used element.
+  void insertOrAssign(const K& key, V value) {
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+      getOrCompute(key, [&value](const K&) { return std::move(value); });
+      return;
+    }
+    auto& [oldValue, listIterator] = it->second;
+    oldValue = std::move(value);
+    keys_.splice(keys_.begin(), keys_, listIterator);
+  }
+
+  // Return the number of elements that are currently stored in the cache.
+  size_t size() const { return cache_.size(); }
 };
 
 }  // namespace ad_utility::util
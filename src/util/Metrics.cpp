@@ -0,0 +1,216 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#include "util/Metrics.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include "util/Exception.h"
+
+namespace ad_utility::metrics {
+
+// _____________________________________________________________________________
+size_t currentShard() {
+  static std::atomic<size_t> nextShard = 0;
+  thread_local const size_t shard =
+      nextShard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+  return shard;
+}
+
+// _____________________________________________________________________________
+uint64_t Counter::value() const {
+  uint64_t result = 0;
+  for (const auto& shard : shards_) {
+    result += shard.value_.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void Histogram::observe(std::chrono::nanoseconds duration) {
+  double seconds = std::chrono::duration<double>(duration).count();
+  // The number of buckets is small, so a linear search is fastest.
+  size_t bucket = 0;
+  while (bucket < BUCKET_BOUNDS.size() && seconds > BUCKET_BOUNDS[bucket]) {
+    ++bucket;
+  }
+  auto& shard = shards_[currentShard()];
+  shard.bucketCounts_[bucket].fetch_add(1, std::memory_order_relaxed);
+  shard.sumNanoseconds_.fetch_add(
+      static_cast<uint64_t>(std::max(duration.count(), int64_t{0})),
+      std::memory_order_relaxed);
+}
+
+// _____________________________________________________________________________
+auto Histogram::snapshot() const -> Snapshot {
+  Snapshot result;
+  uint64_t sumNanoseconds = 0;
+  for (const auto& shard : shards_) {
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+      auto count = shard.bucketCounts_[i].load(std::memory_order_relaxed);
+      result.bucketCounts_[i] += count;
+      result.count_ += count;
+    }
+    sumNanoseconds += shard.sumNanoseconds_.load(std::memory_order_relaxed);
+  }
+  result.sum_ = std::chrono::nanoseconds{sumNanoseconds};
+  return result;
+}
+
+namespace {
+// Format the `labels` as `key1="value1",key2="value2"`, with the escaping that
+// is required by Prometheus.
+std::string formatLabels(const Labels& labels) {
+  auto escape = [](std::string_view value) {
+    std::string result;
+    for (char c : value) {
+      if (c == '\\' || c == '"') {
+        result.push_back('\\');
+        result.push_back(c);
+      } else if (c == '\n') {
+        result.append("\\n");
+      } else {
+        result.push_back(c);
+      }
+    }
+    return result;
+  };
+  return absl::StrJoin(labels, ",", [&escape](std::string* out, const auto& p) {
+    absl::StrAppend(out, p.first, "=\"", escape(p.second), "\"");
+  });
+}
+
+// Return `{labels}`, or the empty string if there are no labels.
+std::string withBraces(std::string_view labels) {
+  return labels.empty() ? std::string{} : absl::StrCat("{", labels, "}");
+}
+
+// The name of the type of a metric in the Prometheus format.
+template <typename T>
+constexpr std::string_view typeName() {
+  if constexpr (std::is_same_v<T, Counter>) {
+    return "counter";
+  } else if constexpr (std::is_same_v<T, Gauge>) {
+    return "gauge";
+  } else {
+    static_assert(std::is_same_v<T, Histogram>);
+    return "histogram";
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+template <typename T>
+T& Registry::getOrCreate(std::string_view name, std::string_view help,
+                         const Labels& labels) {
+  auto formattedLabels = formatLabels(labels);
+  auto get = [&name, &formattedLabels](const auto& families) -> T* {
+    auto family = families.find(name);
+    if (family == families.end()) {
+      return nullptr;
+    }
+    auto metric = family->second.metrics_.find(formattedLabels);
+    if (metric == family->second.metrics_.end()) {
+      return nullptr;
+    }
+    auto* ptr = std::get_if<std::unique_ptr<T>>(&metric->second);
+    AD_CONTRACT_CHECK(ptr != nullptr, "The metric \"", name,
+                      "\" was registered with a different type");
+    return ptr->get();
+  };
+  // The metric usually exists already, then the shared lock suffices.
+  if (T* metric = families_.withReadLock(get)) {
+    return *metric;
+  }
+  return *families_.withWriteLock([&](auto& families) -> T* {
+    if (T* metric = get(families)) {
+      return metric;
+    }
+    auto& family = families[std::string{name}];
+    if (family.help_.empty()) {
+      family.help_ = help;
+    }
+    AD_CONTRACT_CHECK(family.metrics_.empty() ||
+                          std::holds_alternative<std::unique_ptr<T>>(
+                              family.metrics_.begin()->second),
+                      "The metric \"", name,
+                      "\" was registered with a different type");
+    auto metric = std::make_unique<T>();
+    T* result = metric.get();
+    family.metrics_.emplace(formattedLabels, std::move(metric));
+    return result;
+  });
+}
+
+// _____________________________________________________________________________
+Counter& Registry::counter(std::string_view name, std::string_view help,
+                           const Labels& labels) {
+  return getOrCreate<Counter>(name, help, labels);
+}
+
+// _____________________________________________________________________________
+Gauge& Registry::gauge(std::string_view name, std::string_view help,
+                       const Labels& labels) {
+  return getOrCreate<Gauge>(name, help, labels);
+}
+
+// _____________________________________________________________________________
+Histogram& Registry::histogram(std::string_view name, std::string_view help,
+                               const Labels& labels) {
+  return getOrCreate<Histogram>(name, help, labels);
+}
+
+// _____________________________________________________________________________
+std::string Registry::toPrometheusText() const {
+  std::string result;
+  families_.withReadLock([&result](const auto& families) {
+    for (const auto& [name, family] : families) {
+      if (family.metrics_.empty()) {
+        continue;
+      }
+      std::string_view type = std::visit(
+          []<typename T>(const std::unique_ptr<T>&) { return typeName<T>(); },
+          family.metrics_.begin()->second);
+      absl::StrAppend(&result, "# HELP ", name, " ", family.help_, "\n",
+                      "# TYPE ", name, " ", type, "\n");
+      for (const auto& [labels, metric] : family.metrics_) {
+        if (const auto* counter =
+                std::get_if<std::unique_ptr<Counter>>(&metric)) {
+          absl::StrAppend(&result, name, withBraces(labels), " ",
+                          (*counter)->value(), "\n");
+        } else if (const auto* gauge =
+                       std::get_if<std::unique_ptr<Gauge>>(&metric)) {
+          absl::StrAppend(&result, name, withBraces(labels), " ",
+                          (*gauge)->value(), "\n");
+        } else {
+          const auto& histogram = std::get<std::unique_ptr<Histogram>>(metric);
+          auto snapshot = histogram->snapshot();
+          std::string separator = labels.empty() ? "" : ",";
+          uint64_t cumulativeCount = 0;
+          for (size_t i = 0; i < Histogram::NUM_BUCKETS; ++i) {
+            cumulativeCount += snapshot.bucketCounts_[i];
+            std::string bound = i < Histogram::BUCKET_BOUNDS.size()
+                                    ? absl::StrCat(Histogram::BUCKET_BOUNDS[i])
+                                    : "+Inf";
+            absl::StrAppend(&result, name, "_bucket{", labels, separator,
+                            "le=\"", bound, "\"} ", cumulativeCount, "\n");
+          }
+          absl::StrAppend(
+              &result, name, "_sum", withBraces(labels), " ",
+              std::chrono::duration<double>(snapshot.sum_).count(), "\n", name,
+              "_count", withBraces(labels), " ", snapshot.count_, "\n");
+        }
+      }
+    }
+  });
+  return result;
+}
+
+// _____________________________________________________________________________
+Registry& globalRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+}  // namespace ad_utility::metrics
@@ -0,0 +1,150 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_UTIL_METRICS_H
+#define QLEVER_SRC_UTIL_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "util/Synchronized.h"
+#include "util/Timer.h"
+
+// Counters, gauges, and latency histograms that are always recorded and that
+// can be exported in the text format of Prometheus (see the `cmd=metrics`
+// command of the `Server`). Recording a value is cheap enough for hot paths:
+// each metric consists of several shards on separate cache lines, and each
+// thread always writes to the same shard with relaxed atomic operations. The
+// shards are only summed up when the metrics are exported.
+namespace ad_utility::metrics {
+
+// The number of shards per metric. Threads are assigned to the shards in a
+// round-robin fashion.
+static constexpr size_t NUM_SHARDS = 16;
+
+// The shard of the current thread.
+size_t currentShard();
+
+// A monotonically increasing count (for example, the number of cache hits).
+class Counter {
+ public:
+  void add(uint64_t value = 1) {
+    shards_[currentShard()].value_.fetch_add(value, std::memory_order_relaxed);
+  }
+  uint64_t value() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> value_ = 0;
+  };
+  std::array<Shard, NUM_SHARDS> shards_;
+};
+
+// A value that can go up and down (for example, the number of delta triples).
+// It is set as a whole, so it is not sharded.
+class Gauge {
+ public:
+  void set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+  int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<int64_t> value_ = 0;
+};
+
+// The distribution of durations, with fixed buckets from 100 microseconds to
+// one minute.
+class Histogram {
+ public:
+  // The upper bounds of the buckets in seconds. There is an additional bucket
+  // for all the larger values.
+  static constexpr std::array<double, 12> BUCKET_BOUNDS{
+      0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 60};
+  static constexpr size_t NUM_BUCKETS = BUCKET_BOUNDS.size() + 1;
+
+  void observe(std::chrono::nanoseconds duration);
+
+  // The sum of all the shards. The bucket counts are not cumulative.
+  struct Snapshot {
+    std::array<uint64_t, NUM_BUCKETS> bucketCounts_{};
+    uint64_t count_ = 0;
+    std::chrono::nanoseconds sum_{0};
+  };
+  Snapshot snapshot() const;
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> bucketCounts_{};
+    std::atomic<uint64_t> sumNanoseconds_ = 0;
+  };
+  std::array<Shard, NUM_SHARDS> shards_;
+};
+
+// The labels of a metric, for example `{{"operation", "Join"}}`.
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+// The set of all metrics. A metric is identified by its name and its labels,
+// and all the metrics with the same name must have the same type. The returned
+// references stay valid for the lifetime of the registry, so the callers on
+// hot paths should look up the metric once (for example, in a function-local
+// `static` variable).
+class Registry {
+ public:
+  Counter& counter(std::string_view name, std::string_view help,
+                   const Labels& labels = {});
+  Gauge& gauge(std::string_view name, std::string_view help,
+               const Labels& labels = {});
+  Histogram& histogram(std::string_view name, std::string_view help,
+                       const Labels& labels = {});
+
+  // Export all the metrics in the text format of Prometheus.
+  std::string toPrometheusText() const;
+
+ private:
+  using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>,
+                              std::unique_ptr<Histogram>>;
+  struct Family {
+    std::string help_;
+    // The metrics by their formatted labels (for example `operation="Join"`).
+    std::map<std::string, Metric> metrics_;
+  };
+
+  // Return the metric of type `T` with the given `name` and `labels`, create
+  // it if it doesn't exist yet.
+  template <typename T>
+  T& getOrCreate(std::string_view name, std::string_view help,
+                 const Labels& labels);
+
+  ad_utility::Synchronized<std::map<std::string, Family, std::less<>>>
+      families_;
+};
+
+// The registry that is used by the `Server` and in which all the components
+// of QLever record their metrics.
+Registry& globalRegistry();
+
+// Observe the time between the construction and the destruction of this
+// object in the given `histogram`.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram& histogram) : histogram_{histogram} {}
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ~ScopedTimer() { histogram_.observe(timer_.value()); }
+
+ private:
+  Histogram& histogram_;
+  ad_utility::Timer timer_{ad_utility::Timer::Started};
+};
+
+}  // namespace ad_utility::metrics
+
+#endif  // QLEVER_SRC_UTIL_METRICS_H
@@ -0,0 +1,118 @@
+// Copyright 2026, University of Freiburg,
+// Chair of Algorithms and Data Structures.
+
+#ifndef QLEVER_SRC_UTIL_READONLYMMAPFILE_H
+#define QLEVER_SRC_UTIL_READONLYMMAPFILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <absl/strings/str_cat.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "backports/span.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// A complete file that is memory-mapped for reading. The contents are not
+// copied to the heap, but are read lazily via the page cache of the operating
+// system. This makes the loading of large files (almost) instantaneous, and
+// several processes that map the same file share the same physical memory.
+class ReadOnlyMmapFile {
+ private:
+  std::string filename_;
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+
+ public:
+  // Map the file at `filename`. Throw if the file can't be opened or mapped.
+  explicit ReadOnlyMmapFile(std::string filename)
+      : filename_{std::move(filename)} {
+    int fd = ::open(filename_.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw std::runtime_error{
+          absl::StrCat("Could not open file \"", filename_,
+                       "\" for memory mapping: ", std::strerror(errno))};
+    }
+    struct stat fileInfo {};
+    if (::fstat(fd, &fileInfo) != 0) {
+      ::close(fd);
+      throw std::runtime_error{
+          absl::StrCat("Could not determine the size of \"", filename_,
+                       "\": ", std::strerror(errno))};
+    }
+    size_ = static_cast<size_t>(fileInfo.st_size);
+    // An empty file can't be mapped, but there is also nothing to read.
+    if (size_ > 0) {
+      void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (ptr == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error{
+            absl::StrCat("Could not memory-map file \"", filename_,
+                         "\": ", std::strerror(errno))};
+      }
+      data_ = static_cast<const char*>(ptr);
+    }
+    // The mapping stays valid after the file descriptor is closed.
+    ::close(fd);
+  }
+
+  // The mapping is owned exclusively, so this type is neither copyable nor
+  // movable (use a `shared_ptr` to share it).
+  ReadOnlyMmapFile(const ReadOnlyMmapFile&) = delete;
+  ReadOnlyMmapFile& operator=(const ReadOnlyMmapFile&) = delete;
+
+  ~ReadOnlyMmapFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  const std::string& filename() const { return filename_; }
+  size_t size() const { return size_; }
+  const char* data() const { return data_; }
+
+  // Return the `numElements` objects of type `T` that are stored starting at
+  // byte `offset`. Throw if the range is out of bounds or not properly
+  // aligned for `T`.
+  template <typename T>
+  ql::span<const T> view(size_t offset, size_t numElements) const {
+    AD_CONTRACT_CHECK(offset <= size_ &&
+                          numElements <= (size_ - offset) / sizeof(T),
+                      "Range out of bounds in memory-mapped file ", filename_);
+    if (numElements == 0) {
+      return {};
+    }
+    const char* ptr = data_ + offset;
+    AD_CONTRACT_CHECK(isAligned<T>(offset));
+    return {reinterpret_cast<const T*>(ptr), numElements};
+  }
+
+  // Return true iff objects of type `T` can be directly read at `offset`.
+  template <typename T>
+  bool isAligned(size_t offset) const {
+    return reinterpret_cast<uintptr_t>(data_ + offset) % alignof(T) == 0;
+  }
+
+  // Read a single object of type `T` at byte `offset`. This also works for
+  // unaligned offsets.
+  template <typename T>
+  T read(size_t offset) const {
+    AD_CONTRACT_CHECK(offset <= size_ && sizeof(T) <= size_ - offset,
+                      "Range out of bounds in memory-mapped file ", filename_);
+    T result;
+    std::memcpy(&result, data_ + offset, sizeof(T));
+    return result;
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_READONLYMMAPFILE_H
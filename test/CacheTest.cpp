@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <string>
 #include <string_view>
 
@@ -139,4 +140,41 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+// _____________________________________________________________________________
+TEST(LRUCacheTest, recomputeSize) {
+  LRUCache<string, string, StringSizeGetter<string>> cache(10, 10_B, 10_B);
+  auto value = std::make_shared<string>("xx");
+  auto pinnedValue = std::make_shared<string>("x");
+  cache.insert("1", value);
+  cache.insert("2", "xxx");
+  cache.insertPinned("3", pinnedValue);
+  ASSERT_EQ(cache.nonPinnedSize(), 5_B);
+  ASSERT_EQ(cache.pinnedSize(), 1_B);
+
+  // The sizes only change when they are recomputed.
+  *value = "xxxx";
+  *pinnedValue = "xx";
+  ASSERT_EQ(cache.nonPinnedSize(), 5_B);
+  cache.recomputeSize("1");
+  cache.recomputeSize("3");
+  cache.recomputeSize("unknown");
+  ASSERT_EQ(cache.nonPinnedSize(), 7_B);
+  ASSERT_EQ(cache.pinnedSize(), 2_B);
+
+  // An entry that has grown too much is evicted (here the least recently used
+  // one, which is the grown entry itself).
+  *value = "xxxxxxx";
+  cache.recomputeSize("1");
+  ASSERT_FALSE(cache["1"]);
+  ASSERT_EQ(*cache["2"], "xxx");
+  ASSERT_EQ(cache.nonPinnedSize(), 3_B);
+
+  // Erasing an entry subtracts the size it was accounted with.
+  *pinnedValue = "xxxx";
+  cache.erase("3");
+  ASSERT_EQ(cache.pinnedSize(), 0_B);
+  cache.clearUnpinnedOnly();
+  ASSERT_EQ(cache.nonPinnedSize(), 0_B);
+}
 }  // namespace ad_utility
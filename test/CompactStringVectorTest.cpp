@@ -267,3 +267,59 @@ TEST(CompactVectorOfStrings, SerializationWithPushMiddleOfFile) {
   testSerializationWithPush(CompactVectorChar{}, strings);
   testSerializationWithPush(CompactVectorInt{}, ints);
 }
+
+// Test that a `CompactVectorOfStrings` can be memory-mapped from a file, also
+// from the middle of a file and when the offsets in the file are not aligned.
+TEST(CompactVectorOfStrings, MemoryMapped) {
+  auto testMemoryMapped = [](const auto& v, auto& inputVector,
+                             size_t numBytesBefore) {
+    using V = std::decay_t<decltype(v)>;
+
+    const std::string filename = "_writerTest4.dat";
+    const std::string filename2 = "_writerTest5.dat";
+    {
+      ad_utility::File file{filename, "w"};
+      std::string prefix(numBytesBefore, 'x');
+      file.write(prefix.data(), prefix.size());
+      typename V::Writer writer{std::move(file)};
+      for (const auto& s : inputVector) {
+        writer.push(s.data(), s.size());
+      }
+    }
+
+    auto compactVector = V::fromMmappedFile(
+        std::make_shared<const ad_utility::ReadOnlyMmapFile>(filename),
+        numBytesBefore);
+    EXPECT_TRUE(compactVector.isMmapped());
+    vectorsEqual(inputVector, compactVector);
+
+    // The mapping stays valid when the vector is moved.
+    V moved{std::move(compactVector)};
+    vectorsEqual(inputVector, moved);
+
+    // A memory-mapped vector can be serialized in the usual format.
+    {
+      ad_utility::serialization::FileWriteSerializer ser{filename2};
+      ser << moved;
+    }
+    V deserialized;
+    {
+      ad_utility::serialization::FileReadSerializer ser{filename2};
+      ser >> deserialized;
+    }
+    EXPECT_FALSE(deserialized.isMmapped());
+    vectorsEqual(inputVector, deserialized);
+
+    ad_utility::deleteFile(filename);
+    ad_utility::deleteFile(filename2);
+  };
+  // For the strings, the offsets in the file are aligned only in the second
+  // case.
+  testMemoryMapped(CompactVectorChar{}, strings, 0);
+  testMemoryMapped(CompactVectorChar{}, strings, 2);
+  testMemoryMapped(CompactVectorInt{}, ints, 0);
+  testMemoryMapped(CompactVectorInt{}, ints, 8);
+
+  // Files that don't exist can't be mapped.
+  EXPECT_ANY_THROW(ad_utility::ReadOnlyMmapFile{"_doesNotExist.dat"});
+}
@@ -175,6 +175,19 @@ TEST(ConcurrentCache, sequentialPinnedUpgradeComputation) {
   ASSERT_TRUE(a.getStorage().wlock()->_inProgress.empty());
 }
 
+TEST(ConcurrentCache, clearPinnedOnly) {
+  SimpleConcurrentLruCache a{3ul};
+  a.computeOncePinned(3, waiting_function("3"s, 0), false, returnTrue);
+  a.computeOnce(4, waiting_function("4"s, 0), false, returnTrue);
+  ASSERT_EQ(1ul, a.numPinnedEntries());
+  ASSERT_EQ(1ul, a.numNonPinnedEntries());
+  a.clearPinnedOnly();
+  ASSERT_EQ(0ul, a.numPinnedEntries());
+  ASSERT_EQ(1ul, a.numNonPinnedEntries());
+  auto result = a.computeOnce(4, waiting_function("4"s, 0), false, returnTrue);
+  ASSERT_EQ(result._cacheStatus, ad_utility::CacheStatus::cachedNotPinned);
+}
+
 TEST(ConcurrentCache, concurrentComputation) {
   auto a = SimpleConcurrentLruCache(3ul);
   StartStopSignal signal;
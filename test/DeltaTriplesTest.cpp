@@ -449,6 +449,62 @@ TEST_F(DeltaTriplesTest, DeltaTriplesManager) {
                                      3 * numThreads + 2));
 }
 
+// Test that the snapshots record the index of the last snapshot in which the
+// triples of a predicate were changed (this is used for the cache keys).
+TEST_F(DeltaTriplesTest, lastChangePerPredicate) {
+  DeltaTriplesManager deltaTriplesManager(testQec->getIndex().getImpl());
+  auto& vocab = testQec->getIndex().getVocab();
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  LocalVocab localVocab;
+  auto uppTriples = makeIdTriples(vocab, localVocab, {"<a> <upp> <X>"});
+  auto lowTriples = makeIdTriples(vocab, localVocab, {"<a> <low> <X>"});
+  Id upp = uppTriples.at(0).ids().at(1);
+  Id low = lowTriples.at(0).ids().at(1);
+  auto insert = [&](const DeltaTriples::Triples& triples) {
+    deltaTriplesManager.modify<void>([&](DeltaTriples& deltaTriples) {
+      deltaTriples.insertTriples(cancellationHandle, triples);
+    });
+    return deltaTriplesManager.getCurrentSnapshot();
+  };
+
+  auto snapshot0 = deltaTriplesManager.getCurrentSnapshot();
+  EXPECT_EQ(snapshot0->versions_->lastChange_, 0);
+  EXPECT_EQ(snapshot0->versions_->lastChangeOfPredicate(upp), 0);
+  EXPECT_EQ(snapshot0->versions_->lastChangeOfPredicate(low), 0);
+
+  // Only the predicate of the inserted triple is changed.
+  auto snapshot1 = insert(uppTriples);
+  EXPECT_EQ(snapshot1->versions_->lastChange_, snapshot1->index_);
+  EXPECT_EQ(snapshot1->versions_->lastChangeOfPredicate(upp),
+            snapshot1->index_);
+  EXPECT_EQ(snapshot1->versions_->lastChangeOfPredicate(low), 0);
+  // The previous snapshot is not affected.
+  EXPECT_EQ(snapshot0->versions_->lastChangeOfPredicate(upp), 0);
+
+  auto snapshot2 = insert(lowTriples);
+  EXPECT_EQ(snapshot2->versions_->lastChangeOfPredicate(upp),
+            snapshot1->index_);
+  EXPECT_EQ(snapshot2->versions_->lastChangeOfPredicate(low),
+            snapshot2->index_);
+
+  // Inserting a triple that is already inserted doesn't change anything.
+  auto snapshot3 = insert(uppTriples);
+  EXPECT_EQ(snapshot3->versions_->lastChange_, snapshot2->index_);
+  EXPECT_EQ(snapshot3->versions_->lastChangeOfPredicate(upp),
+            snapshot1->index_);
+
+  // After clearing, the results of the original index are valid again.
+  deltaTriplesManager.clear();
+  auto snapshot4 = deltaTriplesManager.getCurrentSnapshot();
+  EXPECT_EQ(snapshot4->versions_->lastChange_, 0);
+  EXPECT_EQ(snapshot4->versions_->lastChangeOfPredicate(upp), 0);
+  EXPECT_EQ(snapshot4->versions_->lastChangeOfPredicate(low), 0);
+  // The snapshots before the clearing are not affected.
+  EXPECT_EQ(snapshot2->versions_->lastChangeOfPredicate(low),
+            snapshot2->index_);
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, restoreFromNonExistingFile) {
   DeltaTriples deltaTriples{testQec->getIndex()};
@@ -10,7 +10,9 @@
 #include "./util/IndexTestHelpers.h"
 #include "./util/TripleComponentTestHelpers.h"
 #include "engine/GraphStoreProtocol.h"
+#include "index/DeltaTriples.h"
 #include "parser/SparqlParserHelpers.h"
+#include "util/ParseException.h"
 
 namespace m = matchers;
 using namespace ad_utility::testing;
@@ -362,3 +364,95 @@ TEST(GraphStoreProtocolTest, EncodedIriManagerUsage) {
       graphQuery._originalString,
       testing::HasSubstr("GRAPH <http://example.org/123> { ?s ?p ?o }"));
 }
+
+// _____________________________________________________________________________________________
+TEST(GraphStoreProtocolTest, insertTriplesInBatches) {
+  const Index& index = ad_utility::testing::getQec()->getIndex();
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  // The fourth triple is a duplicate of the first one, but they are parsed
+  // in different batches. This checks that the same blank node label is
+  // mapped to the same blank node in all batches.
+  std::string body =
+      "_:b <p> <o1> .\n"
+      "<s> <p> <o2> .\n"
+      "<s> <p> <o3> .\n"
+      "_:b <p> <o1> .\n"
+      "_:c <p> <o1> .\n";
+  for (size_t batchSize : {1, 2, 3, 100}) {
+    DeltaTriples deltaTriples{index};
+    auto metadata = GraphStoreProtocol::insertTriplesInBatches(
+        body, ad_utility::MediaType::turtle, DEFAULT{}, index, deltaTriples,
+        handle, batchSize);
+    EXPECT_EQ(deltaTriples.numInserted(), 4) << batchSize;
+    EXPECT_EQ(deltaTriples.numDeleted(), 0) << batchSize;
+    ASSERT_TRUE(metadata.inUpdate_.has_value());
+    // Duplicates are only removed within a batch.
+    EXPECT_EQ(metadata.inUpdate_->triplesInserted_, batchSize >= 4 ? 4 : 5)
+        << batchSize;
+
+    // The same triples in a named graph are different triples, but the blank
+    // nodes are fresh for each request.
+    GraphStoreProtocol::insertTriplesInBatches(
+        body, ad_utility::MediaType::ntriples, iri("<g>"), index,
+        deltaTriples, handle, batchSize);
+    EXPECT_EQ(deltaTriples.numInserted(), 8) << batchSize;
+  }
+
+  // Prefixes are kept between the batches.
+  {
+    DeltaTriples deltaTriples{index};
+    GraphStoreProtocol::insertTriplesInBatches(
+        "@prefix ex: <http://example.org/> .\n"
+        "ex:a ex:b ex:c .\n ex:d ex:e ex:f, ex:g .",
+        ad_utility::MediaType::turtle, DEFAULT{}, index, deltaTriples, handle,
+        1);
+    EXPECT_EQ(deltaTriples.numInserted(), 3);
+  }
+
+  // A syntax error is reported. Some of the batches before it might have been
+  // inserted, depending on how far the parsing was ahead of the insertion, and
+  // the error reports how many triples that are.
+  {
+    DeltaTriples deltaTriples{index};
+    try {
+      GraphStoreProtocol::insertTriplesInBatches(
+          "<a> <b> <c> .\n <d> <e> <f> .\n <a> <b> .",
+          ad_utility::MediaType::turtle, DEFAULT{}, index, deltaTriples, handle,
+          1);
+      ADD_FAILURE() << "The syntax error was not reported";
+    } catch (const ParseException& e) {
+      EXPECT_LE(deltaTriples.numInserted(), 2);
+      EXPECT_THAT(e.what(), testing::HasSubstr("Parse error"));
+      EXPECT_THAT(e.what(),
+                  testing::HasSubstr(absl::StrCat(
+                      "aborted after ", deltaTriples.numInserted(),
+                      " triples of the request had been inserted")));
+    }
+  }
+
+  // Unsupported media types.
+  {
+    DeltaTriples deltaTriples{index};
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        GraphStoreProtocol::insertTriplesInBatches(
+            "{}", ad_utility::MediaType::json, DEFAULT{}, index, deltaTriples,
+            handle, 1),
+        testing::HasSubstr("Mediatype \"application/json\" is not supported"));
+  }
+
+  // The complete request.
+  {
+    DeltaTriples deltaTriples{index};
+    GraphStoreProtocol::insertInBatches(
+        makePostRequest("/?default&insert-in-batches=true", "text/turtle",
+                        body),
+        DEFAULT{}, index, deltaTriples, handle, 2);
+    EXPECT_EQ(deltaTriples.numInserted(), 4);
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        GraphStoreProtocol::insertInBatches(
+            makePostRequest("/?default&insert-in-batches=true", "text/turtle",
+                            ""),
+            DEFAULT{}, index, deltaTriples, handle),
+        testing::HasSubstr("Request body is empty"));
+  }
+}
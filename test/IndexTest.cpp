@@ -390,6 +390,48 @@ TEST(IndexTest, scanTest) {
   testWithAndWithoutPrefixCompression(false);
 };
 
+// ______________________________________________________________
+TEST(IndexTest, parallelPermutationCreation) {
+  std::string kb =
+      "<a>  <b>  <c>  . \n"
+      "<a>  <b>  <c2> . \n"
+      "<a>  <b2> <c>  . \n"
+      "<a2> <b2> <c2> . \n"
+      "<c>  <b>  <a>  .   ";
+  auto makeQecWithParallelPermutations = [&kb](bool parallel) {
+    TestIndexConfig config{kb};
+    config.usePatterns = false;
+    config.parallelPermutationCreation = parallel;
+    return getQec(std::move(config));
+  };
+  const auto& sequentialQec = *makeQecWithParallelPermutations(false);
+  const auto& parallelQec = *makeQecWithParallelPermutations(true);
+  const IndexImpl& sequential = sequentialQec.getIndex().getImpl();
+  const IndexImpl& parallel = parallelQec.getIndex().getImpl();
+
+  EXPECT_EQ(parallel.numTriples(), sequential.numTriples());
+  EXPECT_EQ(parallel.numDistinctSubjects(), sequential.numDistinctSubjects());
+  EXPECT_EQ(parallel.numDistinctPredicates(),
+            sequential.numDistinctPredicates());
+  EXPECT_EQ(parallel.numDistinctObjects(), sequential.numDistinctObjects());
+
+  // All the permutations have to contain the same triples.
+  auto scan = [](const IndexImpl& index, const QueryExecutionContext& qec,
+                 const TripleComponent& c0, Permutation::Enum permutation) {
+    return index.scan({c0, std::nullopt, std::nullopt}, permutation,
+                      Permutation::ColumnIndicesRef{},
+                      std::make_shared<ad_utility::CancellationHandle<>>(),
+                      qec.locatedTriplesSnapshot());
+  };
+  for (auto permutation : Permutation::ALL) {
+    for (const auto& c0 : {iri("<a>"), iri("<a2>"), iri("<b>"), iri("<b2>"),
+                           iri("<c>"), iri("<c2>")}) {
+      EXPECT_EQ(scan(parallel, parallelQec, c0, permutation),
+                scan(sequential, sequentialQec, c0, permutation));
+    }
+  }
+}
+
 // ______________________________________________________________
 TEST(IndexTest, emptyIndex) {
   const auto& qec = *makeQecWithOrWithoutCompression("", true);
@@ -612,6 +654,32 @@ TEST(IndexTest, updateInputFileSpecificationsAndLog) {
     EXPECT_FALSE(twoFilesSpec.at(1).parseInParallel_);
   }
 
+  // Parallel parsing not specified anywhere for N-Quads input streams. They
+  // are parsed in parallel by default (without a deprecation warning), because
+  // N-Quads can always be split at newlines.
+  {
+    std::vector<qlever::InputFileSpecification> nQuadsSpec = {
+        {"firstFile.nq", NQuad, std::nullopt},
+        {"secondFile.ttl", Turtle, std::nullopt},
+        {"thirdFile.nq", NQuad, std::nullopt, false, true}};
+    testing::internal::CaptureStdout();
+    IndexImpl::updateInputFileSpecificationsAndLog(nQuadsSpec, std::nullopt);
+    EXPECT_THAT(testing::internal::GetCapturedStdout(),
+                Not(HasSubstr("deprecated")));
+    EXPECT_TRUE(nQuadsSpec.at(0).parseInParallel_);
+    EXPECT_FALSE(nQuadsSpec.at(1).parseInParallel_);
+    EXPECT_FALSE(nQuadsSpec.at(2).parseInParallel_);
+
+    nQuadsSpec.resize(1);
+    nQuadsSpec.at(0).parseInParallel_ = false;
+    testing::internal::CaptureStdout();
+    IndexImpl::updateInputFileSpecificationsAndLog(nQuadsSpec, std::nullopt);
+    EXPECT_THAT(testing::internal::GetCapturedStdout(),
+                AllOf(HasSubstr("firstFile.nq"), HasSubstr("parallel = true"),
+                      Not(HasSubstr("deprecated"))));
+    EXPECT_TRUE(nQuadsSpec.at(0).parseInParallel_);
+  }
+
   // Parallel parsing not specified on the command line, but explicitly set in
   // the `settings.json` file. This is deprecated for a single input
   // stream and forbidden for multiple input streams.
@@ -101,7 +101,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
     return testing::ResultOf(
         absl::StrCat(".map_.at(", std::to_string(blockIndex), ")"),
         [blockIndex](const LocatedTriplesPerBlock& ltpb) {
-          return ltpb.map_.at(blockIndex);
+          return *ltpb.map_->at(blockIndex);
         },
         testing::Eq(expectedLTs));
   };
@@ -118,11 +118,12 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               return locatedTriplesInBlock(blockIndex, expectedLTs);
             });
         // The macro does not work with templated types.
-        using HashMapType = ad_utility::HashMap<size_t, LocatedTriples>;
+        using HashMapType = LocatedTriplesPerBlock::BlockMap;
         return testing::AllOf(
             AD_FIELD(LocatedTriplesPerBlock, map_,
-                     AD_PROPERTY(HashMapType, size,
-                                 testing::Eq(locatedTriplesBlockwise.size()))),
+                     testing::Pointee(AD_PROPERTY(
+                         HashMapType, size,
+                         testing::Eq(locatedTriplesBlockwise.size())))),
             testing::AllOfArray(blockMatchers));
       };
   using LT = LocatedTriple;
@@ -153,7 +154,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               locatedTriplesAre(
                   {{1, {LT1, LT2, LT3}}, {2, {LT4, LT5}}, {4, {LT6, LT7}}}));
 
-  auto handles = locatedTriplesPerBlock.add(std::vector{LT8, LT9});
+  locatedTriplesPerBlock.add(std::vector{LT8, LT9});
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(4));
   EXPECT_THAT(locatedTriplesPerBlock, numTriplesTotal(9));
@@ -166,7 +167,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
                                  {3, {LT8}},
                                  {4, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(3, handles[0]);
+  locatedTriplesPerBlock.erase(3, LT8.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -180,7 +181,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
           {{1, {LT1, LT2, LT3}}, {2, {LT4, LT5}}, {4, {LT6, LT7, LT9}}}));
 
   // Erasing in a block that does not exist, raises an exception.
-  EXPECT_THROW(locatedTriplesPerBlock.erase(100, handles[1]),
+  EXPECT_THROW(locatedTriplesPerBlock.erase(100, LT9.triple_),
                ad_utility::Exception);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
@@ -195,7 +196,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
       locatedTriplesAre(
           {{1, {LT1, LT2, LT3}}, {2, {LT4, LT5}}, {4, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(4, handles[1]);
+  locatedTriplesPerBlock.erase(4, LT9.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -217,6 +218,52 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
   EXPECT_THAT(locatedTriplesPerBlock, locatedTriplesAre({}));
 }
 
+// Test that copies of a `LocatedTriplesPerBlock` (as used for the snapshots)
+// are independent of each other, but share the located triples of all blocks
+// that are not modified.
+TEST_F(LocatedTriplesTest, copiesShareUnmodifiedBlocks) {
+  using LT = LocatedTriple;
+  auto LT1 = LT{1, IT(10, 1, 0), true};
+  auto LT2 = LT{2, IT(20, 2, 0), true};
+  auto LT3 = LT{2, IT(21, 3, 0), false};
+  auto LT4 = LT{3, IT(25, 4, 0), true};
+  auto original = makeLocatedTriplesPerBlock({LT1, LT2});
+  auto snapshot = original;
+  EXPECT_EQ(original.map_, snapshot.map_);
+
+  // Modify block 2 and add block 3. Block 1 is still shared, the snapshot is
+  // unchanged.
+  original.add(std::vector{LT3, LT4});
+  EXPECT_NE(original.map_, snapshot.map_);
+  EXPECT_EQ(original.map_->at(1), snapshot.map_->at(1));
+  EXPECT_NE(original.map_->at(2), snapshot.map_->at(2));
+  EXPECT_THAT(original, numBlocks(3));
+  EXPECT_THAT(original, numTriplesTotal(4));
+  EXPECT_THAT(snapshot, numBlocks(2));
+  EXPECT_THAT(snapshot, numTriplesTotal(2));
+  EXPECT_EQ(*snapshot.map_->at(2), LocatedTriples{LT2});
+  EXPECT_EQ(*original.map_->at(2), (LocatedTriples{LT2, LT3}));
+
+  // Erasing from the original also doesn't affect the snapshot.
+  original.erase(1, LT1.triple_);
+  original.updateAugmentedMetadata();
+  EXPECT_FALSE(original.containsTriples(1));
+  EXPECT_TRUE(snapshot.containsTriples(1));
+  EXPECT_EQ(*snapshot.map_->at(1), LocatedTriples{LT1});
+
+  // Without other copies, modifications happen in place.
+  auto blockBefore = original.map_->at(2);
+  original.erase(2, LT3.triple_);
+  EXPECT_EQ(original.map_->at(2), blockBefore);
+  EXPECT_EQ(*original.map_->at(2), LocatedTriples{LT2});
+
+  // Clearing the original leaves the snapshot intact.
+  original.clear();
+  EXPECT_THAT(original, numBlocks(0));
+  EXPECT_THAT(snapshot, numBlocks(2));
+  EXPECT_THAT(snapshot, numTriplesTotal(2));
+}
+
 // Test the method that merges the matching `LocatedTriple`s from a block into
 // an `IdTable`.
 TEST_F(LocatedTriplesTest, mergeTriples) {
@@ -783,9 +830,8 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // T4 is before block 4. The beginning of block 4 changes.
-    auto handles =
-        locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
-            Span{T4}, metadata, keyOrder, true, handle));
+    locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
+        Span{T4}, metadata, keyOrder, true, handle));
 
     expectedAugmentedMetadata[4] = CBM(T4.toPermutedTriple(), PT8);
     expectedAugmentedMetadata[4].containsDuplicatesWithDifferentGraphs_ = true;
@@ -793,7 +839,7 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // Erasing the update of T4 restores the beginning of block 4.
-    locatedTriplesPerBlock.erase(4, handles[0]);
+    locatedTriplesPerBlock.erase(4, T4);
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(PT8, PT8);
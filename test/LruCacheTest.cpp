@@ -43,3 +43,41 @@ TEST(LRUCache, testEmptyCapacityForbidden) {
   EXPECT_THROW((ad_utility::util::LRUCache<int, int>{0}),
                ad_utility::Exception);
 }
+
+// _____________________________________________________________________________
+TEST(LRUCache, getIfContained) {
+  ad_utility::util::LRUCache<int, int> cache{2};
+  EXPECT_EQ(cache.getIfContained(1), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+  cache.getOrCompute(1, [](int) { return 10; });
+  cache.getOrCompute(2, [](int) { return 20; });
+  EXPECT_EQ(cache.size(), 2);
+  auto* value = cache.getIfContained(1);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 10);
+
+  // The lookup of `1` made it the most recently used element, so `2` is
+  // evicted.
+  cache.getOrCompute(3, [](int) { return 30; });
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.getIfContained(2), nullptr);
+  EXPECT_NE(cache.getIfContained(1), nullptr);
+  EXPECT_NE(cache.getIfContained(3), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(LRUCache, insertOrAssign) {
+  ad_utility::util::LRUCache<int, int> cache{2};
+  cache.insertOrAssign(1, 10);
+  cache.insertOrAssign(2, 20);
+  cache.insertOrAssign(1, 11);
+  EXPECT_EQ(cache.size(), 2);
+  ASSERT_NE(cache.getIfContained(1), nullptr);
+  EXPECT_EQ(*cache.getIfContained(1), 11);
+
+  // `2` is the least recently used element.
+  cache.insertOrAssign(3, 30);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.getIfContained(2), nullptr);
+  EXPECT_EQ(*cache.getIfContained(3), 30);
+}
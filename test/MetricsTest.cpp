@@ -0,0 +1,94 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util/GTestHelpers.h"
+#include "util/Metrics.h"
+#include "util/jthread.h"
+
+using namespace ad_utility::metrics;
+using namespace std::chrono_literals;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+// _____________________________________________________________________________
+TEST(Metrics, counterFromMultipleThreads) {
+  Counter counter;
+  EXPECT_EQ(counter.value(), 0);
+  {
+    std::vector<ad_utility::JThread> threads;
+    for (size_t i = 0; i < 2 * NUM_SHARDS; ++i) {
+      threads.emplace_back([&counter]() {
+        for (size_t j = 0; j < 1000; ++j) {
+          counter.add();
+        }
+        counter.add(5);
+      });
+    }
+  }
+  EXPECT_EQ(counter.value(), 2 * NUM_SHARDS * 1005);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, histogram) {
+  Histogram histogram;
+  histogram.observe(50us);
+  histogram.observe(100us);
+  histogram.observe(2ms);
+  histogram.observe(2min);
+  auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count_, 4);
+  EXPECT_EQ(snapshot.sum_, 50us + 100us + 2ms + 2min);
+  // The upper bounds of the buckets are inclusive.
+  EXPECT_EQ(snapshot.bucketCounts_[0], 2);
+  EXPECT_EQ(snapshot.bucketCounts_[3], 1);
+  EXPECT_EQ(snapshot.bucketCounts_.back(), 1);
+
+  {
+    ScopedTimer timer{histogram};
+  }
+  EXPECT_EQ(histogram.snapshot().count_, 5);
+}
+
+// _____________________________________________________________________________
+TEST(Metrics, registryAndPrometheusText) {
+  Registry registry;
+  auto& counter = registry.counter("requests_total", "The requests",
+                                   {{"type", "query"}});
+  // The same name and labels return the same metric.
+  EXPECT_EQ(&counter, &registry.counter("requests_total", "ignored",
+                                        {{"type", "query"}}));
+  EXPECT_NE(&counter, &registry.counter("requests_total", "ignored",
+                                        {{"type", "update"}}));
+  counter.add(3);
+  registry.gauge("size", "A size").set(-7);
+  registry.histogram("duration_seconds", "A duration", {{"op", "a\"b"}})
+      .observe(3s);
+
+  auto text = registry.toPrometheusText();
+  EXPECT_THAT(text, HasSubstr("# HELP requests_total The requests\n"
+                              "# TYPE requests_total counter\n"
+                              "requests_total{type=\"query\"} 3\n"
+                              "requests_total{type=\"update\"} 0\n"));
+  EXPECT_THAT(text, HasSubstr("# TYPE size gauge\nsize -7\n"));
+  EXPECT_THAT(text, HasSubstr("# TYPE duration_seconds histogram\n"));
+  EXPECT_THAT(text,
+              HasSubstr("duration_seconds_bucket{op=\"a\\\"b\",le=\"1\"} 0\n"
+                        "duration_seconds_bucket{op=\"a\\\"b\",le=\"5\"} 1\n"));
+  EXPECT_THAT(text,
+              HasSubstr("duration_seconds_bucket{op=\"a\\\"b\",le=\"+Inf\"} 1\n"
+                        "duration_seconds_sum{op=\"a\\\"b\"} 3\n"
+                        "duration_seconds_count{op=\"a\\\"b\"} 1\n"));
+  EXPECT_THAT(text, Not(HasSubstr("ignored")));
+
+  // A name can only be used for a single type of metric.
+  AD_EXPECT_THROW_WITH_MESSAGE(registry.gauge("requests_total", ""),
+                               HasSubstr("registered with a different type"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      registry.histogram("requests_total", "", {{"type", "query"}}),
+      HasSubstr("registered with a different type"));
+}
@@ -9,6 +9,7 @@
 #include "engine/Result.h"
 #include "engine/ValuesForTesting.h"
 #include "gmock/gmock.h"
+#include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
@@ -788,3 +789,145 @@ TEST(PathSearchTest, clone) {
   EXPECT_THAT(pathSearch, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), pathSearch.getDescriptor());
 }
+
+// The elongated diamond from above, with the shortest path algorithms.
+// _____________________________________________________________________________
+TEST(PathSearchTest, shortestPaths) {
+  auto sub =
+      makeIdTableFromVector({{0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4}, {4, 5}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0)},
+      {V(1), V(2), I(0), I(1)},
+      {V(2), V(4), I(0), I(2)},
+      {V(0), V(1), I(1), I(0)},
+      {V(1), V(2), I(1), I(1)},
+      {V(2), V(4), I(1), I(2)},
+      {V(4), V(5), I(1), I(3)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(4), V(5)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  // The bidirectional search finds the same paths.
+  config.algorithm_ = PathSearchAlgorithm::BIDIRECTIONAL_SHORTEST_PATHS;
+  resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  // Without targets, there is one path to each reachable node.
+  config.targets_ = std::vector<Id>{};
+  resultTable = performPathSearch(config, sub.clone(), vars);
+  EXPECT_EQ(resultTable.idTable().numRows(), 1 + 2 + 2 + 3 + 4);
+  config.algorithm_ = PathSearchAlgorithm::SHORTEST_PATHS;
+  resultTable = performPathSearch(config, std::move(sub), vars);
+  EXPECT_EQ(resultTable.idTable().numRows(), 1 + 2 + 2 + 3 + 4);
+}
+
+/**
+ * Graph with edge weights:
+ *    0 --10--> 3
+ *    |         ^
+ *    1         1
+ *    v         |
+ *    1 --1---> 2
+ */
+// _____________________________________________________________________________
+TEST(PathSearchTest, weightedShortestPaths) {
+  auto sub = makeIdTableFromVector({{V(0), V(1), I(1)},
+                                    {V(0), V(3), I(10)},
+                                    {V(1), V(2), I(1)},
+                                    {V(2), V(3), I(1)}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0)},
+      {V(1), V(2), I(0), I(1)},
+      {V(2), V(3), I(0), I(2)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}, Variable{"?weight"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {},
+                                 true,
+                                 std::nullopt,
+                                 Var{"?weight"}};
+
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+
+  // Without the weights, the direct edge is the shortest path.
+  config.edgeWeight_ = std::nullopt;
+  resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(
+                  makeIdTableFromVector({{V(0), V(3), I(0), I(0)}})));
+
+  // Negative weights are not allowed.
+  config.edgeWeight_ = Var{"?weight"};
+  sub(0, 2) = I(-1);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      performPathSearch(config, std::move(sub), vars),
+      ::testing::HasSubstr("must not be negative"));
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, kShortestPaths) {
+  auto sub = makeIdTableFromVector({{V(0), V(1), I(1)},
+                                    {V(0), V(3), I(10)},
+                                    {V(1), V(2), I(1)},
+                                    {V(2), V(3), I(1)},
+                                    {V(1), V(3), I(3)}});
+  // The paths ordered by their lengths 3, 4, and 10.
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0)},
+      {V(1), V(2), I(0), I(1)},
+      {V(2), V(3), I(0), I(2)},
+      {V(0), V(1), I(1), I(0)},
+      {V(1), V(3), I(1), I(1)},
+      {V(0), V(3), I(2), I(0)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}, Variable{"?weight"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::K_SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {},
+                                 true,
+                                 5,
+                                 Var{"?weight"}};
+
+  // There are only three paths.
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+
+  config.numPathsPerTarget_ = 2;
+  resultTable = performPathSearch(config, std::move(sub), vars);
+  expected.resize(5);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+}
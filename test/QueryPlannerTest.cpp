@@ -1476,6 +1476,31 @@ TEST(QueryPlanner, PathSearchUnsupportedArgument) {
       parsedQuery::PathSearchException);
 }
 
+// __________________________________________________________________________
+TEST(QueryPlanner, PathSearchWeightWithUnsupportedAlgorithm) {
+  auto qec = ad_utility::testing::getQec("<x> <p> <y>. <y> <p> <z>");
+
+  auto query =
+      "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
+      "SELECT ?start ?end ?path ?edge WHERE {"
+      "SERVICE pathSearch: {"
+      "_:path pathSearch:algorithm pathSearch:bidirectionalShortestPaths ;"
+      "pathSearch:source <x> ;"
+      "pathSearch:target <z> ;"
+      "pathSearch:pathColumn ?path ;"
+      "pathSearch:edgeColumn ?edge ;"
+      "pathSearch:start ?start;"
+      "pathSearch:end ?end;"
+      "pathSearch:weight ?weight;"
+      "{SELECT * WHERE {"
+      "?start <p> ?end."
+      "}}}}";
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      h::parseAndPlan(std::move(query), qec),
+      HasSubstr("The parameter <weight> is only supported by"),
+      parsedQuery::PathSearchException);
+}
+
 // __________________________________________________________________________
 TEST(QueryPlanner, PathSearchTwoVariablesForSource) {
   auto qec = ad_utility::testing::getQec("<x> <p> <y>. <y> <p> <z>");
@@ -5104,3 +5129,24 @@ TEST(QueryPlanner, SubqueryColumnStripping) {
     EXPECT_EQ(qet.getResultWidth(), doStrip ? 2 : 4);
   }
 }
+
+// _____________________________________________________________________________
+TEST(QueryPlanner, parallelDynamicProgrammingYieldsSamePlan) {
+  // A star with many triples, s.t. the levels of the dynamic programming
+  // contain enough pairs of plans to create the join candidates in parallel.
+  std::string query = "SELECT * WHERE {";
+  for (size_t i = 0; i < 8; ++i) {
+    absl::StrAppend(&query, " ?x <p", i, "> ?o", i, " .");
+  }
+  absl::StrAppend(&query, " ?o0 <next> ?o1 . ?o2 <next> ?o3 }");
+  auto* qec = ad_utility::testing::getQec();
+  auto plan = [&query, qec](size_t numThreads) {
+    auto cleanup =
+        setRuntimeParameterForTest<"query-planning-max-num-threads">(
+            numThreads);
+    return h::parseAndPlan(query, qec).getCacheKey();
+  };
+  auto sequentialPlan = plan(1);
+  EXPECT_EQ(plan(4), sequentialPlan);
+  EXPECT_EQ(plan(0), sequentialPlan);
+}
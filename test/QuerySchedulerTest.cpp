@@ -0,0 +1,242 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include "engine/HttpError.h"
+#include "engine/QueryScheduler.h"
+#include "engine/Sort.h"
+#include "engine/ValuesForTesting.h"
+#include "util/AsyncTestHelpers.h"
+#include "util/GTestHelpers.h"
+#include "util/IdTableHelpers.h"
+#include "util/IndexTestHelpers.h"
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using Priority = QueryScheduler::Priority;
+using Request = QueryScheduler::Request;
+using namespace ad_utility::memory_literals;
+
+namespace {
+// Wait for the given time without blocking the executor.
+net::awaitable<void> sleep(std::chrono::milliseconds duration) {
+  net::steady_timer timer{co_await net::this_coro::executor, duration};
+  co_await timer.async_wait(net::use_awaitable);
+}
+
+// Start a coroutine that waits until the `request` is admitted, then appends
+// the `name` to the `order` and immediately releases the admission.
+void spawnWaiting(net::io_context& ioContext, QueryScheduler& scheduler,
+                  Request request, std::string name,
+                  std::vector<std::string>& order) {
+  auto wait = [](QueryScheduler& scheduler, Request request, std::string name,
+                 std::vector<std::string>& order) -> net::awaitable<void> {
+    auto admission = co_await scheduler.admit(std::move(request));
+    order.push_back(std::move(name));
+  };
+  net::co_spawn(ioContext, wait(scheduler, std::move(request), std::move(name),
+                                order),
+                net::detached);
+}
+
+// Return a request with a deadline that is reached after `timeout`.
+Request withDeadline(Request request, std::chrono::milliseconds timeout) {
+  request.deadline_ = QueryScheduler::Clock::now() + timeout;
+  return request;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, admitImmediately) {
+  QueryScheduler scheduler{2, 100_B};
+  auto first = co_await scheduler.admit({});
+  auto second = co_await scheduler.admit({});
+  auto stats = scheduler.getStatistics();
+  EXPECT_EQ(stats["num-running"], 2);
+  EXPECT_EQ(stats["num-admitted"], 2);
+  {
+    // The resources are given back when the admission is destroyed.
+    auto moved = std::move(first);
+  }
+  EXPECT_EQ(scheduler.getStatistics()["num-running"], 1);
+}
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, priorities) {
+  QueryScheduler scheduler{1, 100_B};
+  std::vector<std::string> order;
+  std::optional<QueryScheduler::Admission> running =
+      co_await scheduler.admit({});
+  spawnWaiting(ioContext, scheduler, {Priority::Low}, "low", order);
+  spawnWaiting(ioContext, scheduler, {Priority::Normal}, "normal", order);
+  spawnWaiting(ioContext, scheduler, {Priority::High}, "high", order);
+  co_await sleep(std::chrono::milliseconds{10});
+  auto stats = scheduler.getStatistics();
+  EXPECT_EQ(stats["num-waiting-high"], 1);
+  EXPECT_EQ(stats["num-waiting-normal"], 1);
+  EXPECT_EQ(stats["num-waiting-low"], 1);
+  EXPECT_TRUE(order.empty());
+
+  running.reset();
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ElementsAre("high", "normal", "low"));
+  stats = scheduler.getStatistics();
+  EXPECT_EQ(stats["num-running"], 0);
+  EXPECT_EQ(stats["num-admitted"], 4);
+  EXPECT_EQ(stats["num-rejected"], 0);
+}
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, fairnessBetweenClients) {
+  QueryScheduler scheduler{2, 100_B};
+  std::vector<std::string> order;
+  auto runningA = co_await scheduler.admit({Priority::Normal, "A"});
+  std::optional<QueryScheduler::Admission> runningB =
+      co_await scheduler.admit({Priority::Normal, "B"});
+  // Client A sends its query first, but client B has fewer running queries
+  // when the slot of B becomes free.
+  spawnWaiting(ioContext, scheduler, {Priority::Normal, "A"}, "A", order);
+  spawnWaiting(ioContext, scheduler, {Priority::Normal, "B"}, "B", order);
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_TRUE(order.empty());
+  runningB.reset();
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ElementsAre("B", "A"));
+}
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, memoryBudgetAndDeadline) {
+  QueryScheduler scheduler{4, 100_B};
+  // A query that doesn't fit into the budget alone is still admitted when
+  // nothing else runs.
+  std::optional<QueryScheduler::Admission> large =
+      co_await scheduler.admit({Priority::Normal, "", 1000_B});
+  EXPECT_EQ(scheduler.getStatistics()["running-memory-estimate"], "100 B");
+
+  // There is a free slot, but not enough memory, so the query is rejected
+  // when its deadline is reached.
+  try {
+    co_await scheduler.admit(withDeadline({Priority::High, "", 10_B},
+                                          std::chrono::milliseconds{5}));
+    ADD_FAILURE() << "The query should have been rejected";
+  } catch (const HttpError& error) {
+    EXPECT_EQ(error.status(),
+              boost::beast::http::status::service_unavailable);
+    EXPECT_THAT(error.what(), HasSubstr("could not be started"));
+  }
+  auto stats = scheduler.getStatistics();
+  EXPECT_EQ(stats["num-rejected"], 1);
+  EXPECT_EQ(stats["num-waiting-high"], 0);
+
+  // Queries that fit are admitted together.
+  large.reset();
+  auto first = co_await scheduler.admit({Priority::Normal, "", 60_B});
+  auto second = co_await scheduler.admit({Priority::Normal, "", 40_B});
+  stats = scheduler.getStatistics();
+  EXPECT_EQ(stats["num-running"], 2);
+  EXPECT_EQ(stats["running-memory-estimate"], "100 B");
+}
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, smallQueryOvertakesBlockedQuery) {
+  QueryScheduler scheduler{4, 100_B};
+  std::vector<std::string> order;
+  std::optional<QueryScheduler::Admission> running =
+      co_await scheduler.admit({Priority::Normal, "", 60_B});
+  spawnWaiting(ioContext, scheduler, {Priority::High, "", 60_B}, "large",
+               order);
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_EQ(scheduler.getStatistics()["num-waiting-high"], 1);
+
+  // A query with a lower priority that fits is admitted before the query that
+  // doesn't fit.
+  spawnWaiting(ioContext, scheduler, {Priority::Low, "", 30_B}, "small",
+               order);
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ElementsAre("small"));
+  running.reset();
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ElementsAre("small", "large"));
+}
+
+// _____________________________________________________________________________
+ASYNC_TEST(QueryScheduler, agingPreventsStarvation) {
+  QueryScheduler scheduler{4, 100_B, std::chrono::milliseconds{20}};
+  std::vector<std::string> order;
+  std::optional<QueryScheduler::Admission> running =
+      co_await scheduler.admit({Priority::Normal, "", 60_B});
+  spawnWaiting(ioContext, scheduler, {Priority::Normal, "", 60_B}, "large",
+               order);
+  co_await sleep(std::chrono::milliseconds{30});
+
+  // The large query has waited for longer than the aging interval, so it is
+  // not overtaken by the small query anymore.
+  spawnWaiting(ioContext, scheduler, {Priority::Normal, "", 30_B}, "small",
+               order);
+  co_await sleep(std::chrono::milliseconds{5});
+  EXPECT_TRUE(order.empty());
+  running.reset();
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ::testing::UnorderedElementsAre("large", "small"));
+
+  // A query with a low priority that has waited for an aging interval is
+  // admitted before a query with a normal priority that arrives later.
+  order.clear();
+  QueryScheduler singleSlot{1, 100_B, std::chrono::milliseconds{20}};
+  running = co_await singleSlot.admit({});
+  spawnWaiting(ioContext, singleSlot, {Priority::Low}, "low", order);
+  co_await sleep(std::chrono::milliseconds{30});
+  spawnWaiting(ioContext, singleSlot, {Priority::Normal}, "normal", order);
+  co_await sleep(std::chrono::milliseconds{5});
+  running.reset();
+  co_await sleep(std::chrono::milliseconds{10});
+  EXPECT_THAT(order, ElementsAre("low", "normal"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, priorityFromString) {
+  EXPECT_EQ(QueryScheduler::priorityFromString("high"), Priority::High);
+  EXPECT_EQ(QueryScheduler::priorityFromString("normal"), Priority::Normal);
+  EXPECT_EQ(QueryScheduler::priorityFromString("low"), Priority::Low);
+  AD_EXPECT_THROW_WITH_MESSAGE(QueryScheduler::priorityFromString("urgent"),
+                               HasSubstr("Invalid priority \"urgent\""));
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, estimateMemory) {
+  EXPECT_EQ(QueryScheduler::estimateMemory(10, 3), 240_B);
+  EXPECT_EQ(QueryScheduler::estimateMemory(10, 0), 80_B);
+  EXPECT_EQ(QueryScheduler::estimateMemory(std::numeric_limits<size_t>::max(),
+                                           2),
+            ad_utility::MemorySize::max());
+}
+
+// _____________________________________________________________________________
+TEST(QueryScheduler, estimateMemoryOfQueryExecutionTree) {
+  auto* qec = ad_utility::testing::getQec();
+  auto makeValues = [qec](bool lazy) {
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, makeIdTableFromVector({{1, 2}, {3, 4}, {5, 6}}),
+        std::vector<std::optional<Variable>>{Variable{"?a"}, Variable{"?b"}},
+        false, std::vector<ColumnIndex>{}, LocalVocab{}, std::nullopt, !lazy);
+  };
+  // A lazy result is not counted, a materialized one is.
+  EXPECT_EQ(QueryScheduler::estimateMemory(*makeValues(true)), 0_B);
+  EXPECT_EQ(QueryScheduler::estimateMemory(*makeValues(false)), 48_B);
+
+  // The `Sort` always materializes its result, but its lazy input is not
+  // counted.
+  auto sortLazy = ad_utility::makeExecutionTree<Sort>(
+      qec, makeValues(true), std::vector<ColumnIndex>{1});
+  EXPECT_EQ(QueryScheduler::estimateMemory(*sortLazy), 48_B);
+  auto sortMaterialized = ad_utility::makeExecutionTree<Sort>(
+      qec, makeValues(false), std::vector<ColumnIndex>{1});
+  EXPECT_EQ(QueryScheduler::estimateMemory(*sortMaterialized), 96_B);
+}
@@ -1232,6 +1232,47 @@ TEST(RdfParserTest, nQuadParser) {
   runTestsForParser(NQuadCtreParser{encodedIriManager()});
 }
 
+// _____________________________________________________________________________
+TEST(RdfParserTest, nQuadParallelParser) {
+  // N-Quads with comments after the final `.` of each statement. The parallel
+  // parser splits N-Quads at arbitrary newlines, so this works although no
+  // line ends with a `.` directly followed by a newline.
+  std::string filename{"nQuadParallelParserTest.nq"};
+  std::vector<TurtleTriple> expectedTriples;
+  auto defaultGraph = qlever::specialIds().at(std::string{DEFAULT_GRAPH_IRI});
+  {
+    auto of = ad_utility::makeOfstream(filename);
+    for (size_t i = 0; i < 1'000; ++i) {
+      auto subject = absl::StrCat("<s", i, ">");
+      auto object = absl::StrCat("\"literal ", i, "\"");
+      of << subject << " <p> " << object;
+      if (i % 3 == 0) {
+        of << " .\n";
+        expectedTriples.emplace_back(iri(subject), iri("<p>"), lit(object),
+                                     defaultGraph);
+      } else {
+        auto graph = absl::StrCat("<g", i % 3, ">");
+        of << ' ' << graph << " . # comment " << i << "\n";
+        expectedTriples.emplace_back(iri(subject), iri("<p>"), lit(object),
+                                     iri(graph));
+      }
+    }
+  }
+
+  auto testWithParser = [&](auto t, bool useBatchInterface) {
+    using Parser = typename decltype(t)::type;
+    auto result = parseFromFile<Parser>(filename, useBatchInterface);
+    EXPECT_THAT(result, ::testing::UnorderedElementsAreArray(expectedTriples));
+  };
+  for (bool useBatchInterface : {true, false}) {
+    testWithParser(ti<RdfParallelParser<NQuadParser<Tokenizer>>>,
+                   useBatchInterface);
+    testWithParser(ti<RdfParallelParser<NQuadParser<TokenizerCtre>>>,
+                   useBatchInterface);
+  }
+  ad_utility::deleteFile(filename);
+}
+
 // _____________________________________________________________________________
 TEST(RdfParserTest, noGetlineInStringParser) {
   auto runTestsForParser = [](auto parser) {
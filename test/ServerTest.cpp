@@ -6,11 +6,14 @@
 
 #include <boost/beast/http.hpp>
 
+#include "engine/QueryExecutionContext.h"
 #include "engine/QueryPlanner.h"
 #include "engine/Server.h"
+#include "index/DeltaTriples.h"
 #include "parser/SparqlParser.h"
 #include "util/GTestHelpers.h"
 #include "util/HttpRequestHelpers.h"
+#include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/http/HttpUtils.h"
 #include "util/http/UrlParser.h"
@@ -44,6 +47,38 @@ TEST(ServerTest, determineResultPinning) {
               testing::Pair(false, false));
 }
 
+// _____________________________________________________________________________
+TEST(ServerTest, determineSchedulingRequest) {
+  using Priority = QueryScheduler::Priority;
+  auto request = makeGetRequest("/");
+  auto defaultRequest = Server::determineSchedulingRequest({}, request, false);
+  EXPECT_EQ(defaultRequest.priority_, Priority::Normal);
+  EXPECT_EQ(defaultRequest.client_, "");
+
+  auto fromParams = Server::determineSchedulingRequest(
+      {{"priority", {"low"}}, {"client-id", {"alice"}}}, request, false);
+  EXPECT_EQ(fromParams.priority_, Priority::Low);
+  EXPECT_EQ(fromParams.client_, "alice");
+
+  // The headers are used if there are no parameters.
+  auto requestWithHeaders = makeGetRequest("/");
+  requestWithHeaders.set("QLever-Priority", "high");
+  requestWithHeaders.set("QLever-Client-Id", "bob");
+  auto fromHeaders =
+      Server::determineSchedulingRequest({}, requestWithHeaders, true);
+  EXPECT_EQ(fromHeaders.priority_, Priority::High);
+  EXPECT_EQ(fromHeaders.client_, "bob");
+
+  // The priority "high" requires a valid access token.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      Server::determineSchedulingRequest({}, requestWithHeaders, false),
+      testing::HasSubstr("requires a valid access token"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      Server::determineSchedulingRequest({{"priority", {"urgent"}}}, request,
+                                         true),
+      testing::HasSubstr("Invalid priority"));
+}
+
 // _____________________________________________________________________________
 TEST(ServerTest, determineMediaType) {
   auto MakeRequest = [](const std::optional<std::string>& accept,
@@ -305,3 +340,48 @@ TEST(ServerTest, adjustParsedQueryLimitOffset) {
   expectExportLimit(csv, std::nullopt, complexQuery);
   expectExportLimit(tsv, std::nullopt);
 }
+
+// _____________________________________________________________________________
+TEST(ServerTest, processBatchedInsertImpl) {
+  const ad_utility::SharedCancellationHandle handle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  const ad_utility::Timer requestTimer{
+      ad_utility::Timer::InitialStatus::Stopped};
+  const Index& index = getQec("<a> <b> <c>")->getIndex();
+  DeltaTriples deltaTriples{index};
+  QueryResultCache cache;
+  auto addCacheEntries = [&cache]() {
+    auto makeValue = []() {
+      return std::make_shared<CacheValue>(
+          Result{makeIdTableFromVector({{1}}), {}, LocalVocab{}},
+          RuntimeInformation{});
+    };
+    cache.tryInsertIfNotPresent(true, QueryCacheKey{"pinned", 0}, makeValue());
+    cache.tryInsertIfNotPresent(false, QueryCacheKey{"notPinned", 0},
+                                makeValue());
+    ASSERT_EQ(cache.numPinnedEntries(), 1ul);
+  };
+  auto insert = [&](std::string body) {
+    return Server::processBatchedInsertImpl(
+        makePostRequest("/?default&insert-in-batches=true", "text/turtle",
+                        std::move(body)),
+        DEFAULT{}, requestTimer, handle, index, cache, deltaTriples);
+  };
+
+  // The pinned cache entries are removed, like for all other updates.
+  addCacheEntries();
+  json response = insert("<x> <y> <z> .\n <x> <y> <a> .");
+  EXPECT_EQ(response["status"], "OK");
+  EXPECT_EQ(deltaTriples.numInserted(), 2);
+  EXPECT_EQ(cache.numPinnedEntries(), 0ul);
+  EXPECT_EQ(cache.numNonPinnedEntries(), 1ul);
+
+  // Also if the request fails.
+  addCacheEntries();
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      insert("<d> <e> <f> .\n <a> <b> ."),
+      testing::AllOf(testing::HasSubstr("Parse error"),
+                     testing::HasSubstr("triples of the request had been "
+                                        "inserted, they are not rolled back")));
+  EXPECT_EQ(cache.numPinnedEntries(), 0ul);
+}
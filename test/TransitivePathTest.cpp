@@ -10,15 +10,19 @@
 
 #include "./util/IdTestHelpers.h"
 #include "./util/IndexTestHelpers.h"
+#include "engine/IndexScan.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/TransitivePathBase.h"
 #include "engine/TransitivePathBinSearch.h"
 #include "engine/TransitivePathHashMap.h"
 #include "engine/ValuesForTesting.h"
+#include "global/SpecialIds.h"
+#include "index/DeltaTriples.h"
 #include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -1118,6 +1122,150 @@ TEST_P(TransitivePathTest, columnOriginatesFromGraphOrUndef) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, boundedLengthWithShortcut) {
+  // The node 3 can be reached from 0 with two steps only via the shortcut
+  // 0 -> 2, which a search must not miss when it first reaches 2 via 1.
+  auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {0, 2}});
+  auto expected =
+      makeIdTableFromVector({{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}});
+  TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+  TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+  auto T = makePathUnbound(std::move(sub),
+                           {Variable{"?start"}, Variable{"?target"}}, left,
+                           right, 1, 2);
+  auto resultTable = T->computeResultOnlyForTesting(requestLaziness());
+  assertResultMatchesIdTable(resultTable, expected);
+}
+
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, manyStartNodesWithMultipleThreads) {
+  // A chain 0 -> 1 -> ... -> 299, with more start nodes than the size of a
+  // batch of `transitiveHull`.
+  constexpr int64_t numNodes = 300;
+  IdTable sub{2, ad_utility::testing::makeAllocator()};
+  IdTable expected{2, ad_utility::testing::makeAllocator()};
+  for (int64_t i = 0; i + 1 < numNodes; ++i) {
+    sub.push_back({V(i), V(i + 1)});
+    for (int64_t j = i + 2; j <= std::min(i + 3, numNodes - 1); ++j) {
+      expected.push_back({V(i), V(j)});
+    }
+  }
+  TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+  TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+  for (size_t numThreads : {1, 4}) {
+    auto cleanup =
+        setRuntimeParameterForTest<"transitive-path-max-num-threads">(
+            numThreads);
+    auto T = makePathUnbound(sub.clone(),
+                             {Variable{"?start"}, Variable{"?target"}}, left,
+                             right, 2, 3);
+    auto resultTable = T->computeResultOnlyForTesting(requestLaziness());
+    assertResultMatchesIdTable(resultTable, expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, reachabilityIndex) {
+  using ad_utility::testing::makeTestIndex;
+  using ad_utility::testing::TestIndexConfig;
+  std::string turtle =
+      "<a> <sub> <b> . <b> <sub> <c> . <c> <sub> <a> . <c> <sub> <d> . "
+      "<e> <sub> <d> . <d> <other> <f> .";
+  TestIndexConfig config{turtle};
+  config.reachabilityPredicates = {"<sub>"};
+  auto indexWith =
+      makeTestIndex("TransitivePathTest_withReachabilityIndex", config);
+  auto indexWithout = makeTestIndex(
+      "TransitivePathTest_withoutReachabilityIndex", TestIndexConfig{turtle});
+  QueryResultCache cacheWith;
+  QueryResultCache cacheWithout;
+  QueryExecutionContext qecWith{
+      indexWith, &cacheWith,
+      ad_utility::testing::makeAllocator(ad_utility::MemorySize::megabytes(10)),
+      SortPerformanceEstimator{}};
+  QueryExecutionContext qecWithout{
+      indexWithout, &cacheWithout,
+      ad_utility::testing::makeAllocator(ad_utility::MemorySize::megabytes(10)),
+      SortPerformanceEstimator{}};
+  auto iri = [](std::string_view iriref) {
+    return TripleComponent{TripleComponent::Iri::fromIriref(iriref)};
+  };
+  Variable s{"?s"};
+  Variable o{"?o"};
+
+  // Compute the transitive path `left <sub>{minDist,} right` and return the
+  // result together with the information whether the index was used.
+  auto compute = [&](QueryExecutionContext& qec, TripleComponent left,
+                     TripleComponent right, size_t minDist) {
+    qec.clearCacheUnpinnedOnly();
+    auto scan = ad_utility::makeExecutionTree<IndexScan>(
+        &qec, Permutation::PSO, SparqlTripleSimple{s, iri("<sub>"), o});
+    auto path = TransitivePathBase::makeTransitivePath(
+        &qec, std::move(scan),
+        TransitivePathSide{std::nullopt, 0, std::move(left), 0},
+        TransitivePathSide{std::nullopt, 1, std::move(right), 1}, minDist,
+        std::numeric_limits<size_t>::max(), std::get<0>(GetParam()));
+    auto result = path->computeResultOnlyForTesting(requestLaziness());
+    IdTable table = result.isFullyMaterialized()
+                        ? result.idTable().clone()
+                        : aggregateTables(result.idTables(), 2).first;
+    bool usedIndex =
+        path->runtimeInfo().details_.value("reachability-index", false);
+    return std::pair{std::move(table), usedIndex};
+  };
+
+  // The results with and without the index have to be the same.
+  auto expectSameResult =
+      [&](TripleComponent left, TripleComponent right, size_t minDist,
+          size_t expectedSize, bool expectIndex,
+          ad_utility::source_location loc =
+              ad_utility::source_location::current()) {
+        auto t = generateLocationTrace(loc);
+        auto [withIndex, usedIndex] = compute(qecWith, left, right, minDist);
+        auto [withoutIndex, usedNoIndex] =
+            compute(qecWithout, left, right, minDist);
+        EXPECT_EQ(usedIndex, expectIndex);
+        EXPECT_FALSE(usedNoIndex);
+        EXPECT_EQ(withIndex.numRows(), expectedSize);
+        EXPECT_THAT(withIndex, UnorderedElementsAreArray(withoutIndex));
+      };
+
+  for (size_t minDist : {0, 1}) {
+    // Forward and reversed direction.
+    expectSameResult(iri("<a>"), o, minDist, 4, true);
+    expectSameResult(s, iri("<d>"), minDist, minDist == 0 ? 5 : 4, true);
+    // Both sides fixed.
+    expectSameResult(iri("<a>"), iri("<d>"), minDist, 1, true);
+    expectSameResult(iri("<d>"), iri("<a>"), minDist, 0, true);
+    // `<f>` is not a node of the graph, `<e>` is only a source.
+    expectSameResult(iri("<f>"), o, minDist, minDist == 0 ? 1 : 0, true);
+    expectSameResult(iri("<e>"), o, minDist, minDist == 0 ? 2 : 1, true);
+    expectSameResult(s, iri("<e>"), minDist, minDist == 0 ? 1 : 0, true);
+  }
+  // If both sides are unbound, all paths are enumerated without the index.
+  expectSameResult(s, o, 1, 13, false);
+
+  // After an update of the predicate, the index is outdated and the graph is
+  // traversed instead.
+  for (auto [index, qec] : {std::pair{&indexWith, &qecWith},
+                             std::pair{&indexWithout, &qecWithout}}) {
+    auto getId = ad_utility::testing::makeGetId(*index);
+    index->deltaTriplesManager().modify<void>(
+        [&](DeltaTriples& deltaTriples) {
+          auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+          deltaTriples.insertTriples(
+              handle,
+              {IdTriple{{getId("<d>"), getId("<sub>"), getId("<e>"),
+                         qlever::specialIds().at(
+                             std::string{DEFAULT_GRAPH_IRI})}}});
+        });
+    qec->updateLocatedTriplesSnapshot();
+  }
+  expectSameResult(iri("<a>"), o, 1, 5, false);
+  expectSameResult(iri("<a>"), iri("<e>"), 1, 1, false);
+}
+
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(
     TransitivePathTestSuite, TransitivePathTest,
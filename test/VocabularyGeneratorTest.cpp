@@ -3,6 +3,7 @@
 // Authors: Johannes Kalmbach <kalmbacj@cs.uni-freiburg.de>
 //          Christoph Ullinger <ullingec@cs.uni-freiburg.de>
 
+#include <absl/cleanup/cleanup.h>
 #include <gmock/gmock.h>
 
 #include <cstdlib>
@@ -225,6 +226,43 @@ TEST_F(MergeVocabularyTest, mergeVocabulary) {
   ASSERT_TRUE(vocabTestCompare(mapping1, _expMapping1));
 }
 
+// Test that the merging yields the same result if the merged words are
+// processed in small batches, s.t. duplicates and the mappings of a single
+// partial vocabulary are spread across several batches.
+TEST_F(MergeVocabularyTest, mergeVocabularyInSmallBatches) {
+  const size_t originalBatchSize = BATCH_SIZE_VOCABULARY_MERGE;
+  absl::Cleanup restoreBatchSize{
+      [originalBatchSize] { BATCH_SIZE_VOCABULARY_MERGE = originalBatchSize; }};
+  for (size_t batchSize : {1, 2, 3, 5}) {
+    BATCH_SIZE_VOCABULARY_MERGE = batchSize;
+    std::vector<std::pair<std::string, bool>> mergeResult;
+    std::vector<std::pair<std::string, bool>> geoMergeResult;
+    auto internalVocabularyAction = [&mergeResult, &geoMergeResult](
+                                        const auto& word,
+                                        bool isExternal) -> uint64_t {
+      if (word.ends_with(
+              "\"^^<http://www.opengis.net/ont/geosparql#wktLiteral>")) {
+        geoMergeResult.emplace_back(word, isExternal);
+        return (geoMergeResult.size() - 1) | (1ull << 59);
+      }
+      mergeResult.emplace_back(word, isExternal);
+      return mergeResult.size() - 1;
+    };
+    mergeVocabulary(_basePath, 2, TripleComponentComparator(),
+                    internalVocabularyAction, 1_GB);
+    EXPECT_THAT(mergeResult,
+                ::testing::ElementsAreArray(expectedMergedVocabulary_));
+    EXPECT_THAT(geoMergeResult,
+                ::testing::ElementsAreArray(expectedMergedGeoVocabulary_));
+    IdPairMMapVecView mapping0(_basePath + PARTIAL_MMAP_IDS +
+                               std::to_string(0));
+    EXPECT_TRUE(vocabTestCompare(mapping0, _expMapping0));
+    IdPairMMapVecView mapping1(_basePath + PARTIAL_MMAP_IDS +
+                               std::to_string(1));
+    EXPECT_TRUE(vocabTestCompare(mapping1, _expMapping1));
+  }
+}
+
 TEST(VocabularyGeneratorTest, createInternalMapping) {
   ItemVec input;
   using S = LocalVocabIndexAndSplitVal;
@@ -102,3 +102,19 @@ TEST(CountConnectedSubgraphs, bitsetToString) {
   EXPECT_EQ(toBitsetString(0), "0");
   EXPECT_EQ(toBitsetString(13), "1101");
 }
+
+// Test that counting with multiple threads yields the same results.
+TEST(CountConnectedSubgraphs, multipleThreads) {
+  for (size_t numThreads : {2, 4, 7}) {
+    EXPECT_EQ(countSubgraphs(makeClique(10), 1'000'000, numThreads), 1023);
+    EXPECT_EQ(countSubgraphs(makeChain(40), 1'000'000, numThreads),
+              40 * 41 / 2);
+    EXPECT_EQ(countSubgraphs(makeDisjointCliques(4, 8), 1'000'000, numThreads),
+              4 * 255);
+    EXPECT_EQ(countSubgraphs({}, 1'000'000, numThreads), 0);
+    // The counting stops as soon as the budget is exceeded.
+    EXPECT_EQ(countSubgraphs(makeClique(64), 100'000, numThreads), 100'001);
+    EXPECT_EQ(countSubgraphs(makeClique(16), 65'535, numThreads), 65'535);
+    EXPECT_EQ(countSubgraphs(makeClique(16), 65'534, numThreads), 65'535);
+  }
+}
@@ -0,0 +1,130 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/AllocatorTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/CsrGraph.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/Result.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+using ad_utility::testing::makeAllocator;
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CsrGraph, successors) {
+  auto table = makeIdTableFromVector({{1, 2}, {1, 3}, {1, 5}, {3, 1}, {5, 5}});
+  CsrGraph graph{table.getColumn(0), table.getColumn(1), makeAllocator()};
+  EXPECT_EQ(graph.numNodes(), 3);
+  EXPECT_EQ(graph.numEdges(), 5);
+  EXPECT_THAT(graph.nodes(), ElementsAre(V(1), V(3), V(5)));
+
+  EXPECT_THAT(graph.successors(V(1)), ElementsAre(V(2), V(3), V(5)));
+  EXPECT_THAT(graph.successors(V(3)), ElementsAre(V(1)));
+  EXPECT_THAT(graph.successors(V(5)), ElementsAre(V(5)));
+  // Nodes without outgoing edges.
+  EXPECT_THAT(graph.successors(V(0)), IsEmpty());
+  EXPECT_THAT(graph.successors(V(2)), IsEmpty());
+  EXPECT_THAT(graph.successors(V(6)), IsEmpty());
+
+  // The edge positions are the rows of the table.
+  EXPECT_EQ(graph.getDenseIndex(V(3)), 1);
+  EXPECT_EQ(graph.getDenseIndex(V(2)), std::nullopt);
+  EXPECT_EQ(graph.getEdgeRange(V(3)), std::pair(size_t{3}, size_t{4}));
+  EXPECT_EQ(graph.getEdgeRange(V(5)), std::pair(size_t{4}, size_t{5}));
+  EXPECT_EQ(graph.getEdgeRange(V(4)), std::pair(size_t{0}, size_t{0}));
+  // The successors are not copied, they are the column of the table.
+  EXPECT_EQ(graph.successors(V(1)).data(), table.getColumn(1).data());
+  EXPECT_EQ(graph.getMemorySize().getBytes(),
+            3 * sizeof(Id) + 4 * sizeof(uint64_t));
+
+  CsrGraph empty{{}, {}, makeAllocator()};
+  EXPECT_EQ(empty.numNodes(), 0);
+  EXPECT_THAT(empty.successors(V(1)), IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, sharedViaResult) {
+  auto makeResult = [](std::vector<ColumnIndex> sortedBy) {
+    return Result{makeIdTableFromVector({{1, 2}, {1, 3}, {2, 3}}),
+                  std::move(sortedBy), LocalVocab{}};
+  };
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<"csr-adjacency-min-num-uses">(size_t{2});
+    auto result = makeResult({0, 1});
+    size_t numBuilds = 0;
+    auto getGraph = [&numBuilds](const Result& res, ColumnIndex startCol,
+                                 ColumnIndex targetCol) {
+      return res.getCsrGraph(startCol, targetCol, makeAllocator(),
+                             [&numBuilds]() { ++numBuilds; });
+    };
+    // The graph is only built on the second request, and then shared.
+    EXPECT_EQ(getGraph(result, 0, 1), nullptr);
+    EXPECT_EQ(result.getCsrGraphsMemorySize().getBytes(), 0);
+    auto graph = getGraph(result, 0, 1);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(numBuilds, 1);
+    EXPECT_THAT(graph->successors(V(1)), ElementsAre(V(2), V(3)));
+    EXPECT_EQ(getGraph(result, 0, 1), graph);
+    EXPECT_EQ(numBuilds, 1);
+    EXPECT_EQ(result.getCsrGraphsMemorySize(), graph->getMemorySize());
+
+    // The result is not sorted by the second column.
+    EXPECT_EQ(getGraph(result, 1, 0), nullptr);
+    EXPECT_EQ(getGraph(result, 1, 0), nullptr);
+    EXPECT_EQ(getGraph(makeResult({}), 0, 1), nullptr);
+    EXPECT_EQ(numBuilds, 1);
+  }
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<"csr-adjacency-min-num-uses">(size_t{1});
+    auto result = makeResult({0, 1});
+    EXPECT_NE(result.getCsrGraph(0, 1, makeAllocator()), nullptr);
+
+    // The graph is not built if it doesn't fit into the allocator.
+    auto result2 = makeResult({0, 1});
+    EXPECT_EQ(result2.getCsrGraph(0, 1,
+                                  makeAllocator(ad_utility::MemorySize::bytes(
+                                      sizeof(Id)))),
+              nullptr);
+  }
+  {
+    // The value 0 disables the adjacencies.
+    auto cleanup =
+        setRuntimeParameterForTest<"csr-adjacency-min-num-uses">(size_t{0});
+    auto result = makeResult({0, 1});
+    EXPECT_EQ(result.getCsrGraph(0, 1, makeAllocator()), nullptr);
+    EXPECT_EQ(result.getCsrGraph(0, 1, makeAllocator()), nullptr);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CsrGraph, sizeOfCacheEntry) {
+  auto cleanup =
+      setRuntimeParameterForTest<"csr-adjacency-min-num-uses">(size_t{1});
+  QueryResultCache cache;
+  QueryCacheKey key{"edges", 0};
+  auto value = std::make_shared<CacheValue>(
+      Result{makeIdTableFromVector({{1, 2}, {1, 3}, {2, 3}}), {0, 1},
+             LocalVocab{}},
+      RuntimeInformation{});
+  auto tableSize = CacheValue::getSize(value->resultTable().idTable());
+  cache.tryInsertIfNotPresent(false, key, value);
+  EXPECT_EQ(cache.nonPinnedSize(), tableSize);
+
+  // The cache entry includes the graph once its size is recomputed.
+  auto graph = value->resultTable().getCsrGraph(
+      0, 1, makeAllocator(), [&cache, &key]() { cache.recomputeSize(key); });
+  ASSERT_NE(graph, nullptr);
+  EXPECT_EQ(cache.nonPinnedSize(), tableSize + graph->getMemorySize());
+}
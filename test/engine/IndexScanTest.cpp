@@ -1263,6 +1263,60 @@ TEST(IndexScan, clone) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, locatedTriplesSnapshotIndexForCaching) {
+  auto index = makeTestIndex("IndexScan_locatedTriplesSnapshotIndexForCaching",
+                             TestIndexConfig{"<x> <p> <y> . <x> <q> <z> ."});
+  QueryResultCache cache;
+  QueryExecutionContext qec{index, &cache,
+                            makeAllocator(ad_utility::MemorySize::megabytes(10)),
+                            SortPerformanceEstimator{}};
+  auto getId = makeGetId(index);
+  auto snapshotIndex = [&qec](const TripleComponent& predicate) {
+    auto permutation =
+        predicate.isVariable() ? Permutation::SPO : Permutation::PSO;
+    IndexScan scan{&qec, permutation,
+                   SparqlTripleSimple{Var{"?s"}, predicate, Var{"?o"}}};
+    return scan.getLocatedTriplesSnapshotIndexForCaching();
+  };
+  auto insert = [&index, &qec, &getId](const std::string& predicate) {
+    index.deltaTriplesManager().modify<void>([&](DeltaTriples& deltaTriples) {
+      auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+      deltaTriples.insertTriples(
+          handle, {IdTriple{{getId("<y>"), getId(predicate), getId("<z>"),
+                             getId("<x>")}}});
+    });
+    qec.updateLocatedTriplesSnapshot();
+    return qec.locatedTriplesSnapshot().index_;
+  };
+  Tc p{iri("<p>")};
+  Tc q{iri("<q>")};
+  Tc anyPredicate{Var{"?p"}};
+
+  EXPECT_EQ(snapshotIndex(p), 0);
+  EXPECT_EQ(snapshotIndex(q), 0);
+  EXPECT_EQ(snapshotIndex(anyPredicate), 0);
+
+  // An update of `<p>` only affects the scans for `<p>` and for all
+  // predicates.
+  auto first = insert("<p>");
+  EXPECT_NE(first, 0);
+  EXPECT_EQ(snapshotIndex(p), first);
+  EXPECT_EQ(snapshotIndex(q), 0);
+  EXPECT_EQ(snapshotIndex(anyPredicate), first);
+
+  auto second = insert("<q>");
+  EXPECT_EQ(snapshotIndex(p), first);
+  EXPECT_EQ(snapshotIndex(q), second);
+  EXPECT_EQ(snapshotIndex(anyPredicate), second);
+
+  // The cache key of the scan is the same before and after unrelated updates.
+  IndexScan scanP{&qec, Permutation::PSO,
+                  SparqlTripleSimple{Var{"?s"}, p, Var{"?o"}}};
+  EXPECT_EQ(scanP.getQueryCacheKey(),
+            (QueryCacheKey{scanP.getCacheKey(), first}));
+}
+
 // _____________________________________________________________________________
 TEST(IndexScan, columnOriginatesFromGraphOrUndef) {
   auto* qec = getQec();
@@ -0,0 +1,298 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/LazyResultBroadcast.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/CancellationHandle.h"
+#include "util/jthread.h"
+
+using namespace ad_utility::memory_literals;
+using IdTableVocabPair = Result::IdTableVocabPair;
+using LazyResult = Result::LazyResult;
+
+namespace {
+// Two different queries, only the pointers are relevant.
+const QueryExecutionContext* firstQuery() {
+  return ad_utility::testing::getQec();
+}
+const QueryExecutionContext* secondQuery() {
+  return ad_utility::testing::getQec("<a> <b> <c> .");
+}
+
+LazyResultBroadcast::Key makeKey(std::string key) {
+  return {nullptr, QueryCacheKey{std::move(key), 0}};
+}
+
+// The chunks of the shared result in the tests.
+std::vector<IdTable> makeChunks() {
+  std::vector<IdTable> chunks;
+  chunks.push_back(makeIdTableFromVector({{1, 2}, {3, 4}}));
+  chunks.push_back(makeIdTableFromVector({{5, 6}}));
+  chunks.push_back(makeIdTableFromVector({{7, 8}, {9, 10}, {11, 12}}));
+  return chunks;
+}
+
+// Return a lazy result that yields copies of the `chunks` and counts the
+// computed chunks in `numComputed`. If `throwAfter` is set, the generator
+// throws the `exception` after yielding that many chunks.
+LazyResult makeSource(
+    const std::vector<IdTable>& chunks, std::atomic<size_t>& numComputed,
+    std::optional<size_t> throwAfter = std::nullopt,
+    std::exception_ptr exception =
+        std::make_exception_ptr(std::runtime_error{"Computation failed"})) {
+  return LazyResult{[](const std::vector<IdTable>& chunks,
+                       std::atomic<size_t>& numComputed,
+                       std::optional<size_t> throwAfter,
+                       std::exception_ptr exception) -> Result::Generator {
+    for (const auto& chunk : chunks) {
+      if (throwAfter.has_value() && numComputed == throwAfter.value()) {
+        std::rethrow_exception(exception);
+      }
+      ++numComputed;
+      co_yield {chunk.clone(), LocalVocab{}};
+    }
+  }(chunks, numComputed, throwAfter, std::move(exception))};
+}
+
+// Attach to the result with the `key` for the given `query`. If the consumer
+// is detached, it recomputes the `chunks` and counts them in `numRecomputed`.
+std::optional<LazyResult> attach(
+    const LazyResultBroadcast::Key& key, const std::vector<IdTable>& chunks,
+    std::atomic<size_t>& numRecomputed,
+    const QueryExecutionContext* query = secondQuery()) {
+  return LazyResultBroadcast::tryAttach(
+      key, query, {}, [&chunks, &numRecomputed]() {
+        return makeSource(chunks, numRecomputed);
+      });
+}
+
+// Read the next chunk from the `range`.
+IdTable next(LazyResult& range) {
+  auto chunk = range.get();
+  AD_CORRECTNESS_CHECK(chunk.has_value());
+  return std::move(chunk.value().idTable_);
+}
+
+// Read all the remaining chunks from the `range`.
+std::vector<IdTable> readAll(LazyResult& range) {
+  std::vector<IdTable> result;
+  for (auto& chunk : range) {
+    result.push_back(std::move(chunk.idTable_));
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, resultIsComputedOnce) {
+  auto chunks = makeChunks();
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("computedOnce");
+  auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                          makeSource(chunks, numComputed));
+  auto consumer = attach(key, chunks, numRecomputed);
+  ASSERT_TRUE(consumer.has_value());
+  EXPECT_EQ(next(owner), chunks[0]);
+
+  // The consumer that is ahead computes the next chunk, the other one reads it
+  // from the buffer.
+  EXPECT_EQ(next(consumer.value()), chunks[0]);
+  EXPECT_EQ(next(consumer.value()), chunks[1]);
+  EXPECT_EQ(next(owner), chunks[1]);
+  EXPECT_EQ(numComputed, 2);
+  EXPECT_THAT(readAll(owner), ::testing::ElementsAre(chunks[2]));
+  EXPECT_THAT(readAll(consumer.value()), ::testing::ElementsAre(chunks[2]));
+  EXPECT_EQ(numComputed, 3);
+  EXPECT_EQ(numRecomputed, 0);
+
+  // The operations of the same query are not attached.
+  auto key2 = makeKey("sameQuery");
+  auto owner2 = LazyResultBroadcast::share(key2, firstQuery(),
+                                           makeSource(chunks, numComputed));
+  EXPECT_FALSE(attach(key2, chunks, numRecomputed, firstQuery()).has_value());
+  EXPECT_FALSE(
+      attach(makeKey("unknown"), chunks, numRecomputed).has_value());
+
+  // A chunk that is computed while no other consumer is attached isn't
+  // buffered, so no consumer can attach afterwards.
+  EXPECT_EQ(next(owner2), chunks[0]);
+  EXPECT_FALSE(attach(key2, chunks, numRecomputed).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, concurrentConsumers) {
+  auto chunks = makeChunks();
+  for (size_t i = 0; i < 50; ++i) {
+    chunks.push_back(makeIdTableFromVector({{i, i + 1}}));
+  }
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("concurrent");
+  auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                          makeSource(chunks, numComputed));
+  auto consumer = attach(key, chunks, numRecomputed);
+  ASSERT_TRUE(consumer.has_value());
+  std::vector<IdTable> consumerResult;
+  {
+    ad_utility::JThread thread{
+        [&]() { consumerResult = readAll(consumer.value()); }};
+    EXPECT_EQ(readAll(owner), chunks);
+  }
+  EXPECT_EQ(consumerResult, chunks);
+  EXPECT_EQ(numComputed, chunks.size());
+  // The consumer recomputes the result if it falls too far behind the owner or
+  // gets too far ahead of it.
+  EXPECT_THAT(numRecomputed.load(),
+              ::testing::AnyOf(size_t{0}, chunks.size()));
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, noAttachingAfterMaxSize) {
+  auto chunks = makeChunks();
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("maxSize");
+  {
+    auto cleanup =
+        setRuntimeParameterForTest<"lazy-result-sharing-max-size">(1_B);
+    auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                            makeSource(chunks, numComputed));
+    auto consumer = attach(key, chunks, numRecomputed);
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(next(owner), chunks[0]);
+    EXPECT_FALSE(attach(key, chunks, numRecomputed).has_value());
+  }
+
+  // The value 0 disables the sharing.
+  auto cleanup = setRuntimeParameterForTest<"lazy-result-sharing-max-size">(
+      ad_utility::MemorySize::bytes(0));
+  auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                          makeSource(chunks, numComputed));
+  EXPECT_FALSE(attach(key, chunks, numRecomputed).has_value());
+  EXPECT_EQ(readAll(owner), chunks);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, ownerIsDestroyedEarly) {
+  auto chunks = makeChunks();
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("ownerDestroyed");
+  std::optional<LazyResult> consumer;
+  {
+    auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                            makeSource(chunks, numComputed));
+    consumer = attach(key, chunks, numRecomputed);
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(next(owner), chunks[0]);
+  }
+  // The owner doesn't compute the remaining chunks for the consumer.
+  EXPECT_EQ(numComputed, 1);
+  EXPECT_FALSE(attach(key, chunks, numRecomputed).has_value());
+  // The consumer reads the buffered chunk, and then recomputes the result
+  // without the rows that it has already read.
+  EXPECT_EQ(next(consumer.value()), chunks[0]);
+  EXPECT_EQ(numRecomputed, 0);
+  EXPECT_THAT(readAll(consumer.value()),
+              ::testing::ElementsAre(chunks[1], chunks[2]));
+  EXPECT_EQ(numRecomputed, 3);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, ownerIsCancelled) {
+  auto chunks = makeChunks();
+  // The cancellation of the owner's query, and the memory limit of the owner's
+  // query (the generator uses its allocator).
+  std::vector<std::exception_ptr> exceptions{
+      std::make_exception_ptr(ad_utility::CancellationException{
+          ad_utility::CancellationState::TIMEOUT}),
+      std::make_exception_ptr(
+          ad_utility::detail::AllocationExceedsLimitException{
+              ad_utility::MemorySize::megabytes(2),
+              ad_utility::MemorySize::megabytes(1)})};
+  for (const auto& exception : exceptions) {
+    std::atomic<size_t> numComputed = 0;
+    std::atomic<size_t> numRecomputed = 0;
+    auto key = makeKey("ownerCancelled");
+    auto owner = LazyResultBroadcast::share(
+        key, firstQuery(), makeSource(chunks, numComputed, 1, exception));
+    auto consumer = attach(key, chunks, numRecomputed);
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(next(owner), chunks[0]);
+    EXPECT_EQ(next(consumer.value()), chunks[0]);
+
+    // The consumer computes the next chunk with the generator of the owner,
+    // which fails. Only the owner gets the exception, the consumer recomputes
+    // the remaining chunks.
+    EXPECT_THAT(readAll(consumer.value()),
+                ::testing::ElementsAre(chunks[1], chunks[2]));
+    EXPECT_EQ(numRecomputed, 3);
+    EXPECT_THROW(owner.get(), std::exception);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, exceptionsArePropagated) {
+  auto chunks = makeChunks();
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("exception");
+  auto owner = LazyResultBroadcast::share(
+      key, firstQuery(), makeSource(chunks, numComputed, 1));
+  auto consumer = attach(key, chunks, numRecomputed);
+  ASSERT_TRUE(consumer.has_value());
+  EXPECT_EQ(next(owner), chunks[0]);
+  AD_EXPECT_THROW_WITH_MESSAGE(owner.get(),
+                               ::testing::HasSubstr("Computation failed"));
+  EXPECT_EQ(next(consumer.value()), chunks[0]);
+  AD_EXPECT_THROW_WITH_MESSAGE(consumer.value().get(),
+                               ::testing::HasSubstr("Computation failed"));
+  EXPECT_EQ(numRecomputed, 0);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, laggingConsumerIsDetached) {
+  auto cleanup =
+      setRuntimeParameterForTest<"lazy-result-sharing-max-num-chunks">(2);
+  auto chunks = makeChunks();
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto key = makeKey("boundedBuffer");
+  {
+    auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                            makeSource(chunks, numComputed));
+    auto consumer = attach(key, chunks, numRecomputed);
+    ASSERT_TRUE(consumer.has_value());
+    // The ring is full after two chunks, so the consumer that hasn't read
+    // anything is detached when the owner needs the third chunk.
+    EXPECT_EQ(readAll(owner), chunks);
+    EXPECT_EQ(numComputed, 3);
+    EXPECT_EQ(numRecomputed, 0);
+    EXPECT_EQ(readAll(consumer.value()), chunks);
+    EXPECT_EQ(numRecomputed, 3);
+  }
+
+  // If the owner is the slowest consumer, the fast consumer detaches itself
+  // and skips the rows that it has already read.
+  numComputed = 0;
+  numRecomputed = 0;
+  auto owner = LazyResultBroadcast::share(key, firstQuery(),
+                                          makeSource(chunks, numComputed));
+  auto consumer = attach(key, chunks, numRecomputed);
+  ASSERT_TRUE(consumer.has_value());
+  EXPECT_EQ(readAll(consumer.value()), chunks);
+  EXPECT_EQ(numComputed, 2);
+  EXPECT_EQ(numRecomputed, 3);
+  EXPECT_EQ(readAll(owner), chunks);
+  EXPECT_EQ(numComputed, 3);
+}
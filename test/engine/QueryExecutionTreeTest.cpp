@@ -89,3 +89,34 @@ TEST(QueryExecutionTree, createSortedTreeAnyPermutation) {
     EXPECT_EQ(castTree->getResultSortedOn(), (SC{0, 1}));
   }
 }
+
+// _____________________________________________________________________________
+TEST(QueryExecutionTree, sortedTreesAreShared) {
+  using Vars = std::vector<std::optional<Variable>>;
+  auto* qec = getQec();
+  auto values = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{1, 0}, {0, 1}}),
+      Vars{Variable{"?a"}, Variable{"?b"}});
+
+  auto sortedTree = QueryExecutionTree::createSortedTree(values, {1});
+  EXPECT_NE(sortedTree, values);
+  // As long as the sorted tree is alive, it is returned again for the same
+  // sort columns.
+  EXPECT_EQ(QueryExecutionTree::createSortedTree(values, {1}), sortedTree);
+  auto otherSortedTree = QueryExecutionTree::createSortedTree(values, {0, 1});
+  EXPECT_NE(otherSortedTree, sortedTree);
+  EXPECT_NE(otherSortedTree->getCacheKey(), sortedTree->getCacheKey());
+
+  // Once the sorted tree is destroyed, a new one is created.
+  std::string cacheKey = sortedTree->getCacheKey();
+  sortedTree.reset();
+  auto newSortedTree = QueryExecutionTree::createSortedTree(values, {1});
+  EXPECT_EQ(newSortedTree->getCacheKey(), cacheKey);
+  EXPECT_EQ(newSortedTree.use_count(), 1);
+
+  // A tree to which a `LIMIT` has been applied is not returned again.
+  newSortedTree->applyLimit({1});
+  auto unlimitedTree = QueryExecutionTree::createSortedTree(values, {1});
+  EXPECT_NE(unlimitedTree, newSortedTree);
+  EXPECT_EQ(unlimitedTree->getCacheKey(), cacheKey);
+}
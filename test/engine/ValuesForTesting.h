@@ -133,6 +133,8 @@ class ValuesForTesting : public Operation {
 
   bool supportsLimitOffset() const override { return supportsLimit_; }
 
+  bool canYieldLazyResult() const override { return !forceFullyMaterialized_; }
+
   bool& forceFullyMaterialized() { return forceFullyMaterialized_; }
 
  private:
@@ -5,6 +5,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "../../util/AllocatorTestHelpers.h"
 #include "../../util/GTestHelpers.h"
 #include "../../util/IdTableHelpers.h"
@@ -247,6 +249,45 @@ TEST(CompressedExternalIdTable, compressorRandomInput) {
   testExternalCompressor<3>(3, 1000, 1_MB);
 }
 
+// Test that a `CompressedExternalIdTable` can be persisted and reopened.
+TEST(CompressedExternalIdTable, persistAndReopen) {
+  using namespace ad_utility::memory_literals;
+  auto test = [](size_t numRows, ad_utility::MemorySize memory) {
+    std::string filename = "idTableCompressor.persistAndReopen.dat";
+    CopyableIdTable<3> randomTable =
+        createRandomlyFilledIdTable(numRows, 3).toStatic<3>();
+    ad_utility::CompressedExternalIdTableWriter::PersistedMetadata metadata;
+    {
+      ad_utility::CompressedExternalIdTable<3> writer{
+          filename, 3, memory, ad_utility::testing::makeAllocator(), 5_kB};
+      for (const auto& row : randomTable) {
+        writer.push(row);
+      }
+      metadata = writer.persist();
+      // The table can still be read after it was persisted.
+      EXPECT_THAT(idTableFromRowGenerator<3>(writer.getRows(), 3),
+                  ::testing::Eq(randomTable));
+    }
+    // The file was not deleted by the destructor.
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    {
+      ad_utility::CompressedExternalIdTable<3> reopened{
+          filename, 3, memory, ad_utility::testing::makeAllocator(),
+          std::move(metadata)};
+      EXPECT_EQ(reopened.size(), numRows);
+      EXPECT_THAT(idTableFromRowGenerator<3>(reopened.getRows(), 3),
+                  ::testing::Eq(randomTable));
+    }
+    // Reopened tables also don't delete the file.
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    ad_utility::deleteFile(filename);
+  };
+  // Many blocks, a single block, and an empty table.
+  test(10'000, 10_kB);
+  test(1000, 1_MB);
+  test(0, 1_MB);
+}
+
 TEST(CompressedExternalIdTable, exceptionsWhenWritingWhileIterating) {
   std::string filename = "idTableCompressor.exceptionsWhenWritingTest.dat";
   using namespace ad_utility::memory_literals;
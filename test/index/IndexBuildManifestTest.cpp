@@ -0,0 +1,303 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "index/ConstantsIndexBuilding.h"
+#include "index/IndexBuildManifest.h"
+#include "index/IndexImpl.h"
+#include "util/File.h"
+
+namespace {
+using Phase = IndexBuildManifest::Phase;
+using json = nlohmann::json;
+
+// Create an empty file with the given `filename`.
+void touch(const std::string& filename) {
+  auto f = ad_utility::makeOfstream(filename);
+}
+
+// The input and the settings of the index builds in the tests below.
+const std::string inputFilename = "IndexBuildManifestTest.input.ttl";
+const std::string settingsFilename = "IndexBuildManifestTest.settings.json";
+
+// Write the input and the `settings` of the index builds.
+void writeInputAndSettings(const json& settings = json::object()) {
+  {
+    auto f = ad_utility::makeOfstream(inputFilename);
+    f << "<a> <b> <c> . <a> <b> \"some literal\" . <c> <d> <a> .\n"
+         "<x> <b> <y> . <y> <e> \"other\"@en . <z> <f> 42 .\n";
+  }
+  auto f = ad_utility::makeOfstream(settingsFilename);
+  f << settings.dump();
+}
+
+// Build the index with the given `basename` from the input and the settings
+// above. If `resume` is true, the index build is resumable, and the
+// `afterCheckpoint` callback is called after the checkpoint was written.
+void buildIndex(const std::string& basename, bool resume,
+                std::function<void()> afterCheckpoint = {}) {
+  Index index = ad_utility::testing::makeIndexWithTestSettings();
+  index.setOnDiskBase(basename);
+  index.setSettingsFile(settingsFilename);
+  index.resumeIndexBuild() = resume;
+  index.getImpl().setVocabularyTypeForIndexBuilding(
+      ad_utility::VocabularyType{
+          ad_utility::VocabularyType::Enum::OnDiskCompressed});
+  index.getImpl().afterCheckpointOnlyForTesting() = std::move(afterCheckpoint);
+  index.createFromFiles({qlever::InputFileSpecification{
+      inputFilename, qlever::Filetype::Turtle, std::nullopt}});
+}
+
+// Start a resumable index build with the given `basename` that is interrupted
+// after the checkpoint has been written.
+void buildIndexAndInterrupt(const std::string& basename) {
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      buildIndex(basename, true,
+                 []() { throw std::runtime_error{"Build interrupted"}; }),
+      ::testing::HasSubstr("Build interrupted"));
+  ASSERT_TRUE(std::filesystem::exists(
+      absl::StrCat(basename, INDEX_BUILD_MANIFEST_FILE_NAME)));
+  ASSERT_TRUE(std::filesystem::exists(
+      absl::StrCat(basename, UNSORTED_TRIPLES_FILE_NAME)));
+}
+
+// Build the index with the given `basename` with resuming enabled, and return
+// true iff the vocabulary phase was resumed from a checkpoint.
+bool buildIndexAndCheckIfResumed(const std::string& basename) {
+  size_t numCheckpointsWritten = 0;
+  buildIndex(basename, true,
+             [&numCheckpointsWritten]() { ++numCheckpointsWritten; });
+  return numCheckpointsWritten == 0;
+}
+
+// Return the contents of the file with the given `filename`.
+std::string readFile(const std::string& filename) {
+  std::ifstream f{filename, std::ios::binary};
+  return {std::istreambuf_iterator<char>{f}, std::istreambuf_iterator<char>{}};
+}
+
+// Return the names of the vocabulary files of the index with the `basename`.
+std::vector<std::string> getVocabularyFiles(const std::string& basename) {
+  std::vector<std::string> result;
+  auto prefix = absl::StrCat(basename, VOCAB_SUFFIX);
+  for (const auto& entry : std::filesystem::directory_iterator{"."}) {
+    if (entry.path().filename().string().starts_with(prefix)) {
+      result.push_back(entry.path().filename().string());
+    }
+  }
+  return result;
+}
+
+// Delete all the files of the index with the given `basename`.
+void deleteIndexFiles(const std::string& basename) {
+  for (const auto& file :
+       ad_utility::testing::getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(file, false);
+  }
+  for (const auto& file : getVocabularyFiles(basename)) {
+    ad_utility::deleteFile(file, false);
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, completePhaseAndResume) {
+  std::string filename = "IndexBuildManifestTest.completePhase.json";
+  std::string dataFile = "IndexBuildManifestTest.completePhase.dat";
+  touch(dataFile);
+  json fingerprint{{"input", "someFile.ttl"}, {"size", 42}};
+  {
+    IndexBuildManifest manifest{filename, fingerprint};
+    EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        manifest.data(Phase::TriplesAndVocabulary),
+        ::testing::HasSubstr("isCompleted"));
+    manifest.markCompleted(Phase::TriplesAndVocabulary, {dataFile}, {},
+                           json{{"sizes", {1, 2, 3}}});
+    EXPECT_TRUE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  }
+  ASSERT_TRUE(std::filesystem::exists(filename));
+
+  // A manifest with the same fingerprint reads the completed phases.
+  {
+    IndexBuildManifest manifest{filename, fingerprint};
+    ASSERT_TRUE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+    EXPECT_EQ(manifest.data(Phase::TriplesAndVocabulary).at("sizes"),
+              (json{1, 2, 3}));
+  }
+
+  // A manifest with a different fingerprint ignores the completed phases.
+  {
+    IndexBuildManifest manifest{filename, json{{"input", "otherFile.ttl"}}};
+    EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  }
+
+  // If one of the files of a phase is missing, then the phase is not
+  // completed.
+  {
+    IndexBuildManifest manifest{filename, fingerprint};
+    ASSERT_TRUE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+    ad_utility::deleteFile(dataFile);
+    EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  }
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, finish) {
+  std::string filename = "IndexBuildManifestTest.finish.json";
+  std::string dataFile = "IndexBuildManifestTest.finish.dat";
+  std::string outputFile = "IndexBuildManifestTest.finish.output";
+  json fingerprint{{"input", "someFile.ttl"}};
+  for (bool keepFiles : {false, true}) {
+    touch(dataFile);
+    touch(outputFile);
+    IndexBuildManifest manifest{filename, fingerprint};
+    manifest.markCompleted(Phase::TriplesAndVocabulary, {dataFile},
+                           {outputFile});
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    manifest.finish(keepFiles);
+    EXPECT_FALSE(std::filesystem::exists(filename));
+    EXPECT_EQ(std::filesystem::exists(dataFile), keepFiles);
+    // The output files are part of the final index and are always kept.
+    EXPECT_TRUE(std::filesystem::exists(outputFile));
+    EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  }
+  ad_utility::deleteFile(dataFile);
+  ad_utility::deleteFile(outputFile);
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, missingOutputFile) {
+  std::string filename = "IndexBuildManifestTest.missingOutput.json";
+  std::string dataFile = "IndexBuildManifestTest.missingOutput.dat";
+  std::string outputFile = "IndexBuildManifestTest.missingOutput.output";
+  touch(dataFile);
+  touch(outputFile);
+  IndexBuildManifest manifest{filename, json{{"input", "someFile.ttl"}}};
+  manifest.markCompleted(Phase::TriplesAndVocabulary, {dataFile},
+                         {outputFile});
+  EXPECT_TRUE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  ad_utility::deleteFile(outputFile);
+  EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  manifest.finish(false);
+  EXPECT_FALSE(std::filesystem::exists(dataFile));
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, corruptManifestIsIgnored) {
+  std::string filename = "IndexBuildManifestTest.corrupt.json";
+  {
+    auto f = ad_utility::makeOfstream(filename);
+    f << "{this is not valid json";
+  }
+  IndexBuildManifest manifest{filename, json{{"input", "someFile.ttl"}}};
+  EXPECT_FALSE(manifest.isCompleted(Phase::TriplesAndVocabulary));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, resumeInterruptedIndexBuild) {
+  writeInputAndSettings();
+  std::string fresh = "IndexBuildManifestTest.fresh";
+  std::string resumed = "IndexBuildManifestTest.resumed";
+
+  // Without resuming, no checkpoint is written, and no temporary files are
+  // left behind.
+  size_t numCheckpointsWritten = 0;
+  buildIndex(fresh, false,
+             [&numCheckpointsWritten]() { ++numCheckpointsWritten; });
+  EXPECT_EQ(numCheckpointsWritten, 0);
+  EXPECT_FALSE(std::filesystem::exists(
+      absl::StrCat(fresh, INDEX_BUILD_MANIFEST_FILE_NAME)));
+  EXPECT_FALSE(
+      std::filesystem::exists(absl::StrCat(fresh, UNSORTED_TRIPLES_FILE_NAME)));
+  EXPECT_FALSE(
+      std::filesystem::exists(absl::StrCat(fresh, PARTIAL_MMAP_IDS, 0)));
+
+  buildIndexAndInterrupt(resumed);
+  EXPECT_TRUE(buildIndexAndCheckIfResumed(resumed));
+  // The checkpoint has been deleted after the successful index build.
+  EXPECT_FALSE(std::filesystem::exists(
+      absl::StrCat(resumed, INDEX_BUILD_MANIFEST_FILE_NAME)));
+  EXPECT_FALSE(std::filesystem::exists(
+      absl::StrCat(resumed, UNSORTED_TRIPLES_FILE_NAME)));
+  EXPECT_FALSE(
+      std::filesystem::exists(absl::StrCat(resumed, PARTIAL_MMAP_IDS, 0)));
+
+  // The resumed index is the same as the freshly built one.
+  size_t numComparedFiles = 0;
+  auto freshFiles = ad_utility::testing::getAllIndexFilenames(fresh);
+  auto resumedFiles = ad_utility::testing::getAllIndexFilenames(resumed);
+  for (size_t i = 0; i < freshFiles.size(); ++i) {
+    if (freshFiles[i].ends_with(".ttl") ||
+        freshFiles[i].ends_with(".meta-data.json") ||
+        !std::filesystem::exists(freshFiles[i])) {
+      continue;
+    }
+    EXPECT_EQ(readFile(freshFiles[i]), readFile(resumedFiles[i]))
+        << freshFiles[i];
+    ++numComparedFiles;
+  }
+  EXPECT_GE(numComparedFiles, 12);
+  auto vocabularyFiles = getVocabularyFiles(fresh);
+  ASSERT_FALSE(vocabularyFiles.empty());
+  for (const auto& file : vocabularyFiles) {
+    EXPECT_EQ(readFile(file),
+              readFile(absl::StrCat(resumed, file.substr(fresh.size()))))
+        << file;
+  }
+  deleteIndexFiles(fresh);
+  deleteIndexFiles(resumed);
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildManifest, changedFingerprintForcesRebuild) {
+  std::string basename = "IndexBuildManifestTest.changed";
+
+  // Changed contents of the settings file.
+  writeInputAndSettings();
+  buildIndexAndInterrupt(basename);
+  writeInputAndSettings(json{{"num-triples-per-batch", 3}});
+  EXPECT_FALSE(buildIndexAndCheckIfResumed(basename));
+
+  // A changed option of the index builder.
+  buildIndexAndInterrupt(basename);
+  {
+    Index index = ad_utility::testing::makeIndexWithTestSettings();
+    index.setOnDiskBase(basename);
+    index.setSettingsFile(settingsFilename);
+    index.resumeIndexBuild() = true;
+    index.getImpl().setVocabularyTypeForIndexBuilding(
+        ad_utility::VocabularyType{
+            ad_utility::VocabularyType::Enum::InMemoryUncompressed});
+    size_t numCheckpointsWritten = 0;
+    index.getImpl().afterCheckpointOnlyForTesting() =
+        [&numCheckpointsWritten]() { ++numCheckpointsWritten; };
+    index.createFromFiles({qlever::InputFileSpecification{
+        inputFilename, qlever::Filetype::Turtle, std::nullopt}});
+    EXPECT_EQ(numCheckpointsWritten, 1);
+  }
+  deleteIndexFiles(basename);
+
+  // A deleted vocabulary file.
+  buildIndexAndInterrupt(basename);
+  auto vocabularyFiles = getVocabularyFiles(basename);
+  ASSERT_FALSE(vocabularyFiles.empty());
+  ad_utility::deleteFile(vocabularyFiles.at(0));
+  EXPECT_FALSE(buildIndexAndCheckIfResumed(basename));
+
+  // Unchanged input and settings.
+  buildIndexAndInterrupt(basename);
+  EXPECT_TRUE(buildIndexAndCheckIfResumed(basename));
+  deleteIndexFiles(basename);
+}
@@ -0,0 +1,236 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <random>
+#include <set>
+
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "global/Constants.h"
+#include "index/IndexImpl.h"
+#include "index/ReachabilityIndex.h"
+#include "util/File.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/FileSerializer.h"
+
+using ::testing::UnorderedElementsAreArray;
+
+namespace {
+auto V = ad_utility::testing::VocabId;
+
+// Build the `ReachabilityIndex` for the `edges` between the vocab IDs with
+// the given indices.
+ReachabilityIndex makeIndex(
+    const std::vector<std::pair<size_t, size_t>>& edges) {
+  std::vector<Id> from;
+  std::vector<Id> to;
+  for (const auto& [u, v] : edges) {
+    from.push_back(V(u));
+    to.push_back(V(v));
+  }
+  return ReachabilityIndex{from, to};
+}
+
+// Return the nodes that can be reached from `node` with at least one step.
+std::vector<Id> reachable(const ReachabilityIndex& index, Id node) {
+  std::vector<Id> result;
+  index.forEachReachable(node, [&result](Id id) { result.push_back(id); });
+  return result;
+}
+
+// Compute the nodes that can be reached from `start` with at least one step
+// with a simple depth-first search for the comparison.
+std::vector<Id> reachableBruteForce(
+    const std::vector<std::pair<size_t, size_t>>& edges, size_t start) {
+  std::set<size_t> visited;
+  std::vector<size_t> stack{start};
+  while (!stack.empty()) {
+    size_t node = stack.back();
+    stack.pop_back();
+    for (const auto& [u, v] : edges) {
+      if (u == node && visited.insert(v).second) {
+        stack.push_back(v);
+      }
+    }
+  }
+  std::vector<Id> result;
+  for (size_t node : visited) {
+    result.push_back(V(node));
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, hierarchy) {
+  // A small class hierarchy with multiple inheritance (4 is a subclass of 2
+  // and 3).
+  auto index = makeIndex({{1, 0}, {2, 1}, {3, 1}, {4, 2}, {4, 3}, {5, 0}});
+  EXPECT_EQ(index.numNodes(), 6);
+  EXPECT_EQ(index.numComponents(), 6);
+  EXPECT_THAT(reachable(index, V(4)),
+              UnorderedElementsAreArray({V(2), V(3), V(1), V(0)}));
+  EXPECT_THAT(reachable(index, V(5)), UnorderedElementsAreArray({V(0)}));
+  EXPECT_TRUE(reachable(index, V(0)).empty());
+  EXPECT_TRUE(index.reaches(V(4), V(0)));
+  EXPECT_TRUE(index.reaches(V(3), V(1)));
+  EXPECT_FALSE(index.reaches(V(0), V(4)));
+  EXPECT_FALSE(index.reaches(V(2), V(3)));
+  EXPECT_FALSE(index.reaches(V(5), V(1)));
+  // A node can't be reached from itself with at least one step in a DAG.
+  EXPECT_FALSE(index.reaches(V(4), V(4)));
+
+  // Nodes that are not part of the graph.
+  EXPECT_TRUE(index.contains(V(5)));
+  EXPECT_FALSE(index.contains(V(6)));
+  EXPECT_FALSE(index.reaches(V(6), V(0)));
+  EXPECT_TRUE(reachable(index, V(6)).empty());
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, cyclesAndSelfLoops) {
+  // 0 -> 1 -> 2 -> 0 is a cycle, 3 has a self-loop, and the duplicate edges
+  // are ignored.
+  auto index =
+      makeIndex({{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 3}, {3, 4}, {0, 1}});
+  EXPECT_EQ(index.numNodes(), 5);
+  EXPECT_EQ(index.numComponents(), 3);
+  EXPECT_THAT(reachable(index, V(1)),
+              UnorderedElementsAreArray({V(0), V(1), V(2), V(3), V(4)}));
+  EXPECT_THAT(reachable(index, V(3)), UnorderedElementsAreArray({V(3), V(4)}));
+  EXPECT_TRUE(reachable(index, V(4)).empty());
+  EXPECT_TRUE(index.reaches(V(0), V(0)));
+  EXPECT_TRUE(index.reaches(V(3), V(3)));
+  EXPECT_FALSE(index.reaches(V(4), V(4)));
+  EXPECT_FALSE(index.reaches(V(3), V(2)));
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, randomGraphsAgainstBruteForce) {
+  std::mt19937 generator{42};
+  for (size_t numNodes : {10, 50, 200}) {
+    for (size_t edgeFactor : {1, 2, 4}) {
+      std::uniform_int_distribution<size_t> nodeDistribution{0, numNodes - 1};
+      std::vector<std::pair<size_t, size_t>> edges;
+      for (size_t i = 0; i < edgeFactor * numNodes; ++i) {
+        edges.emplace_back(nodeDistribution(generator),
+                           nodeDistribution(generator));
+      }
+      auto index = makeIndex(edges);
+      for (size_t node = 0; node < numNodes; ++node) {
+        auto expected = reachableBruteForce(edges, node);
+        ASSERT_THAT(reachable(index, V(node)),
+                    UnorderedElementsAreArray(expected));
+        for (size_t other = 0; other < numNodes; ++other) {
+          bool isExpected = ql::ranges::find(expected, V(other)) !=
+                            expected.end();
+          ASSERT_EQ(index.reaches(V(node), V(other)), isExpected)
+              << node << " " << other;
+        }
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, serialization) {
+  auto index = makeIndex({{1, 0}, {2, 1}, {0, 2}, {3, 2}});
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << index;
+  ReachabilityIndex copy;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  reader >> copy;
+  EXPECT_EQ(copy.numNodes(), 4);
+  EXPECT_EQ(copy.numIntervals(), index.numIntervals());
+  EXPECT_THAT(reachable(copy, V(3)),
+              UnorderedElementsAreArray({V(0), V(1), V(2)}));
+  EXPECT_FALSE(copy.reaches(V(0), V(3)));
+
+  // An empty index.
+  ReachabilityIndex empty{{}, {}};
+  EXPECT_EQ(empty.numNodes(), 0);
+  EXPECT_FALSE(empty.contains(V(0)));
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, loadOrBuildWithTheIndex) {
+  using namespace ad_utility::testing;
+  std::string basename = "ReachabilityIndexTest_loadOrBuild";
+  TestIndexConfig config{"<a> <sub> <b> . <b> <sub> <c> . <c> <other> <d> ."};
+  // The first predicate is not contained in the vocabulary and is skipped.
+  config.reachabilityPredicates = {"<notInVocabulary>", "<sub>"};
+  auto index = makeTestIndex(basename, config);
+  auto getId = makeGetId(index);
+  Id a = getId("<a>");
+  Id c = getId("<c>");
+  Id sub = getId("<sub>");
+  const auto* forward = index.getImpl().getReachabilityIndex(sub, false);
+  const auto* reversed = index.getImpl().getReachabilityIndex(sub, true);
+  ASSERT_NE(forward, nullptr);
+  ASSERT_NE(reversed, nullptr);
+  EXPECT_TRUE(forward->reaches(a, c));
+  EXPECT_FALSE(forward->reaches(c, a));
+  EXPECT_TRUE(reversed->reaches(c, a));
+  EXPECT_FALSE(reversed->reaches(a, c));
+  EXPECT_EQ(index.getImpl().getReachabilityIndex(getId("<other>"), false),
+            nullptr);
+
+  // The file names contain the position of the predicate in the settings.
+  auto filename = absl::StrCat(basename, REACHABILITY_INDEX_SUFFIX);
+  EXPECT_FALSE(std::filesystem::exists(filename + "0"));
+  ASSERT_TRUE(std::filesystem::exists(filename + "1"));
+
+  // An index that exists on disk is read when the index is loaded (here, it
+  // is replaced by the index for the reversed edges).
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{filename + "1"};
+    serializer << *reversed;
+    serializer << *forward;
+  }
+  {
+    Index loaded{ad_utility::makeUnlimitedAllocator<Id>()};
+    loaded.createFromOnDiskIndex(basename, false);
+    const auto* loadedForward =
+        loaded.getImpl().getReachabilityIndex(sub, false);
+    ASSERT_NE(loadedForward, nullptr);
+    EXPECT_TRUE(loadedForward->reaches(c, a));
+  }
+
+  // A missing index is built again, for example, by
+  // `createReachabilityIndexes` directly after the index build.
+  ad_utility::deleteFile(filename + "1");
+  index.createReachabilityIndexes();
+  ASSERT_TRUE(std::filesystem::exists(filename + "1"));
+  Index rebuilt{ad_utility::makeUnlimitedAllocator<Id>()};
+  rebuilt.createFromOnDiskIndex(basename, false);
+  const auto* rebuiltForward =
+      rebuilt.getImpl().getReachabilityIndex(sub, false);
+  ASSERT_NE(rebuiltForward, nullptr);
+  EXPECT_TRUE(rebuiltForward->reaches(a, c));
+
+  for (const auto& file : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(file, false);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, noReachabilityPredicates) {
+  using namespace ad_utility::testing;
+  std::string basename = "ReachabilityIndexTest_noPredicates";
+  auto index = makeTestIndex(basename, TestIndexConfig{"<a> <sub> <b> ."});
+  EXPECT_FALSE(index.getImpl().hasReachabilityPredicates());
+  EXPECT_EQ(
+      index.getImpl().getReachabilityIndex(makeGetId(index)("<sub>"), false),
+      nullptr);
+  index.createReachabilityIndexes();
+  EXPECT_FALSE(std::filesystem::exists(
+      absl::StrCat(basename, REACHABILITY_INDEX_SUFFIX, 0)));
+  for (const auto& file : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(file, false);
+  }
+}
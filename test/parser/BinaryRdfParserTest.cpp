@@ -0,0 +1,250 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "parser/BinaryRdfParser.h"
+#include "parser/Tokenizer.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/File.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+using Triple = std::array<uint64_t, 4>;
+constexpr uint64_t noGraph = BinaryRdfParser::NO_GRAPH;
+
+// Append the bytes of the integer `value` to `result`.
+template <typename T>
+void appendInteger(std::string& result, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  result.append(bytes, sizeof(T));
+}
+
+// Return the contents of a binary RDF file with the given `terms` and
+// `triples`.
+std::string makeBinaryRdf(const std::vector<std::string>& terms,
+                          const std::vector<Triple>& triples) {
+  std::string result{BinaryRdfParser::MAGIC};
+  appendInteger(result, BinaryRdfParser::VERSION);
+  appendInteger(result, static_cast<uint64_t>(terms.size()));
+  for (const auto& term : terms) {
+    appendInteger(result, static_cast<uint32_t>(term.size()));
+    result += term;
+  }
+  for (const auto& triple : triples) {
+    for (auto id : triple) {
+      appendInteger(result, id);
+    }
+  }
+  return result;
+}
+
+// Write `contents` to the file `filename`.
+void writeFile(const std::string& filename, std::string_view contents) {
+  auto of = ad_utility::makeOfstream(filename);
+  of.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+// Replace a term that refers to the dictionary of the parser by the IRI or
+// literal it refers to, s.t. it can be compared to the output of the Turtle
+// parser.
+void resolveDictionaryEntry(TripleComponent& term) {
+  if (!term.isId() || term.getId().getDatatype() != Datatype::LocalVocabIndex) {
+    return;
+  }
+  const auto& entry = *term.getId().getLocalVocabIndex();
+  term = entry.isIri() ? TripleComponent{entry.getIri()}
+                       : TripleComponent{entry.getLiteral()};
+}
+
+// Read all the triples from the `parser` and resolve the terms that refer to
+// its dictionary.
+std::vector<TurtleTriple> parseAll(RdfParserBase& parser) {
+  std::vector<TurtleTriple> result;
+  while (auto batch = parser.getBatch()) {
+    ql::ranges::move(batch.value(), std::back_inserter(result));
+  }
+  for (auto& triple : result) {
+    resolveDictionaryEntry(triple.subject_);
+    resolveDictionaryEntry(triple.predicate_);
+    resolveDictionaryEntry(triple.object_);
+    resolveDictionaryEntry(triple.graphIri_);
+  }
+  return result;
+}
+
+// Parse the given Turtle `input`, this is the reference for the binary parser.
+std::vector<TurtleTriple> parseTurtle(const std::string& input) {
+  EncodedIriManager encodedIriManager;
+  RdfStringParser<TurtleParser<Tokenizer>> parser{&encodedIriManager};
+  parser.setInputStream(input);
+  return parser.parseAndReturnAllTriples();
+}
+
+const std::vector<std::string> terms{
+    "<s>",
+    "<p>",
+    "\"hello\"@en",
+    "\"42\"^^<http://www.w3.org/2001/XMLSchema#integer>",
+    "_:b",
+    "<g>",
+    "\"with \\\"escaped\\\" quotes\\n\""};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BinaryRdfParser, parseTriples) {
+  std::vector<Triple> triples{
+      {0, 1, 2, noGraph}, {4, 1, 3, 5}, {0, 1, 4, noGraph}, {0, 1, 6, 5}};
+  auto expected = parseTurtle(
+      "<s> <p> \"hello\"@en . "
+      "_:b <p> \"42\"^^<http://www.w3.org/2001/XMLSchema#integer> . "
+      "<s> <p> _:b . "
+      "<s> <p> \"with \\\"escaped\\\" quotes\\n\" .");
+  ASSERT_EQ(expected.size(), 4);
+  auto g = TripleComponent::Iri::fromIriref("<g>");
+  expected[1].graphIri_ = g;
+  expected[3].graphIri_ = g;
+
+  std::string contents = makeBinaryRdf(terms, triples);
+  std::string filename = "BinaryRdfParserTest.parseTriples.rdfbin";
+  std::string compressedFilename = filename + ".zst";
+  writeFile(filename, contents);
+  auto compressed = ZstdWrapper::compress(contents.data(), contents.size());
+  writeFile(compressedFilename,
+            std::string_view{compressed.data(), compressed.size()});
+
+  EncodedIriManager encodedIriManager;
+  for (const auto& file : {filename, compressedFilename}) {
+    // A small buffer size, s.t. the terms and triples span several blocks.
+    for (auto bufferSize : {1_B, 7_B, 1_kB}) {
+      BinaryRdfParser parser{file, &encodedIriManager, bufferSize};
+      EXPECT_EQ(parser.numTerms(), terms.size());
+      EXPECT_THAT(parseAll(parser), ::testing::ElementsAreArray(expected));
+    }
+  }
+
+  // The IRIs and literals are stored only once and the triples refer to them.
+  {
+    BinaryRdfParser parser{filename, &encodedIriManager, 1_kB};
+    EXPECT_NE(parser.getTermStorage(), nullptr);
+    auto batch = parser.getBatch();
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_EQ(batch->size(), 4);
+    const auto& subject = batch->at(0).subject_;
+    ASSERT_TRUE(subject.isId());
+    EXPECT_EQ(subject.getId().getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(subject.getId().getLocalVocabIndex(),
+              batch->at(2).subject_.getId().getLocalVocabIndex());
+  }
+
+  // A default graph for the triples without a graph.
+  {
+    auto defaultGraph = TripleComponent::Iri::fromIriref("<default>");
+    BinaryRdfParser parser{filename, &encodedIriManager, 1_kB, defaultGraph};
+    auto result = parseAll(parser);
+    ASSERT_EQ(result.size(), 4);
+    EXPECT_EQ(result[0].graphIri_, TripleComponent{defaultGraph});
+    EXPECT_EQ(result[1].graphIri_, TripleComponent{g});
+  }
+
+  // The binary format via the `RdfMultifileParser`, which is what the index
+  // builder uses.
+  {
+    RdfMultifileParser parser{
+        {{filename, qlever::Filetype::Binary, std::nullopt}},
+        &encodedIriManager};
+    EXPECT_THAT(parseAll(parser), ::testing::ElementsAreArray(expected));
+  }
+  ad_utility::deleteFile(filename);
+  ad_utility::deleteFile(compressedFilename);
+}
+
+// _____________________________________________________________________________
+TEST(BinaryRdfParser, buildIndex) {
+  // The terms reach the vocabulary of the index via the dictionary of the
+  // parser, the result has to be the same as for the equivalent Turtle input.
+  // The test index externalizes all the words.
+  std::vector<Triple> triples{{0, 1, 2, noGraph},
+                              {0, 1, 3, noGraph},
+                              {5, 1, 2, noGraph},
+                              {0, 1, 6, noGraph},
+                              {0, 1, 5, noGraph}};
+  std::string turtle =
+      "<s> <p> \"hello\"@en . "
+      "<s> <p> \"42\"^^<http://www.w3.org/2001/XMLSchema#integer> . "
+      "<g> <p> \"hello\"@en . "
+      "<s> <p> \"with \\\"escaped\\\" quotes\\n\" . "
+      "<s> <p> <g> .";
+  auto makeIndex = [](std::string input, qlever::Filetype filetype,
+                      const std::string& basename) {
+    ad_utility::testing::TestIndexConfig config{std::move(input)};
+    config.indexType = filetype;
+    return ad_utility::testing::makeTestIndex(basename, std::move(config));
+  };
+  auto expected =
+      makeIndex(turtle, qlever::Filetype::Turtle, "BinaryRdfParserTestTurtle");
+  auto index = makeIndex(makeBinaryRdf(terms, triples),
+                         qlever::Filetype::Binary, "BinaryRdfParserTestBinary");
+
+  EXPECT_EQ(index.numTriples().normal, expected.numTriples().normal);
+  // The language-tagged literals lead to additional internal triples.
+  EXPECT_EQ(index.numTriples().internal, expected.numTriples().internal);
+  EXPECT_GT(index.numTriples().internal, 0);
+  const auto& vocab = index.getVocab();
+  const auto& expectedVocab = expected.getVocab();
+  ASSERT_EQ(vocab.size(), expectedVocab.size());
+  for (size_t i = 0; i < vocab.size(); ++i) {
+    auto idx = VocabIndex::make(i);
+    EXPECT_EQ(std::string{vocab[idx]}, std::string{expectedVocab[idx]});
+  }
+}
+
+// _____________________________________________________________________________
+TEST(BinaryRdfParser, invalidInput) {
+  std::string filename = "BinaryRdfParserTest.invalidInput.rdfbin";
+  EncodedIriManager encodedIriManager;
+  auto expectError = [&](std::string_view contents,
+                         const std::string& expectedMessage,
+                         ad_utility::source_location l =
+                             ad_utility::source_location::current()) {
+    auto trace = generateLocationTrace(l);
+    writeFile(filename, contents);
+    auto parse = [&]() {
+      BinaryRdfParser parser{filename, &encodedIriManager, 1_kB};
+      parseAll(parser);
+    };
+    AD_EXPECT_THROW_WITH_MESSAGE(parse(),
+                                 ::testing::HasSubstr(expectedMessage));
+  };
+
+  expectError("QLRDFBIX", "is not in the binary RDF format");
+  expectError("QLRD", "Unexpected end of input");
+  auto wrongVersion = makeBinaryRdf(terms, {});
+  wrongVersion[BinaryRdfParser::MAGIC.size()] = 2;
+  expectError(wrongVersion, "Unsupported version 2");
+  expectError(makeBinaryRdf({"<a>", "<b"}, {}), "Term #1 of the dictionary");
+  expectError(makeBinaryRdf({"<a>", ""}, {}), "Term #1 of the dictionary");
+  expectError(makeBinaryRdf({"<a>", "<b> , <c>"}, {}),
+              "is not a single RDF term");
+  expectError(makeBinaryRdf({"<a>", "<b> . <a> <b> <c>"}, {}),
+              "is not a single RDF term");
+  expectError(makeBinaryRdf(terms, {{0, 1, 7, noGraph}}),
+              "The object of a triple is 7, but the dictionary only has 7");
+  expectError(makeBinaryRdf(terms, {{2, 1, 0, noGraph}}),
+              "The term #2 can't be the subject");
+  expectError(makeBinaryRdf(terms, {{0, 4, 0, noGraph}}),
+              "The term #4 can't be the predicate");
+  expectError(makeBinaryRdf(terms, {{0, 1, 0, 3}}),
+              "The term #3 can't be the graph");
+  auto truncated = makeBinaryRdf(terms, {{0, 1, 2, noGraph}});
+  truncated.pop_back();
+  expectError(truncated, "ends in the middle of a triple");
+  ad_utility::deleteFile(filename);
+}
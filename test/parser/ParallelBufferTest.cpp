@@ -5,8 +5,67 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <absl/strings/str_cat.h>
+
 #include "../util/GTestHelpers.h"
 #include "parser/ParallelBuffer.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/CompressorStream.h"
+
+namespace {
+// Write `contents` to the file `filename`.
+void writeFile(const std::string& filename, std::string_view contents) {
+  auto of = ad_utility::makeOfstream(filename);
+  of.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+// Compress `input` with zstd. If `frameSize` is set, then each `frameSize`
+// bytes of the input are compressed into a separate frame.
+std::string compressZstd(std::string_view input,
+                         std::optional<size_t> frameSize = std::nullopt) {
+  std::string result;
+  size_t step = frameSize.value_or(std::max(input.size(), 1UL));
+  // Note: An empty input is compressed into a single (empty) frame.
+  size_t i = 0;
+  do {
+    auto part = input.substr(i, step);
+    auto compressed = ZstdWrapper::compress(part.data(), part.size());
+    result.append(compressed.begin(), compressed.end());
+    i += step;
+  } while (i < input.size());
+  return result;
+}
+
+// Compress `input` with gzip.
+std::string compressGzip(std::string_view input) {
+  std::string result;
+  for (const auto& part : ad_utility::streams::compressStream(
+           std::vector{std::string{input}},
+           ad_utility::content_encoding::CompressionMethod::GZIP)) {
+    result += part;
+  }
+  return result;
+}
+
+// Read all the blocks from `buffer` and return their concatenation.
+std::string readAll(ParallelBuffer& buffer) {
+  std::string result;
+  while (auto block = buffer.getNextBlock()) {
+    EXPECT_FALSE(block->empty());
+    result.append(block->begin(), block->end());
+  }
+  return result;
+}
+
+// A test input with many lines.
+std::string makeLines(size_t numLines) {
+  std::string result;
+  for (size_t i = 0; i < numLines; ++i) {
+    absl::StrAppend(&result, "<s", i, "> <p> \"object ", i, "\" .\n");
+  }
+  return result;
+}
+}  // namespace
 
 // ________________________________________________________
 TEST(ParallelBuffer, ParallelFileBuffer) {
@@ -122,3 +181,97 @@ TEST(ParallelBuffer, ParallelBufferWithEndRegexLongLookahead) {
   }
   ad_utility::deleteFile(filename);
 }
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, getInputCompression) {
+  EXPECT_EQ(getInputCompression("data.ttl"), InputCompression::None);
+  EXPECT_EQ(getInputCompression("/dev/stdin"), InputCompression::None);
+  EXPECT_EQ(getInputCompression("data.nt.gz"), InputCompression::Gzip);
+  EXPECT_EQ(getInputCompression("data.ttl.zst"), InputCompression::Zstd);
+  EXPECT_EQ(getInputCompression("data.ttl.zstd"), InputCompression::Zstd);
+  EXPECT_EQ(stripCompressionSuffix("data.ttl"), "data.ttl");
+  EXPECT_EQ(stripCompressionSuffix("data.nt.gz"), "data.nt");
+  EXPECT_EQ(stripCompressionSuffix("data.ttl.zst"), "data.ttl");
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, ParallelDecompressingBuffer) {
+  std::string input = makeLines(20'000);
+  auto test = [&input](std::string_view suffix, const std::string& compressed,
+                       size_t blocksize, size_t numThreads) {
+    std::string filename = absl::StrCat("parallelDecompressingBuffer", suffix);
+    writeFile(filename, compressed);
+    ParallelDecompressingBuffer buffer{blocksize, numThreads};
+    buffer.open(filename);
+    EXPECT_EQ(readAll(buffer), input) << suffix << ' ' << blocksize;
+    ad_utility::deleteFile(filename);
+  };
+  for (size_t blocksize : {1000UL, 100'000UL, 10'000'000UL}) {
+    for (size_t numThreads : {1UL, 4UL}) {
+      // A single zstd frame (decompressed sequentially).
+      test(".zst", compressZstd(input), blocksize, numThreads);
+      // Many zstd frames (decompressed concurrently when `numThreads > 1`).
+      test(".zstd", compressZstd(input, 7'777), blocksize, numThreads);
+      test(".gz", compressGzip(input), blocksize, numThreads);
+    }
+  }
+
+  // Empty files.
+  test(".zst", compressZstd(""), 100, 4);
+  test(".gz", compressGzip(""), 100, 4);
+
+  // Reading from an unopened buffer throws.
+  ParallelDecompressingBuffer unopened{100};
+  EXPECT_ANY_THROW(unopened.getNextBlock());
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, ParallelDecompressingBufferCorruptInput) {
+  std::string input = makeLines(1000);
+  auto expectError = [](std::string_view suffix, const std::string& compressed,
+                        size_t numThreads, std::string_view expectedMessage) {
+    std::string filename = absl::StrCat("parallelDecompressingCorrupt", suffix);
+    writeFile(filename, compressed);
+    ParallelDecompressingBuffer buffer{1000, numThreads};
+    buffer.open(filename);
+    AD_EXPECT_THROW_WITH_MESSAGE(readAll(buffer),
+                                 ::testing::HasSubstr(expectedMessage));
+    ad_utility::deleteFile(filename);
+  };
+  auto zstd = compressZstd(input);
+  expectError(".zst", zstd.substr(0, zstd.size() / 2), 1, "truncated");
+  auto multipleFrames = compressZstd(input, 1000);
+  expectError(".zst", multipleFrames.substr(0, multipleFrames.size() - 10), 4,
+              "zstd");
+  expectError(".gz", "this is not gzip", 1, "gzip");
+
+  // Opening a file that doesn't exist throws immediately.
+  for (auto filename : {"doesNotExist.zst", "doesNotExist.gz"}) {
+    ParallelDecompressingBuffer buffer{1000};
+    EXPECT_ANY_THROW(buffer.open(filename));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ParallelBuffer, ParallelBufferWithEndRegexCompressed) {
+  std::string input = makeLines(5000);
+  for (auto [suffix, compressed] :
+       {std::pair{".nt", input},
+        std::pair{".nt.zst", compressZstd(input, 3000)},
+        std::pair{".nt.gz", compressGzip(input)}}) {
+    std::string filename =
+        absl::StrCat("parallelBufferWithEndRegexCompressed", suffix);
+    writeFile(filename, compressed);
+    ParallelBufferWithEndRegex buffer{10'000, "\\.[\\t ]*([\\r\\n]+)"};
+    buffer.open(filename);
+    std::string result;
+    while (auto block = buffer.getNextBlock()) {
+      // Each block ends with a complete statement.
+      ASSERT_FALSE(block->empty());
+      EXPECT_EQ(block->back(), '\n');
+      result.append(block->begin(), block->end());
+    }
+    EXPECT_EQ(result, input) << suffix;
+    ad_utility::deleteFile(filename);
+  }
+}
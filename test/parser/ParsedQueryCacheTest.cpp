@@ -0,0 +1,220 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "parser/ParsedQueryCache.h"
+#include "parser/QueryTemplate.h"
+#include "parser/SparqlParser.h"
+#include "util/ParseException.h"
+
+namespace {
+const std::string query = "SELECT ?x WHERE { ?x <p> <o> }";
+
+// Return the triples of the first graph pattern of the `parsedQuery`.
+const auto& getTriples(const ParsedQuery& parsedQuery) {
+  return parsedQuery._rootGraphPattern._graphPatterns.at(0)
+      .getBasic()
+      ._triples;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ParsedQueryCache, hitsAndMisses) {
+  EncodedIriManager encodedIriManager;
+  ParsedQueryCache cache{2};
+  auto first = cache.getOrParse(&encodedIriManager, query);
+  EXPECT_EQ(cache.numMisses(), 1);
+  EXPECT_EQ(cache.numHits(), 0);
+  EXPECT_EQ(cache.numEntries(), 1);
+  auto second = cache.getOrParse(&encodedIriManager, query);
+  EXPECT_EQ(cache.numMisses(), 1);
+  EXPECT_EQ(cache.numHits(), 1);
+  EXPECT_EQ(second._originalString, query);
+  EXPECT_EQ(second.getVisibleVariables(), first.getVisibleVariables());
+
+  // The datasets from the SPARQL protocol are part of the key.
+  std::vector<DatasetClause> datasets{
+      {TripleComponent::Iri::fromIriref("<g>"), false}};
+  auto withDataset = cache.getOrParse(&encodedIriManager, query, datasets);
+  EXPECT_EQ(cache.numMisses(), 2);
+  const auto& graphs = withDataset.datasetClauses_.activeDefaultGraphs();
+  ASSERT_TRUE(graphs.has_value());
+  EXPECT_THAT(graphs.value(),
+              ::testing::ElementsAre(
+                  TripleComponent{TripleComponent::Iri::fromIriref("<g>")}));
+  cache.getOrParse(&encodedIriManager, query, datasets);
+  EXPECT_EQ(cache.numHits(), 2);
+
+  // A different query evicts the least recently used entry (the one without
+  // the datasets).
+  cache.getOrParse(&encodedIriManager, "ASK { ?x <p> <o> }");
+  EXPECT_EQ(cache.numMisses(), 3);
+  EXPECT_EQ(cache.numEntries(), 2);
+  cache.getOrParse(&encodedIriManager, query);
+  EXPECT_EQ(cache.numMisses(), 4);
+
+  // The runtime parameters that change the parsing are part of the key.
+  {
+    auto cleanup = setRuntimeParameterForTest<"syntax-test-mode">(true);
+    cache.getOrParse(&encodedIriManager, query);
+    EXPECT_EQ(cache.numMisses(), 5);
+  }
+
+  // Changing the size clears the cache.
+  cache.setMaxNumEntries(10);
+  EXPECT_EQ(cache.numEntries(), 0);
+  cache.getOrParse(&encodedIriManager, query);
+  EXPECT_EQ(cache.numMisses(), 6);
+}
+
+// _____________________________________________________________________________
+TEST(ParsedQueryCache, queriesThatAreNotCached) {
+  EncodedIriManager encodedIriManager;
+  ParsedQueryCache cache{10};
+
+  // Queries with aggregates, GROUP BY, or `NOW()` are parsed every time.
+  for (std::string notReused :
+       {"SELECT (COUNT(?x) AS ?cnt) WHERE { ?x <p> <o> } GROUP BY ?x",
+        "SELECT (sum(?x) AS ?s) {}", "SELECT ?x { ?x <p> <o> } GROUP BY ?x",
+        "SELECT (NOW() AS ?now) {}",
+        "SELECT ?x { ?x <p> <o> FILTER(?x < NOW()) }"}) {
+    auto parsed = cache.getOrParse(&encodedIriManager, notReused);
+    EXPECT_FALSE(parsed.mayBeReused_);
+    cache.getOrParse(&encodedIriManager, notReused);
+  }
+  EXPECT_EQ(cache.numEntries(), 0);
+  EXPECT_EQ(cache.numHits(), 0);
+  EXPECT_EQ(cache.numMisses(), 10);
+
+  // The keywords of these expressions in other places don't matter.
+  std::string minus =
+      "SELECT ?x { ?x <count> <MIN> MINUS { ?x <p> \"now\" } }";
+  EXPECT_TRUE(cache.getOrParse(&encodedIriManager, minus).mayBeReused_);
+  cache.getOrParse(&encodedIriManager, minus);
+  EXPECT_EQ(cache.numEntries(), 1);
+  EXPECT_EQ(cache.numHits(), 1);
+
+  // Invalid queries throw and are not stored.
+  for (size_t i = 0; i < 2; ++i) {
+    EXPECT_ANY_THROW(cache.getOrParse(&encodedIriManager, "SELECT * {"));
+  }
+  EXPECT_EQ(cache.numEntries(), 1);
+  EXPECT_EQ(cache.numMisses(), 13);
+
+  // A disabled cache parses every query.
+  ParsedQueryCache disabled{0};
+  disabled.getOrParse(&encodedIriManager, query);
+  disabled.getOrParse(&encodedIriManager, query);
+  EXPECT_EQ(disabled.numEntries(), 0);
+  EXPECT_EQ(disabled.numHits(), 0);
+}
+
+// _____________________________________________________________________________
+TEST(ParsedQueryCache, queriesThatOnlyDifferInConstants) {
+  EncodedIriManager encodedIriManager;
+  ParsedQueryCache cache{10};
+  // Parse the `query` with the `cache` and without it, and check that the
+  // results have the same triples.
+  auto expectSameTriples = [&](const std::string& query) {
+    auto cached = cache.getOrParse(&encodedIriManager, query);
+    auto expected = SparqlParser::parseQuery(&encodedIriManager, query);
+    EXPECT_EQ(cached._originalString, query);
+    EXPECT_EQ(getTriples(cached), getTriples(expected));
+    EXPECT_EQ(cached.getVisibleVariables(), expected.getVisibleVariables());
+  };
+
+  expectSameTriples(
+      "SELECT ?x { <http://a> <http://p> ?x . ?x <http://q> \"a\"@en }");
+  EXPECT_EQ(cache.numMisses(), 1);
+  // Other subjects and objects of triples are substituted, also if
+  // whitespace and comments differ.
+  expectSameTriples(
+      "SELECT ?x { <http://b>  <http://p> ?x . # comment\n"
+      "?x <http://q> \"b\"@de }");
+  expectSameTriples(
+      "SELECT ?x { <http://c> <http://p> ?x . ?x <http://q> \"c\" }");
+  EXPECT_EQ(cache.numMisses(), 1);
+  EXPECT_EQ(cache.numHits(), 2);
+  EXPECT_EQ(cache.numEntries(), 1);
+  // The predicates are part of the key.
+  expectSameTriples(
+      "SELECT ?x { <http://b> <http://r> ?x . ?x <http://q> \"b\"@de }");
+  EXPECT_EQ(cache.numMisses(), 2);
+  // An invalid constant is reported by the parser.
+  EXPECT_ANY_THROW(cache.getOrParse(
+      &encodedIriManager,
+      "SELECT ?x { <http://b> <http://p> ?x . ?x <http://q> \"b\"@- }"));
+
+  // The constants outside of triples have to be equal.
+  std::string filter =
+      "SELECT ?x { <http://a> <http://p> ?x FILTER(?x != <http://a>) }";
+  expectSameTriples(filter);
+  EXPECT_EQ(cache.numMisses(), 4);
+  expectSameTriples(
+      "SELECT ?x { <http://b> <http://p> ?x FILTER(?x != <http://a>) }");
+  EXPECT_EQ(cache.numMisses(), 4);
+  expectSameTriples(
+      "SELECT ?x { <http://b> <http://p> ?x FILTER(?x != <http://b>) }");
+  EXPECT_EQ(cache.numMisses(), 5);
+  // The entry was replaced by the last query.
+  cache.getOrParse(&encodedIriManager, filter);
+  EXPECT_EQ(cache.numMisses(), 6);
+
+  // The same holds for the IRIs of `PREFIX` declarations.
+  std::string prefix = "PREFIX a: <http://a/> SELECT ?x { a:b a:p ?x }";
+  expectSameTriples(prefix);
+  expectSameTriples("PREFIX a: <http://b/> SELECT ?x { a:b a:p ?x }");
+  EXPECT_EQ(cache.numMisses(), 8);
+}
+
+// _____________________________________________________________________________
+TEST(QueryTemplate, keyAndConstants) {
+  QueryTemplate a{"SELECT * { <http://a> ?p \"x\"^^<http://t> } LIMIT 5"};
+  QueryTemplate b{"SELECT *\n{ <http://b> ?p 'y'^^<http://t> }  LIMIT 5"};
+  EXPECT_EQ(a.key(), b.key());
+  EXPECT_THAT(a.constants(),
+              ::testing::ElementsAre("<http://a>", "\"x\"^^<http://t>"));
+  EXPECT_THAT(b.constants(),
+              ::testing::ElementsAre("<http://b>", "'y'^^<http://t>"));
+  EXPECT_EQ(a.withPlaceholders({true, false}),
+            absl::StrCat("SELECT * { ", QueryTemplate::placeholder(0),
+                         " ?p \"x\"^^<http://t> } LIMIT 5"));
+  auto iri = [](const std::string& iri) {
+    return TripleComponent{TripleComponent::Iri::fromIriref(iri)};
+  };
+  EXPECT_EQ(QueryTemplate::getPlaceholderIndex(
+                iri(QueryTemplate::placeholder(3))),
+            3u);
+  EXPECT_EQ(QueryTemplate::getPlaceholderIndex(iri("<http://a>")),
+            std::nullopt);
+
+  // Relative IRIs, function calls, numbers, and literals with escapes are not
+  // lifted, and neither are the constants of a query with `BASE`.
+  EXPECT_TRUE(QueryTemplate{"SELECT * { <a> ?p 42, \"a\\n\" }"}
+                  .constants()
+                  .empty());
+  EXPECT_TRUE(QueryTemplate{"SELECT (<http://f>(?x) AS ?y) {}"}
+                  .constants()
+                  .empty());
+  EXPECT_TRUE(QueryTemplate{"BASE <http://b/> SELECT * { <http://a> ?p ?o }"}
+                  .constants()
+                  .empty());
+  EXPECT_NE(QueryTemplate{"SELECT * { ?s ?p ?o }"}.key(),
+            QueryTemplate{"SELECT * { ?s ?p ?q }"}.key());
+
+  // The parsing of single constants.
+  EncodedIriManager encodedIriManager;
+  EXPECT_EQ(QueryTemplate::parseConstant(&encodedIriManager, "\"a\"@en"),
+            TripleComponent{TripleComponent::Literal::fromStringRepresentation(
+                "\"a\"@en")});
+  for (std::string_view invalid : {"<a> . <b> <c> <d>", "<a> , <b>", "_:b",
+                                   "?x", "\"a\" <b>"}) {
+    EXPECT_ANY_THROW(
+        QueryTemplate::parseConstant(&encodedIriManager, invalid));
+  }
+}
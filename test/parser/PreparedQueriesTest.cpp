@@ -0,0 +1,147 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "parser/PreparedQueries.h"
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+namespace {
+const std::string query = "SELECT ?name WHERE { $person <name> ?name }";
+
+// Return the `VALUES` clause at the beginning of the `WHERE` clause of the
+// `parsedQuery`.
+const parsedQuery::SparqlValues& getBoundValues(
+    const ParsedQuery& parsedQuery) {
+  const auto& patterns = parsedQuery._rootGraphPattern._graphPatterns;
+  AD_CONTRACT_CHECK(!patterns.empty());
+  return std::get<parsedQuery::Values>(patterns.front())._inlineValues;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PreparedQueries, prepareAndBind) {
+  EncodedIriManager encodedIriManager;
+  PreparedQueries preparedQueries{10};
+  auto id = preparedQueries.prepare(&encodedIriManager, query);
+  EXPECT_EQ(preparedQueries.numQueries(), 1);
+  EXPECT_THAT(id, ::testing::MatchesRegex("[0-9a-f]{32}"));
+  EXPECT_THAT(preparedQueries.getParameters(id),
+              ElementsAre(Variable{"?person"}, Variable{"?name"}));
+
+  // Bind a single parameter (with and without the leading `?` or `$`).
+  for (std::string name : {"person", "?person", "$person"}) {
+    auto bound = preparedQueries.bind(&encodedIriManager, id,
+                                      {{name, "<http://example.org/x>"}});
+    EXPECT_EQ(bound._originalString, query);
+    EXPECT_EQ(bound._rootGraphPattern._graphPatterns.size(), 2);
+    const auto& values = getBoundValues(bound);
+    EXPECT_THAT(values._variables, ElementsAre(Variable{"?person"}));
+    ASSERT_EQ(values._values.size(), 1);
+    EXPECT_THAT(values._values[0],
+                ElementsAre(TripleComponent{TripleComponent::Iri::fromIriref(
+                    "<http://example.org/x>")}));
+  }
+
+  // Bind both parameters, the values are literals.
+  auto bound = preparedQueries.bind(
+      &encodedIriManager, id, {{"person", "42"}, {"name", "\"Alice\"@en"}});
+  const auto& values = getBoundValues(bound);
+  EXPECT_THAT(values._variables,
+              ElementsAre(Variable{"?person"}, Variable{"?name"}));
+  ASSERT_EQ(values._values.size(), 1);
+  EXPECT_EQ(values._values[0][0], TripleComponent{int64_t{42}});
+  EXPECT_TRUE(values._values[0][1].isLiteral());
+
+  // Without bindings, the query is unchanged.
+  auto unbound = preparedQueries.bind(&encodedIriManager, id, {});
+  EXPECT_EQ(unbound._rootGraphPattern._graphPatterns.size(), 1);
+
+  // Queries with aggregates are parsed again for each execution.
+  auto aggregateId = preparedQueries.prepare(
+      &encodedIriManager,
+      "SELECT (COUNT(?name) AS ?count) { ?person <name> ?name }");
+  for (size_t i = 0; i < 2; ++i) {
+    auto boundAggregate = preparedQueries.bind(
+        &encodedIriManager, aggregateId, {{"person", "<x>"}});
+    EXPECT_THAT(getBoundValues(boundAggregate)._variables,
+                ElementsAre(Variable{"?person"}));
+  }
+
+  // The same holds for `NOW()`, which is evaluated at the time of the parsing,
+  // so each execution gets its own expression.
+  auto nowId = preparedQueries.prepare(
+      &encodedIriManager, "SELECT ?person (NOW() AS ?now) { ?person <a> <b> }");
+  auto first = preparedQueries.bind(&encodedIriManager, nowId, {});
+  auto second = preparedQueries.bind(&encodedIriManager, nowId, {});
+  EXPECT_FALSE(first.mayBeReused_);
+  auto getNow = [](const ParsedQuery& bound) {
+    const auto& aliases = bound.selectClause().getAliases();
+    AD_CORRECTNESS_CHECK(aliases.size() == 1);
+    return aliases[0]._expression.getPimpl();
+  };
+  EXPECT_NE(getNow(first), getNow(second));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedQueries, errors) {
+  EncodedIriManager encodedIriManager;
+  PreparedQueries preparedQueries{1};
+  auto id = preparedQueries.prepare(&encodedIriManager, query);
+
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQueries.bind(&encodedIriManager, "unknown", {}),
+      HasSubstr("There is no prepared query with ID \"unknown\""));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQueries.bind(&encodedIriManager, id, {{"other", "<x>"}}),
+      HasSubstr("The variable ?other is not a parameter"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQueries.bind(&encodedIriManager, id,
+                           {{"person", "<x>"}, {"?person", "<y>"}}),
+      HasSubstr("has more than one value"));
+  // The value has to be a single IRI or literal.
+  for (std::string value : {"<x", "<x> . <a> <b> <c>", "<a> , <b>", "_:b",
+                            "?x", ""}) {
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        preparedQueries.bind(&encodedIriManager, id, {{"person", value}}),
+        HasSubstr("for the parameter ?person is not a single IRI or literal"));
+  }
+
+  // The variables that are assigned by `BIND` or `VALUES` are no parameters.
+  auto assignedId = preparedQueries.prepare(
+      &encodedIriManager,
+      "SELECT * { ?x <p> ?y BIND(3 AS ?z) OPTIONAL { VALUES ?w { 1 } } } "
+      "VALUES ?v { 2 }");
+  EXPECT_THAT(preparedQueries.getParameters(assignedId),
+              ElementsAre(Variable{"?x"}, Variable{"?y"}));
+  for (std::string name : {"?z", "?w", "?v"}) {
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        preparedQueries.bind(&encodedIriManager, assignedId, {{name, "1"}}),
+        HasSubstr("is not a parameter"));
+  }
+  // The registry only has room for a single query.
+  id = preparedQueries.prepare(&encodedIriManager, query);
+
+  // Invalid queries can't be prepared.
+  EXPECT_ANY_THROW(preparedQueries.prepare(&encodedIriManager, "SELECT * {"));
+  EXPECT_EQ(preparedQueries.numQueries(), 1);
+
+  // The least recently used query is removed when the maximal number of
+  // queries is reached.
+  auto secondId = preparedQueries.prepare(&encodedIriManager, query);
+  EXPECT_NE(id, secondId);
+  EXPECT_EQ(preparedQueries.numQueries(), 1);
+  EXPECT_ANY_THROW(preparedQueries.getParameters(id));
+  EXPECT_NO_THROW(preparedQueries.getParameters(secondId));
+
+  // Disable the prepared queries.
+  preparedQueries.setMaxNumQueries(0);
+  EXPECT_EQ(preparedQueries.numQueries(), 0);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      preparedQueries.prepare(&encodedIriManager, query),
+      HasSubstr("Preparing queries is disabled"));
+}
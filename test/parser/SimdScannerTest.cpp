@@ -0,0 +1,61 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "parser/SimdScanner.h"
+
+using namespace simdScanner;
+
+namespace {
+// Compare `findFirstOf` and `findFirstNotOf` against the corresponding
+// functions of `std::string_view` for all start positions in `input`.
+void checkAgainstStringView(std::string_view input) {
+  static constexpr std::string_view chars = "<>\"\n";
+  for (size_t pos = 0; pos <= input.size() + 1; ++pos) {
+    EXPECT_EQ((findFirstOf<'<', '>', '"', '\n'>(input, pos)),
+              input.find_first_of(chars, pos))
+        << input << ' ' << pos;
+    EXPECT_EQ((findFirstNotOf<'<', '>', '"', '\n'>(input, pos)),
+              input.find_first_not_of(chars, pos))
+        << input << ' ' << pos;
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SimdScanner, findFirstOfAndFirstNotOf) {
+  checkAgainstStringView("");
+  checkAgainstStringView("<");
+  checkAgainstStringView("abc");
+  checkAgainstStringView("<http://example.org/a>");
+  checkAgainstStringView("\"a literal with a \\\" quote\"@en .\n");
+  // Inputs that span several chunks, with the matches at different positions
+  // within and at the borders of the chunks.
+  for (size_t numPrefix : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 100}) {
+    std::string input(numPrefix, 'x');
+    input += ">";
+    input += std::string(40, 'y');
+    input += "\n";
+    checkAgainstStringView(input);
+    checkAgainstStringView(std::string(numPrefix, '<') + "abc");
+  }
+}
+
+// _____________________________________________________________________________
+TEST(SimdScanner, numLeadingWhitespace) {
+  EXPECT_EQ(numLeadingWhitespace(""), 0);
+  EXPECT_EQ(numLeadingWhitespace("abc"), 0);
+  EXPECT_EQ(numLeadingWhitespace(" \t\r\nabc"), 4);
+  EXPECT_EQ(numLeadingWhitespace("   "), 3);
+  for (size_t numWhitespace : {1, 16, 31, 32, 33, 70}) {
+    std::string whitespace;
+    for (size_t i = 0; i < numWhitespace; ++i) {
+      whitespace.push_back(" \t\r\n"[i % 4]);
+    }
+    EXPECT_EQ(numLeadingWhitespace(whitespace), numWhitespace);
+    EXPECT_EQ(numLeadingWhitespace(whitespace + "<a> ."), numWhitespace);
+  }
+}
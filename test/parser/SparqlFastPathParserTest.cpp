@@ -0,0 +1,157 @@
+//  Copyright 2026, University of Freiburg,
+//  Chair of Algorithms and Data Structures.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/VariableToColumnMap.h"
+#include "parser/SparqlFastPathParser.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+// Parse the `query` with the parser that is generated by ANTLR.
+ParsedQuery parseWithAntlr(const EncodedIriManager& encodedIriManager,
+                           const std::string& query,
+                           const std::vector<DatasetClause>& datasets = {}) {
+  auto cleanup =
+      setRuntimeParameterForTest<"use-sparql-fast-path-parser">(false);
+  return SparqlParser::parseQuery(&encodedIriManager, query, datasets);
+}
+
+// Check that the fast path supports the `query` and that the result is the
+// same as the result of the parser that is generated by ANTLR.
+void expectSameAsAntlr(const std::string& query,
+                       const std::vector<DatasetClause>& datasets = {},
+                       ad_utility::source_location l =
+                           ad_utility::source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  EncodedIriManager encodedIriManager;
+  auto expected = parseWithAntlr(encodedIriManager, query, datasets);
+  auto result =
+      SparqlFastPathParser::tryParseQuery(&encodedIriManager, query, datasets);
+  ASSERT_TRUE(result.has_value()) << query;
+  const auto& actual = result.value();
+
+  EXPECT_EQ(actual._originalString, expected._originalString);
+  ASSERT_TRUE(actual.hasSelectClause());
+  const auto& select = actual.selectClause();
+  const auto& expectedSelect = expected.selectClause();
+  EXPECT_EQ(select.distinct_, expectedSelect.distinct_);
+  EXPECT_EQ(select.isAsterisk(), expectedSelect.isAsterisk());
+  EXPECT_EQ(select.getSelectedVariables(),
+            expectedSelect.getSelectedVariables());
+  EXPECT_EQ(actual.getVisibleVariables(), expected.getVisibleVariables());
+  EXPECT_EQ(actual._limitOffset, expected._limitOffset);
+  EXPECT_EQ(actual.warnings(), expected.warnings());
+  EXPECT_EQ(actual.datasetClauses_, expected.datasetClauses_);
+
+  const auto& patterns = actual._rootGraphPattern._graphPatterns;
+  const auto& expectedPatterns = expected._rootGraphPattern._graphPatterns;
+  ASSERT_EQ(patterns.size(), expectedPatterns.size());
+  if (!patterns.empty()) {
+    EXPECT_EQ(patterns[0].getBasic()._triples,
+              expectedPatterns[0].getBasic()._triples);
+  }
+
+  // The filters are compared via their descriptors and their cache keys,
+  // which contain the structure of the expressions.
+  const auto& filters = actual._rootGraphPattern._filters;
+  const auto& expectedFilters = expected._rootGraphPattern._filters;
+  EXPECT_EQ(filters, expectedFilters);
+  VariableToColumnMap varColMap;
+  for (const auto& var : expected.getVisibleVariables()) {
+    varColMap[var] = makeAlwaysDefinedColumn(varColMap.size());
+  }
+  ASSERT_EQ(filters.size(), expectedFilters.size());
+  for (size_t i = 0; i < filters.size(); ++i) {
+    EXPECT_EQ(filters[i].expression_.getCacheKey(varColMap),
+              expectedFilters[i].expression_.getCacheKey(varColMap));
+  }
+}
+
+// Check that the fast path doesn't support the `query`.
+void expectUnsupported(const std::string& query,
+                       ad_utility::source_location l =
+                           ad_utility::source_location::current()) {
+  auto trace = generateLocationTrace(l);
+  EncodedIriManager encodedIriManager;
+  EXPECT_FALSE(
+      SparqlFastPathParser::tryParseQuery(&encodedIriManager, query)
+          .has_value())
+      << query;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SparqlFastPathParser, supportedQueries) {
+  expectSameAsAntlr("SELECT ?x WHERE { ?x <p> <o> }");
+  expectSameAsAntlr("SELECT * {}");
+  expectSameAsAntlr("select distinct ?x ?y { ?x <p> ?y . }");
+  expectSameAsAntlr(
+      "PREFIX ex: <http://example.org/>\n"
+      "PREFIX : <http://default.org/>\n"
+      "SELECT ?x ?name WHERE {\n"
+      "  # A comment.\n"
+      "  ?x a ex:Person ; ex:name ?name , \"Alice\"@en-US ;\n"
+      "     :age 42 ; ex:born \"1990\"^^ex:year ; .\n"
+      "  ?x ?p ?o .\n"
+      "} LIMIT 10 OFFSET 5");
+  expectSameAsAntlr("SELECT ?x { ?x <p> ?y } OFFSET 3 LIMIT 4");
+  expectSameAsAntlr(
+      "PREFIX xsd: <http://www.w3.org/2001/XMLSchema#>\n"
+      "SELECT ?x ?y WHERE { ?x <p> ?y FILTER(?y > 3) "
+      "FILTER (?y!=\"a\") . ?x <q> <r> . FILTER(?x = <s>) "
+      "FILTER(?y <= \"3.5\"^^xsd:decimal) FILTER(?y < ?x) "
+      "FILTER(?y >= \"x\"@en) }");
+  expectSameAsAntlr("SELECT ?x { ?x ql:has-predicate ?p }");
+  expectSameAsAntlr("SELECT * { ?x <p> \"with # hash\" }");
+
+  // Datasets from outside the query.
+  expectSameAsAntlr("SELECT ?x WHERE { ?x <p> <o> }",
+                    {{TripleComponent::Iri::fromIriref("<g>"), false}});
+
+  // A variable that is selected but not visible leads to a warning.
+  expectSameAsAntlr("SELECT ?z WHERE { ?x <p> <o> }");
+}
+
+// _____________________________________________________________________________
+TEST(SparqlFastPathParser, unsupportedQueries) {
+  expectUnsupported("ASK { ?x <p> <o> }");
+  expectUnsupported("SELECT (?x AS ?y) { ?x <p> <o> }");
+  expectUnsupported("SELECT ?x FROM <g> { ?x <p> <o> }");
+  expectUnsupported("SELECT ?x { ?x <p> <o> OPTIONAL { ?x <q> ?y } }");
+  expectUnsupported("SELECT ?x { ?x <p>+ <o> }");
+  expectUnsupported("SELECT ?x { ?x <p> [ <q> ?y ] }");
+  expectUnsupported("SELECT ?x { ?x <p> ?y FILTER(?y > 3 && ?y < 5) }");
+  expectUnsupported("SELECT ?x { ?x <p> ?y FILTER(?y<?x>) }");
+  expectUnsupported("SELECT ?x { ?x <p> \"\\u0041\" }");
+  expectUnsupported("SELECT ?x { ?x <p> \"\xc3\xa4\" }");
+  expectUnsupported("SELECT ?x { ?x <p> 3.5 }");
+  expectUnsupported("SELECT ?x { ?x <p> ?y } ORDER BY ?x");
+  expectUnsupported("SELECT ?x { ?x <p> ?y } LIMIT 1 LIMIT 2");
+  expectUnsupported("SELECT ?x { ?x ql:contains-word \"word\" }");
+
+  // Invalid queries are left to the general parser, which reports the error.
+  expectUnsupported("SELECT ?x { ?x <p> <o> ");
+  expectUnsupported("SELECT ?x { ?x unknown:p <o> }");
+  expectUnsupported("SELECT ?x { ?x <p> 99999999999999999999999 }");
+}
+
+// _____________________________________________________________________________
+TEST(SparqlFastPathParser, usedBySparqlParser) {
+  EncodedIriManager encodedIriManager;
+  // Both with and without the fast path, the supported queries are parsed and
+  // errors are reported by the general parser.
+  for (bool useFastPath : {true, false}) {
+    auto cleanup =
+        setRuntimeParameterForTest<"use-sparql-fast-path-parser">(useFastPath);
+    auto query = SparqlParser::parseQuery(&encodedIriManager,
+                                          "SELECT ?x { ?x <p> <o> }");
+    EXPECT_THAT(query.getVisibleVariables(),
+                ::testing::ElementsAre(Variable{"?x"}));
+    EXPECT_ANY_THROW(
+        SparqlParser::parseQuery(&encodedIriManager, "SELECT ?x { ?x <p> "));
+  }
+}
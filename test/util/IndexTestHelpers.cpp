@@ -57,7 +57,9 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".docsfile",
           indexBasename + ".text.index",
           indexBasename + ".text.vocabulary",
-          indexBasename + ".text.docsDB"};
+          indexBasename + ".text.docsDB",
+          indexBasename + ".reachability.0",
+          indexBasename + ".reachability.1"};
 }
 
 namespace {
@@ -169,6 +171,9 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
       settingsJson["prefixes-external"] = std::vector<std::string>{""};
       settingsJson["languages-internal"] = std::vector<std::string>{""};
     }
+    if (!c.reachabilityPredicates.empty()) {
+      settingsJson["reachability-predicates"] = c.reachabilityPredicates;
+    }
     settingsFile << settingsJson.dump();
   }
   {
@@ -183,6 +188,7 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     index.usePatterns() = c.usePatterns;
     index.setSettingsFile(inputFilename + ".settings.json");
     index.loadAllPermutations() = c.loadAllPermutations;
+    index.parallelPermutationCreation() = c.parallelPermutationCreation;
     qlever::InputFileSpecification spec{inputFilename, c.indexType,
                                         std::nullopt};
     // randomly choose one of the vocabulary implementations
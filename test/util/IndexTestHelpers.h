@@ -50,6 +50,7 @@ struct TestIndexConfig {
   std::optional<std::string> turtleInput = std::nullopt;
   bool loadAllPermutations = true;
   bool usePatterns = true;
+  bool parallelPermutationCreation = false;
   bool usePrefixCompression = true;
   ad_utility::MemorySize blocksizePermutations = 16_B;
   bool createTextIndex = false;
@@ -65,6 +66,8 @@ struct TestIndexConfig {
   qlever::Filetype indexType = qlever::Filetype::Turtle;
   std::optional<VocabularyType> vocabularyType = std::nullopt;
   std::optional<EncodedIriManager> encodedIriManager = std::nullopt;
+  // The IRIs of the predicates for which a reachability index is built.
+  std::vector<std::string> reachabilityPredicates;
 
   // A very typical use case is to only specify the turtle input, and leave all
   // the other members as the default. We therefore have a dedicated constructor
@@ -77,11 +80,12 @@ struct TestIndexConfig {
   template <typename H>
   friend H AbslHashValue(H h, const TestIndexConfig& c) {
     return H::combine(std::move(h), c.turtleInput, c.loadAllPermutations,
-                      c.usePatterns, c.usePrefixCompression,
-                      c.blocksizePermutations, c.createTextIndex,
-                      c.addWordsFromLiterals, c.contentsOfWordsFileAndDocsfile,
-                      c.parserBufferSize, c.scoringMetric, c.bAndKParam,
-                      c.indexType, c.encodedIriManager);
+                      c.usePatterns, c.parallelPermutationCreation,
+                      c.usePrefixCompression, c.blocksizePermutations,
+                      c.createTextIndex, c.addWordsFromLiterals,
+                      c.contentsOfWordsFileAndDocsfile, c.parserBufferSize,
+                      c.scoringMetric, c.bAndKParam, c.indexType,
+                      c.encodedIriManager, c.reachabilityPredicates);
   }
   bool operator==(const TestIndexConfig&) const = default;
 };